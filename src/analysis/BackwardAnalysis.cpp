@@ -18,10 +18,13 @@
  ***************************************************************************/
 
 #include "BackwardAnalysis.h"
+#include "MeasuredOrder.h"
+#include "BreadthFirstStrategy.h"
 #include "../basic_types/RunException.h"
+#include "../basic_types/CancelledException.h"
 #include "../logging/message_logging.h"
-#include <time.h>
 #include <sstream>
+#include <chrono>
 
 using namespace std;
 using namespace uncover::graphs;
@@ -31,6 +34,8 @@ using namespace uncover::logging;
 namespace uncover {
 	namespace analysis {
 
+		InitialCoverage::InitialCoverage() : covered(false), initialGraph(nullptr), graphChain(), ruleChain() {}
+
 		BackwardAnalysis::BackwardAnalysis(GTS_sp gts,
 				shared_ptr<vector<Hypergraph_sp>> errorGraphs,
 				Order_sp order,
@@ -46,11 +51,23 @@ namespace uncover {
 		  pocEnumerator(pocEnumerator),
 		  checkInitial(checkInitial),
 		  resultHandler(resultHandler),
-		  timer((timeout==0) ? nullptr : new Timer(timeout)) {}
-
-		BackwardAnalysis::~BackwardAnalysis() {
-			if(timer) delete timer;
-		}
+		  timeout(timeout),
+		  cancellation(make_shared<CancellationToken>()),
+		  initialCheckOrder(order),
+		  metricsWriter(nullptr),
+		  dropIsomorphicGraphs(true),
+		  isomorphismFilter(),
+		  ruleProfiler(nullptr),
+		  preparedGTSCache(nullptr),
+		  pruneDominatedRules(false),
+		  explorationStrategy(make_shared<BreadthFirstStrategy>()),
+		  initialCheckThreads(1),
+		  initialCheckInvariants(true),
+		  initialIndex(nullptr),
+		  predecessors(),
+		  initialCoverage() {}
+
+		BackwardAnalysis::~BackwardAnalysis() {}
 
 		shared_ptr<vector<Hypergraph_sp>> BackwardAnalysis::performAnalysis() {
 
@@ -75,18 +92,50 @@ namespace uncover {
 				throw RunException("No enumerator for minimal pushout complements was given for the backward search.");
 			}
 
-			// start timer if existent
-			if(timer) {
-				timer->start();
+			// set the deadline if a timeout is given
+			if(timeout > 0) {
+				cancellation->setTimeout(chrono::seconds(timeout));
 			}
 
+			// wrap the order to measure its calls, if requested
+			Order_sp minimizationOrder = order;
+			initialCheckOrder = order;
+			if(metrics.isEnabled()) {
+				minimizationOrder = make_shared<MeasuredOrder>(order, "minimization", metrics);
+				initialCheckOrder = make_shared<MeasuredOrder>(order, "initial", metrics);
+			}
+
+			// index the initial graphs once; note: the preparation does not change the initial graphs
+			initialCoverage = InitialCoverage();
+			predecessors.clear();
+			initialIndex = checkInitial ?
+					make_shared<InitialGraphIndex>(initialCheckOrder, gts->getInitialGraphs(), initialCheckInvariants) : nullptr;
+
 			// prepare rule set and generate new gts
-			PreparedGTS_sp prepGTS = make_shared<PreparedGTS>(*gts,rulePreparer);
+			PreparedGTS_sp prepGTS = nullptr;
+			long cachedQuantities = -1;
+			if(preparedGTSCache) {
+				prepGTS = preparedGTSCache->load(*gts, rulePreparer);
+				if(prepGTS) {
+					cachedQuantities = prepGTS->getPreparedQuantityCount();
+				}
+			}
+			if(!prepGTS) {
+				prepGTS = make_shared<PreparedGTS>(*gts,rulePreparer);
+			}
+			if(pruneDominatedRules) {
+				size_t removed = prepGTS->removeDominatedRules();
+				logger.newUserInfo() << "Removed " << removed << " prepared rules dominated by other prepared rules." << endLogMessage;
+			}
 			logger.newUserInfo() << "The rule preparer generated a new set of (standard) rules now containing ";
 			logger.contMsg() << prepGTS->getStdRuleCount() << " rules (old set contained " << gts->getStdRules().size() << " rules). ";
 			logger.contMsg() << "The " << prepGTS->getUQRuleCount() << " universally quantified rules where not prepared." << endLogMessage;
 			pocEnumerator->setResultHandler(resultHandler);
 			pocEnumerator->setPreparedGTS(prepGTS);
+			// isomorphic pushout complements would be dropped anyway, so the enumerator may skip them
+			pocEnumerator->setUpToIsomorphism(dropIsomorphicGraphs);
+			ruleProfiler = make_shared<RuleProfiler>();
+			ruleProfiler->setPreparedGTS(prepGTS);
 
 			// Process all preparation results, if ResultHandler is defined
 			if(resultHandler) {
@@ -95,51 +144,106 @@ namespace uncover {
 				resultHandler->setFirstGraphs(errorGraphs);
 			}
 
+			// retrieve counters for all (prepared) rules once
+			unordered_map<IDType,Counter*> stdRuleCounters;
+			for(auto ruleIt = prepGTS->getStdRules().cbegin(); ruleIt != prepGTS->getStdRules().cend(); ++ruleIt) {
+				stdRuleCounters[ruleIt->first] = &metrics.getCounter("analysis.poc.rule" + to_string(ruleIt->first));
+			}
+			unordered_map<IDType,Counter*> uqRuleCounters;
+			for(auto ruleIt = prepGTS->getUQRules().cbegin(); ruleIt != prepGTS->getUQRules().cend(); ++ruleIt) {
+				uqRuleCounters[ruleIt->first] = &metrics.getCounter("analysis.poc.uqrule" + to_string(ruleIt->first));
+			}
+			Counter& processedCounter = metrics.getCounter("analysis.graphs.processed");
+			Counter& skippedCounter = metrics.getCounter("analysis.graphs.skipped");
+			Gauge& depthGauge = metrics.getGauge("analysis.depth");
+			Gauge& listSizeGauge = metrics.getGauge("analysis.mingraphlist.size");
+
 			// generate all needed graph lists
-			MinGraphList minimalGraphs(order, resultHandler);
+			MinGraphList minimalGraphs(minimizationOrder, resultHandler);
 			minimalGraphs.addGraphs(*errorGraphs);
-			vector<Hypergraph_sp>* todoGraphs = new vector<Hypergraph_sp>(*errorGraphs);
-			vector<Hypergraph_sp>* newGraphs = new vector<Hypergraph_sp>();
+			explorationStrategy->clear();
+			explorationStrategy->initialize(prepGTS, ruleProfiler);
+			for(Hypergraph_sp const& graph : *errorGraphs) {
+				explorationStrategy->add(graph);
+			}
+			vector<Hypergraph_sp> newGraphs;
+			logger.newUserInfo() << "Using exploration strategy '" << explorationStrategy->getName() << "'." << endLogMessage;
 
 			// check timeout before starting backward step computation
-			if(timer && timer->outOfTime()) {
-				logger.newWarning() << "Timeout reached before first backward step! Stopping." << endLogMessage;
-				return minimalGraphs.getGraphs();
+			if(cancellation->isCancelled()) {
+				logger.newWarning() << "Stopping before the first backward step, because " << getCancellationReason();
+				logger.contMsg() << "." << endLogMessage;
+				return finishAnalysis(*prepGTS, cachedQuantities, minimalGraphs.getGraphs());
 			}
 
+			// from now on long computations are interrupted as soon as the token is cancelled; the wrapping
+			// MeasuredOrders forward to the same order
+			order->setCancellationToken(cancellation);
+			pocEnumerator->setCancellationToken(cancellation);
+			minimalGraphs.setCancellationToken(cancellation);
+
+			// if the analysis is cancelled, the minimal graphs of the last finished step are returned, since the
+			// list may contain graphs of the unfinished step which are not minimal w.r.t. all its predecessors
+			shared_ptr<vector<Hypergraph_sp>> finishedStepGraphs;
+			auto stopResult = [&]() {
+				if(initialCoverage.covered) {
+					return minimalGraphs.getGraphs();
+				}
+				logger.newWarning() << "Stopping because " << getCancellationReason() << ". Discarding the results of ";
+				logger.contMsg() << "the unfinished backward step." << endLogMessage;
+				return finishedStepGraphs;
+			};
+
 			size_t searchDepth = 1;
-			while (todoGraphs->size() > 0) {
+			while (!explorationStrategy->empty()) {
 
 				logger.newUserInfo() << "Starting with search depth " << searchDepth << ", ";
-				logger.contMsg() << todoGraphs->size() << " new graphs to process." << endLogMessage;
+				logger.contMsg() << explorationStrategy->size() << " new graphs to process." << endLogMessage;
 
 				if(resultHandler) {
 					resultHandler->startingNewBackwardStep();
 				}
+				isomorphismFilter.clear();
+				finishedStepGraphs = make_shared<vector<Hypergraph_sp>>(*minimalGraphs.getGraphs());
+
+				depthGauge.set(searchDepth);
+				Counter& depthProcessedCounter = metrics.getCounter("analysis.depth" + to_string(searchDepth) + ".processed");
+				Counter& depthSkippedCounter = metrics.getCounter("analysis.depth" + to_string(searchDepth) + ".skipped");
 
 				size_t todoCounter = 0;
-				size_t todoSize = todoGraphs->size();
-				while(todoGraphs->size() > 0) {
+				size_t todoSize = explorationStrategy->size();
+				while(!explorationStrategy->empty()) {
 
-					Hypergraph_sp currentGraph = todoGraphs->back();
-					todoGraphs->pop_back();
+					Hypergraph_sp currentGraph = explorationStrategy->next();
 
 					// check if a graph smaller than the current graph was found in the meantime
+					++todoCounter;
 					if(!minimalGraphs.contains(currentGraph->getID())) {
-						logger.newUserInfo() << "Skipping graph " << ++todoCounter << " of " << todoSize;
-						logger.contMsg() << " (id=" << currentGraph->getID() << "), it was already subsumed by another graph." << endLogMessage;
+						skippedCounter.increment();
+						depthSkippedCounter.increment();
+						if(logger.isActive(LogTypes::LT_UserInfo)) {
+							logger.newUserInfo() << "Skipping graph " << todoCounter << " of " << todoSize;
+							logger.contMsg() << " (id=" << currentGraph->getID() << "), it was already subsumed by another graph." << endLogMessage;
+						}
 						continue;
 					}
 
-					logger.newUserInfo() << "Processing graph " << ++todoCounter << " of " << todoSize << " (size: ";
-					logger.contMsg() << currentGraph->getVertexCount() << " vertices, " << currentGraph->getEdgeCount() << " edges)." << endLogMessage;
+					if(logger.isActive(LogTypes::LT_UserInfo)) {
+						logger.newUserInfo() << "Processing graph " << todoCounter << " of " << todoSize << " (size: ";
+						logger.contMsg() << currentGraph->getVertexCount() << " vertices, " << currentGraph->getEdgeCount() << " edges)." << endLogMessage;
+					}
+					processedCounter.increment();
+					depthProcessedCounter.increment();
 
 					// apply all rules backward one at a time
 					auto ruleMap = prepGTS->getStdRules();
 					for(auto ruleIt = ruleMap.cbegin(); ruleIt != ruleMap.cend(); ++ruleIt) {
-						pocEnumerator->resetWith(ruleIt->second, currentGraph);
-						if(applyOne(minimalGraphs, *newGraphs)) {
-							return minimalGraphs.getGraphs();
+						bool stop = applyProfiled([&]() { pocEnumerator->resetWith(ruleIt->second, currentGraph); },
+								minimalGraphs, newGraphs, currentGraph->getID(), ruleIt->first, *stdRuleCounters[ruleIt->first],
+								ruleProfiler->getStdRuleProfile(ruleIt->first));
+						listSizeGauge.set(minimalGraphs.size());
+						if(stop) {
+							return finishAnalysis(*prepGTS, cachedQuantities, stopResult());
 						}
 					}
 
@@ -149,9 +253,12 @@ namespace uncover {
 
 						// generate all instances up to the necessary bound
 						for(auto instIt = prepGTS->beginUQInstances(ruleIt->first, *currentGraph);	!instIt.hasEnded(); ++instIt) {
-							pocEnumerator->resetWith(*instIt, ruleIt->first, currentGraph);
-							if(applyOne(minimalGraphs, *newGraphs)) {
-								return minimalGraphs.getGraphs();
+							bool stop = applyProfiled([&]() { pocEnumerator->resetWith(*instIt, ruleIt->first, currentGraph); },
+									minimalGraphs, newGraphs, currentGraph->getID(), ruleIt->first, *uqRuleCounters[ruleIt->first],
+									ruleProfiler->getUQRuleProfile(ruleIt->first));
+							listSizeGauge.set(minimalGraphs.size());
+							if(stop) {
+								return finishAnalysis(*prepGTS, cachedQuantities, stopResult());
 							}
 						}
 
@@ -160,73 +267,233 @@ namespace uncover {
 				}
 
 				// initialize lists for next round
-				delete todoGraphs;
-				todoGraphs = newGraphs;
-				newGraphs = new vector<Hypergraph_sp>();
+				for(Hypergraph_sp const& graph : newGraphs) {
+					explorationStrategy->add(graph);
+				}
+				newGraphs.clear();
 
 				if(resultHandler) {
 					resultHandler->finishedBackwardStep();
 				}
+				writeMetrics("step" + to_string(searchDepth));
 
 				++searchDepth;
 
 			}
 
 			logger.newUserInfo() << "Backward search terminated finding " << minimalGraphs.size() << " error graphs." << endLogMessage;
+			return finishAnalysis(*prepGTS, cachedQuantities, minimalGraphs.getGraphs());
+		}
 
-			// set names of all error graphs if they don't already have a name
-			auto result = minimalGraphs.getGraphs();
-			for(auto graph : *result) {
-				if(graph->getName().empty()) {
-					stringstream s;
-					s << "EG" << graph->getID();
-					graph->setName(s.str());
-				}
+		void BackwardAnalysis::setMetricsWriter(MetricsWriter_sp writer) {
+			metricsWriter = writer;
+		}
+
+		void BackwardAnalysis::setPreparedGTSCache(PreparedGTSCache_csp cache) {
+			preparedGTSCache = cache;
+		}
+
+		void BackwardAnalysis::setPruneDominatedRules(bool prune) {
+			pruneDominatedRules = prune;
+		}
+
+		void BackwardAnalysis::setExplorationStrategy(ExplorationStrategy_sp strategy) {
+			if(strategy) {
+				explorationStrategy = strategy;
+			} else {
+				explorationStrategy = make_shared<BreadthFirstStrategy>();
 			}
+		}
 
-			return result;
+		void BackwardAnalysis::setDropIsomorphicGraphs(bool drop) {
+			dropIsomorphicGraphs = drop;
+		}
+
+		void BackwardAnalysis::setInitialCheckThreads(unsigned int threads) {
+			initialCheckThreads = threads;
+		}
+
+		void BackwardAnalysis::setInitialCheckInvariants(bool useInvariants) {
+			initialCheckInvariants = useInvariants;
+		}
+
+		InitialCoverage const& BackwardAnalysis::getInitialCoverage() const {
+			return initialCoverage;
+		}
+
+		void BackwardAnalysis::setCancellationToken(CancellationToken_sp token) {
+			cancellation = token ? token : make_shared<CancellationToken>();
+		}
+
+		CancellationToken_sp BackwardAnalysis::getCancellationToken() const {
+			return cancellation;
+		}
+
+		RuleProfiler_csp BackwardAnalysis::getRuleProfiler() const {
+			return ruleProfiler;
+		}
+
+		bool BackwardAnalysis::applyProfiled(
+				std::function<void()> const& reset,
+				MinGraphList& minList,
+				vector<Hypergraph_sp>& newGraphs,
+				IDType graphID,
+				IDType ruleID,
+				Counter& pocCounter,
+				RuleProfile& profile) {
+
+			static Counter& droppedCounter = metrics.getCounter("poc.dropped_by_bound");
+			static Counter& isomorphicCounter = metrics.getCounter("analysis.graphs.isomorphic");
+			uint64_t producedBefore = profile.produced;
+			uint64_t isomorphic = 0;
+
+			auto start = chrono::steady_clock::now();
+			auto resetEnd = start;
+			bool stop = true;
+			try {
+				reset();
+				resetEnd = chrono::steady_clock::now();
+				stop = applyOne(minList, newGraphs, graphID, ruleID, isomorphic, profile);
+			} catch(CancelledException const&) {
+				// the results of the unfinished backward step are discarded by the caller
+			}
+			auto applyEnd = chrono::steady_clock::now();
+
+			// the shared counters are updated once per application instead of once per pushout complement
+			uint64_t dropped = pocEnumerator->getDroppedByBound();
+			pocCounter.increment(profile.produced - producedBefore);
+			droppedCounter.increment(dropped);
+			isomorphicCounter.increment(isomorphic);
+
+			++profile.applications;
+			profile.resetTime += chrono::duration_cast<chrono::nanoseconds>(resetEnd - start).count();
+			profile.enumerationTime += chrono::duration_cast<chrono::nanoseconds>(applyEnd - resetEnd).count();
+			profile.droppedByBound += dropped;
+			return stop;
 		}
 
 		bool BackwardAnalysis::applyOne(
 				MinGraphList& minList,
-				vector<Hypergraph_sp>& newGraphs) {
+				vector<Hypergraph_sp>& newGraphs,
+				IDType graphID,
+				IDType ruleID,
+				uint64_t& isomorphic,
+				RuleProfile& profile) {
+
+			// the graphs added to the list are checked together against the initial graphs
+			vector<Hypergraph_sp> addedGraphs;
 
 			while(!pocEnumerator->ended()) {
 
 				Hypergraph_sp newGraph = **pocEnumerator;
-				if(minList.addGraph(newGraph)) {
-
-					newGraphs.push_back(newGraph);
+				++profile.produced;
 
-					if(checkInitial) {
+				// drop copies of graphs already added in this step, they would be subsumed by the list anyway; only
+				// added graphs are stored, such that graphs subsumed at once do not stay alive until the step ends
+				Hypergraph_sp isomorphicGraph = dropIsomorphicGraphs ? isomorphismFilter.find(newGraph) : nullptr;
+				if(isomorphicGraph) {
 
-						// note: the preparation does not change the initial graphs
-						auto initialGraphs = gts->getInitialGraphs();
-						for(auto initIt = initialGraphs.cbegin(); initIt != initialGraphs.cend(); ++initIt) {
+					++isomorphic;
+					if(resultHandler) {
+						resultHandler->wasDeletedBecauseOf(newGraph->getID(), isomorphicGraph->getID());
+					}
 
-							if(order->isLessOrEq(*newGraph, **initIt)) {
-								logger.newUserInfo() << "One of the initial graphs was covered. ";
-								logger.contMsg() << "Aborting backward step and terminating after minimization." << endLogMessage;
-								return true;
-							}
+				} else if(minList.addGraph(newGraph)) {
 
-						}
+					if(dropIsomorphicGraphs) {
+						isomorphismFilter.insert(newGraph);
+					}
+					++profile.survived;
+					newGraphs.push_back(newGraph);
 
+					if(initialIndex) {
+						addedGraphs.push_back(newGraph);
+						predecessors[newGraph->getID()] = make_pair(graphID, ruleID);
 					}
 
 				} // else the new graph was subsumed already
 
 				// check timeout
-				if(timer && timer->outOfTime()) {
-					logger.newWarning() << "Stopping because of timeout reached. Discarding unfinished backward step results." << endLogMessage;
+				if(cancellation->isCancelled()) {
 					return true;
 				}
 
 				++(*pocEnumerator);
 			}
 
+			if(!addedGraphs.empty()) {
+				CoverageResult result = initialIndex->checkAll(addedGraphs, initialCheckThreads);
+				if(result.covered) {
+					reportCoverage(*addedGraphs[result.graphIndex], initialIndex->getInitialGraph(result.initialIndex));
+					return true;
+				}
+			}
+
 			return false;
 		}
 
+		void BackwardAnalysis::reportCoverage(Hypergraph const& graph, Hypergraph_sp initialGraph) {
+
+			initialCoverage.covered = true;
+			initialCoverage.initialGraph = initialGraph;
+			initialCoverage.graphChain.assign(1, graph.getID());
+			initialCoverage.ruleChain.clear();
+			for(auto it = predecessors.find(graph.getID()); it != predecessors.end(); it = predecessors.find(it->second.first)) {
+				initialCoverage.ruleChain.push_back(it->second.second);
+				initialCoverage.graphChain.push_back(it->second.first);
+			}
+
+			logger.newUserInfo() << "One of the initial graphs was covered";
+			if(!initialGraph->getName().empty()) {
+				logger.contMsg() << " ('" << initialGraph->getName() << "')";
+			}
+			logger.contMsg() << " by graph " << graph.getID();
+			for(size_t i = 0; i < initialCoverage.ruleChain.size(); ++i) {
+				logger.contMsg() << ", which was obtained from graph " << initialCoverage.graphChain[i+1];
+				logger.contMsg() << " by rule " << initialCoverage.ruleChain[i];
+			}
+			logger.contMsg() << ". Aborting backward step and terminating after minimization." << endLogMessage;
+		}
+
+		void BackwardAnalysis::writeMetrics(string const& label) {
+			if(metricsWriter) {
+				metricsWriter->writeSnapshot(label);
+			}
+		}
+
+		shared_ptr<vector<Hypergraph_sp>> BackwardAnalysis::finishAnalysis(
+				PreparedGTS& prepGTS,
+				long cachedQuantities,
+				shared_ptr<vector<Hypergraph_sp>> result) {
+
+			order->setCancellationToken(nullptr);
+			pocEnumerator->setCancellationToken(nullptr);
+			writeMetrics("final");
+			if(preparedGTSCache && (cachedQuantities < 0 || (size_t)cachedQuantities != prepGTS.getPreparedQuantityCount())) {
+				preparedGTSCache->store(prepGTS);
+			}
+
+			// set names of all error graphs if they don't already have a name
+			for(auto graph : *result) {
+				if(graph->getName().empty()) {
+					stringstream s;
+					s << "EG" << graph->getID();
+					graph->setName(s.str());
+				}
+			}
+
+			return result;
+		}
+
+		string BackwardAnalysis::getCancellationReason() const {
+			// note: testbench/perform-benchmark.sh detects timed out runs by searching for "timeout reached"
+			// (checked by timeout_message_test)
+			if(cancellation->wasCancelledExplicitly()) {
+				return "the analysis was cancelled";
+			} else {
+				return "of timeout reached";
+			}
+		}
+
 	} /* namespace analysis */
 } /* namespace uncover */
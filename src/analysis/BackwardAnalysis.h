@@ -21,16 +21,61 @@
 #define BACKWARDANALYSIS_H_
 
 #include "../basic_types/Order.h"
-#include "../basic_types/Timer.h"
+#include "../basic_types/CancellationToken.h"
 #include "../graphs/MinGraphList.h"
+#include "../graphs/IsomorphismFilter.h"
 #include "../graphs/GTS.h"
+#include "../logging/MetricsWriter.h"
 #include "RulePreparer.h"
 #include "MinPOCEnumerator.h"
 #include "BackwardResultHandler.h"
+#include "RuleProfiler.h"
+#include "PreparedGTSCache.h"
+#include "ExplorationStrategy.h"
+#include "InitialGraphIndex.h"
+#include <functional>
 
 namespace uncover {
 	namespace analysis {
 
+		/**
+		 * Describes which initial graph was covered by the backward search and how the covering graph was derived
+		 * from an error graph.
+		 * @see BackwardAnalysis
+		 * @author Jan Stückrath
+		 */
+		struct InitialCoverage {
+
+			/**
+			 * Creates a new InitialCoverage stating that no initial graph was covered.
+			 */
+			InitialCoverage();
+
+			/**
+			 * Is true iff an initial graph was covered.
+			 */
+			bool covered;
+
+			/**
+			 * The covered initial graph, or null if no initial graph was covered.
+			 */
+			graphs::Hypergraph_sp initialGraph;
+
+			/**
+			 * The IDs of the graphs leading from the error graph to the initial graph. The first ID is the graph
+			 * smaller than or equal to the initial graph, every further ID is the graph to which a rule was applied
+			 * backward to obtain the previous one, and the last ID is an error graph.
+			 */
+			vector<IDType> graphChain;
+
+			/**
+			 * The IDs of the (prepared) rules applied backward, where ruleChain[i] was applied to graphChain[i+1] to
+			 * obtain graphChain[i].
+			 */
+			vector<IDType> ruleChain;
+
+		};
+
 		/**
 		 * This class performs a backward search to solve the coverability problem with respect to a given Order.
 		 * The GTS and Order have to form a Q-restricted well-structured transition system for this algorithm to
@@ -58,10 +103,13 @@ namespace uncover {
 				 * @param rulePreparer a RulePreparer compatible to the order
 				 * @param pocEnumerator a MinPOCEnumerator compatible to the order
 				 * @param checkInitial if true, the analysis will stop as soon as an initial graph or a smaller graph was
-				 * 				reached; false will deactivate this check
+				 * 				reached; false will deactivate this check; the graphs are checked after the backward
+				 * 				application of a rule was completely enumerated, hence this application is finished
+				 * 				even if an earlier graph already covers an initial graph
 				 * @param resultHandler a BackwardResultHandler for handling intermediate results
-				 * @param timeout a threshold after which the computation will be stopped (soft stop); a timeout of 0
-				 * 				suppresses this check
+				 * @param timeout a threshold (in seconds) after which the computation will be stopped (soft stop); a
+				 * 				timeout of 0 suppresses this check; the timeout is enforced by the CancellationToken of
+				 * 				this analysis (see setCancellationToken(...))
 				 */
 				BackwardAnalysis(graphs::GTS_sp gts,
 						shared_ptr<vector<graphs::Hypergraph_sp>> errorGraphs,
@@ -73,35 +121,198 @@ namespace uncover {
 						unsigned int timeout = 0);
 
 				/**
-				 * Destroys the current instance of this class freeing all raw pointed data!
+				 * Destroys the current instance of this class.
 				 */
 				virtual ~BackwardAnalysis();
 
 				/**
 				 * This function performs the backwards analysis with the parameters given during initialization. The
 				 * search terminates when a backward step leads to no new graphs, a graph smaller or equal to an initial
-				 * graph is reached (if set) or the timer threshold was exceeded (if set). The resulting set of minimal
-				 * graphs is returned. Note that the set of minimal graphs may be incomplete if one of the latter two
-				 * conditions caused termination.
+				 * graph is reached (if set) or the CancellationToken was cancelled, e.g. by the timeout (if set). The
+				 * resulting set of minimal graphs is returned. Note that the set of minimal graphs may be incomplete if
+				 * one of the latter two conditions caused termination. If the analysis was cancelled, the results of
+				 * the unfinished backward step are discarded and the minimal graphs after the last finished backward
+				 * step are returned.
 				 * @return a vector containing all minimal graphs resulting from this backward search; may be incomplete
 				 * 				 if the search terminated due to a timeout or a found initial graph
 				 */
 				shared_ptr<vector<graphs::Hypergraph_sp>> performAnalysis();
 
+				/**
+				 * Sets a MetricsWriter, which will be used to write a snapshot of all metrics after each backward step
+				 * and when the analysis terminates. If the metrics registry is enabled, the calls to the order are
+				 * measured as well. A null pointer deactivates writing metrics (default).
+				 * @param writer the MetricsWriter to be used or a null pointer
+				 */
+				void setMetricsWriter(logging::MetricsWriter_sp writer);
+
+				/**
+				 * Sets whether graphs isomorphic to a graph computed earlier in the same backward step are dropped before
+				 * they are added to the list of minimal graphs (default: true). Such graphs would be subsumed by the
+				 * list anyway, but dropping them early avoids comparing them with every graph of the list. Dropped graphs
+				 * are reported to the BackwardResultHandler as deleted because of the earlier isomorphic graph. If set,
+				 * the MinPOCEnumerator is also allowed to skip pushout complements known to be isomorphic.
+				 * @param drop true, iff isomorphic graphs should be dropped early
+				 */
+				void setDropIsomorphicGraphs(bool drop);
+
+				/**
+				 * Sets a PreparedGTSCache, from which the prepared GTS is loaded instead of preparing the rules again.
+				 * If the cache cannot be used, the rules are prepared and the result is stored in the cache when the
+				 * analysis terminates. The cache is also updated if further UQRuleInstances were prepared during the
+				 * analysis. A null pointer deactivates caching (default).
+				 * @param cache the PreparedGTSCache to be used or a null pointer
+				 */
+				void setPreparedGTSCache(PreparedGTSCache_csp cache);
+
+				/**
+				 * Sets whether prepared rules dominated by other prepared rules are removed before the backward search
+				 * starts (default: false). Removing them does not change the result, but every backward step has to
+				 * apply fewer rules. See PreparedGTS::removeDominatedRules() for details.
+				 * @param prune true, iff dominated rules should be removed
+				 */
+				void setPruneDominatedRules(bool prune);
+
+				/**
+				 * Sets the ExplorationStrategy defining the order in which the graphs of a backward step are processed
+				 * (default: BreadthFirstStrategy). The order does not change the result of the analysis, but graphs
+				 * subsumed before they are processed are skipped. A null pointer resets the default strategy.
+				 * @param strategy the ExplorationStrategy to be used or a null pointer
+				 */
+				void setExplorationStrategy(ExplorationStrategy_sp strategy);
+
+				/**
+				 * Sets the CancellationToken used to stop the analysis (softly). It is passed to the Order, the
+				 * MinPOCEnumerator and the list of minimal graphs during performAnalysis(), such that a single
+				 * comparison or pushout complement computation is interrupted within milliseconds. If a timeout was
+				 * given at construction, performAnalysis() sets the deadline of the token accordingly. When the token
+				 * is cancelled, the unfinished backward step is discarded and the minimal graphs found so far are
+				 * returned. A null pointer resets the token to a new one (default).
+				 * @param token the CancellationToken to be used or a null pointer
+				 */
+				void setCancellationToken(basic_types::CancellationToken_sp token);
+
+				/**
+				 * Returns the CancellationToken used to stop the analysis. It can be cancelled from another thread.
+				 * @return the CancellationToken used to stop the analysis
+				 */
+				basic_types::CancellationToken_sp getCancellationToken() const;
+
+				/**
+				 * Sets the number of threads used to check whether an initial graph was covered (default: 1). The
+				 * graphs computed by one backward application of a rule are checked together against all initial
+				 * graphs, after all of them were computed. If 0 is given, one thread per hardware thread is used.
+				 * @param threads the number of threads used for the check of the initial graphs
+				 */
+				void setInitialCheckThreads(unsigned int threads);
+
+				/**
+				 * Sets whether initial graphs are pruned by their invariants (sizes and label counts) before the order
+				 * is called to check whether they are covered (default: true). This is only correct for orders monotone
+				 * w.r.t. these invariants, see InitialGraphIndex.
+				 * @param useInvariants true, iff initial graphs should be pruned by their invariants
+				 */
+				void setInitialCheckInvariants(bool useInvariants);
+
+				/**
+				 * Returns which initial graph was covered during the last call of performAnalysis() and how the
+				 * covering graph was derived from an error graph. If the check of the initial graphs is disabled or no
+				 * initial graph was covered, the returned InitialCoverage states this.
+				 * @return the coverage of the initial graphs found by the last analysis
+				 */
+				InitialCoverage const& getInitialCoverage() const;
+
+				/**
+				 * Returns the RuleProfiler containing the costs of all rules applied during the last call of
+				 * performAnalysis(). Returns a null pointer if performAnalysis() was not called yet.
+				 * @return the RuleProfiler of the last analysis
+				 */
+				RuleProfiler_csp getRuleProfiler() const;
+
 			private:
 
 				/**
 				 * Takes the given rule and graph and computes all minimal representants of predecessor of the
-				 * upward-closure of the graph. If a computed graph was not immediately subsumed by a graph in the
-				 * given MinGraphList, it is added to the MinGraphList and the given vector. If these checks are
-				 * activated, after every computed predecessor it is checked if an initial graph (or anything smaller)
-				 * was found or a timeout was reached, which will cause the function to terminate early. The
+				 * upward-closure of the graph. If a computed graph is not isomorphic to a graph computed earlier in this
+				 * backward step (if activated) and was not immediately subsumed by a graph in the given MinGraphList, it
+				 * is added to the MinGraphList and the given vector. After every computed predecessor it is checked if
+				 * the analysis was cancelled, e.g. by a timeout, which will cause the function to terminate early. Afterwards it is
+				 * checked whether one of the added graphs is smaller than or equal to an initial graph. The
 				 * MinPOCEnumerator used must be reset immediately before calling this function.
 				 * @param minList all computed graphs will be added to this list (and may be immediately deleted by it)
 				 * @param newGraphs all graphs not dropped my the MinGraphList will be added to this vector
+				 * @param graphID the ID of the graph to which the rule is applied backward
+				 * @param ruleID the ID of the applied rule
+				 * @param isomorphic the number of computed graphs dropped because of an isomorphic copy, which is
+				 * 				increased for every such graph
+				 * @param profile the profile of the applied rule, which is updated for every computed graph
 				 * @return true, iff the function terminated because of a timeout or found initial graph
+				 * @exception CancelledException if the CancellationToken was cancelled during a computation
+				 */
+				bool applyOne(graphs::MinGraphList& minList,
+						vector<graphs::Hypergraph_sp>& newGraphs,
+						IDType graphID,
+						IDType ruleID,
+						uint64_t& isomorphic,
+						RuleProfile& profile);
+
+				/**
+				 * Resets the MinPOCEnumerator using the given function and calls applyOne(...) afterwards. The time needed
+				 * for both steps and the number of graphs dropped by a bound are added to the given profile. If one of
+				 * the steps is cancelled by the CancellationToken, the function terminates early.
+				 * @param reset a function resetting the MinPOCEnumerator with the rule to be applied
+				 * @param minList all computed graphs will be added to this list (and may be immediately deleted by it)
+				 * @param newGraphs all graphs not dropped my the MinGraphList will be added to this vector
+				 * @param graphID the ID of the graph to which the rule is applied backward
+				 * @param ruleID the ID of the applied rule
+				 * @param pocCounter the counter of the applied rule, which is increased by the number of computed graphs
+				 * @param profile the profile of the applied rule
+				 * @return true, iff the function terminated because of a timeout or found initial graph
+				 */
+				bool applyProfiled(std::function<void()> const& reset,
+						graphs::MinGraphList& minList,
+						vector<graphs::Hypergraph_sp>& newGraphs,
+						IDType graphID,
+						IDType ruleID,
+						logging::Counter& pocCounter,
+						RuleProfile& profile);
+
+				/**
+				 * Stores in the InitialCoverage of this analysis that the given graph covered the given initial graph,
+				 * including the chain of graphs and rules from which it was derived, and logs this information.
+				 * @param graph the graph smaller than or equal to the initial graph
+				 * @param initialGraph the covered initial graph
+				 */
+				void reportCoverage(graphs::Hypergraph const& graph, graphs::Hypergraph_sp initialGraph);
+
+				/**
+				 * Writes a snapshot of all metrics with the given label, if a MetricsWriter is set.
+				 * @param label the label of the snapshot
+				 */
+				void writeMetrics(string const& label);
+
+				/**
+				 * Performs all tasks necessary when the analysis terminates, i.e. removes the CancellationToken from the
+				 * Order and the MinPOCEnumerator, writes the final snapshot of all metrics, stores the given
+				 * PreparedGTS in the PreparedGTSCache, if one is set and the PreparedGTS contains data not yet cached,
+				 * and names all unnamed graphs of the result "EG<id>".
+				 * @param prepGTS the PreparedGTS used in the analysis
+				 * @param cachedQuantities the number of quantity vectors with prepared UQRuleInstances which were
+				 * 				already cached, or a negative value if the PreparedGTS was not loaded from the cache
+				 * @param result the minimal graphs returned by the analysis
+				 * @return the given result
 				 */
-				bool applyOne(graphs::MinGraphList& minList, vector<graphs::Hypergraph_sp>& newGraphs);
+				shared_ptr<vector<graphs::Hypergraph_sp>> finishAnalysis(PreparedGTS& prepGTS,
+						long cachedQuantities,
+						shared_ptr<vector<graphs::Hypergraph_sp>> result);
+
+				/**
+				 * Returns a description of why the CancellationToken of this analysis is cancelled, i.e. whether it was
+				 * cancelled explicitly or a timeout was reached. Reaching the deadline of a token set by
+				 * setCancellationToken(...) is reported as timeout as well.
+				 * @return the reason of the cancellation
+				 */
+				string getCancellationReason() const;
 
 				/**
 				 * Stores the GTS used for the backwards search (before rule preparation).
@@ -143,9 +354,83 @@ namespace uncover {
 				BackwardResultHandler_sp resultHandler;
 
 				/**
-				 * Stores a Timer to handle premature timeout termination.
+				 * Stores the timeout in seconds; 0 means no timeout.
+				 */
+				unsigned int timeout;
+
+				/**
+				 * Stores the CancellationToken used to handle premature termination.
+				 */
+				basic_types::CancellationToken_sp cancellation;
+
+				/**
+				 * Stores the Order used to check whether an initial graph was covered. This is the order given at
+				 * construction, possibly wrapped to collect metrics.
+				 */
+				basic_types::Order_sp initialCheckOrder;
+
+				/**
+				 * Stores the MetricsWriter used to write snapshots of all metrics.
+				 */
+				logging::MetricsWriter_sp metricsWriter;
+
+				/**
+				 * If true, graphs isomorphic to a graph computed earlier in the same backward step are dropped.
+				 */
+				bool dropIsomorphicGraphs;
+
+				/**
+				 * Stores all graphs added to the list of minimal graphs in the current backward step to detect isomorphic
+				 * copies.
+				 */
+				graphs::IsomorphismFilter isomorphismFilter;
+
+				/**
+				 * Stores the costs of all rules applied during the last analysis.
+				 */
+				RuleProfiler_sp ruleProfiler;
+
+				/**
+				 * Stores the PreparedGTSCache used to load and store the prepared GTS.
+				 */
+				PreparedGTSCache_csp preparedGTSCache;
+
+				/**
+				 * If true, dominated rules are removed from the prepared GTS before the backward search starts.
+				 */
+				bool pruneDominatedRules;
+
+				/**
+				 * Stores the ExplorationStrategy defining the order in which the graphs of a backward step are processed.
+				 */
+				ExplorationStrategy_sp explorationStrategy;
+
+				/**
+				 * Stores the number of threads used to check whether an initial graph was covered.
+				 */
+				unsigned int initialCheckThreads;
+
+				/**
+				 * If true, initial graphs are pruned by their invariants before they are compared to new graphs.
+				 */
+				bool initialCheckInvariants;
+
+				/**
+				 * Stores the index of the initial graphs used to check whether an initial graph was covered. Is null if
+				 * this check is disabled.
+				 */
+				shared_ptr<InitialGraphIndex> initialIndex;
+
+				/**
+				 * Stores for each graph added to the list of minimal graphs the ID of the graph and the rule from which
+				 * it was computed. Only used if the check of the initial graphs is enabled.
+				 */
+				unordered_map<IDType,pair<IDType,IDType>> predecessors;
+
+				/**
+				 * Stores which initial graph was covered in the last analysis.
 				 */
-				basic_types::Timer* timer;
+				InitialCoverage initialCoverage;
 
 		};
 
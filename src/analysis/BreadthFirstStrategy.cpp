@@ -0,0 +1,57 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "BreadthFirstStrategy.h"
+
+using namespace uncover::graphs;
+
+namespace uncover {
+	namespace analysis {
+
+		BreadthFirstStrategy::BreadthFirstStrategy() : graphs() {}
+
+		BreadthFirstStrategy::~BreadthFirstStrategy() {}
+
+		void BreadthFirstStrategy::add(Hypergraph_sp graph) {
+			graphs.push_back(graph);
+		}
+
+		Hypergraph_sp BreadthFirstStrategy::next() {
+			if(graphs.empty()) {
+				return nullptr;
+			}
+			Hypergraph_sp result = graphs.back();
+			graphs.pop_back();
+			return result;
+		}
+
+		size_t BreadthFirstStrategy::size() const {
+			return graphs.size();
+		}
+
+		void BreadthFirstStrategy::clear() {
+			graphs.clear();
+		}
+
+		string BreadthFirstStrategy::getName() const {
+			return "bfs";
+		}
+
+	} /* namespace analysis */
+} /* namespace uncover */
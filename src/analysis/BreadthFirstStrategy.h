@@ -0,0 +1,69 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef BREADTHFIRSTSTRATEGY_H_
+#define BREADTHFIRSTSTRATEGY_H_
+
+#include "ExplorationStrategy.h"
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * This strategy processes the graphs of a backward step in reverse order of their addition. It is the
+		 * default strategy and does not cause any overhead.
+		 * @author Jan Stückrath
+		 */
+		class BreadthFirstStrategy : public ExplorationStrategy {
+
+			public:
+
+				/**
+				 * Creates a new BreadthFirstStrategy.
+				 */
+				BreadthFirstStrategy();
+
+				/**
+				 * Destroys this BreadthFirstStrategy.
+				 */
+				virtual ~BreadthFirstStrategy();
+
+				virtual void add(graphs::Hypergraph_sp graph) override;
+
+				virtual graphs::Hypergraph_sp next() override;
+
+				virtual size_t size() const override;
+
+				virtual void clear() override;
+
+				virtual string getName() const override;
+
+			private:
+
+				/**
+				 * Stores the graphs which still have to be processed.
+				 */
+				vector<graphs::Hypergraph_sp> graphs;
+
+		};
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* BREADTHFIRSTSTRATEGY_H_ */
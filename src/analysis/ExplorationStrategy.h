@@ -0,0 +1,102 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef EXPLORATIONSTRATEGY_H_
+#define EXPLORATIONSTRATEGY_H_
+
+#include "../graphs/Hypergraph.h"
+#include "PreparedGTS.h"
+#include "RuleProfiler.h"
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * This abstract class defines in which order the BackwardAnalysis processes the graphs of a backward step.
+		 * At the beginning of each backward step all graphs computed in the previous step are added and then
+		 * taken one after the other until none is left. Graphs found during a step are processed in the next
+		 * step, hence the order only influences which graphs are subsumed (and thus skipped) before they are
+		 * processed, but not the result of the analysis.
+		 * @author Jan Stückrath
+		 */
+		class ExplorationStrategy {
+
+			public:
+
+				/**
+				 * Destroys this ExplorationStrategy.
+				 */
+				virtual ~ExplorationStrategy() {}
+
+				/**
+				 * Initializes this strategy for a new analysis. The given PreparedGTS contains the rules which will
+				 * be applied and the given RuleProfiler collects the costs of all rule applications during the
+				 * analysis. The default implementation does nothing.
+				 * @param gts the PreparedGTS used by the analysis
+				 * @param profiler the RuleProfiler of the analysis
+				 */
+				virtual void initialize(PreparedGTS_csp gts, RuleProfiler_csp profiler) {}
+
+				/**
+				 * Adds the given graph to the graphs which have to be processed.
+				 * @param graph the graph to be added
+				 */
+				virtual void add(graphs::Hypergraph_sp graph) = 0;
+
+				/**
+				 * Removes and returns the graph which should be processed next. If no graph is left, a null pointer
+				 * is returned.
+				 * @return the graph which should be processed next
+				 */
+				virtual graphs::Hypergraph_sp next() = 0;
+
+				/**
+				 * Returns the number of graphs which still have to be processed.
+				 * @return the number of graphs which still have to be processed
+				 */
+				virtual size_t size() const = 0;
+
+				/**
+				 * Returns true, iff no graph has to be processed.
+				 * @return true, iff no graph has to be processed
+				 */
+				bool empty() const { return size() == 0; }
+
+				/**
+				 * Removes all graphs from this strategy.
+				 */
+				virtual void clear() = 0;
+
+				/**
+				 * Returns the name of this strategy, which is used for logging.
+				 * @return the name of this strategy
+				 */
+				virtual string getName() const = 0;
+
+		};
+
+		/**
+		 * Alias of a shared pointer to an ExplorationStrategy.
+		 */
+		typedef shared_ptr<ExplorationStrategy> ExplorationStrategy_sp;
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* EXPLORATIONSTRATEGY_H_ */
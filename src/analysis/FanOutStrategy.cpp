@@ -0,0 +1,108 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "FanOutStrategy.h"
+
+using namespace uncover::graphs;
+
+namespace uncover {
+	namespace analysis {
+
+		FanOutStrategy::FanOutStrategy() : SmallestFirstStrategy(), gts(nullptr), profiler(nullptr), rules() {}
+
+		FanOutStrategy::~FanOutStrategy() {}
+
+		void FanOutStrategy::initialize(PreparedGTS_csp gts, RuleProfiler_csp profiler) {
+			this->gts = gts;
+			this->profiler = profiler;
+			rules.clear();
+		}
+
+		void FanOutStrategy::add(Hypergraph_sp graph) {
+			// a new backward step starts, when graphs are added to the empty queue
+			if(empty()) {
+				updateRates();
+			}
+			SmallestFirstStrategy::add(graph);
+		}
+
+		void FanOutStrategy::clear() {
+			SmallestFirstStrategy::clear();
+			rules.clear();
+		}
+
+		string FanOutStrategy::getName() const {
+			return "fanout";
+		}
+
+		void FanOutStrategy::updateRates() {
+
+			rules.clear();
+			if(!gts) {
+				return;
+			}
+
+			unordered_map<IDType, RuleProfile> profiles;
+			if(profiler) {
+				for(RuleProfile const& profile : profiler->getPreparedProfiles()) {
+					if(!profile.quantified) {
+						profiles[profile.ruleID] = profile;
+					}
+				}
+			}
+
+			for(auto ruleIt = gts->getStdRules().cbegin(); ruleIt != gts->getStdRules().cend(); ++ruleIt) {
+				double rate = 1;
+				auto profIt = profiles.find(ruleIt->first);
+				if(profIt != profiles.end() && profIt->second.applications > 0) {
+					rate = (double)profIt->second.produced / profIt->second.applications;
+				}
+				vector<string> labels;
+				AnonHypergraph_csp right = ruleIt->second->getRight();
+				for(auto edgeIt = right->cbeginEdges(); edgeIt != right->cendEdges(); ++edgeIt) {
+					labels.push_back(edgeIt->second.getLabel());
+				}
+				rules.push_back(make_pair(rate, labels));
+			}
+		}
+
+		double FanOutStrategy::computePriority(Hypergraph const& graph) const {
+
+			unordered_map<string, size_t> labelCounts;
+			for(auto edgeIt = graph.cbeginEdges(); edgeIt != graph.cendEdges(); ++edgeIt) {
+				++labelCounts[edgeIt->second.getLabel()];
+			}
+
+			double result = 0;
+			for(auto const& rule : rules) {
+				// rules without edges on the right side can be matched to every vertex
+				size_t hosts = rule.second.empty() ? graph.getVertexCount() : 0;
+				for(string const& label : rule.second) {
+					auto countIt = labelCounts.find(label);
+					if(countIt != labelCounts.end()) {
+						hosts += countIt->second;
+					}
+				}
+				result += rule.first * hosts;
+			}
+			return result;
+		}
+
+	} /* namespace analysis */
+} /* namespace uncover */
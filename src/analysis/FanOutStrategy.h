@@ -0,0 +1,93 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef FANOUTSTRATEGY_H_
+#define FANOUTSTRATEGY_H_
+
+#include "SmallestFirstStrategy.h"
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * This strategy processes the graphs of a backward step ordered by the estimated number of graphs their
+		 * processing will produce (fan-out), starting with the lowest estimation. Cheap graphs are processed
+		 * first, so that their predecessors may subsume expensive graphs before these are processed. The
+		 * fan-out of a graph is estimated as the sum over all prepared standard rules of the average number of
+		 * graphs produced by one application of the rule (taken from the RuleProfiler, or 1 if the rule was not
+		 * applied yet) multiplied with the number of edges of the graph, to which some edge of the right side of
+		 * the rule could be mapped. The averages are updated at the beginning of each backward step. UQRules
+		 * are ignored, since they are applied to every graph.
+		 * @author Jan Stückrath
+		 */
+		class FanOutStrategy : public SmallestFirstStrategy {
+
+			public:
+
+				/**
+				 * Creates a new FanOutStrategy.
+				 */
+				FanOutStrategy();
+
+				/**
+				 * Destroys this FanOutStrategy.
+				 */
+				virtual ~FanOutStrategy();
+
+				virtual void initialize(PreparedGTS_csp gts, RuleProfiler_csp profiler) override;
+
+				virtual void add(graphs::Hypergraph_sp graph) override;
+
+				virtual void clear() override;
+
+				virtual string getName() const override;
+
+			protected:
+
+				virtual double computePriority(graphs::Hypergraph const& graph) const override;
+
+			private:
+
+				/**
+				 * Recomputes the average number of produced graphs of all rules from the RuleProfiler.
+				 */
+				void updateRates();
+
+				/**
+				 * Stores the PreparedGTS used by the analysis.
+				 */
+				PreparedGTS_csp gts;
+
+				/**
+				 * Stores the RuleProfiler of the analysis.
+				 */
+				RuleProfiler_csp profiler;
+
+				/**
+				 * Stores for every prepared standard rule the average number of graphs produced by one application
+				 * and the labels of the edges of its right side.
+				 */
+				vector<pair<double, vector<string>>> rules;
+
+		};
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* FANOUTSTRATEGY_H_ */
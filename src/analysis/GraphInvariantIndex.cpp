@@ -0,0 +1,183 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "GraphInvariantIndex.h"
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using namespace uncover::graphs;
+using namespace std;
+
+namespace uncover {
+	namespace analysis {
+
+		GraphInvariantIndex::GraphInvariantIndex(vector<Hypergraph_sp> const& graphs, IndexedSide side, bool useInvariants)
+			: graphs(graphs), side(side), useInvariants(useInvariants), index(), labelIndices() {
+
+			for(Hypergraph_sp const& graph : graphs) {
+				for(auto it = graph->cbeginEdges(); it != graph->cendEdges(); ++it) {
+					labelIndices.insert(make_pair(it->second.getLabel(), labelIndices.size()));
+				}
+			}
+
+			index.resize(graphs.size());
+			for(size_t i = 0; i < graphs.size(); ++i) {
+				index[i].pos = i;
+				computeInvariants(*graphs[i], index[i].invariants);
+			}
+
+			// smaller graphs are cheaper to compare and graphs with unfitting vertex counts can be skipped by a binary
+			// search
+			stable_sort(index.begin(), index.end(), [](IndexEntry const& e1, IndexEntry const& e2) {
+				return e1.invariants.vertexCount < e2.invariants.vertexCount
+						|| (e1.invariants.vertexCount == e2.invariants.vertexCount
+								&& e1.invariants.edgeCount < e2.invariants.edgeCount);
+			});
+		}
+
+		GraphInvariantIndex::~GraphInvariantIndex() {}
+
+		size_t GraphInvariantIndex::size() const {
+			return graphs.size();
+		}
+
+		Hypergraph_sp GraphInvariantIndex::getGraph(size_t pos) const {
+			return (pos < graphs.size()) ? graphs[pos] : nullptr;
+		}
+
+		void GraphInvariantIndex::findCandidates(Hypergraph const& graph, vector<size_t>& candidates) const {
+			findFirst(graph, [&candidates](size_t pos) {
+				candidates.push_back(pos);
+				return false;
+			});
+		}
+
+		size_t GraphInvariantIndex::findFirst(Hypergraph const& graph, function<bool(size_t)> const& test) const {
+
+			Invariants invariants;
+			auto begin = index.cbegin();
+			auto end = index.cend();
+			if(useInvariants) {
+				if(!computeInvariants(graph, invariants)) {
+					return graphs.size();
+				}
+				if(side == IS_Smaller) {
+					end = upper_bound(index.cbegin(), index.cend(), invariants.vertexCount,
+							[](size_t count, IndexEntry const& e) { return count < e.invariants.vertexCount; });
+				} else {
+					begin = lower_bound(index.cbegin(), index.cend(), invariants.vertexCount,
+							[](IndexEntry const& e, size_t count) { return e.invariants.vertexCount < count; });
+				}
+			}
+
+			for(auto it = begin; it != end; ++it) {
+				if((!useInvariants || fits(*it, invariants)) && test(it->pos)) {
+					return it->pos;
+				}
+			}
+			return graphs.size();
+		}
+
+		size_t GraphInvariantIndex::runParallel(size_t taskCount, unsigned int threadCount,
+				function<void(size_t,atomic<size_t>&)> const& task) {
+
+			if(threadCount == 0) {
+				threadCount = max(thread::hardware_concurrency(), 1u);
+			}
+			threadCount = min<size_t>(threadCount, max<size_t>(taskCount, 1));
+
+			atomic<size_t> next(0);
+			atomic<size_t> bound(taskCount);
+			exception_ptr failure = nullptr;
+			mutex failureMutex;
+
+			// every thread takes the next position until all positions below the bound are processed
+			auto worker = [&]() {
+				try {
+					for(size_t i = next++; i < bound.load(); i = next++) {
+						task(i, bound);
+					}
+				} catch(...) {
+					lock_guard<mutex> lock(failureMutex);
+					if(!failure) {
+						failure = current_exception();
+					}
+					bound.store(0);
+				}
+			};
+
+			if(threadCount <= 1) {
+				worker();
+			} else {
+				vector<thread> threads;
+				for(unsigned int i = 0; i < threadCount; ++i) {
+					threads.push_back(thread(worker));
+				}
+				for(thread& t : threads) {
+					t.join();
+				}
+			}
+
+			if(failure) {
+				rethrow_exception(failure);
+			}
+
+			return bound.load();
+		}
+
+		bool GraphInvariantIndex::computeInvariants(Hypergraph const& graph, Invariants& invariants) const {
+			invariants.vertexCount = graph.getVertexCount();
+			invariants.edgeCount = graph.getEdgeCount();
+			invariants.labelCounts.assign(labelIndices.size(), 0);
+			invariants.usedLabels.clear();
+			for(auto it = graph.cbeginEdges(); it != graph.cendEdges(); ++it) {
+				auto labelIt = labelIndices.find(it->second.getLabel());
+				if(labelIt == labelIndices.end()) {
+					// no indexed graph can be larger than a graph with an unknown label
+					if(side == IS_Larger) {
+						return false;
+					}
+					continue;
+				}
+				if(invariants.labelCounts[labelIt->second]++ == 0) {
+					invariants.usedLabels.push_back(labelIt->second);
+				}
+			}
+			return true;
+		}
+
+		bool GraphInvariantIndex::fits(IndexEntry const& entry, Invariants const& invariants) const {
+			// only the labels of the smaller graph have to be checked
+			Invariants const& smaller = (side == IS_Smaller) ? entry.invariants : invariants;
+			Invariants const& larger = (side == IS_Smaller) ? invariants : entry.invariants;
+			if(smaller.vertexCount > larger.vertexCount || smaller.edgeCount > larger.edgeCount) {
+				return false;
+			}
+			for(size_t label : smaller.usedLabels) {
+				if(smaller.labelCounts[label] > larger.labelCounts[label]) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+	} /* namespace analysis */
+} /* namespace uncover */
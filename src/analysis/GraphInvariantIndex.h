@@ -0,0 +1,211 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef GRAPHINVARIANTINDEX_H_
+#define GRAPHINVARIANTINDEX_H_
+
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "../graphs/Hypergraph.h"
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * The side on which the graphs of a GraphInvariantIndex appear when they are compared to other graphs.
+		 */
+		enum IndexedSide {
+			IS_Smaller, //!< the indexed graphs are the smaller ones, i.e. G_indexed <= G is checked
+			IS_Larger //!< the indexed graphs are the larger ones, i.e. G <= G_indexed is checked
+		};
+
+		/**
+		 * A GraphInvariantIndex stores a fixed list of graphs together with their number of vertices, their number of
+		 * edges and their number of edges of each label. For a given graph it finds all indexed graphs, which can be
+		 * smaller or equal (or larger or equal, depending on the IndexedSide) according to these invariants. This
+		 * avoids most calls to an (expensive) order. Additionally, it provides the distribution of such checks among
+		 * several threads. It is used by the UpwardClosureChecker and the InitialGraphIndex.
+		 *
+		 * <p><b>Note:</b> This pruning is only correct if the order is monotone w.r.t. these invariants, i.e. if
+		 * G <= H implies that H has at least as many vertices, edges and edges of each label as G. This is the case
+		 * for the (injective) subgraph order and the minor order. For all other orders the pruning has to be disabled.
+		 * </p>
+		 * @author Jan Stückrath
+		 * @see UpwardClosureChecker
+		 * @see InitialGraphIndex
+		 */
+		class GraphInvariantIndex {
+
+			public:
+
+				/**
+				 * Creates a new GraphInvariantIndex for the given graphs.
+				 * @param graphs the graphs to be indexed
+				 * @param side the side on which the indexed graphs appear when compared
+				 * @param useInvariants if true (default), indexed graphs are pruned by invariants; otherwise all indexed
+				 * 				graphs are candidates for every graph
+				 */
+				GraphInvariantIndex(vector<graphs::Hypergraph_sp> const& graphs, IndexedSide side, bool useInvariants = true);
+
+				/**
+				 * Destroys this GraphInvariantIndex.
+				 */
+				virtual ~GraphInvariantIndex();
+
+				/**
+				 * Returns the number of indexed graphs.
+				 * @return the number of indexed graphs
+				 */
+				size_t size() const;
+
+				/**
+				 * Returns the indexed graph at the given position of the list given to the constructor.
+				 * @param pos the position of the indexed graph
+				 * @return the indexed graph at the given position or null, if there is no such position
+				 */
+				graphs::Hypergraph_sp getGraph(size_t pos) const;
+
+				/**
+				 * Appends the positions (in the list given to the constructor) of all indexed graphs, which are not
+				 * excluded by their invariants, to the given vector. Graphs with fewer vertices (and edges) are appended
+				 * first.
+				 * @param graph the graph to be compared to the indexed graphs
+				 * @param candidates the vector to which the positions are appended
+				 */
+				void findCandidates(graphs::Hypergraph const& graph, vector<size_t>& candidates) const;
+
+				/**
+				 * Calls the given test for the positions (in the list given to the constructor) of the indexed graphs,
+				 * which are not excluded by their invariants, until the test returns true. Graphs with fewer vertices
+				 * (and edges) are tested first.
+				 * @param graph the graph to be compared to the indexed graphs
+				 * @param test the test called for the candidate positions
+				 * @return the first position for which the test returned true or size(), if there is none
+				 */
+				size_t findFirst(graphs::Hypergraph const& graph, std::function<bool(size_t)> const& test) const;
+
+				/**
+				 * Calls the given task for the positions 0 to taskCount-1, which are distributed among the given number
+				 * of threads. Every thread takes the next position until all positions are processed or the bound
+				 * given to the tasks is reached. A task may lower this bound (initially taskCount), after which no
+				 * task at a position not below the bound is started. If a task throws an exception, no further tasks
+				 * are started and the first exception is rethrown after all threads finished.
+				 * @param taskCount the number of positions
+				 * @param threadCount the number of threads used; if 0, the number of hardware threads is used
+				 * @param task the task called with a position and the bound
+				 * @return the bound after all tasks were processed
+				 */
+				static size_t runParallel(size_t taskCount, unsigned int threadCount,
+						std::function<void(size_t,std::atomic<size_t>&)> const& task);
+
+			private:
+
+				/**
+				 * Stores the invariants of a graph.
+				 */
+				struct Invariants {
+
+					/**
+					 * The number of vertices of the graph.
+					 */
+					size_t vertexCount;
+
+					/**
+					 * The number of edges of the graph.
+					 */
+					size_t edgeCount;
+
+					/**
+					 * Stores the number of edges of the graph for each label index.
+					 */
+					vector<size_t> labelCounts;
+
+					/**
+					 * Stores the indices of all labels used in the graph.
+					 */
+					vector<size_t> usedLabels;
+
+				};
+
+				/**
+				 * Stores an indexed graph together with its invariants.
+				 */
+				struct IndexEntry {
+
+					/**
+					 * The position of the indexed graph in the list given to the constructor.
+					 */
+					size_t pos;
+
+					/**
+					 * The invariants of the indexed graph.
+					 */
+					Invariants invariants;
+
+				};
+
+				/**
+				 * Computes the invariants of the given graph. Labels not used by any indexed graph are ignored.
+				 * @param graph the graph whose invariants will be computed
+				 * @param invariants the object in which the invariants will be stored
+				 * @return false, iff the given graph uses a label not used by any indexed graph and the indexed graphs
+				 * 				are the larger ones, i.e. if no indexed graph can be a candidate
+				 */
+				bool computeInvariants(graphs::Hypergraph const& graph, Invariants& invariants) const;
+
+				/**
+				 * Checks whether the given indexed graph is not excluded by the invariants of a compared graph.
+				 * @param entry the indexed graph
+				 * @param invariants the invariants of the compared graph
+				 * @return true, iff the indexed graph is a candidate for the compared graph
+				 */
+				bool fits(IndexEntry const& entry, Invariants const& invariants) const;
+
+				/**
+				 * The indexed graphs in the order given to the constructor.
+				 */
+				vector<graphs::Hypergraph_sp> graphs;
+
+				/**
+				 * The side on which the indexed graphs appear when compared.
+				 */
+				IndexedSide side;
+
+				/**
+				 * Is true iff indexed graphs are pruned by their invariants.
+				 */
+				bool useInvariants;
+
+				/**
+				 * All indexed graphs sorted ascending by their number of vertices and edges.
+				 */
+				vector<IndexEntry> index;
+
+				/**
+				 * Maps each label used in an indexed graph to its label index.
+				 */
+				unordered_map<string,size_t> labelIndices;
+
+		};
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* GRAPHINVARIANTINDEX_H_ */
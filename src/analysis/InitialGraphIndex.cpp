@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "InitialGraphIndex.h"
+#include <algorithm>
+
+using namespace uncover::basic_types;
+using namespace uncover::graphs;
+using namespace std;
+
+namespace uncover {
+	namespace analysis {
+
+		CoverageResult::CoverageResult() : covered(false), graphIndex(0), initialIndex(0), orderChecks(0) {}
+
+		InitialGraphIndex::InitialGraphIndex(
+				Order_csp order,
+				vector<Hypergraph_sp> const& initialGraphs,
+				bool useInvariants) : order(order), index(initialGraphs, IS_Larger, useInvariants) {}
+
+		InitialGraphIndex::~InitialGraphIndex() {}
+
+		void InitialGraphIndex::findCandidates(Hypergraph const& graph, vector<size_t>& candidates) const {
+			size_t first = candidates.size();
+			index.findCandidates(graph, candidates);
+			// report the first covered initial graph w.r.t. the order given by the user
+			sort(candidates.begin() + first, candidates.end());
+		}
+
+		CoverageResult InitialGraphIndex::check(Hypergraph const& graph) const {
+
+			CoverageResult result;
+			vector<size_t> candidates;
+			findCandidates(graph, candidates);
+			for(size_t candidate : candidates) {
+				++result.orderChecks;
+				if(order->isLessOrEq(graph, *index.getGraph(candidate))) {
+					result.covered = true;
+					result.initialIndex = candidate;
+					break;
+				}
+			}
+			return result;
+		}
+
+		CoverageResult InitialGraphIndex::checkAll(vector<Hypergraph_sp> const& graphs, unsigned int threadCount) const {
+
+			// collect all pairs of graphs and initial graphs passing the invariants, ordered by their priority
+			vector<pair<size_t,size_t>> pairs;
+			vector<size_t> candidates;
+			for(size_t i = 0; i < graphs.size(); ++i) {
+				candidates.clear();
+				findCandidates(*graphs[i], candidates);
+				for(size_t candidate : candidates) {
+					pairs.push_back(make_pair(i, candidate));
+				}
+			}
+
+			// the first covering pair is searched; pairs after an already covering pair need not be checked
+			atomic<size_t> orderChecks(0);
+			size_t firstCovering = GraphInvariantIndex::runParallel(pairs.size(), threadCount,
+					[&](size_t i, atomic<size_t>& bound) {
+				++orderChecks;
+				if(order->isLessOrEq(*graphs[pairs[i].first], *index.getGraph(pairs[i].second))) {
+					size_t current = bound.load();
+					while(i < current && !bound.compare_exchange_weak(current, i)) {}
+				}
+			});
+
+			CoverageResult result;
+			result.orderChecks = orderChecks.load();
+			if(firstCovering < pairs.size()) {
+				result.covered = true;
+				result.graphIndex = pairs[firstCovering].first;
+				result.initialIndex = pairs[firstCovering].second;
+			}
+			return result;
+		}
+
+		size_t InitialGraphIndex::getInitialGraphCount() const {
+			return index.size();
+		}
+
+		Hypergraph_sp InitialGraphIndex::getInitialGraph(size_t pos) const {
+			return index.getGraph(pos);
+		}
+
+	} /* namespace analysis */
+} /* namespace uncover */
@@ -0,0 +1,153 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef INITIALGRAPHINDEX_H_
+#define INITIALGRAPHINDEX_H_
+
+#include <vector>
+#include "GraphInvariantIndex.h"
+#include "../basic_types/Order.h"
+#include "../graphs/Hypergraph.h"
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * Stores the result of checking whether one of several graphs is smaller than or equal to an initial graph.
+		 * @see InitialGraphIndex
+		 * @author Jan Stückrath
+		 */
+		struct CoverageResult {
+
+			/**
+			 * Creates a new CoverageResult of a check without covered initial graph.
+			 */
+			CoverageResult();
+
+			/**
+			 * Is true iff one of the checked graphs is smaller than or equal to one of the initial graphs.
+			 */
+			bool covered;
+
+			/**
+			 * The position of the covering graph in the list of checked graphs. Only meaningful if covered is true.
+			 */
+			size_t graphIndex;
+
+			/**
+			 * The position of the covered initial graph in the list given to the InitialGraphIndex. Only meaningful if
+			 * covered is true.
+			 */
+			size_t initialIndex;
+
+			/**
+			 * The number of calls to the order needed for the check.
+			 */
+			size_t orderChecks;
+
+		};
+
+		/**
+		 * An InitialGraphIndex decides whether graphs are smaller than or equal to one of a fixed set of initial
+		 * graphs, i.e. whether the backward search covered an initial graph. To avoid most calls to the (expensive)
+		 * order, the initial graphs are stored in a GraphInvariantIndex. A graph is only compared to an initial graph,
+		 * if none of its invariants is larger than in the initial graph (see GraphInvariantIndex for the restrictions
+		 * on the order).
+		 * @author Jan Stückrath
+		 * @see GraphInvariantIndex
+		 */
+		class InitialGraphIndex {
+
+			public:
+
+				/**
+				 * Creates a new InitialGraphIndex for the given initial graphs. The order has to be thread-safe if
+				 * graphs are checked by several threads.
+				 * @param order the order used to compare graphs
+				 * @param initialGraphs the initial graphs
+				 * @param useInvariants if true (default), initial graphs are pruned by invariants before calling the order
+				 */
+				InitialGraphIndex(
+						basic_types::Order_csp order,
+						vector<graphs::Hypergraph_sp> const& initialGraphs,
+						bool useInvariants = true);
+
+				/**
+				 * Destroys this InitialGraphIndex.
+				 */
+				virtual ~InitialGraphIndex();
+
+				/**
+				 * Checks whether the given graph is smaller than or equal to one of the initial graphs.
+				 * @param graph the graph to be checked
+				 * @return the result of the check
+				 */
+				CoverageResult check(graphs::Hypergraph const& graph) const;
+
+				/**
+				 * Checks whether one of the given graphs is smaller than or equal to one of the initial graphs. All pairs
+				 * of a graph and an initial graph passing the invariants are distributed among the given number of
+				 * threads. The result reports the first covering graph (in the given order) and the first initial graph
+				 * it covers, hence it does not depend on the number of threads.
+				 * @param graphs the graphs to be checked
+				 * @param threadCount the number of threads used; if 0, the number of hardware threads is used
+				 * @return the result of the check
+				 */
+				CoverageResult checkAll(vector<graphs::Hypergraph_sp> const& graphs, unsigned int threadCount = 1) const;
+
+				/**
+				 * Returns the number of initial graphs.
+				 * @return the number of initial graphs
+				 */
+				size_t getInitialGraphCount() const;
+
+				/**
+				 * Returns the initial graph at the given position of the list given to the constructor.
+				 * @param pos the position of the initial graph
+				 * @return the initial graph at the given position
+				 */
+				graphs::Hypergraph_sp getInitialGraph(size_t pos) const;
+
+			private:
+
+				/**
+				 * Appends the positions of all initial graphs to the given vector, which the given graph may be smaller
+				 * than or equal to according to the invariants. The positions are appended in the order of the list
+				 * given to the constructor.
+				 * @param graph the graph to be checked
+				 * @param candidates the vector to which the positions are appended
+				 */
+				void findCandidates(graphs::Hypergraph const& graph, vector<size_t>& candidates) const;
+
+				/**
+				 * The order used to compare graphs.
+				 */
+				basic_types::Order_csp order;
+
+				/**
+				 * The initial graphs indexed by their invariants.
+				 */
+				GraphInvariantIndex index;
+
+		};
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* INITIALGRAPHINDEX_H_ */
@@ -0,0 +1,61 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "MeasuredOrder.h"
+#include <chrono>
+
+using namespace std;
+using namespace uncover::basic_types;
+using namespace uncover::graphs;
+using namespace uncover::logging;
+
+namespace uncover {
+	namespace analysis {
+
+		MeasuredOrder::MeasuredOrder(Order_sp order, string const& name, MetricsRegistry& registry)
+				: Order(),
+				  order(order),
+				  calls(registry.getCounter("order." + name + ".calls")),
+				  successes(registry.getCounter("order." + name + ".true")),
+				  time(registry.getHistogram("order." + name + ".time_ns")) {}
+
+		MeasuredOrder::~MeasuredOrder() {}
+
+		bool MeasuredOrder::isLessOrEq(Hypergraph const& smaller, Hypergraph const& bigger) const {
+			auto start = chrono::steady_clock::now();
+			bool result = order->isLessOrEq(smaller, bigger);
+			time.record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+			calls.increment();
+			if(result) {
+				successes.increment();
+			}
+			return result;
+		}
+
+		void MeasuredOrder::setCancellationToken(CancellationToken_csp token) {
+			Order::setCancellationToken(token);
+			order->setCancellationToken(token);
+		}
+
+		Order_sp MeasuredOrder::getWrappedOrder() const {
+			return order;
+		}
+
+	} /* namespace analysis */
+} /* namespace uncover */
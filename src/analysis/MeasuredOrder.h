@@ -0,0 +1,100 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef MEASUREDORDER_H_
+#define MEASUREDORDER_H_
+
+#include "../basic_types/Order.h"
+#include "../logging/MetricsRegistry.h"
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * A MeasuredOrder wraps another Order and records the number of calls to isLessOrEq(...), how many of them
+		 * succeeded and the time (in nanoseconds) each call needed. The metrics are stored in the given registry under
+		 * 'order.<name>.calls', 'order.<name>.true' and 'order.<name>.time_ns'. The result of the wrapped order is not
+		 * changed.
+		 * @author Jan Stückrath
+		 */
+		class MeasuredOrder : public basic_types::Order {
+
+			public:
+
+				/**
+				 * Creates a new MeasuredOrder wrapping the given order.
+				 * @param order the order to be measured
+				 * @param name the name of the order used in the metric names
+				 * @param registry the registry in which the metrics are stored
+				 */
+				MeasuredOrder(basic_types::Order_sp order, string const& name, logging::MetricsRegistry& registry);
+
+				/**
+				 * Destroys this MeasuredOrder.
+				 */
+				virtual ~MeasuredOrder();
+
+				/**
+				 * Calls isLessOrEq(...) of the wrapped order and records the call.
+				 * @param smaller the Hypergraph which should be smaller
+				 * @param bigger the Hypergraph which should be larger
+				 * @return the result of the wrapped order
+				 */
+				virtual bool isLessOrEq(graphs::Hypergraph const& smaller, graphs::Hypergraph const& bigger) const override;
+
+				/**
+				 * Sets the CancellationToken of this and of the wrapped order.
+				 * @param token the CancellationToken to be checked or a null pointer
+				 */
+				virtual void setCancellationToken(basic_types::CancellationToken_csp token) override;
+
+				/**
+				 * Returns the wrapped order.
+				 * @return the wrapped order
+				 */
+				basic_types::Order_sp getWrappedOrder() const;
+
+			private:
+
+				/**
+				 * The wrapped order.
+				 */
+				basic_types::Order_sp order;
+
+				/**
+				 * Counts all calls to isLessOrEq(...).
+				 */
+				logging::Counter& calls;
+
+				/**
+				 * Counts all calls to isLessOrEq(...) returning true.
+				 */
+				logging::Counter& successes;
+
+				/**
+				 * Records the time needed by each call to isLessOrEq(...).
+				 */
+				logging::Histogram& time;
+
+		};
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* MEASUREDORDER_H_ */
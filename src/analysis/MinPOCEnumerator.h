@@ -24,6 +24,7 @@
 #include "../graphs/Hypergraph.h"
 #include "BackwardResultHandler.h"
 #include "PreparedGTS.h"
+#include "../basic_types/CancellationToken.h"
 
 namespace uncover {
 	namespace analysis {
@@ -102,12 +103,36 @@ namespace uncover {
 				 */
 				void setPreparedGTS(PreparedGTS_csp gts) { prepGTS = gts; }
 
+				/**
+				 * Sets whether the caller only needs the minimal pushout complements up to isomorphism (default: false).
+				 * If set, an enumerator may skip pushout complements which are guaranteed to be isomorphic to one
+				 * enumerated earlier, e.g. those differing only by a permutation of interchangeable isolated nodes.
+				 * @param upToIso true, iff the pushout complements are only needed up to isomorphism
+				 */
+				void setUpToIsomorphism(bool upToIso) { upToIsomorphism = upToIso; }
+
+				/**
+				 * Sets the CancellationToken checked while enumerating. If it is cancelled, resetWith(...) and
+				 * operator++() throw a CancelledException and the enumerator has to be reset before being used again.
+				 * A null pointer (default) deactivates the checks.
+				 * @param token the CancellationToken to be checked or a null pointer
+				 */
+				void setCancellationToken(basic_types::CancellationToken_csp token) { cancellation = token; }
+
+				/**
+				 * Returns the number of pushout complements dropped because of a bound (e.g. the path bound of the
+				 * subgraph order) since the last call of resetWith(...).
+				 * @return the number of pushout complements dropped because of a bound
+				 */
+				size_t getDroppedByBound() const { return droppedByBound; }
+
 			protected:
 
 				/**
 				 * Initializes this enumerator.
 				 */
-				MinPOCEnumerator() : resultHandler(nullptr), prepGTS(nullptr) {}
+				MinPOCEnumerator()
+					: resultHandler(nullptr), prepGTS(nullptr), upToIsomorphism(false), cancellation(nullptr), droppedByBound(0) {}
 
 				/**
 				 * Stores the BackwardResultHandler used by this enumerator.
@@ -120,6 +145,22 @@ namespace uncover {
 				 */
 				PreparedGTS_csp prepGTS;
 
+				/**
+				 * Stores whether the pushout complements are only needed up to isomorphism.
+				 */
+				bool upToIsomorphism;
+
+				/**
+				 * Stores the CancellationToken checked while enumerating; may be null.
+				 */
+				basic_types::CancellationToken_csp cancellation;
+
+				/**
+				 * Stores the number of pushout complements dropped because of a bound since the last reset; has to be
+				 * reset and increased by the implementations using a bound.
+				 */
+				size_t droppedByBound;
+
 		};
 
 		/**
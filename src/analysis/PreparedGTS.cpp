@@ -19,27 +19,26 @@
 
 #include "PreparedGTS.h"
 #include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 #include "../logging/message_logging.h"
 #include "../basic_types/VectorCallback.h"
+#include "../graphs/CanonicalLabeler.h"
+#include "../logging/MetricsRegistry.h"
+#include "../rule_engine/StdMatchFinder.h"
 
 using namespace uncover::logging;
 using namespace uncover::graphs;
 using namespace uncover::basic_types;
+using namespace uncover::rule_engine;
 using namespace std;
 
 namespace uncover {
 	namespace analysis {
 
-		PreparedGTS::PreparedGTS(GTS const& gts, RulePreparer_sp rulePrep, bool opt)
-			: GTS(gts.getName(),
-					unordered_map<IDType, Rule_sp>(),
-					gts.getUQRules(),
-					gts.getInitialGraphs()),
-				oldStdRules(gts.getStdRules()),
-				prepFrom(),
-				rulePreparer(rulePrep),
-				uqRuleInstances(),
-				uqRuleLengths() {
+		PreparedGTS::PreparedGTS(GTS const& gts, RulePreparer_sp rulePrep, bool opt, unsigned int threadCount)
+			: PreparedGTS(gts, rulePrep, opt, vector<Rule_sp>(), vector<vector<IDType>>()) {
 
 			if(!this->rulePreparer) {
 				logger.newError() << "PreparedRules object cannot be instantiated without a "
@@ -48,29 +47,115 @@ namespace uncover {
 			}
 
 			this->rulePreparer->setOptimization(opt);
-			StdRuleMapCB callbackStdRules(*this);
 
 			// each standard rule is prepared independently, i.e. the result set can contain isomorphic rules
 			// if there are two old rules with identical left sides
-			for(auto it = oldStdRules.cbegin(); it != oldStdRules.cend(); ++it) {
-				callbackStdRules.setCurrentRuleID(it->first);
-				rulePreparer->prepareRule(*it->second, callbackStdRules);
+			vector<Rule_csp> originals = getSortedOriginalRules();
+			vector<vector<Rule_sp>> prepared = prepareStdRules(originals, threadCount);
+
+			// the prepared rules received their IDs in the order the threads created them; renumbering them in
+			// the order of the original rules keeps the IDs independent of the thread scheduling
+			for(size_t i = 0; i < originals.size(); ++i) {
+				for(Rule_sp& rule : prepared[i]) {
+					Rule_sp numbered = make_shared<Rule>(rule->getName(), rule->getLeft(), rule->getRight(), rule->getMapping());
+					addStdRule(numbered);
+					prepFrom[numbered->getID()].push_back(originals[i]->getID());
+				}
 			}
 
-			// universally quantified rules have to be prepared at runtime
+			// universally quantified rules have to be prepared at runtime, isomorphic instances are dropped then
 
 			if(opt) {
 
-				// TODO possible optimization: delete isomorphic morphisms
-
 				// TODO possible optimization: delete all UQRules if all their instantiations are order morphisms
 
 			}
 
 		}
 
+		PreparedGTS::PreparedGTS(GTS const& gts,
+				RulePreparer_sp rulePrep,
+				bool opt,
+				vector<Rule_sp> const& preparedRules,
+				vector<vector<IDType>> const& originalIDs)
+			: GTS(gts.getName(),
+					unordered_map<IDType, Rule_sp>(),
+					gts.getUQRules(),
+					gts.getInitialGraphs()),
+				oldStdRules(gts.getStdRules()),
+				prepFrom(),
+				rulePreparer(rulePrep),
+				optimize(opt),
+				preparedInstances(),
+				instanceForms(),
+				instanceMutex() {
+
+			for(size_t i = 0; i < preparedRules.size() && i < originalIDs.size(); ++i) {
+				addStdRule(preparedRules[i]);
+				prepFrom[preparedRules[i]->getID()] = originalIDs[i];
+			}
+		}
+
 		PreparedGTS::~PreparedGTS() {}
 
+		vector<Rule_csp> PreparedGTS::getSortedOriginalRules() const {
+			map<IDType, Rule_csp> sorted(oldStdRules.cbegin(), oldStdRules.cend());
+			vector<Rule_csp> result;
+			for(auto it = sorted.cbegin(); it != sorted.cend(); ++it) {
+				result.push_back(it->second);
+			}
+			return result;
+		}
+
+		vector<vector<Rule_sp>> PreparedGTS::prepareStdRules(vector<Rule_csp> const& rules, unsigned int threadCount) const {
+
+			vector<vector<Rule_sp>> results(rules.size());
+
+			if(threadCount == 0) {
+				threadCount = max(thread::hardware_concurrency(), 1u);
+			}
+			threadCount = min<size_t>(threadCount, max<size_t>(rules.size(), 1));
+
+			atomic<size_t> next(0);
+			atomic<bool> stop(false);
+			exception_ptr failure = nullptr;
+			mutex failureMutex;
+
+			// every thread takes the next unprepared rule until all rules are prepared
+			auto worker = [&]() {
+				try {
+					for(size_t i = next++; i < rules.size() && !stop.load(); i = next++) {
+						VectorCallback<Rule_sp> callback(results[i]);
+						rulePreparer->prepareRule(*rules[i], callback);
+					}
+				} catch(...) {
+					lock_guard<mutex> lock(failureMutex);
+					if(!failure) {
+						failure = current_exception();
+					}
+					stop.store(true);
+				}
+			};
+
+			if(threadCount <= 1) {
+				worker();
+			} else {
+				vector<thread> threads;
+				for(unsigned int i = 0; i < threadCount; ++i) {
+					threads.push_back(thread(worker));
+				}
+				for(thread& t : threads) {
+					t.join();
+				}
+			}
+
+			if(failure) {
+				rethrow_exception(failure);
+			}
+
+			return results;
+		}
+
 
 		shared_ptr<vector<AnonRule_csp>> PreparedGTS::getOriginalRules(IDType id) const {
 
@@ -92,6 +177,176 @@ namespace uncover {
 		}
 
 
+		SplitRule_csp PreparedGTS::getSplitRule(AnonRule_csp rule) const {
+
+			static Counter& splitCounter = metrics.getCounter("poc.splits.computed");
+			static Counter& reusedCounter = metrics.getCounter("poc.splits.reused");
+
+			{
+				lock_guard<mutex> lock(splitMutex);
+				auto cacheIt = splitRules.find(rule.get());
+				if(cacheIt != splitRules.end()) {
+					reusedCounter.increment();
+					return cacheIt->second.second;
+				}
+			}
+
+			// splitting is done without holding the lock; if another thread split the same rule in the meantime,
+			// its split is kept
+			SplitRule_csp split = make_shared<SplitRule>(*rule);
+
+			lock_guard<mutex> lock(splitMutex);
+			auto inserted = splitRules.insert(make_pair(rule.get(), make_pair(rule, split)));
+			if(inserted.second) {
+				splitCounter.increment();
+			} else {
+				reusedCounter.increment();
+			}
+			return inserted.first->second.second;
+		}
+
+		size_t PreparedGTS::getPreparedQuantityCount() {
+			lock_guard<mutex> lock(instanceMutex);
+			size_t result = 0;
+			for(auto it = preparedInstances.cbegin(); it != preparedInstances.cend(); ++it) {
+				result += it->second.size();
+			}
+			return result;
+		}
+
+		size_t PreparedGTS::removeDominatedRules() {
+
+			static Counter& prunedCounter = metrics.getCounter("prepare.rules.pruned");
+
+			// a dominating rule has a smaller left side than the rules it dominates, hence it is checked first;
+			// rules are only compared to undominated rules, since the extension by context is transitive
+			vector<Rule_csp> originals = getSortedOriginalRules();
+			stable_sort(originals.begin(), originals.end(), [](Rule_csp const& r1, Rule_csp const& r2) {
+				return r1->getLeft()->getVertexCount() + r1->getLeft()->getEdgeCount()
+						< r2->getLeft()->getVertexCount() + r2->getLeft()->getEdgeCount();
+			});
+			vector<Rule_csp> undominated;
+			unordered_set<IDType> dominated;
+			for(Rule_csp const& rule : originals) {
+				string form = CanonicalLabeler::createCanonicalForm(*rule);
+				bool isDominated = false;
+				for(auto it = undominated.cbegin(); it != undominated.cend() && !isDominated; ++it) {
+					isDominated = extendsByContext(**it, *rule, form);
+				}
+				if(isDominated) {
+					dominated.insert(rule->getID());
+				} else {
+					undominated.push_back(rule);
+				}
+			}
+
+			// rules are checked in the order of their IDs, so the rule with the smallest ID of isomorphic rules is kept
+			map<IDType, Rule_sp> sorted(stdRules.cbegin(), stdRules.cend());
+			unordered_map<string, IDType> keptForms;
+			size_t removed = 0;
+			for(auto it = sorted.cbegin(); it != sorted.cend(); ++it) {
+
+				vector<IDType> from = prepFrom[it->first];
+				bool remove = !from.empty();
+				for(auto fromIt = from.cbegin(); fromIt != from.cend() && remove; ++fromIt) {
+					remove = dominated.count(*fromIt) != 0;
+				}
+
+				if(!remove && rulePreparer) {
+					remove = rulePreparer->isNoOpRule(*it->second);
+				}
+
+				if(!remove) {
+					auto inserted = keptForms.insert(make_pair(CanonicalLabeler::createCanonicalForm(*it->second), it->first));
+					if(!inserted.second) {
+						vector<IDType>& keptFrom = prepFrom[inserted.first->second];
+						for(IDType id : from) {
+							if(find(keptFrom.cbegin(), keptFrom.cend(), id) == keptFrom.cend()) {
+								keptFrom.push_back(id);
+							}
+						}
+						remove = true;
+					}
+				}
+
+				if(remove) {
+					stdRules.erase(it->first);
+					prepFrom.erase(it->first);
+					++removed;
+				}
+			}
+
+			prunedCounter.increment(removed);
+			return removed;
+		}
+
+		bool PreparedGTS::extendsByContext(AnonRule const& smaller, AnonRule const& larger, string const& largerForm) {
+
+			AnonHypergraph const& smallLeft = *smaller.getLeft();
+			AnonHypergraph const& largeLeft = *larger.getLeft();
+
+			// the context is added to both sides, hence both sides have to grow by the same amount
+			if(largeLeft.getVertexCount() - smallLeft.getVertexCount()
+						!= larger.getRight()->getVertexCount() - smaller.getRight()->getVertexCount()
+					|| largeLeft.getEdgeCount() - smallLeft.getEdgeCount()
+						!= larger.getRight()->getEdgeCount() - smaller.getRight()->getEdgeCount()) {
+				return false;
+			}
+
+			StdMatchFinder finder(true);
+			shared_ptr<vector<Mapping>> matches = finder.findMatches(smallLeft, largeLeft);
+			for(Mapping const& match : *matches) {
+
+				unordered_map<IDType,IDType> inverse;
+				for(auto it = match.cbegin(); it != match.cend(); ++it) {
+					inverse[it->second] = it->first;
+				}
+
+				AnonRule extended(smaller);
+				unordered_map<IDType,IDType> leftIDs, rightIDs;
+				for(auto it = largeLeft.cbeginVertices(); it != largeLeft.cendVertices(); ++it) {
+					auto invIt = inverse.find(it->first);
+					if(invIt != inverse.end()) {
+						leftIDs[it->first] = invIt->second;
+						if(extended.getMapping().hasSrc(invIt->second)) {
+							rightIDs[it->first] = extended.getMapping().getTar(invIt->second);
+						}
+					} else {
+						leftIDs[it->first] = extended.getLeft()->addVertex();
+						rightIDs[it->first] = extended.getRight()->addVertex();
+						extended.getMapping()[leftIDs[it->first]] = rightIDs[it->first];
+					}
+				}
+
+				// context edges attached to a deleted vertex cannot be preserved
+				bool valid = true;
+				for(auto it = largeLeft.cbeginEdges(); it != largeLeft.cendEdges() && valid; ++it) {
+					if(inverse.count(it->first)) {
+						continue;
+					}
+					vector<IDType> leftAtt, rightAtt;
+					for(IDType v : it->second.getVertices()) {
+						if(!rightIDs.count(v)) {
+							valid = false;
+							break;
+						}
+						leftAtt.push_back(leftIDs[v]);
+						rightAtt.push_back(rightIDs[v]);
+					}
+					if(valid) {
+						IDType leftEdge = extended.getLeft()->addEdge(it->second.getLabel(), leftAtt);
+						extended.getMapping()[leftEdge] = extended.getRight()->addEdge(it->second.getLabel(), rightAtt);
+					}
+				}
+
+				if(valid && CanonicalLabeler::createCanonicalForm(extended) == largerForm) {
+					return true;
+				}
+			}
+
+			return false;
+		}
+
 		PreparedGTS::uqinst_iterator PreparedGTS::beginUQInstances(IDType const& ruleID, Hypergraph const& graph) {
 
 			if(uqRules.count(ruleID) == 0) {
@@ -99,44 +354,69 @@ namespace uncover {
 			} else {
 
 				size_t bound = graph.getVertexCount() + graph.getEdgeCount();
-				return PreparedGTS::uqinst_iterator(uqRules[ruleID], rulePreparer, bound);
+				return PreparedGTS::uqinst_iterator(*this, ruleID, uqRules.at(ruleID), bound);
 
 			}
 
 		}
 
-		void PreparedGTS::createInstancesUpTo(IDType const& ruleID, size_t bound) {
+		vector<UQRuleInstance_sp> const& PreparedGTS::getPreparedInstances(IDType ruleID, vector<unsigned int> const& quantities) {
 
-			vector<UQRuleInstance_sp>& instances = uqRuleInstances[ruleID];
-			vector<size_t>& lengths = uqRuleLengths[ruleID];
-			UQRule_csp rule = uqRules[ruleID];
+			static Counter& preparedCounter = metrics.getCounter("uq.instances.prepared");
+			static Counter& isomorphicCounter = metrics.getCounter("uq.instances.isomorphic");
+			static Counter& reusedCounter = metrics.getCounter("uq.instances.reused");
 
-			if(lengths.size() == 0) {
-				instances.push_back(rule->createZeroInstance());
-				lengths.push_back(1);
+			{
+				lock_guard<mutex> lock(instanceMutex);
+				map<vector<unsigned int>, vector<UQRuleInstance_sp>>& cache = preparedInstances[ruleID];
+				auto cacheIt = cache.find(quantities);
+				if(cacheIt != cache.end()) {
+					reusedCounter.increment(cacheIt->second.size());
+					return cacheIt->second;
+				}
 			}
 
-			VectorCallback<UQRuleInstance_sp> callback(instances);
-
-			// possibly multiple instantiations (concatenated) are necessary
-			while(lengths.size() <= bound) {
-
-				size_t index = (lengths.size() == 1) ? 0 : lengths[lengths.size()-2];
-				size_t oldEnd = lengths.back();
+			// preparation is the expensive part and is done without holding the lock
+			vector<UQRuleInstance_sp> prepared;
+			VectorCallback<UQRuleInstance_sp> callback(prepared);
+			UQRuleInstance_sp instance = uqRules.at(ruleID)->createInstance(quantities);
+			rulePreparer->prepareRule(*instance, callback);
+			vector<string> preparedForms;
+			if(optimize) {
+				for(UQRuleInstance_sp& inst : prepared) {
+					preparedForms.push_back(CanonicalLabeler::createCanonicalForm(*inst));
+				}
+			}
 
-				// for each rule instance with a number of instantiations of one less than current
-				for(; index < oldEnd; ++index) {
-					// for each quantification of the rule
-					for(size_t quantCount = 0; quantCount < rule->getQuantCount(); ++quantCount) {
+			lock_guard<mutex> lock(instanceMutex);
+			map<vector<unsigned int>, vector<UQRuleInstance_sp>>& cache = preparedInstances[ruleID];
+			auto inserted = cache.insert(make_pair(quantities, vector<UQRuleInstance_sp>()));
+			vector<UQRuleInstance_sp>& result = inserted.first->second;
+			if(!inserted.second) {
+				// another thread prepared the same instances in the meantime
+				reusedCounter.increment(result.size());
+				return result;
+			}
 
-						// prepare the rule and insert all resulting rules (possibly using optimization)
-						UQRuleInstance_sp newRule = rule->extendInstance(instances[index], quantCount);
-						rulePreparer->prepareRule(*newRule, callback);
+			preparedCounter.increment(prepared.size());
+			if(optimize) {
+				unsigned int sum = 0;
+				for(unsigned int q : quantities) {
+					sum += q;
+				}
+				unordered_set<string>& forms = instanceForms[ruleID][sum];
+				for(size_t i = 0; i < prepared.size(); ++i) {
+					if(forms.insert(preparedForms[i]).second) {
+						result.push_back(prepared[i]);
+					} else {
+						isomorphicCounter.increment();
 					}
 				}
-
-				lengths.push_back(instances.size());
+			} else {
+				result.swap(prepared);
 			}
+
+			return result;
 		}
 
 		// **************************************************************************************
@@ -145,21 +425,23 @@ namespace uncover {
 
 		PreparedGTS::uqinst_iterator::uqinst_iterator(PreparedGTS::uqinst_iterator&& old)
 			: rule(old.rule),
-			  rulePreparer(old.rulePreparer),
+			  gts(old.gts),
+			  ruleID(old.ruleID),
 			  currentQuant(old.currentQuant),
 			  currentInstances(old.currentInstances),
 			  bound(old.bound) {
 
 			old.rule = nullptr;
-			old.rulePreparer = nullptr;
-			currentQuant = nullptr;
-			currentInstances = nullptr;
+			old.gts = nullptr;
+			old.currentQuant = nullptr;
+			old.currentInstances = nullptr;
 
 		}
 
-		PreparedGTS::uqinst_iterator::uqinst_iterator(UQRule_sp rule, RulePreparer_sp rulepreparer, unsigned int bound)
+		PreparedGTS::uqinst_iterator::uqinst_iterator(PreparedGTS& gts, IDType ruleID, UQRule_sp rule, unsigned int bound)
 			: rule(rule),
-			  rulePreparer(rulepreparer),
+			  gts(&gts),
+			  ruleID(ruleID),
 			  currentQuant(new vector<unsigned int>()),
 			  currentInstances(new vector<UQRuleInstance_sp>()),
 			  bound(bound) {
@@ -179,9 +461,11 @@ namespace uncover {
 		void PreparedGTS::uqinst_iterator::loadNextRule(bool firstTime) {
 
 			// if rules are still stored, take them
-			if(currentInstances->size() > 1) {
+			if(!currentInstances->empty()) {
 				currentInstances->pop_back();
-				return;
+				if(!currentInstances->empty()) {
+					return;
+				}
 			}
 
 			// search and generate the next quantification (terminate if found)
@@ -196,16 +480,15 @@ namespace uncover {
 				}
 
 				// if currentQuant is valid, then:
-				// 1) generate UQRuleInstance for currentQuant
-				// 2) prepare just generated UQRuleInstance
-				// 3) if prepared set is non-empty, terminate, otherwise try next currentQuant
+				// 1) take the prepared UQRuleInstances for currentQuant (they are generated on first use)
+				// 2) if prepared set is non-empty, terminate, otherwise try next currentQuant
 				if(sumCurrentQuant() <= bound) {
-					VectorCallback<UQRuleInstance_sp> callback(*currentInstances);
-					UQRuleInstance_sp currentInstance = rule->createInstance(*currentQuant);
-					rulePreparer->prepareRule(*currentInstance, callback);
+					*currentInstances = gts->getPreparedInstances(ruleID, *currentQuant);
 					if(currentInstances->size()) {
 						return;
-					} // else try next quantification possibility
+					}
+					// else try next quantification possibility, starting again with the first quantification
+					curIt = currentQuant->begin();
 				} else {
 					*curIt = 0;
 					++curIt;
@@ -234,7 +517,7 @@ namespace uncover {
 			return *this;
 		}
 
-		UQRuleInstance_sp PreparedGTS::uqinst_iterator::operator*() {
+		UQRuleInstance_csp PreparedGTS::uqinst_iterator::operator*() {
 			if(currentInstances) {
 				return currentInstances->back();
 			} else {
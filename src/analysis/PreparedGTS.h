@@ -23,10 +23,14 @@
 #include "../graphs/GTS.h"
 #include "RulePreparer.h"
 #include "../graphs/UQRuleInstance.h"
+#include "../rule_engine/SplitRule.h"
+#include <mutex>
 
 namespace uncover {
 	namespace analysis {
 
+		class PreparedGTSCache;
+
 		/**
 		 * The PreparedGTS class represents a graph transformation system that was prepared for use in the
 		 * backward procedure. It is instantiated with a GTS and a RulePreparer object. The standard rules
@@ -39,6 +43,8 @@ namespace uncover {
 		 */
 		class PreparedGTS: public graphs::GTS {
 
+			friend class PreparedGTSCache;
+
 			public:
 
 				/**
@@ -75,13 +81,12 @@ namespace uncover {
 
 						/**
 						 * Returns the last UQRuleInstance computed by this iterator (i.e. by the last ++ call).
-						 * The returned UQRuleInstance can be used and modified freely, without affecting the this
-						 * iterator. However, this iterator keeps a pointer to the UQRuleInstance and will return this
-						 * pointer in any subsequent * call, as long as the iterator was not incremented again. If
-						 * the iterator ended, this operator will return a null pointer.
+						 * The returned UQRuleInstance is shared with the cache of the PreparedGTS and will be returned
+						 * again by other iterators, hence it must not be modified. If the iterator ended, this operator
+						 * will return a null pointer.
 						 * @return the last computed UQRuleInstance
 						 */
-						graphs::UQRuleInstance_sp operator*();
+						graphs::UQRuleInstance_csp operator*();
 
 						/**
 						 * Returns true, if this iterator has ended, i.e. the last UQRuleInstance was already computed and returned.
@@ -92,17 +97,18 @@ namespace uncover {
 					private:
 
 						/**
-						 * Generates a new iterator for the given rule. This iterator will use the given RulePreparer
-						 * on every generated UQRuleInstance and will generate instances up to the given bound.
+						 * Generates a new iterator for the given rule. This iterator will take the prepared instances
+						 * from the given PreparedGTS and will generate instances up to the given bound.
+						 * @param gts the PreparedGTS preparing and caching the instances
+						 * @param ruleID the ID of the rule to be used
 						 * @param rule the rule to be used
-						 * @param rulepreparer the RulePreparer to be used
 						 * @param bound the bound up to which UQRuleInstances will be generated
 						 */
-						uqinst_iterator(graphs::UQRule_sp rule, RulePreparer_sp rulepreparer, unsigned int bound);
+						uqinst_iterator(PreparedGTS& gts, IDType ruleID, graphs::UQRule_sp rule, unsigned int bound);
 
 						/**
-						 * Drops the current UQRuleInstance and computes the next one if possible. If there is no
-						 * UQRuleInstance to compute, this iterator ends.
+						 * Drops the current UQRuleInstance and loads the next one if possible. If there is no
+						 * UQRuleInstance left, this iterator ends.
 						 * @param firstTime if this parameter is true, the internal iterator will no be incremented by
 						 * 				this call; this is necessary in the first call of this function after initializing the
 						 * 				iterator
@@ -122,9 +128,14 @@ namespace uncover {
 						graphs::UQRule_sp rule;
 
 						/**
-						 * Stores the RulePreparer used by this iterator.
+						 * Stores the PreparedGTS from which the prepared instances are taken.
 						 */
-						RulePreparer_sp rulePreparer;
+						PreparedGTS* gts;
+
+						/**
+						 * Stores the ID of the UQRule used by this iterator.
+						 */
+						IDType ruleID;
 
 						/**
 						 * Stores a count for each Quantification of the UQRule storing how often each Quantification will
@@ -133,8 +144,8 @@ namespace uncover {
 						vector<unsigned int>* currentQuant;
 
 						/**
-						 * Stores the UQRuleInstances generated by preparing a last computed UQRuleInstance. These instances
-						 * will be returned one after the other before computing the next UQRuleInstance.
+						 * Stores the prepared UQRuleInstances of the current quantities. These instances will be returned
+						 * one after the other (starting at the back) before loading the instances of the next quantities.
 						 */
 						vector<graphs::UQRuleInstance_sp>* currentInstances;
 
@@ -149,12 +160,18 @@ namespace uncover {
 				 * Creates a Prepared GTS using the given GTS and RulePreparer. All rules of the given GTS are prepared
 				 * and all resulting rules added to this PreparedGTS. If optimization is enabled (default), rules are
 				 * only added if they are no order morphism wrt. to the order used by the RulePreparer (these rules
-				 * do not produce new results during the backward search). UQRules are not prepared and just copied.
+				 * do not produce new results during the backward search) and prepared UQRuleInstances isomorphic to
+				 * an already prepared instance are dropped. UQRules are not prepared and just copied.
+				 * The standard rules are prepared in parallel (one rule per task). The prepared rules are added in
+				 * the order of the original rules (ordered by ID) and numbered afterwards, hence their IDs and order do not depend
+				 * on the number of threads.
 				 * @param gts the GTS of which the rules will be prepared
 				 * @param rulePrep the RulePreparer used for preparation
 				 * @param opt if true (default), then order morphisms will not be added to this PreparedGTS
+				 * @param threadCount the number of threads used for preparing the standard rules; 0 (default) uses
+				 * 				one thread per available core
 				 */
-				PreparedGTS(GTS const& gts, RulePreparer_sp rulePrep, bool opt = true);
+				PreparedGTS(GTS const& gts, RulePreparer_sp rulePrep, bool opt = true, unsigned int threadCount = 0);
 
 				/**
 				 * Destroys this PreparedGTS.
@@ -165,7 +182,9 @@ namespace uncover {
 				 * Creates and returns an iterator, iterating over all UQRuleInstances of the UQRule with the given ID,
 				 * which need to be applied backward to the given graph. The number of UQRuleInstance increases
 				 * exponentially with the complexity of the rule (i.e. the basis is the number of Quantifications) and
-				 * the size of the graph (the exponent).
+				 * the size of the graph (the exponent). Instances are only prepared once and then reused for all
+				 * subsequent graphs, i.e. a graph only pays for the instances exceeding the bounds of all earlier
+				 * graphs. Iterators of the same PreparedGTS may be used concurrently by different threads.
 				 * @param ruleID the ID of the UQRule to be instantiated
 				 * @param graph the graph to which the UQRule should be applied backwards to
 				 * @return an iterator, enumerating all necessary instances of the UQRule
@@ -180,15 +199,97 @@ namespace uncover {
 				 */
 				shared_ptr<vector<graphs::AnonRule_csp>> getOriginalRules(IDType id) const;
 
+				/**
+				 * Returns the split of the given rule into a partial and a total part together with all data derived
+				 * from it, which does not depend on a graph (see rule_engine::SplitRule). The split is computed on the
+				 * first call for a rule and cached for all later calls, hence it is computed once per prepared rule
+				 * (or UQRuleInstance) and not once per graph to which the rule is applied. The given rule must not be
+				 * modified afterwards. The cache keeps the rule alive. This function is thread-safe.
+				 * @param rule the rule to be split
+				 * @return the split of the given rule
+				 */
+				rule_engine::SplitRule_csp getSplitRule(graphs::AnonRule_csp rule) const;
+
+				/**
+				 * Returns the number of quantity vectors for which UQRuleInstances were prepared so far (summed over
+				 * all UQRules).
+				 * @return the number of quantity vectors for which UQRuleInstances were prepared
+				 */
+				size_t getPreparedQuantityCount();
+
+				/**
+				 * Removes all prepared standard rules which cannot contribute new graphs to a backward step, since the
+				 * results of some other prepared rule always subsume their results. A prepared rule is removed if it is
+				 * isomorphic to a prepared rule with a smaller ID, if the RulePreparer classifies it as no-op rule, or
+				 * if all original rules it was prepared from are dominated. An original rule is dominated by another
+				 * original rule, if it equals the other rule extended by preserved context, i.e. it is applicable
+				 * wherever the other rule is applicable with the same match and yields the same result. The removed
+				 * rules are not renumbered and the original rules of a removed isomorphic rule are added to the kept
+				 * rule. UQRules are not affected.
+				 * @return the number of removed rules
+				 */
+				size_t removeDominatedRules();
+
 			protected:
 
 				/**
-				 * Creates and stores all UQRuleInstances for the given UQRule up to the given bound. The generated
-				 * UQRuleInstances are stored in uqRuleInstances and indexed by uqRuleLengths.
+				 * Creates a PreparedGTS containing the given (already prepared) standard rules. This constructor does
+				 * not prepare any rules and is used to restore a PreparedGTS, e.g. by a PreparedGTSCache.
+				 * @param gts the GTS of which the rules were prepared
+				 * @param rulePrep the RulePreparer used for preparing UQRuleInstances
+				 * @param opt if true, optimizations are used when preparing UQRuleInstances
+				 * @param preparedRules the prepared standard rules
+				 * @param originalIDs for every prepared rule the IDs of the rules of the given GTS from which it was
+				 * 				prepared; the i-th entry belongs to the i-th prepared rule
+				 */
+				PreparedGTS(GTS const& gts,
+						RulePreparer_sp rulePrep,
+						bool opt,
+						vector<graphs::Rule_sp> const& preparedRules,
+						vector<vector<IDType>> const& originalIDs);
+
+				/**
+				 * Returns the standard rules of the original GTS ordered by their IDs.
+				 * @return the standard rules of the original GTS ordered by their IDs
+				 */
+				vector<graphs::Rule_csp> getSortedOriginalRules() const;
+
+				/**
+				 * Returns the prepared instances of the UQRule with the given ID, where each quantification is
+				 * instantiated as often as given by the quantities. The instances are prepared on the first call and
+				 * cached for all later calls. If optimization is enabled, prepared instances isomorphic to an
+				 * instance prepared earlier for quantities with the same sum are dropped. Since an iterator enumerates
+				 * either all or no quantities with a given sum, dropping these instances does not lose any rule.
+				 * This function is thread-safe. Instances are prepared without holding the lock, so other threads
+				 * can take cached instances in the meantime.
 				 * @param ruleID the ID of the UQRule to be instantiated
-				 * @param bound the size up to which instances should be generated
+				 * @param quantities the number of instantiations of each quantification
+				 * @return the prepared instances
+				 */
+				vector<graphs::UQRuleInstance_sp> const& getPreparedInstances(IDType ruleID, vector<unsigned int> const& quantities);
+
+				/**
+				 * Prepares the given original rules using the given number of threads. The rules prepared from the i-th
+				 * original rule are stored in the i-th vector of the result. Since every task fills its own vector, no
+				 * synchronization of the callbacks is necessary. Exceptions thrown during preparation are rethrown.
+				 * @param rules the original rules to be prepared
+				 * @param threadCount the number of threads to be used; 0 uses one thread per available core
+				 * @return the prepared rules for each original rule
 				 */
-				void createInstancesUpTo(IDType const& ruleID, size_t bound);
+				vector<vector<graphs::Rule_sp>> prepareStdRules(vector<graphs::Rule_csp> const& rules,
+						unsigned int threadCount) const;
+
+				/**
+				 * Checks whether the larger rule equals the smaller rule extended by context which is preserved by the
+				 * larger rule. Every injective match of the left side of the smaller rule into the left side of the
+				 * larger rule is extended by the unmatched vertices and edges (which have to be attached to vertices
+				 * preserved by the smaller rule) and the result is compared to the larger rule.
+				 * @param smaller the possibly dominating rule
+				 * @param larger the possibly dominated rule
+				 * @param largerForm the canonical form of the larger rule
+				 * @return true, iff the larger rule is the smaller rule extended by preserved context
+				 */
+				static bool extendsByContext(graphs::AnonRule const& smaller, graphs::AnonRule const& larger, string const& largerForm);
 
 				/**
 				 * Stores the RuleMap containing the (unprepared) rules of the original GTS.
@@ -208,73 +309,37 @@ namespace uncover {
 				RulePreparer_sp rulePreparer;
 
 				/**
-				 * For each ID of a UQRule (key) this map stores all UQRuleInstances (value) generated for the
-				 * corresponding UQRule.
+				 * Stores whether optimizations are enabled.
 				 */
-				unordered_map<IDType, vector<graphs::UQRuleInstance_sp>> uqRuleInstances;
+				bool optimize;
 
 				/**
-				 * For each ID of a UQRule (key) this map stores a vector of positions (value). The i-th value
-				 * in the vector is the first position in the corresponding vector of uqRuleInstances (with the
-				 * same UQRule ID) where the length of the instantiation is i.
+				 * For each ID of a UQRule (key) this map stores the prepared instances for all quantities requested so
+				 * far. The cache is shared by all iterators and only grows, hence references to its entries stay valid.
 				 */
-				unordered_map<IDType, vector<size_t>> uqRuleLengths;
+				unordered_map<IDType, map<vector<unsigned int>, vector<graphs::UQRuleInstance_sp>>> preparedInstances;
 
 				/**
-				 * The StdRuleMapCB is a helper class defining a CollectionCallback to a PreparedGTS standard rule map.
-				 * For every rule added it also stores that it was prepared by the rule with the ID currently set in this
-				 * callback.
-				 * @see CollectionCallback
-				 * @see PreparedGTS
-				 * @author Jan Stückrath
+				 * For each ID of a UQRule and sum of quantities this map stores the canonical forms of all prepared
+				 * instances.
 				 */
-				class StdRuleMapCB : public basic_types::CollectionCallback<graphs::Rule_sp> {
+				unordered_map<IDType, unordered_map<unsigned int, unordered_set<string>>> instanceForms;
 
-					public:
-
-						/**
-						 * Creates a new CollectionCallback to the given PreparedGTS standard rule map.
-						 * @param gts to which rules will be added by the callback
-						 */
-						StdRuleMapCB(PreparedGTS& gts) : gts(gts), currentRuleID(0) {};
-
-						/**
-						 * Destroys this StdRuleMapCB, not affecting the references PreparedGTS.
-						 */
-						virtual ~StdRuleMapCB() {}
-
-						/**
-						 * Adds the given Rule to the standard rule map of the PreparedGTS. It is also referenced
-						 * as having been prepared from the rule with the ID currently stored in this callback.
-						 * @param rule the rule to be added
-						 */
-						virtual void insert(graphs::Rule_sp rule) {
-							gts.addStdRule(rule);
-							gts.prepFrom[rule->getID()].push_back(currentRuleID);
-						}
-
-						/**
-						 * Sets the ID of the rule which was used to generate any subsequently added (prepared) rules
-						 * (until the next time this function is called).
-						 */
-						void setCurrentRuleID(IDType id) {
-							currentRuleID = id;
-						}
-
-					private:
-
-						/**
-						 * Stores a reference to the PreparedGTS to which Rules will be added by this callback.
-						 */
-						PreparedGTS& gts;
+				/**
+				 * Guards preparedInstances and instanceForms, since iterators may be used by multiple threads.
+				 */
+				std::mutex instanceMutex;
 
-						/**
-						 * Stores an ID which will be set as the original rule ID from which any rules added by insert(...)
-						 * were generated.
-						 */
-						IDType currentRuleID;
+				/**
+				 * For each rule split so far this map stores the rule and its split. The rule is stored to keep it
+				 * alive, such that its address cannot be reused by another rule.
+				 */
+				mutable unordered_map<graphs::AnonRule const*, pair<graphs::AnonRule_csp, rule_engine::SplitRule_csp>> splitRules;
 
-				};
+				/**
+				 * Guards splitRules, since the backward search may split rules in multiple threads.
+				 */
+				mutable std::mutex splitMutex;
 
 		};
 
@@ -0,0 +1,427 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "PreparedGTSCache.h"
+#include <fstream>
+#include <cstdio>
+#include "../basic_types/InvalidInputException.h"
+#include "../logging/message_logging.h"
+
+using namespace uncover::logging;
+using namespace uncover::graphs;
+using namespace uncover::basic_types;
+using namespace std;
+
+/**
+ * Identifies files written by the PreparedGTSCache.
+ */
+#define PREPARED_GTS_CACHE_MAGIC "uncover-prepared-gts"
+
+/**
+ * The version of the file format. Has to be increased whenever the format or the rule preparation changes.
+ */
+#define PREPARED_GTS_CACHE_VERSION 1
+
+namespace uncover {
+	namespace analysis {
+
+		PreparedGTSCache::PreparedGTSCache(string filename, uint64_t key) : filename(filename), key(key) {}
+
+		PreparedGTSCache::~PreparedGTSCache() {}
+
+		uint64_t PreparedGTSCache::createKey(string gtsFile, vector<string> const& settings) {
+
+			ifstream ist(gtsFile.c_str(), ios::in | ios::binary);
+			if(!ist.is_open()) {
+				throw InvalidInputException("Could not read the file '" + gtsFile + "' to compute the cache key.");
+			}
+
+			// FNV-1a over the version, the content of the file and all settings (each preceded by a separator)
+			uint64_t hash = 14695981039346656037ULL;
+			auto add = [&hash](unsigned char c) {
+				hash ^= c;
+				hash *= 1099511628211ULL;
+			};
+			add(PREPARED_GTS_CACHE_VERSION);
+			char buffer[4096];
+			while(ist.read(buffer, sizeof(buffer)) || ist.gcount() > 0) {
+				for(streamsize i = 0; i < ist.gcount(); ++i) {
+					add(buffer[i]);
+				}
+			}
+			for(string const& setting : settings) {
+				add(0);
+				for(char c : setting) {
+					add(c);
+				}
+			}
+
+			return hash;
+		}
+
+		PreparedGTS_sp PreparedGTSCache::load(GTS const& gts, RulePreparer_sp rulePrep, bool opt) const {
+
+			ifstream ist(filename.c_str(), ios::in | ios::binary);
+			if(!ist.is_open()) {
+				logger.newUserInfo() << "No prepared GTS found in cache file '" << filename << "'." << endLogMessage;
+				return nullptr;
+			}
+
+			try {
+				PreparedGTS_sp result = readFrom(ist, gts, rulePrep, opt);
+				if(result) {
+					logger.newUserInfo() << "Loaded the prepared GTS from cache file '" << filename << "'." << endLogMessage;
+				} else {
+					logger.newUserInfo() << "The cache file '" << filename << "' belongs to another input and is ignored." << endLogMessage;
+				}
+				return result;
+			} catch(InvalidInputException& ex) {
+				logger.newWarning() << "The cache file '" << filename << "' is corrupted and is ignored: " << ex.what() << endLogMessage;
+				return nullptr;
+			}
+		}
+
+		bool PreparedGTSCache::store(PreparedGTS& gts) const {
+
+			// write to a temporary file first, such that concurrent runs never read a partially written cache
+			string tmpFilename = filename + ".tmp";
+			ofstream ost(tmpFilename.c_str(), ios::out | ios::binary | ios::trunc);
+			if(!ost.is_open()) {
+				logger.newError() << "Could not write the prepared GTS to cache file '" << tmpFilename << "'." << endLogMessage;
+				return false;
+			}
+
+			writeString(ost, PREPARED_GTS_CACHE_MAGIC);
+			write<uint32_t>(ost, PREPARED_GTS_CACHE_VERSION);
+			write<uint64_t>(ost, key);
+			write<uint8_t>(ost, gts.optimize);
+
+			// original rules are identified by their position when ordered by ID
+			vector<Rule_csp> originals = gts.getSortedOriginalRules();
+			unordered_map<IDType, uint32_t> originalIndex;
+			write<uint32_t>(ost, originals.size());
+			for(size_t i = 0; i < originals.size(); ++i) {
+				originalIndex[originals[i]->getID()] = i;
+				writeString(ost, originals[i]->getName());
+			}
+			map<IDType, UQRule_sp> uqRules(gts.getUQRules().cbegin(), gts.getUQRules().cend());
+			write<uint32_t>(ost, uqRules.size());
+			for(auto it = uqRules.cbegin(); it != uqRules.cend(); ++it) {
+				writeString(ost, it->second->getName());
+			}
+
+			// prepared rules are written in the order of their IDs, which is the order they were added in
+			map<IDType, Rule_sp> prepared(gts.getStdRules().cbegin(), gts.getStdRules().cend());
+			write<uint32_t>(ost, prepared.size());
+			for(auto it = prepared.cbegin(); it != prepared.cend(); ++it) {
+				vector<uint32_t> origins;
+				if(gts.prepFrom.count(it->first)) {
+					for(IDType id : gts.prepFrom.at(it->first)) {
+						if(originalIndex.count(id)) {
+							origins.push_back(originalIndex[id]);
+						}
+					}
+				}
+				write<uint32_t>(ost, origins.size());
+				for(uint32_t index : origins) {
+					write<uint32_t>(ost, index);
+				}
+				writeRule(ost, *it->second);
+			}
+
+			// the UQRuleInstances and their canonical forms are written for every UQRule
+			{
+				lock_guard<mutex> lock(gts.instanceMutex);
+				for(auto it = uqRules.cbegin(); it != uqRules.cend(); ++it) {
+
+					auto instIt = gts.preparedInstances.find(it->first);
+					write<uint32_t>(ost, instIt == gts.preparedInstances.end() ? 0 : instIt->second.size());
+					if(instIt != gts.preparedInstances.end()) {
+						for(auto quantIt = instIt->second.cbegin(); quantIt != instIt->second.cend(); ++quantIt) {
+							write<uint32_t>(ost, quantIt->first.size());
+							for(unsigned int q : quantIt->first) {
+								write<uint32_t>(ost, q);
+							}
+							write<uint32_t>(ost, quantIt->second.size());
+							for(UQRuleInstance_sp const& inst : quantIt->second) {
+								writeRule(ost, *inst);
+								writeIDs(ost, inst->getLeftUQVertices());
+								writeIDs(ost, inst->getRightUQVertices());
+							}
+						}
+					}
+
+					auto formIt = gts.instanceForms.find(it->first);
+					write<uint32_t>(ost, formIt == gts.instanceForms.end() ? 0 : formIt->second.size());
+					if(formIt != gts.instanceForms.end()) {
+						for(auto sumIt = formIt->second.cbegin(); sumIt != formIt->second.cend(); ++sumIt) {
+							write<uint32_t>(ost, sumIt->first);
+							write<uint32_t>(ost, sumIt->second.size());
+							for(string const& form : sumIt->second) {
+								writeString(ost, form);
+							}
+						}
+					}
+				}
+			}
+
+			ost.close();
+			if(ost.fail() || rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+				logger.newError() << "Could not write the prepared GTS to cache file '" << filename << "'." << endLogMessage;
+				remove(tmpFilename.c_str());
+				return false;
+			}
+
+			logger.newUserInfo() << "Stored the prepared GTS in cache file '" << filename << "'." << endLogMessage;
+			return true;
+		}
+
+		string PreparedGTSCache::getFilename() const {
+			return filename;
+		}
+
+		uint64_t PreparedGTSCache::getKey() const {
+			return key;
+		}
+
+		PreparedGTS_sp PreparedGTSCache::readFrom(istream& ist, GTS const& gts, RulePreparer_sp rulePrep, bool opt) const {
+
+			if(readString(ist).compare(PREPARED_GTS_CACHE_MAGIC)) {
+				throw InvalidInputException("The file was not written by a PreparedGTSCache.");
+			}
+			if(read<uint32_t>(ist) != PREPARED_GTS_CACHE_VERSION || read<uint64_t>(ist) != key
+					|| read<uint8_t>(ist) != (uint8_t)opt) {
+				return nullptr;
+			}
+
+			// the original rules have to match the given GTS
+			map<IDType, Rule_sp> originals(gts.getStdRules().cbegin(), gts.getStdRules().cend());
+			vector<IDType> originalIDs;
+			if(read<uint32_t>(ist) != originals.size()) {
+				return nullptr;
+			}
+			for(auto it = originals.cbegin(); it != originals.cend(); ++it) {
+				if(readString(ist).compare(it->second->getName())) {
+					return nullptr;
+				}
+				originalIDs.push_back(it->first);
+			}
+			map<IDType, UQRule_sp> uqRules(gts.getUQRules().cbegin(), gts.getUQRules().cend());
+			if(read<uint32_t>(ist) != uqRules.size()) {
+				return nullptr;
+			}
+			for(auto it = uqRules.cbegin(); it != uqRules.cend(); ++it) {
+				if(readString(ist).compare(it->second->getName())) {
+					return nullptr;
+				}
+			}
+
+			// restore prepared rules
+			vector<Rule_sp> preparedRules;
+			vector<vector<IDType>> preparedFrom;
+			uint32_t ruleCount = read<uint32_t>(ist);
+			for(uint32_t i = 0; i < ruleCount; ++i) {
+				preparedFrom.push_back(vector<IDType>());
+				uint32_t originCount = read<uint32_t>(ist);
+				for(uint32_t j = 0; j < originCount; ++j) {
+					uint32_t index = read<uint32_t>(ist);
+					if(index >= originalIDs.size()) {
+						throw InvalidInputException("A prepared rule references an unknown original rule.");
+					}
+					preparedFrom.back().push_back(originalIDs[index]);
+				}
+				string name;
+				AnonHypergraph_sp left, right;
+				Mapping mapping;
+				Translation leftIDs, rightIDs;
+				readRule(ist, name, left, right, mapping, leftIDs, rightIDs);
+				preparedRules.push_back(make_shared<Rule>(name, left, right, mapping));
+			}
+
+			if(rulePrep) {
+				rulePrep->setOptimization(opt);
+			}
+			PreparedGTS_sp result(new PreparedGTS(gts, rulePrep, opt, preparedRules, preparedFrom));
+
+			// restore UQRuleInstances and their canonical forms
+			for(auto it = uqRules.cbegin(); it != uqRules.cend(); ++it) {
+
+				uint32_t quantCount = read<uint32_t>(ist);
+				for(uint32_t i = 0; i < quantCount; ++i) {
+					vector<unsigned int> quantities;
+					uint32_t length = read<uint32_t>(ist);
+					for(uint32_t j = 0; j < length; ++j) {
+						quantities.push_back(read<uint32_t>(ist));
+					}
+					vector<UQRuleInstance_sp>& instances = result->preparedInstances[it->first][quantities];
+					uint32_t instCount = read<uint32_t>(ist);
+					for(uint32_t j = 0; j < instCount; ++j) {
+						string name;
+						AnonHypergraph_sp left, right;
+						Mapping mapping;
+						Translation leftIDs, rightIDs;
+						readRule(ist, name, left, right, mapping, leftIDs, rightIDs);
+						unordered_set<IDType> leftUQ = readIDs(ist, leftIDs);
+						unordered_set<IDType> rightUQ = readIDs(ist, rightIDs);
+						instances.push_back(make_shared<UQRuleInstance>(name, left, right, mapping, leftUQ, rightUQ));
+					}
+				}
+
+				uint32_t sumCount = read<uint32_t>(ist);
+				for(uint32_t i = 0; i < sumCount; ++i) {
+					unordered_set<string>& forms = result->instanceForms[it->first][read<uint32_t>(ist)];
+					uint32_t formCount = read<uint32_t>(ist);
+					for(uint32_t j = 0; j < formCount; ++j) {
+						forms.insert(readString(ist));
+					}
+				}
+			}
+
+			return result;
+		}
+
+		template<typename T>
+		void PreparedGTSCache::write(ostream& ost, T value) {
+			ost.write(reinterpret_cast<char const*>(&value), sizeof(T));
+		}
+
+		template<typename T>
+		T PreparedGTSCache::read(istream& ist) {
+			T value;
+			if(!ist.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+				throw InvalidInputException("The file ended unexpectedly.");
+			}
+			return value;
+		}
+
+		void PreparedGTSCache::writeString(ostream& ost, string const& s) {
+			write<uint32_t>(ost, s.size());
+			ost.write(s.data(), s.size());
+		}
+
+		string PreparedGTSCache::readString(istream& ist) {
+			uint32_t length = read<uint32_t>(ist);
+			string result;
+			// read in chunks, such that a corrupted length does not allocate huge amounts of memory
+			char buffer[4096];
+			while(length > 0) {
+				uint32_t chunk = min<uint32_t>(length, sizeof(buffer));
+				if(!ist.read(buffer, chunk)) {
+					throw InvalidInputException("The file ended unexpectedly.");
+				}
+				result.append(buffer, chunk);
+				length -= chunk;
+			}
+			return result;
+		}
+
+		void PreparedGTSCache::writeRule(ostream& ost, AnonRule const& rule) {
+			writeString(ost, rule.getName());
+			writeGraph(ost, *rule.getLeft());
+			writeGraph(ost, *rule.getRight());
+			Mapping const& mapping = rule.getMapping();
+			write<uint32_t>(ost, distance(mapping.cbegin(), mapping.cend()));
+			for(auto it = mapping.cbegin(); it != mapping.cend(); ++it) {
+				write<uint32_t>(ost, it->first);
+				write<uint32_t>(ost, it->second);
+			}
+		}
+
+		void PreparedGTSCache::readRule(istream& ist,
+				string& name,
+				AnonHypergraph_sp& left,
+				AnonHypergraph_sp& right,
+				Mapping& mapping,
+				Translation& leftIDs,
+				Translation& rightIDs) {
+
+			name = readString(ist);
+			left = readGraph(ist, leftIDs);
+			right = readGraph(ist, rightIDs);
+			uint32_t count = read<uint32_t>(ist);
+			for(uint32_t i = 0; i < count; ++i) {
+				IDType src = translate(leftIDs, read<uint32_t>(ist));
+				mapping[src] = translate(rightIDs, read<uint32_t>(ist));
+			}
+		}
+
+		void PreparedGTSCache::writeGraph(ostream& ost, AnonHypergraph const& graph) {
+			writeString(ost, graph.getName());
+			write<uint32_t>(ost, graph.getVertexCount());
+			for(auto it = graph.cbeginVertices(); it != graph.cendVertices(); ++it) {
+				write<uint32_t>(ost, it->first);
+			}
+			write<uint32_t>(ost, graph.getEdgeCount());
+			for(auto it = graph.cbeginEdges(); it != graph.cendEdges(); ++it) {
+				write<uint32_t>(ost, it->first);
+				writeString(ost, it->second.getLabel());
+				write<uint32_t>(ost, it->second.getArity());
+				for(auto vit = it->second.cbeginV(); vit != it->second.cendV(); ++vit) {
+					write<uint32_t>(ost, *vit);
+				}
+			}
+		}
+
+		AnonHypergraph_sp PreparedGTSCache::readGraph(istream& ist, Translation& ids) {
+			AnonHypergraph_sp graph = make_shared<AnonHypergraph>(readString(ist));
+			uint32_t vertexCount = read<uint32_t>(ist);
+			for(uint32_t i = 0; i < vertexCount; ++i) {
+				IDType id = read<uint32_t>(ist);
+				ids[id] = graph->addVertex();
+			}
+			uint32_t edgeCount = read<uint32_t>(ist);
+			for(uint32_t i = 0; i < edgeCount; ++i) {
+				IDType id = read<uint32_t>(ist);
+				string label = readString(ist);
+				vector<IDType> vertices;
+				uint32_t arity = read<uint32_t>(ist);
+				for(uint32_t j = 0; j < arity; ++j) {
+					vertices.push_back(translate(ids, read<uint32_t>(ist)));
+				}
+				ids[id] = graph->addEdge(label, vertices);
+			}
+			return graph;
+		}
+
+		void PreparedGTSCache::writeIDs(ostream& ost, unordered_set<IDType> const& ids) {
+			write<uint32_t>(ost, ids.size());
+			for(IDType id : ids) {
+				write<uint32_t>(ost, id);
+			}
+		}
+
+		unordered_set<IDType> PreparedGTSCache::readIDs(istream& ist, Translation const& translation) {
+			unordered_set<IDType> result;
+			uint32_t count = read<uint32_t>(ist);
+			for(uint32_t i = 0; i < count; ++i) {
+				result.insert(translate(translation, read<uint32_t>(ist)));
+			}
+			return result;
+		}
+
+		IDType PreparedGTSCache::translate(Translation const& translation, IDType id) {
+			auto it = translation.find(id);
+			if(it == translation.end()) {
+				throw InvalidInputException("The file references an unknown vertex or edge.");
+			}
+			return it->second;
+		}
+
+	} /* namespace analysis */
+} /* namespace uncover */
@@ -0,0 +1,239 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef PREPAREDGTSCACHE_H_
+#define PREPAREDGTSCACHE_H_
+
+#include <istream>
+#include <ostream>
+#include "PreparedGTS.h"
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * The PreparedGTSCache stores a PreparedGTS in a binary file and restores it in later runs, such that the
+		 * (possibly expensive) rule preparation is only done once for the same input. The cache contains the
+		 * prepared standard rules, the rules they were prepared from and all UQRuleInstances prepared so far. The
+		 * file is identified by a key, which should be computed by createKey(...) from the input GTS and all
+		 * settings influencing the preparation. A file with a different key is never loaded. The file format
+		 * depends on the platform and is only meant to be read on the machine which wrote it.
+		 * @author Jan Stückrath
+		 * @see PreparedGTS
+		 */
+		class PreparedGTSCache {
+
+			public:
+
+				/**
+				 * Creates a new PreparedGTSCache using the given file and key.
+				 * @param filename the file storing the cached PreparedGTS
+				 * @param key the key identifying the input from which the PreparedGTS was generated
+				 */
+				PreparedGTSCache(string filename, uint64_t key);
+
+				/**
+				 * Destroys this PreparedGTSCache.
+				 */
+				virtual ~PreparedGTSCache();
+
+				/**
+				 * Computes a key from the content of the given GTXL file and the given settings. Settings should
+				 * contain everything influencing the rule preparation, e.g. the order and the matching.
+				 * @param gtsFile the GTXL file from which the GTS is read
+				 * @param settings the settings used for the analysis
+				 * @return the key of the given input
+				 * @throws InvalidInputException if the given file cannot be read
+				 */
+				static uint64_t createKey(string gtsFile, vector<string> const& settings);
+
+				/**
+				 * Restores the PreparedGTS of the given GTS from the cache file. If the file does not exist, was
+				 * written with another key or optimization setting or does not match the given GTS, a null pointer
+				 * is returned.
+				 * @param gts the GTS from which the cached PreparedGTS was prepared
+				 * @param rulePrep the RulePreparer used for preparing further UQRuleInstances
+				 * @param opt the optimization setting of the PreparedGTS
+				 * @return the restored PreparedGTS or a null pointer, if the cache cannot be used
+				 */
+				PreparedGTS_sp load(graphs::GTS const& gts, RulePreparer_sp rulePrep, bool opt = true) const;
+
+				/**
+				 * Writes the given PreparedGTS to the cache file, replacing any earlier content.
+				 * @param gts the PreparedGTS to be stored
+				 * @return true, iff the PreparedGTS was written successfully
+				 */
+				bool store(PreparedGTS& gts) const;
+
+				/**
+				 * Returns the file storing the cached PreparedGTS.
+				 * @return the file storing the cached PreparedGTS
+				 */
+				string getFilename() const;
+
+				/**
+				 * Returns the key identifying the input from which the PreparedGTS was generated.
+				 * @return the key of this cache
+				 */
+				uint64_t getKey() const;
+
+			private:
+
+				/**
+				 * Maps IDs of a stored graph to the IDs of the restored graph.
+				 */
+				typedef unordered_map<IDType, IDType> Translation;
+
+				/**
+				 * Writes the given value in binary form to the given stream.
+				 * @param ost the stream to write to
+				 * @param value the value to be written
+				 */
+				template<typename T>
+				static void write(std::ostream& ost, T value);
+
+				/**
+				 * Reads a value in binary form from the given stream.
+				 * @param ist the stream to read from
+				 * @return the read value
+				 * @throws InvalidInputException if the stream ended prematurely
+				 */
+				template<typename T>
+				static T read(std::istream& ist);
+
+				/**
+				 * Writes the given string to the given stream.
+				 * @param ost the stream to write to
+				 * @param s the string to be written
+				 */
+				static void writeString(std::ostream& ost, string const& s);
+
+				/**
+				 * Reads a string written by writeString(...) from the given stream.
+				 * @param ist the stream to read from
+				 * @return the read string
+				 * @throws InvalidInputException if the stream ended prematurely
+				 */
+				static string readString(std::istream& ist);
+
+				/**
+				 * Writes the given rule (name, both sides and mapping) to the given stream.
+				 * @param ost the stream to write to
+				 * @param rule the rule to be written
+				 */
+				static void writeRule(std::ostream& ost, graphs::AnonRule const& rule);
+
+				/**
+				 * Reads the parts of a rule written by writeRule(...) from the given stream. The restored graphs get
+				 * new IDs, which are stored in the given Translations.
+				 * @param ist the stream to read from
+				 * @param name is set to the name of the rule
+				 * @param left is set to the left-hand side of the rule
+				 * @param right is set to the right-hand side of the rule
+				 * @param mapping is set to the mapping of the rule
+				 * @param leftIDs is filled with the new IDs of the left-hand side
+				 * @param rightIDs is filled with the new IDs of the right-hand side
+				 * @throws InvalidInputException if the stream is corrupted
+				 */
+				static void readRule(std::istream& ist,
+						string& name,
+						graphs::AnonHypergraph_sp& left,
+						graphs::AnonHypergraph_sp& right,
+						graphs::Mapping& mapping,
+						Translation& leftIDs,
+						Translation& rightIDs);
+
+				/**
+				 * Writes the given graph to the given stream.
+				 * @param ost the stream to write to
+				 * @param graph the graph to be written
+				 */
+				static void writeGraph(std::ostream& ost, graphs::AnonHypergraph const& graph);
+
+				/**
+				 * Reads a graph written by writeGraph(...) from the given stream.
+				 * @param ist the stream to read from
+				 * @param ids is filled with the new ID of every stored vertex and edge
+				 * @return the restored graph
+				 * @throws InvalidInputException if the stream is corrupted
+				 */
+				static graphs::AnonHypergraph_sp readGraph(std::istream& ist, Translation& ids);
+
+				/**
+				 * Writes the given set of IDs to the given stream.
+				 * @param ost the stream to write to
+				 * @param ids the IDs to be written
+				 */
+				static void writeIDs(std::ostream& ost, unordered_set<IDType> const& ids);
+
+				/**
+				 * Reads a set of IDs written by writeIDs(...) and translates it using the given Translation.
+				 * @param ist the stream to read from
+				 * @param translation the Translation applied to every read ID
+				 * @return the translated set of IDs
+				 * @throws InvalidInputException if the stream is corrupted
+				 */
+				static unordered_set<IDType> readIDs(std::istream& ist, Translation const& translation);
+
+				/**
+				 * Returns the translation of the given ID.
+				 * @param translation the Translation to be used
+				 * @param id the ID to be translated
+				 * @return the translated ID
+				 * @throws InvalidInputException if the ID is unknown
+				 */
+				static IDType translate(Translation const& translation, IDType id);
+
+				/**
+				 * Restores the PreparedGTS from the given stream (see load(...)).
+				 * @param ist the stream to read from
+				 * @param gts the GTS from which the cached PreparedGTS was prepared
+				 * @param rulePrep the RulePreparer used for preparing further UQRuleInstances
+				 * @param opt the optimization setting of the PreparedGTS
+				 * @return the restored PreparedGTS or a null pointer, if the cache does not match
+				 * @throws InvalidInputException if the stream is corrupted
+				 */
+				PreparedGTS_sp readFrom(std::istream& ist, graphs::GTS const& gts, RulePreparer_sp rulePrep, bool opt) const;
+
+				/**
+				 * Stores the file containing the cached PreparedGTS.
+				 */
+				string filename;
+
+				/**
+				 * Stores the key identifying the input from which the PreparedGTS was generated.
+				 */
+				uint64_t key;
+
+		};
+
+		/**
+		 * Alias of a shared pointer to a PreparedGTSCache.
+		 */
+		typedef shared_ptr<PreparedGTSCache> PreparedGTSCache_sp;
+
+		/**
+		 * Alias of a shared pointer to a constant PreparedGTSCache.
+		 */
+		typedef shared_ptr<PreparedGTSCache const> PreparedGTSCache_csp;
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* PREPAREDGTSCACHE_H_ */
@@ -76,7 +76,7 @@ namespace uncover {
 				 * Sets whether the rule preparation will be optimized, i.e. the number of produced rules will be minimized.
 				 * @param opt true, iff the rule preparation should be optimized
 				 */
-				void setOptimization(bool opt) { optimize = true; }
+				void setOptimization(bool opt) { optimize = opt; }
 
 				/**
 				 * Returns whether the rule preparation will be optimized, i.e. the number if produced ruless will be
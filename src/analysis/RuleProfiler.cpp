@@ -0,0 +1,223 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "RuleProfiler.h"
+#include "../logging/message_logging.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace uncover::graphs;
+using namespace uncover::logging;
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * Formats the given time span as seconds with millisecond precision.
+		 * @param nanoseconds the time span in nanoseconds
+		 * @return the formatted time span
+		 */
+		static string formatSeconds(uint64_t nanoseconds) {
+			stringstream ss;
+			ss << fixed << setprecision(3) << (nanoseconds / 1e9) << "s";
+			return ss.str();
+		}
+
+		RuleProfile::RuleProfile(IDType ruleID, string name, bool quantified)
+				: ruleID(ruleID),
+				  name(name),
+				  quantified(quantified),
+				  applications(0),
+				  resetTime(0),
+				  enumerationTime(0),
+				  produced(0),
+				  survived(0),
+				  droppedByBound(0) {}
+
+		void RuleProfile::add(RuleProfile const& profile) {
+			applications += profile.applications;
+			resetTime += profile.resetTime;
+			enumerationTime += profile.enumerationTime;
+			produced += profile.produced;
+			survived += profile.survived;
+			droppedByBound += profile.droppedByBound;
+		}
+
+		/**
+		 * Returns the given share of the value, if the value is split evenly into the given number of shares.
+		 * @param value the value to be split
+		 * @param share the index of the returned share
+		 * @param shares the number of shares
+		 * @return the share of the value, where remainders are assigned to the shares with the smallest indices
+		 */
+		static uint64_t getShare(uint64_t value, size_t share, size_t shares) {
+			return value / shares + ((share < value % shares) ? 1 : 0);
+		}
+
+		void RuleProfile::addShare(RuleProfile const& profile, size_t share, size_t shares) {
+			applications += getShare(profile.applications, share, shares);
+			resetTime += getShare(profile.resetTime, share, shares);
+			enumerationTime += getShare(profile.enumerationTime, share, shares);
+			produced += getShare(profile.produced, share, shares);
+			survived += getShare(profile.survived, share, shares);
+			droppedByBound += getShare(profile.droppedByBound, share, shares);
+		}
+
+		uint64_t RuleProfile::getTotalTime() const {
+			return resetTime + enumerationTime;
+		}
+
+		RuleProfiler::RuleProfiler() : gts(nullptr), stdProfiles(), uqProfiles() {}
+
+		RuleProfiler::~RuleProfiler() {}
+
+		void RuleProfiler::setPreparedGTS(PreparedGTS_csp gts) {
+			this->gts = gts;
+			stdProfiles.clear();
+			uqProfiles.clear();
+		}
+
+		RuleProfile& RuleProfiler::getStdRuleProfile(IDType ruleID) {
+			auto it = stdProfiles.find(ruleID);
+			if(it == stdProfiles.end()) {
+				string name = "";
+				if(gts && gts->getStdRules().count(ruleID)) {
+					name = gts->getStdRules().at(ruleID)->getName();
+				}
+				it = stdProfiles.insert(make_pair(ruleID, RuleProfile(ruleID, name, false))).first;
+			}
+			return it->second;
+		}
+
+		RuleProfile& RuleProfiler::getUQRuleProfile(IDType ruleID) {
+			auto it = uqProfiles.find(ruleID);
+			if(it == uqProfiles.end()) {
+				string name = "";
+				if(gts && gts->getUQRules().count(ruleID)) {
+					name = gts->getUQRules().at(ruleID)->getName();
+				}
+				it = uqProfiles.insert(make_pair(ruleID, RuleProfile(ruleID, name, true))).first;
+			}
+			return it->second;
+		}
+
+		vector<RuleProfile> RuleProfiler::getPreparedProfiles() const {
+			vector<RuleProfile> result;
+			for(auto it = stdProfiles.cbegin(); it != stdProfiles.cend(); ++it) {
+				result.push_back(it->second);
+			}
+			for(auto it = uqProfiles.cbegin(); it != uqProfiles.cend(); ++it) {
+				result.push_back(it->second);
+			}
+			sortByTime(result);
+			return result;
+		}
+
+		vector<RuleProfile> RuleProfiler::getOriginalProfiles() const {
+			unordered_map<IDType,RuleProfile> originals;
+			vector<RuleProfile> result;
+			for(auto it = stdProfiles.cbegin(); it != stdProfiles.cend(); ++it) {
+				shared_ptr<vector<AnonRule_csp>> origRules = nullptr;
+				if(gts) {
+					origRules = gts->getOriginalRules(it->first);
+				}
+				vector<Rule_csp> sources;
+				if(origRules) {
+					for(auto ruleIt = origRules->cbegin(); ruleIt != origRules->cend(); ++ruleIt) {
+						Rule_csp origRule = dynamic_pointer_cast<Rule const>(*ruleIt);
+						if(origRule) {
+							sources.push_back(origRule);
+						}
+					}
+				}
+				// the costs of a prepared rule are split among its original rules, such that they are not counted
+				// multiple times
+				for(size_t i = 0; i < sources.size(); ++i) {
+					auto origIt = originals.find(sources[i]->getID());
+					if(origIt == originals.end()) {
+						origIt = originals.insert(make_pair(sources[i]->getID(),
+								RuleProfile(sources[i]->getID(), sources[i]->getName(), false))).first;
+					}
+					origIt->second.addShare(it->second, i, sources.size());
+				}
+				// keep the prepared rule if no original rule is known
+				if(sources.empty()) {
+					result.push_back(it->second);
+				}
+			}
+			for(auto it = originals.cbegin(); it != originals.cend(); ++it) {
+				result.push_back(it->second);
+			}
+			// universally quantified rules are not prepared
+			for(auto it = uqProfiles.cbegin(); it != uqProfiles.cend(); ++it) {
+				result.push_back(it->second);
+			}
+			sortByTime(result);
+			return result;
+		}
+
+		void RuleProfiler::logReport() const {
+			vector<RuleProfile> original = getOriginalProfiles();
+			RuleProfile total;
+			for(auto it = stdProfiles.cbegin(); it != stdProfiles.cend(); ++it) {
+				total.add(it->second);
+			}
+			for(auto it = uqProfiles.cbegin(); it != uqProfiles.cend(); ++it) {
+				total.add(it->second);
+			}
+			logger.newUserInfo() << "Rule profile: " << (stdProfiles.size() + uqProfiles.size()) << " applied rules needed ";
+			logger.contMsg() << formatSeconds(total.getTotalTime()) << " and produced " << total.produced;
+			logger.contMsg() << " graphs (" << total.survived << " not subsumed, " << total.droppedByBound;
+			logger.contMsg() << " dropped by bound)." << endLogMessage;
+			for(auto it = original.cbegin(); it != original.cend(); ++it) {
+				logger.newUserInfo() << "  " << (it->quantified ? "UQ rule " : "Rule ") << it->ruleID;
+				if(!it->name.empty()) {
+					logger.contMsg() << " '" << it->name << "'";
+				}
+				logger.contMsg() << ": " << it->applications << " applications, " << formatSeconds(it->resetTime) << " reset, ";
+				logger.contMsg() << formatSeconds(it->enumerationTime) << " enumeration, ";
+				logger.contMsg() << it->produced << " produced, " << it->survived << " not subsumed, ";
+				logger.contMsg() << it->droppedByBound << " dropped by bound" << endLogMessage;
+			}
+		}
+
+		void RuleProfiler::writeCSV(ostream& ost) const {
+			ost << "kind,id,name,quantified,applications,reset_ns,enumeration_ns,produced,survived,dropped_by_bound\n";
+			vector<RuleProfile> original = getOriginalProfiles();
+			vector<RuleProfile> prepared = getPreparedProfiles();
+			for(size_t i = 0; i < 2; ++i) {
+				vector<RuleProfile>& profiles = (i == 0) ? original : prepared;
+				for(auto it = profiles.cbegin(); it != profiles.cend(); ++it) {
+					ost << ((i == 0) ? "original," : "prepared,") << it->ruleID << ",\"" << it->name << "\",";
+					ost << (it->quantified ? "true," : "false,") << it->applications << "," << it->resetTime << ",";
+					ost << it->enumerationTime << "," << it->produced << "," << it->survived << "," << it->droppedByBound << "\n";
+				}
+			}
+		}
+
+		void RuleProfiler::sortByTime(vector<RuleProfile>& profiles) {
+			stable_sort(profiles.begin(), profiles.end(), [](RuleProfile const& p1, RuleProfile const& p2) {
+				return p1.getTotalTime() > p2.getTotalTime();
+			});
+		}
+
+	} /* namespace analysis */
+} /* namespace uncover */
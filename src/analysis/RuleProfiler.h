@@ -0,0 +1,223 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef RULEPROFILER_H_
+#define RULEPROFILER_H_
+
+#include <ostream>
+#include <cstdint>
+#include "PreparedGTS.h"
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * Stores the costs caused by the backward application of a single rule.
+		 * @author Jan Stückrath
+		 */
+		struct RuleProfile {
+
+			/**
+			 * Creates a new, empty RuleProfile for the given rule.
+			 * @param ruleID the ID of the profiled rule
+			 * @param name the name of the profiled rule
+			 * @param quantified true, iff the profiled rule is a universally quantified rule
+			 */
+			RuleProfile(IDType ruleID = 0, string name = "", bool quantified = false);
+
+			/**
+			 * Adds all costs of the given profile to this profile.
+			 * @param profile the profile whose costs will be added
+			 */
+			void add(RuleProfile const& profile);
+
+			/**
+			 * Adds one share of all costs of the given profile to this profile, if the costs are split evenly into
+			 * the given number of shares. Remainders of the division are assigned to the shares with the smallest
+			 * indices, hence the costs added for all shares sum up to the costs of the given profile.
+			 * @param profile the profile whose costs will be split
+			 * @param share the index of the share to be added; has to be smaller than shares
+			 * @param shares the number of shares into which the costs are split; has to be greater than 0
+			 */
+			void addShare(RuleProfile const& profile, size_t share, size_t shares);
+
+			/**
+			 * Returns the sum of the time needed to reset the enumerator and to enumerate all pushout complements.
+			 * @return the total time (in nanoseconds) spent for this rule
+			 */
+			uint64_t getTotalTime() const;
+
+			/**
+			 * The ID of the profiled rule.
+			 */
+			IDType ruleID;
+
+			/**
+			 * The name of the profiled rule.
+			 */
+			string name;
+
+			/**
+			 * Is true, iff the profiled rule is a universally quantified rule.
+			 */
+			bool quantified;
+
+			/**
+			 * The number of times the rule (or one of its instances) was applied backwards to a graph.
+			 */
+			uint64_t applications;
+
+			/**
+			 * The time (in nanoseconds) spent resetting the MinPOCEnumerator with this rule.
+			 */
+			uint64_t resetTime;
+
+			/**
+			 * The time (in nanoseconds) spent enumerating and minimizing pushout complements of this rule.
+			 */
+			uint64_t enumerationTime;
+
+			/**
+			 * The number of pushout complements produced for this rule.
+			 */
+			uint64_t produced;
+
+			/**
+			 * The number of produced pushout complements which were not subsumed when added to the MinGraphList.
+			 */
+			uint64_t survived;
+
+			/**
+			 * The number of pushout complements dropped by the MinPOCEnumerator because of a bound (e.g. the path
+			 * bound of the subgraph order).
+			 */
+			uint64_t droppedByBound;
+
+		};
+
+		/**
+		 * The RuleProfiler collects a RuleProfile for every prepared rule and universally quantified rule used during a
+		 * backward search. The profiles of the prepared rules can be folded back to the rules of the original GTS.
+		 * @author Jan Stückrath
+		 * @see RuleProfile
+		 */
+		class RuleProfiler {
+
+			public:
+
+				/**
+				 * Creates a new RuleProfiler without any profiles.
+				 */
+				RuleProfiler();
+
+				/**
+				 * Destroys this RuleProfiler.
+				 */
+				virtual ~RuleProfiler();
+
+				/**
+				 * Sets the PreparedGTS whose rules are profiled. All previously collected profiles are removed.
+				 * @param gts the PreparedGTS whose rules are profiled
+				 */
+				void setPreparedGTS(PreparedGTS_csp gts);
+
+				/**
+				 * Returns the profile of the prepared standard rule with the given ID. The profile is created if it
+				 * does not exist.
+				 * @param ruleID the ID of a standard rule of the PreparedGTS
+				 * @return the profile of the given rule
+				 */
+				RuleProfile& getStdRuleProfile(IDType ruleID);
+
+				/**
+				 * Returns the profile of the universally quantified rule with the given ID. The costs of all instances
+				 * are accumulated in this profile. The profile is created if it does not exist.
+				 * @param ruleID the ID of a universally quantified rule of the PreparedGTS
+				 * @return the profile of the given rule
+				 */
+				RuleProfile& getUQRuleProfile(IDType ruleID);
+
+				/**
+				 * Returns the profiles of all prepared standard rules and universally quantified rules, sorted by total
+				 * time (descending).
+				 * @return the profiles of all prepared rules
+				 */
+				vector<RuleProfile> getPreparedProfiles() const;
+
+				/**
+				 * Returns the profiles of all original standard rules and universally quantified rules, sorted by total
+				 * time (descending). The profile of an original rule is the sum of the profiles of all prepared rules
+				 * generated from it. Since a prepared rule may originate from several (non-isomorphic) original rules,
+				 * its costs are split evenly among them, such that the profiles of all original rules sum up to the
+				 * costs actually spent.
+				 * @return the profiles of all original rules
+				 */
+				vector<RuleProfile> getOriginalProfiles() const;
+
+				/**
+				 * Writes the profiles of all original rules to the logger (one message per rule) and a line
+				 * summarizing all prepared rules.
+				 */
+				void logReport() const;
+
+				/**
+				 * Writes the profiles of all original and prepared rules as CSV to the given stream.
+				 * @param ost the stream to which the profiles are written
+				 */
+				void writeCSV(std::ostream& ost) const;
+
+			private:
+
+				/**
+				 * Sorts the given profiles by total time (descending).
+				 * @param profiles the profiles to be sorted
+				 */
+				static void sortByTime(vector<RuleProfile>& profiles);
+
+				/**
+				 * Stores the PreparedGTS whose rules are profiled.
+				 */
+				PreparedGTS_csp gts;
+
+				/**
+				 * Maps the IDs of prepared standard rules to their profiles.
+				 */
+				unordered_map<IDType,RuleProfile> stdProfiles;
+
+				/**
+				 * Maps the IDs of universally quantified rules to their profiles.
+				 */
+				unordered_map<IDType,RuleProfile> uqProfiles;
+
+		};
+
+		/**
+		 * Alias for a shared pointer to a RuleProfiler.
+		 */
+		typedef shared_ptr<RuleProfiler> RuleProfiler_sp;
+
+		/**
+		 * Alias for a shared pointer to a constant RuleProfiler.
+		 */
+		typedef shared_ptr<RuleProfiler const> RuleProfiler_csp;
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* RULEPROFILER_H_ */
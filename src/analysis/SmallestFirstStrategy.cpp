@@ -0,0 +1,62 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "SmallestFirstStrategy.h"
+
+using namespace uncover::graphs;
+
+namespace uncover {
+	namespace analysis {
+
+		SmallestFirstStrategy::SmallestFirstStrategy() : queue() {}
+
+		SmallestFirstStrategy::~SmallestFirstStrategy() {}
+
+		void SmallestFirstStrategy::add(Hypergraph_sp graph) {
+			queue.push(std::make_tuple(computePriority(*graph),
+					graph->getVertexCount() + graph->getEdgeCount(), graph->getID(), graph));
+		}
+
+		Hypergraph_sp SmallestFirstStrategy::next() {
+			if(queue.empty()) {
+				return nullptr;
+			}
+			Hypergraph_sp result = std::get<3>(queue.top());
+			queue.pop();
+			return result;
+		}
+
+		size_t SmallestFirstStrategy::size() const {
+			return queue.size();
+		}
+
+		void SmallestFirstStrategy::clear() {
+			queue = std::priority_queue<Entry, vector<Entry>, EntryGreater>();
+		}
+
+		string SmallestFirstStrategy::getName() const {
+			return "smallest";
+		}
+
+		double SmallestFirstStrategy::computePriority(Hypergraph const& graph) const {
+			return graph.getVertexCount() + graph.getEdgeCount();
+		}
+
+	} /* namespace analysis */
+} /* namespace uncover */
@@ -0,0 +1,99 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef SMALLESTFIRSTSTRATEGY_H_
+#define SMALLESTFIRSTSTRATEGY_H_
+
+#include "ExplorationStrategy.h"
+#include <queue>
+#include <tuple>
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * This strategy processes the graphs of a backward step ordered by a priority, starting with the lowest
+		 * priority. The priority of a graph is its number of vertices and edges, i.e. small graphs are processed
+		 * first. Since small graphs tend to have small predecessors, which subsume many of the larger graphs not
+		 * processed yet, more graphs can be skipped. Graphs with equal priority are ordered by their size and
+		 * their ID. Subclasses may define other priorities by overwriting computePriority(...).
+		 * @author Jan Stückrath
+		 */
+		class SmallestFirstStrategy : public ExplorationStrategy {
+
+			public:
+
+				/**
+				 * Creates a new SmallestFirstStrategy.
+				 */
+				SmallestFirstStrategy();
+
+				/**
+				 * Destroys this SmallestFirstStrategy.
+				 */
+				virtual ~SmallestFirstStrategy();
+
+				virtual void add(graphs::Hypergraph_sp graph) override;
+
+				virtual graphs::Hypergraph_sp next() override;
+
+				virtual size_t size() const override;
+
+				virtual void clear() override;
+
+				virtual string getName() const override;
+
+			protected:
+
+				/**
+				 * Computes the priority of the given graph. Graphs with lower priority are processed first.
+				 * @param graph the graph of which the priority is computed
+				 * @return the priority of the given graph
+				 */
+				virtual double computePriority(graphs::Hypergraph const& graph) const;
+
+			private:
+
+				/**
+				 * An entry of the priority queue, consisting of the priority, the size and the ID of a graph and
+				 * the graph itself.
+				 */
+				typedef std::tuple<double, size_t, IDType, graphs::Hypergraph_sp> Entry;
+
+				/**
+				 * Orders the entries such that the entry with the lowest priority is at the top of the queue.
+				 */
+				struct EntryGreater {
+					bool operator()(Entry const& e1, Entry const& e2) const {
+						return std::tie(std::get<0>(e1), std::get<1>(e1), std::get<2>(e1))
+								> std::tie(std::get<0>(e2), std::get<1>(e2), std::get<2>(e2));
+					}
+				};
+
+				/**
+				 * Stores the graphs which still have to be processed.
+				 */
+				std::priority_queue<Entry, vector<Entry>, EntryGreater> queue;
+
+		};
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* SMALLESTFIRSTSTRATEGY_H_ */
@@ -0,0 +1,76 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "UpwardClosureChecker.h"
+
+using namespace uncover::basic_types;
+using namespace uncover::graphs;
+using namespace std;
+
+namespace uncover {
+	namespace analysis {
+
+		MembershipResult::MembershipResult() : checked(false), covered(false), coveringIndex(0), orderChecks(0) {}
+
+		UpwardClosureChecker::UpwardClosureChecker(
+				Order_csp order,
+				vector<Hypergraph_sp> const& minimalGraphs,
+				bool useInvariants) : order(order), index(minimalGraphs, IS_Smaller, useInvariants) {}
+
+		UpwardClosureChecker::~UpwardClosureChecker() {}
+
+		MembershipResult UpwardClosureChecker::check(Hypergraph const& graph) const {
+
+			MembershipResult result;
+			result.checked = true;
+
+			// smaller graphs are cheaper to compare and more likely to represent other graphs, hence they are tried first
+			size_t pos = index.findFirst(graph, [&](size_t candidate) {
+				++result.orderChecks;
+				return order->isLessOrEq(*index.getGraph(candidate), graph);
+			});
+			if(pos < index.size()) {
+				result.covered = true;
+				result.coveringIndex = pos;
+			}
+
+			return result;
+		}
+
+		vector<MembershipResult> UpwardClosureChecker::checkAll(
+				vector<Hypergraph_sp> const& graphs,
+				unsigned int threadCount,
+				bool stopAtFirstCovered) const {
+
+			vector<MembershipResult> results(graphs.size());
+			GraphInvariantIndex::runParallel(graphs.size(), threadCount, [&](size_t i, atomic<size_t>& bound) {
+				results[i] = check(*graphs[i]);
+				if(stopAtFirstCovered && results[i].covered) {
+					bound.store(0);
+				}
+			});
+			return results;
+		}
+
+		size_t UpwardClosureChecker::getMinimalGraphCount() const {
+			return index.size();
+		}
+
+	} /* namespace analysis */
+} /* namespace uncover */
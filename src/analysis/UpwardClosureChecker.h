@@ -0,0 +1,141 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef UPWARDCLOSURECHECKER_H_
+#define UPWARDCLOSURECHECKER_H_
+
+#include <vector>
+#include "GraphInvariantIndex.h"
+#include "../basic_types/Order.h"
+#include "../graphs/Hypergraph.h"
+
+namespace uncover {
+	namespace analysis {
+
+		/**
+		 * Stores the result of checking whether a single graph is represented by an upward-closed set of graphs.
+		 * @see UpwardClosureChecker
+		 * @author Jan Stückrath
+		 */
+		struct MembershipResult {
+
+			/**
+			 * Creates a new MembershipResult of an unchecked graph.
+			 */
+			MembershipResult();
+
+			/**
+			 * Is true iff the graph was checked. This is only false if the check was aborted early.
+			 */
+			bool checked;
+
+			/**
+			 * Is true iff the graph is represented by (i.e. larger or equal to) one of the minimal graphs.
+			 */
+			bool covered;
+
+			/**
+			 * The position of the representing minimal graph in the list given to the UpwardClosureChecker. Only
+			 * meaningful if covered is true.
+			 */
+			size_t coveringIndex;
+
+			/**
+			 * The number of calls to the order needed for this graph.
+			 */
+			size_t orderChecks;
+
+		};
+
+		/**
+		 * An UpwardClosureChecker decides for (possibly many) graphs whether they are contained in an upward-closed
+		 * set of graphs given by its minimal elements. To avoid most calls to the (expensive) order, the minimal graphs
+		 * are stored in a GraphInvariantIndex. A minimal graph is only compared to a graph, if none of its invariants
+		 * is larger than in the graph (see GraphInvariantIndex for the restrictions on the order).
+		 * @author Jan Stückrath
+		 * @see GraphInvariantIndex
+		 */
+		class UpwardClosureChecker {
+
+			public:
+
+				/**
+				 * Creates a new UpwardClosureChecker for the upward-closed set represented by the given minimal graphs.
+				 * The order has to be thread-safe if graphs are checked by several threads.
+				 * @param order the order used to compare graphs
+				 * @param minimalGraphs the minimal graphs of the upward-closed set
+				 * @param useInvariants if true (default), minimal graphs are pruned by invariants before calling the order
+				 */
+				UpwardClosureChecker(
+						basic_types::Order_csp order,
+						vector<graphs::Hypergraph_sp> const& minimalGraphs,
+						bool useInvariants = true);
+
+				/**
+				 * Destroys this UpwardClosureChecker.
+				 */
+				virtual ~UpwardClosureChecker();
+
+				/**
+				 * Checks whether the given graph is represented by one of the minimal graphs. The check stops at the
+				 * first representing minimal graph. Smaller minimal graphs are tried first.
+				 * @param graph the graph to be checked
+				 * @return the result of the check
+				 */
+				MembershipResult check(graphs::Hypergraph const& graph) const;
+
+				/**
+				 * Checks for all given graphs whether they are represented by one of the minimal graphs. The graphs are
+				 * distributed among the given number of threads. The result of each graph does not depend on the number
+				 * of threads.
+				 * @param graphs the graphs to be checked
+				 * @param threadCount the number of threads used; if 0, the number of hardware threads is used
+				 * @param stopAtFirstCovered if true, no further graphs will be checked after the first represented graph
+				 * 		was found; the remaining results are marked as not checked
+				 * @return a vector containing the result for each graph at the same position as the graph
+				 */
+				vector<MembershipResult> checkAll(
+						vector<graphs::Hypergraph_sp> const& graphs,
+						unsigned int threadCount = 0,
+						bool stopAtFirstCovered = false) const;
+
+				/**
+				 * Returns the number of minimal graphs.
+				 * @return the number of minimal graphs
+				 */
+				size_t getMinimalGraphCount() const;
+
+			private:
+
+				/**
+				 * The order used to compare graphs.
+				 */
+				basic_types::Order_csp order;
+
+				/**
+				 * The minimal graphs indexed by their invariants.
+				 */
+				GraphInvariantIndex index;
+
+		};
+
+	} /* namespace analysis */
+} /* namespace uncover */
+
+#endif /* UPWARDCLOSURECHECKER_H_ */
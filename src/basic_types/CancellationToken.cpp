@@ -0,0 +1,87 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "CancellationToken.h"
+#include "CancelledException.h"
+#include <limits>
+
+using namespace std;
+
+namespace uncover {
+	namespace basic_types {
+
+		CancellationToken::CancellationToken()
+			: cancelled(false),
+			  deadline(numeric_limits<Clock::rep>::max()) {}
+
+		CancellationToken::~CancellationToken() {}
+
+		void CancellationToken::cancel() {
+			cancelled.store(true);
+		}
+
+		void CancellationToken::setDeadline(Clock::time_point deadline) {
+			this->deadline.store(deadline.time_since_epoch().count());
+		}
+
+		void CancellationToken::setTimeout(Clock::duration timeout) {
+			setDeadline(Clock::now() + timeout);
+		}
+
+		void CancellationToken::clearDeadline() {
+			deadline.store(numeric_limits<Clock::rep>::max());
+		}
+
+		bool CancellationToken::hasDeadline() const {
+			return deadline.load() != numeric_limits<Clock::rep>::max();
+		}
+
+		CancellationToken::Clock::time_point CancellationToken::getDeadline() const {
+			return Clock::time_point(Clock::duration(deadline.load()));
+		}
+
+		bool CancellationToken::isCancelled() const {
+			if(cancelled.load(memory_order_relaxed)) {
+				return true;
+			}
+			// the clock is only read if a deadline is set
+			Clock::rep limit = deadline.load(memory_order_relaxed);
+			return limit != numeric_limits<Clock::rep>::max() && Clock::now().time_since_epoch().count() >= limit;
+		}
+
+		bool CancellationToken::wasCancelledExplicitly() const {
+			return cancelled.load();
+		}
+
+		void CancellationToken::throwIfCancelled() const {
+			if(cancelled.load(memory_order_relaxed)) {
+				throw CancelledException("The computation was cancelled.");
+			}
+			if(isCancelled()) {
+				throw CancelledException("The computation reached its deadline.");
+			}
+		}
+
+		void CancellationToken::reset() {
+			cancelled.store(false);
+			clearDeadline();
+		}
+
+	} /* namespace basic_types */
+} /* namespace uncover */
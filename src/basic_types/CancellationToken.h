@@ -0,0 +1,142 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef CANCELLATIONTOKEN_H_
+#define CANCELLATIONTOKEN_H_
+
+#include "globals.h"
+#include <atomic>
+#include <chrono>
+
+namespace uncover {
+	namespace basic_types {
+
+		/**
+		 * A CancellationToken is shared by a long running computation and its caller, who can stop the computation
+		 * by cancelling the token or by setting a deadline. The deadline is measured with a monotonic clock of high
+		 * resolution. The token itself does not stop anything; the computations check it at bounded intervals in
+		 * their inner loops and throw a CancelledException as soon as it is cancelled. All functions may be called
+		 * concurrently, e.g. the token can be cancelled from another thread.
+		 * @author Jan Stückrath
+		 * @see CancelledException
+		 */
+		class CancellationToken {
+
+			public:
+
+				/**
+				 * The clock used for the deadline.
+				 */
+				typedef std::chrono::steady_clock Clock;
+
+				/**
+				 * Generates a new CancellationToken, which is neither cancelled nor has a deadline.
+				 */
+				CancellationToken();
+
+				/**
+				 * Destroys this CancellationToken.
+				 */
+				virtual ~CancellationToken();
+
+				/**
+				 * Cancels this token. Every computation checking this token will stop at its next check.
+				 */
+				void cancel();
+
+				/**
+				 * Sets the deadline of this token. As soon as the deadline is reached, the token counts as cancelled.
+				 * @param deadline the point in time at which the token is cancelled
+				 */
+				void setDeadline(Clock::time_point deadline);
+
+				/**
+				 * Sets the deadline of this token to the given time from now on.
+				 * @param timeout the time after which the token is cancelled
+				 */
+				void setTimeout(Clock::duration timeout);
+
+				/**
+				 * Removes the deadline of this token. An explicit cancellation is not undone.
+				 */
+				void clearDeadline();
+
+				/**
+				 * Returns true, iff this token has a deadline.
+				 * @return true, iff this token has a deadline
+				 */
+				bool hasDeadline() const;
+
+				/**
+				 * Returns the deadline of this token. If no deadline is set, the result is the maximal time point.
+				 * @return the deadline of this token
+				 */
+				Clock::time_point getDeadline() const;
+
+				/**
+				 * Returns true, iff this token was cancelled explicitly or its deadline was reached.
+				 * @return true, iff the computations using this token should stop
+				 */
+				bool isCancelled() const;
+
+				/**
+				 * Returns true, iff this token was cancelled explicitly (see cancel()), independent of its deadline.
+				 * @return true, iff this token was cancelled explicitly
+				 */
+				bool wasCancelledExplicitly() const;
+
+				/**
+				 * Throws a CancelledException, iff this token was cancelled explicitly or its deadline was reached.
+				 * @exception CancelledException if the computations using this token should stop
+				 */
+				void throwIfCancelled() const;
+
+				/**
+				 * Resets this token, such that it is neither cancelled nor has a deadline.
+				 */
+				void reset();
+
+			private:
+
+				/**
+				 * Stores whether this token was cancelled explicitly.
+				 */
+				std::atomic<bool> cancelled;
+
+				/**
+				 * Stores the deadline as number of clock ticks since the epoch of the clock. The maximal value
+				 * represents that no deadline is set.
+				 */
+				std::atomic<Clock::rep> deadline;
+
+		};
+
+		/**
+		 * Alias for a shared pointer to a CancellationToken.
+		 */
+		typedef shared_ptr<CancellationToken> CancellationToken_sp;
+
+		/**
+		 * Alias for a shared pointer to a constant CancellationToken.
+		 */
+		typedef shared_ptr<CancellationToken const> CancellationToken_csp;
+
+	} /* namespace basic_types */
+} /* namespace uncover */
+#endif /* CANCELLATIONTOKEN_H_ */
@@ -0,0 +1,53 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef CANCELLEDEXCEPTION_H_
+#define CANCELLEDEXCEPTION_H_
+
+#include "GenericMessageException.h"
+
+namespace uncover {
+	namespace basic_types {
+
+		/**
+		 * This exception is thrown if a computation was stopped, because its CancellationToken was cancelled or
+		 * its deadline was reached. The interrupted computation did not produce a result.
+		 * @author Jan Stückrath
+		 * @see CancellationToken
+		 */
+		class CancelledException: public GenericMessageException {
+
+			public:
+
+				/**
+				 * Generates a new CancelledException with the given message as body.
+				 * @param messageBody the exception message
+				 */
+				CancelledException(string messageBody);
+
+				/**
+				 * Destroys the CancelledException instance.
+				 */
+				virtual ~CancelledException() throw ();
+
+		};
+
+	} /* namespace basic_types */
+} /* namespace uncover */
+#endif /* CANCELLEDEXCEPTION_H_ */
@@ -59,6 +59,8 @@ namespace uncover {
 
 		IDPartitionEnumerator::IDPartitionEnumerator() :
 				current(0),
+				first(0),
+				stride(1),
 				lastNew(0),
 				genPartitionsVec(new vector<IDPartition*>),
 				genPartitionsSet(new unordered_set<IDPartition*, IDPartitionPointerHasher, IDPartitionPointerEquality>),
@@ -66,6 +68,8 @@ namespace uncover {
 
 		IDPartitionEnumerator::IDPartitionEnumerator(IDPartitionEnumerator&& oldEnum) :
 			current(oldEnum.current),
+			first(oldEnum.first),
+			stride(oldEnum.stride),
 			lastNew(oldEnum.lastNew),
 			genPartitionsVec(oldEnum.genPartitionsVec),
 			genPartitionsSet(oldEnum.genPartitionsSet),
@@ -145,13 +149,49 @@ namespace uncover {
 
 		void IDPartitionEnumerator::reset() {
 			throwIfNotValid();
-			current = 0;
+			current = first;
 		}
 
 		IDPartitionEnumerator& IDPartitionEnumerator::operator++() {
 
 			throwIfNotValid();
 
+			for(size_t i = 0; i < stride && !this->ended(); ++i) {
+				step();
+			}
+
+			return *this;
+		}
+
+		IDPartitionEnumerator IDPartitionEnumerator::split() {
+
+			throwIfNotValid();
+
+			// copy all partitions generated so far, since both enumerators generate further partitions independently
+			IDPartitionEnumerator other;
+			for(vector<IDPartition*>::const_iterator it = genPartitionsVec->cbegin(); it != genPartitionsVec->cend(); ++it) {
+				IDPartition* copy = new IDPartition(**it);
+				other.genPartitionsVec->push_back(copy);
+				other.genPartitionsSet->insert(copy);
+			}
+			other.current = current;
+			other.lastNew = lastNew;
+
+			// the other enumerator starts with the element following the current one, afterwards both enumerators
+			// skip the elements enumerated by the other one
+			for(size_t i = 0; i < stride && !other.ended(); ++i) {
+				other.step();
+			}
+			other.first = other.current;
+			first = current;
+			stride *= 2;
+			other.stride = stride;
+
+			return other;
+		}
+
+		void IDPartitionEnumerator::step() {
+
 			if(this->ended()) {
 				// do nothing
 			} else if(current < lastNew) {
@@ -187,8 +227,6 @@ namespace uncover {
 				++current;
 				++lastNew;
 			}
-
-			return *this;
 		}
 
 		IDPartition const& IDPartitionEnumerator::operator*() const {
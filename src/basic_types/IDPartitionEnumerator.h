@@ -107,7 +107,8 @@ namespace uncover {
 				bool ended() const;
 
 				/**
-				 * Resets this enumerator to start the enumeration process from the first element.
+				 * Resets this enumerator to start the enumeration process from the first element. If the enumerator
+				 * was split, the enumeration restarts from the element which was current at the last split.
 				 */
 				void reset();
 
@@ -132,6 +133,18 @@ namespace uncover {
 				 */
         IDPartition const& operator*() const;
 
+				/**
+				 * Splits the remaining enumeration of this enumerator into two independent parts. The returned
+				 * enumerator enumerates every second remaining element starting with the element following the
+				 * current one, while this enumerator keeps the current element and every second element after it.
+				 * Hence, both enumerators together enumerate every remaining element exactly once and may be used
+				 * by different threads. Since the IDPartitions are generated lazily, the returned enumerator gets
+				 * its own copy of all IDPartitions generated so far. If there is no element following the current
+				 * one, the returned enumerator has already ended.
+				 * @return an enumerator enumerating half of the remaining elements
+				 */
+				IDPartitionEnumerator split();
+
 			private:
 
         /**
@@ -145,11 +158,27 @@ namespace uncover {
 				 */
 				void throwIfNotValid() const;
 
+				/**
+				 * Computes the IDPartition directly following the current one, ignoring the stride.
+				 */
+				void step();
+
 				/**
 				 * Stores at which index of genPartitionsVec the current IDPartition is stored.
 				 */
 				size_t current;
 
+				/**
+				 * Stores the index of the element at which the enumeration restarts when calling reset().
+				 */
+				size_t first;
+
+				/**
+				 * Stores the distance of two consecutive elements enumerated by this enumerator. This is 1 unless the
+				 * enumerator was split.
+				 */
+				size_t stride;
+
 				/**
 				 * Stores the index of the first element of genPartitionsVec which was not already used to
 				 * create more coarse IDPartitions.
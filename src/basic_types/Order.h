@@ -21,12 +21,14 @@
 #define ORDER_H_
 
 #include "../graphs/Hypergraph.h"
+#include "CancellationToken.h"
 
 namespace uncover {
 	namespace basic_types {
 
 		/**
-		 * This class presents a generic ordering relation on Hypergraphs.
+		 * This class presents a generic ordering relation on Hypergraphs. A CancellationToken can be set, which is
+		 * checked while comparing two graphs; if it is cancelled, the comparison throws a CancelledException.
 		 * @author Jan Stückrath
 		 */
 		class Order {
@@ -39,9 +41,23 @@ namespace uncover {
 				 * @param smaller the Hypergraph which should be smaller
 				 * @param bigger the Hypergraph which should be larger
 				 * @return true iff the first Hypergraph is smaller than or equal to the second
+				 * @exception CancelledException if the set CancellationToken was cancelled during the comparison
 				 */
 				virtual bool isLessOrEq(graphs::Hypergraph const& smaller, graphs::Hypergraph const& bigger) const = 0;
 
+				/**
+				 * Sets the CancellationToken checked while comparing graphs. A null pointer (default) deactivates
+				 * the checks.
+				 * @param token the CancellationToken to be checked or a null pointer
+				 */
+				virtual void setCancellationToken(CancellationToken_csp token) { cancellation = token; }
+
+				/**
+				 * Returns the CancellationToken checked while comparing graphs or a null pointer, if there is none.
+				 * @return the CancellationToken checked while comparing graphs
+				 */
+				CancellationToken_csp getCancellationToken() const { return cancellation; }
+
 				/**
 				 * Destroys this Order object.
 				 */
@@ -52,7 +68,12 @@ namespace uncover {
 				/**
 				 * Calling this constructor except from a subclass, will produce problems with the virtual functions.
 				 */
-				Order() {};
+				Order() : cancellation(nullptr) {};
+
+				/**
+				 * Stores the CancellationToken checked while comparing graphs.
+				 */
+				CancellationToken_csp cancellation;
 
 		};
 
@@ -58,7 +58,10 @@ namespace uncover {
 				 * @return a reference to the given stream
 				 */
 				friend std::ostream& operator<< (std::ostream& ost, uncover::basic_types::Streamable const& data) {
-					data.streamTo(ost);
+					// skip formatting if the stream discards everything anyway (e.g. disabled log messages)
+					if(ost.good()) {
+						data.streamTo(ost);
+					}
 					return ost;
 				}
 
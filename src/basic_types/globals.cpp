@@ -21,6 +21,7 @@
 #include <time.h>
 #include <iomanip>
 #include <limits.h>
+#include <atomic>
 #include "OutOfIDsException.h"
 
 using namespace uncover::basic_types;
@@ -57,34 +58,43 @@ namespace uncover {
 	/**
 	 * Stores the last ID used for a graph. DO NOT MODIFY!
 	 */
-	IDType gl_LastUsedStateID = 1;
+	std::atomic<IDType> gl_LastUsedStateID(1);
 
 	IDType gl_getNewStateID() {
-		if(gl_LastUsedStateID == IDType_MAX)
-			throw OutOfIDsException("The program has run out of unique state IDs and has to be terminated.");
-		return gl_LastUsedStateID++;
+		IDType id = gl_LastUsedStateID.load();
+		do {
+			if(id == IDType_MAX)
+				throw OutOfIDsException("The program has run out of unique state IDs and has to be terminated.");
+		} while(!gl_LastUsedStateID.compare_exchange_weak(id, id + 1));
+		return id;
 	}
 
 	/**
 	 * Stores the last ID used for a rule. DO NOT MODIFY!
 	 */
-	IDType gl_LastUsedRuleID = 1;
+	std::atomic<IDType> gl_LastUsedRuleID(1);
 
 	IDType gl_getNewRuleID() {
-		if(gl_LastUsedRuleID == IDType_MAX)
-			throw OutOfIDsException("The program has run out of unique rule IDs and has to be terminated.");
-		return gl_LastUsedRuleID++;
+		IDType id = gl_LastUsedRuleID.load();
+		do {
+			if(id == IDType_MAX)
+				throw OutOfIDsException("The program has run out of unique rule IDs and has to be terminated.");
+		} while(!gl_LastUsedRuleID.compare_exchange_weak(id, id + 1));
+		return id;
 	}
 
 	/**
 	 * Stores the last ID used for a (backward) application of a rule. DO NOT MODIFY!
 	 */
-	IDType gl_LastUsedStepID = 1;
+	std::atomic<IDType> gl_LastUsedStepID(1);
 
 	IDType gl_getNewStepID() {
-		if(gl_LastUsedStepID == IDType_MAX)
-			throw OutOfIDsException("The program has run out of unique transition step IDs and has to be terminated.");
-		return gl_LastUsedStepID++;
+		IDType id = gl_LastUsedStepID.load();
+		do {
+			if(id == IDType_MAX)
+				throw OutOfIDsException("The program has run out of unique transition step IDs and has to be terminated.");
+		} while(!gl_LastUsedStepID.compare_exchange_weak(id, id + 1));
+		return id;
 	}
 
 }
@@ -27,6 +27,7 @@
 #include <unordered_set>
 #include <memory>
 #include <map>
+#include <cstdint>
 
 // the included data structures can be used without explicit using statement
 using std::string;
@@ -96,7 +97,7 @@ namespace uncover {
 		/**
 		 * PartSig is a Signature of an element of a graph. It is used as part of the Signature type.
 		 */
-		typedef unsigned int PartSig;
+		typedef uint64_t PartSig;
 
 		/**
 		 * HGSignature represents a Signature calculated from a Hypergraph. If two Hypergraphs are
@@ -109,6 +110,7 @@ namespace uncover {
 	/**
 	 * This method returns a new unique ID for a state of a verification instance.
 	 * The ID may intersect with ID's generated by gl_getNewRuleID() and gl_getNewStepID().
+	 * This function is thread-safe.
 	 * @return an ID not used by any other state
 	 */
 	IDType gl_getNewStateID();
@@ -116,6 +118,7 @@ namespace uncover {
 	/**
 	 * This method returns a new unique ID for a transformation rule of a verification instance.
 	 * The ID may intersect with ID's generated by gl_getNewStateID() and gl_getNewStepID().
+	 * This function is thread-safe.
 	 * @return an ID not used by any other rule
 	 */
 	IDType gl_getNewRuleID();
@@ -123,6 +126,7 @@ namespace uncover {
 	/**
 	 * This method returns a new unique ID for a single verification step of a verification instance.
 	 * The ID may intersect with ID's generated by gl_getNewStateID() and gl_getNewRuleID().
+	 * This function is thread-safe.
 	 * @return an ID not used by any other step
 	 */
 	IDType gl_getNewStepID();
@@ -27,6 +27,9 @@ namespace std {
 	 * Defines the stream operator for unordered maps.
 	 */
 	template <typename K, typename V> ostream& operator<<(ostream& ost, unordered_map<K,V> const& mapping) {
+		if(!ost.good()) {
+			return ost;
+		}
 		typename unordered_map<K,V>::const_iterator iter = mapping.cbegin();
 		ost << "(";
 		while(iter != mapping.cend()) {
@@ -41,6 +44,9 @@ namespace std {
 	 * Defines the stream operator for parameterized vectors.
 	 */
 	template <typename T> ostream& operator<<(ostream& ost, vector<T> const& vec) {
+		if(!ost.good()) {
+			return ost;
+		}
 		typename vector<T>::const_iterator iter = vec.cbegin();
 		ost << "(";
 		if(iter != vec.cend()) {
@@ -59,6 +65,9 @@ namespace std {
 	 * Defines the stream operator for parameterized vectors.
 	 */
 	template <typename T> ostream& operator<<(ostream& ost, unordered_set<T> const& vec) {
+		if(!ost.good()) {
+			return ost;
+		}
 		typename unordered_set<T>::const_iterator iter = vec.cbegin();
 		ost << "(";
 		if(iter != vec.cend()) {
@@ -0,0 +1,131 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifdef COMPILE_BENCHMARKS
+
+#include "BenchmarkSuite.h"
+#include "allocation_counting.h"
+#include "../basic_types/InvalidInputException.h"
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+using namespace uncover::basic_types;
+
+namespace uncover {
+	namespace bench {
+
+		BenchmarkSuite::BenchmarkSuite(double minTime, unsigned int repetitions)
+				: minTime(minTime), repetitions((repetitions == 0) ? 1 : repetitions), benchmarks() {}
+
+		BenchmarkSuite::~BenchmarkSuite() {}
+
+		void BenchmarkSuite::add(string const& name, std::function<void()> operation) {
+			for(auto it = benchmarks.cbegin(); it != benchmarks.cend(); ++it) {
+				if(it->first == name) {
+					throw InvalidInputException("A benchmark with the name '" + name + "' already exists.");
+				}
+			}
+			benchmarks.push_back(make_pair(name, operation));
+		}
+
+		vector<string> BenchmarkSuite::getNames() const {
+			vector<string> names;
+			for(auto it = benchmarks.cbegin(); it != benchmarks.cend(); ++it) {
+				names.push_back(it->first);
+			}
+			return names;
+		}
+
+		vector<BenchmarkResult> BenchmarkSuite::run(string const& filter) const {
+			vector<BenchmarkResult> results;
+			for(auto it = benchmarks.cbegin(); it != benchmarks.cend(); ++it) {
+				if(it->first.find(filter) != string::npos) {
+					results.push_back(measure(it->first, it->second));
+				}
+			}
+			return results;
+		}
+
+		BenchmarkResult BenchmarkSuite::measure(string const& name, std::function<void()> const& operation) const {
+
+			typedef chrono::steady_clock clock;
+
+			// warm up and calibrate the number of iterations
+			operation();
+			uint64_t iterations = 1;
+			while(true) {
+				auto start = clock::now();
+				for(uint64_t i = 0; i < iterations; ++i) {
+					operation();
+				}
+				double elapsed = chrono::duration<double>(clock::now() - start).count();
+				if(elapsed >= minTime || iterations >= (uint64_t(1) << 40)) {
+					break;
+				}
+				iterations *= 2;
+			}
+
+			// measure all repetitions
+			vector<double> times;
+			uint64_t allocations = 0;
+			for(unsigned int rep = 0; rep < repetitions; ++rep) {
+				uint64_t allocStart = getAllocationCount();
+				auto start = clock::now();
+				for(uint64_t i = 0; i < iterations; ++i) {
+					operation();
+				}
+				auto end = clock::now();
+				allocations += getAllocationCount() - allocStart;
+				times.push_back(chrono::duration<double,nano>(end - start).count() / iterations);
+			}
+			sort(times.begin(), times.end());
+
+			BenchmarkResult result;
+			result.name = name;
+			result.iterations = iterations;
+			result.nsPerOp = times[times.size() / 2];
+			result.minNsPerOp = times.front();
+			result.allocsPerOp = double(allocations) / (double(iterations) * repetitions);
+			return result;
+		}
+
+		void BenchmarkSuite::writeJSON(ostream& ost, vector<BenchmarkResult> const& results) {
+			ost << "{\n  \"benchmarks\": [";
+			for(auto it = results.cbegin(); it != results.cend(); ++it) {
+				ost << ((it == results.cbegin()) ? "\n" : ",\n");
+				ost << "    {\"name\": \"" << it->name << "\", \"iterations\": " << it->iterations;
+				ost << ", \"ns_per_op\": " << it->nsPerOp << ", \"min_ns_per_op\": " << it->minNsPerOp;
+				ost << ", \"allocs_per_op\": " << it->allocsPerOp << "}";
+			}
+			ost << "\n  ]\n}\n";
+		}
+
+		void BenchmarkSuite::writeCSV(ostream& ost, vector<BenchmarkResult> const& results) {
+			ost << "name,iterations,ns_per_op,min_ns_per_op,allocs_per_op\n";
+			for(auto it = results.cbegin(); it != results.cend(); ++it) {
+				ost << it->name << "," << it->iterations << "," << it->nsPerOp << "," << it->minNsPerOp;
+				ost << "," << it->allocsPerOp << "\n";
+			}
+		}
+
+	}
+}
+
+#endif
@@ -0,0 +1,155 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifdef COMPILE_BENCHMARKS
+
+#ifndef BENCHMARKSUITE_H_
+#define BENCHMARKSUITE_H_
+
+#include <ostream>
+#include <functional>
+#include <cstdint>
+#include "../basic_types/globals.h"
+
+namespace uncover {
+	namespace bench {
+
+		/**
+		 * Stores the measurements of a single benchmark.
+		 * @author Jan Stückrath
+		 */
+		struct BenchmarkResult {
+
+			/**
+			 * The name of the benchmark.
+			 */
+			string name;
+
+			/**
+			 * The number of operations executed per repetition.
+			 */
+			uint64_t iterations;
+
+			/**
+			 * The median time (in nanoseconds) needed per operation over all repetitions.
+			 */
+			double nsPerOp;
+
+			/**
+			 * The smallest time (in nanoseconds) needed per operation over all repetitions.
+			 */
+			double minNsPerOp;
+
+			/**
+			 * The number of allocations performed per operation.
+			 */
+			double allocsPerOp;
+
+		};
+
+		/**
+		 * A BenchmarkSuite stores a list of named operations and measures the time and number of allocations needed
+		 * to execute each of them. The number of iterations is doubled until a repetition runs for at least the
+		 * minimal time; afterwards the given number of repetitions is measured and the median is reported.
+		 * @author Jan Stückrath
+		 */
+		class BenchmarkSuite {
+
+			public:
+
+				/**
+				 * Creates a new, empty BenchmarkSuite.
+				 * @param minTime the minimal time (in seconds) each repetition of a benchmark should run
+				 * @param repetitions the number of repetitions measured for each benchmark
+				 */
+				BenchmarkSuite(double minTime = 0.2, unsigned int repetitions = 5);
+
+				/**
+				 * Destroys this BenchmarkSuite.
+				 */
+				virtual ~BenchmarkSuite();
+
+				/**
+				 * Adds a benchmark to this suite. The operation should perform exactly one unit of work; all setup
+				 * should be done before adding the benchmark.
+				 * @param name the unique name of the benchmark
+				 * @param operation the operation to be measured
+				 */
+				void add(string const& name, std::function<void()> operation);
+
+				/**
+				 * Returns the names of all benchmarks in the order they were added.
+				 * @return the names of all benchmarks
+				 */
+				vector<string> getNames() const;
+
+				/**
+				 * Runs all benchmarks whose name contains the given filter and returns their results.
+				 * @param filter only benchmarks whose name contains this string are executed (empty string for all)
+				 * @return the results of all executed benchmarks
+				 */
+				vector<BenchmarkResult> run(string const& filter) const;
+
+				/**
+				 * Writes the given results as JSON document to the given stream.
+				 * @param ost the stream to which the results are written
+				 * @param results the results to be written
+				 */
+				static void writeJSON(std::ostream& ost, vector<BenchmarkResult> const& results);
+
+				/**
+				 * Writes the given results as CSV (including a header line) to the given stream.
+				 * @param ost the stream to which the results are written
+				 * @param results the results to be written
+				 */
+				static void writeCSV(std::ostream& ost, vector<BenchmarkResult> const& results);
+
+			private:
+
+				/**
+				 * Measures a single benchmark.
+				 * @param name the name of the benchmark
+				 * @param operation the operation to be measured
+				 * @return the measurements
+				 */
+				BenchmarkResult measure(string const& name, std::function<void()> const& operation) const;
+
+				/**
+				 * The minimal time (in seconds) each repetition should run.
+				 */
+				double minTime;
+
+				/**
+				 * The number of repetitions measured for each benchmark.
+				 */
+				unsigned int repetitions;
+
+				/**
+				 * Stores all benchmarks in the order they were added.
+				 */
+				vector<pair<string,std::function<void()>>> benchmarks;
+
+		};
+
+	}
+}
+
+#endif /* BENCHMARKSUITE_H_ */
+
+#endif
@@ -0,0 +1,70 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifdef COMPILE_BENCHMARKS
+
+#include "RandomGraphGenerator.h"
+#include "../basic_types/InvalidInputException.h"
+#include <sstream>
+
+using namespace std;
+using namespace uncover::graphs;
+using namespace uncover::basic_types;
+
+namespace uncover {
+	namespace bench {
+
+		RandomGraphGenerator::RandomGraphGenerator(unsigned int seed) : engine(seed) {}
+
+		RandomGraphGenerator::~RandomGraphGenerator() {}
+
+		Hypergraph_sp RandomGraphGenerator::generate(size_t vertexCount, size_t edgeCount, size_t labelCount, size_t arity) {
+
+			if(labelCount == 0 || labelCount > 26 || arity == 0 || (vertexCount == 0 && edgeCount > 0)) {
+				throw InvalidInputException("Invalid parameters for the generation of a random graph.");
+			}
+
+			stringstream name;
+			name << "random(" << vertexCount << "," << edgeCount << ")";
+			Hypergraph_sp graph = make_shared<Hypergraph>(name.str());
+
+			vector<IDType> vertices;
+			for(size_t i = 0; i < vertexCount; ++i) {
+				vertices.push_back(graph->addVertex());
+			}
+
+			uniform_int_distribution<size_t> labelDist(0, labelCount - 1);
+			uniform_int_distribution<size_t> vertexDist(0, (vertexCount == 0) ? 0 : vertexCount - 1);
+			for(size_t i = 0; i < edgeCount; ++i) {
+				size_t label = labelDist(engine);
+				size_t labelArity = 1 + (label + arity - 1) % arity;
+				vector<IDType> attached;
+				for(size_t j = 0; j < labelArity; ++j) {
+					attached.push_back(vertices[vertexDist(engine)]);
+				}
+				graph->addEdge(string(1, char('A' + label)), attached);
+			}
+
+			return graph;
+		}
+
+	}
+}
+
+#endif
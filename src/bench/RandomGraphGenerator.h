@@ -0,0 +1,80 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifdef COMPILE_BENCHMARKS
+
+#ifndef RANDOMGRAPHGENERATOR_H_
+#define RANDOMGRAPHGENERATOR_H_
+
+#include <random>
+#include "../graphs/Hypergraph.h"
+
+namespace uncover {
+	namespace bench {
+
+		/**
+		 * Generates random hypergraphs. The generator is seeded explicitly, such that the same sequence of graphs is
+		 * generated on every run and benchmarks are reproducible.
+		 * @author Jan Stückrath
+		 */
+		class RandomGraphGenerator {
+
+			public:
+
+				/**
+				 * Creates a new RandomGraphGenerator with the given seed.
+				 * @param seed the seed of the random number engine
+				 */
+				RandomGraphGenerator(unsigned int seed);
+
+				/**
+				 * Destroys this RandomGraphGenerator.
+				 */
+				virtual ~RandomGraphGenerator();
+
+				/**
+				 * Generates a new random hypergraph. All edges with the same label have the same arity. The i-th label
+				 * (starting with 0) is the i-th capital letter and has arity 1 + (i + arity - 1) % arity, i.e. the first
+				 * label has the given arity. Attached vertices are chosen uniformly (with repetition).
+				 * @param vertexCount the number of vertices of the generated graph (at least 1 if edges are generated)
+				 * @param edgeCount the number of edges of the generated graph
+				 * @param labelCount the number of different labels (between 1 and 26)
+				 * @param arity the maximal arity of the edges
+				 * @return the generated graph
+				 */
+				graphs::Hypergraph_sp generate(size_t vertexCount,
+						size_t edgeCount,
+						size_t labelCount = 2,
+						size_t arity = 2);
+
+			private:
+
+				/**
+				 * The random number engine used.
+				 */
+				std::mt19937 engine;
+
+		};
+
+	}
+}
+
+#endif /* RANDOMGRAPHGENERATOR_H_ */
+
+#endif
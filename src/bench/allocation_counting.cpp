@@ -0,0 +1,74 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifdef COMPILE_BENCHMARKS
+
+#include "allocation_counting.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace uncover {
+	namespace bench {
+
+		/**
+		 * Counts all calls of the replaced allocation functions.
+		 */
+		static std::atomic<uint64_t> allocationCount(0);
+
+		uint64_t getAllocationCount() {
+			return allocationCount.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * Allocates the given number of bytes and counts the allocation.
+		 * @param size the number of bytes to allocate
+		 * @return a pointer to the allocated memory
+		 */
+		static void* countedAllocation(std::size_t size) {
+			allocationCount.fetch_add(1, std::memory_order_relaxed);
+			void* ptr = std::malloc(size == 0 ? 1 : size);
+			if(!ptr) {
+				throw std::bad_alloc();
+			}
+			return ptr;
+		}
+
+	}
+}
+
+// replacements of the global allocation functions
+
+void* operator new(std::size_t size) {
+	return uncover::bench::countedAllocation(size);
+}
+
+void* operator new[](std::size_t size) {
+	return uncover::bench::countedAllocation(size);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+#endif
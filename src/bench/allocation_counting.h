@@ -0,0 +1,42 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifdef COMPILE_BENCHMARKS
+
+#ifndef ALLOCATION_COUNTING_H_
+#define ALLOCATION_COUNTING_H_
+
+#include <cstdint>
+
+namespace uncover {
+	namespace bench {
+
+		/**
+		 * Returns the number of calls to the global operator new (including the array version) since program start.
+		 * Only available in the benchmark executable, where the global allocation functions are replaced.
+		 * @return the number of allocations performed so far
+		 */
+		uint64_t getAllocationCount();
+
+	}
+}
+
+#endif /* ALLOCATION_COUNTING_H_ */
+
+#endif
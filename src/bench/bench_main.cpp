@@ -0,0 +1,287 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifdef COMPILE_BENCHMARKS
+
+#include <iostream>
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include "BenchmarkSuite.h"
+#include "RandomGraphGenerator.h"
+#include "../test/graph_generator.h"
+#include "../logging/message_logging.h"
+#include "../logging/MetricsRegistry.h"
+#include "../rule_engine/StdMatchFinder.h"
+#include "../rule_engine/TotalPOCEnumerator.h"
+#include "../rule_engine/PartialPOCEnumerator.h"
+#include "../basic_types/IDPartitionEnumerator.h"
+#include "../subgraphs/SubgraphOrder.h"
+#include "../minors/MinorOrder.h"
+#include "../graphs/MinGraphList.h"
+#include "../io/GTXLReader.h"
+#include "../io/GTXLWriter.h"
+
+#define NO_ERROR 0
+#define ERR_UNKNOWN_PARAMETER 1
+#define ERR_BENCHMARK_FAILED 2
+
+using namespace std;
+using namespace boost::program_options;
+using namespace uncover;
+using namespace uncover::bench;
+using namespace uncover::logging;
+using namespace uncover::basic_types;
+using namespace uncover::graphs;
+using namespace uncover::rule_engine;
+using namespace uncover::subgraphs;
+using namespace uncover::minors;
+using namespace uncover::io;
+using namespace uncover::test;
+
+// initializing the message logger to be cerr, such that cout only contains the results
+MessageLogger uncover::logging::logger(cerr);
+
+// initializing the metrics registry
+MetricsRegistry uncover::logging::metrics;
+
+/**
+ * Adds benchmarks for StdMatchFinder::findMatches for all combinations of injectivity and fast stopping.
+ * @param suite the suite to which the benchmarks are added
+ * @param generator the generator used for random graphs
+ */
+void addMatcherBenchmarks(BenchmarkSuite& suite, RandomGraphGenerator& generator) {
+	vector<pair<string,pair<AnonHypergraph_sp,Hypergraph_sp>>> inputs;
+	inputs.push_back(make_pair("rule7-graph4", make_pair(getRule(7)->getLeft(), getGraph(4))));
+	inputs.push_back(make_pair("rule2-graph1", make_pair(getRule(2)->getLeft(), getGraph(1))));
+	inputs.push_back(make_pair("random3x3-random20x30", make_pair(generator.generate(3,3), generator.generate(20,30))));
+	for(auto& input : inputs) {
+		for(int mode = 0; mode < 4; ++mode) {
+			bool injective = mode & 1;
+			bool stopFast = mode & 2;
+			string name = "matcher/" + string(injective ? "inj" : "noninj") + (stopFast ? "-stopfast/" : "-all/") + input.first;
+			AnonHypergraph_sp source = input.second.first;
+			Hypergraph_sp target = input.second.second;
+			suite.add(name, [source,target,injective,stopFast]() {
+				StdMatchFinder finder(injective, stopFast);
+				finder.findMatches(*source, *target);
+			});
+		}
+	}
+}
+
+/**
+ * Adds benchmarks for the subgraph and minor order.
+ * @param suite the suite to which the benchmarks are added
+ * @param generator the generator used for random graphs
+ */
+void addOrderBenchmarks(BenchmarkSuite& suite, RandomGraphGenerator& generator) {
+	vector<pair<string,pair<Hypergraph_sp,Hypergraph_sp>>> inputs;
+	inputs.push_back(make_pair("graph8-graph11", make_pair(getGraph(8), getGraph(11))));
+	inputs.push_back(make_pair("graph17-graph18", make_pair(getGraph(17), getGraph(18))));
+	inputs.push_back(make_pair("graph25-graph22", make_pair(getGraph(25), getGraph(22))));
+	inputs.push_back(make_pair("random5x5-random10x14", make_pair(generator.generate(5,5), generator.generate(10,14))));
+	shared_ptr<Order> subgraphOrder = make_shared<SubgraphOrder>();
+	shared_ptr<Order> minorOrder = make_shared<MinorOrder>();
+	for(auto& input : inputs) {
+		Hypergraph_sp smaller = input.second.first;
+		Hypergraph_sp bigger = input.second.second;
+		suite.add("order/subgraph/" + input.first, [subgraphOrder,smaller,bigger]() {
+			subgraphOrder->isLessOrEq(*smaller, *bigger);
+		});
+		suite.add("order/minor/" + input.first, [minorOrder,smaller,bigger]() {
+			minorOrder->isLessOrEq(*smaller, *bigger);
+		});
+	}
+}
+
+/**
+ * Adds benchmarks enumerating all partitions of sets of different sizes.
+ * @param suite the suite to which the benchmarks are added
+ */
+void addPartitionBenchmarks(BenchmarkSuite& suite) {
+	for(size_t size : {4, 6, 8}) {
+		vector<IDType> ids;
+		for(size_t i = 1; i <= size; ++i) {
+			ids.push_back(i);
+		}
+		suite.add("partitions/all/" + to_string(size), [ids]() {
+			for(IDPartitionEnumerator enumerator(ids); !enumerator.ended(); ++enumerator) {}
+		});
+	}
+}
+
+/**
+ * Adds benchmarks enumerating all pushout complements with the TotalPOCEnumerator and PartialPOCEnumerator.
+ * @param suite the suite to which the benchmarks are added
+ */
+void addPOCBenchmarks(BenchmarkSuite& suite) {
+	vector<pair<string,pair<Rule_sp,Hypergraph_sp>>> inputs;
+	inputs.push_back(make_pair("rule1-graph3", make_pair(getRule(1), getGraph(3))));
+	inputs.push_back(make_pair("rule2-graph1", make_pair(getRule(2), getGraph(1))));
+	inputs.push_back(make_pair("rule5-graph4", make_pair(getRule(5), getGraph(4))));
+	for(auto& input : inputs) {
+		Rule_sp rule = input.second.first;
+		Hypergraph_sp graph = input.second.second;
+		for(bool injective : {true, false}) {
+			string mode = injective ? "inj/" : "noninj/";
+			suite.add("poc/total/" + mode + input.first, [rule,graph,injective]() {
+				for(TotalPOCEnumerator_up enumerator = TotalPOCEnumerator::create(rule, graph, injective); !enumerator->ended();
+						++(*enumerator)) {}
+			});
+		}
+	}
+	Rule_sp rule7 = getRule(7);
+	Hypergraph_sp graph4 = getGraph(4);
+	for(bool injective : {true, false}) {
+		string mode = injective ? "inj/" : "noninj/";
+		suite.add("poc/partial/" + mode + "rule7-graph4", [rule7,graph4,injective]() {
+			for(PartialPOCEnumerator enumerator(rule7, graph4, injective, nullptr); !enumerator.ended(); ++enumerator) {}
+		});
+	}
+}
+
+/**
+ * Adds benchmarks filling a MinGraphList with a fixed set of random graphs.
+ * @param suite the suite to which the benchmarks are added
+ * @param generator the generator used for random graphs
+ */
+void addMinGraphListBenchmarks(BenchmarkSuite& suite, RandomGraphGenerator& generator) {
+	shared_ptr<vector<Hypergraph_sp>> graphs = make_shared<vector<Hypergraph_sp>>();
+	for(size_t i = 0; i < 50; ++i) {
+		graphs->push_back(generator.generate(3 + i % 4, 2 + i % 5));
+	}
+	Order_sp order = make_shared<SubgraphOrder>();
+	suite.add("mingraphlist/addGraph/subgraph/50-random", [graphs,order]() {
+		MinGraphList list(order);
+		for(auto& graph : *graphs) {
+			list.addGraph(graph);
+		}
+	});
+}
+
+/**
+ * Adds benchmarks writing and reading a GXL file containing random graphs. The file is created in the temporary
+ * directory and has to be removed by the caller.
+ * @param suite the suite to which the benchmarks are added
+ * @param generator the generator used for random graphs
+ * @return the path of the file used by the benchmarks
+ */
+boost::filesystem::path addIOBenchmarks(BenchmarkSuite& suite, RandomGraphGenerator& generator) {
+	shared_ptr<vector<Hypergraph_sp>> graphs = make_shared<vector<Hypergraph_sp>>();
+	for(size_t i = 0; i < 20; ++i) {
+		graphs->push_back(generator.generate(20, 30));
+	}
+	boost::filesystem::path file = boost::filesystem::temp_directory_path();
+	file /= boost::filesystem::unique_path("uncover-bench-%%%%-%%%%.gxl");
+	string filename = file.string();
+	shared_ptr<GTXLWriter> writer(GTXLWriter::newWriter());
+	shared_ptr<GTXLReader> reader(GTXLReader::newReader());
+	writer->writeGXL(*graphs, filename);
+	suite.add("io/gxl/write/20-random20x30", [writer,graphs,filename]() {
+		writer->writeGXL(*graphs, filename);
+	});
+	suite.add("io/gxl/read/20-random20x30", [reader,filename]() {
+		reader->readGXL(filename);
+	});
+	return file;
+}
+
+int main(int argc, char** argv) {
+
+	options_description desc("Options");
+	desc.add_options()
+			("help,h", "Prints this help message.")
+			("list,l", "Lists the names of all benchmarks.")
+			("filter", value<string>()->default_value(""), "Only benchmarks whose name contains the given string are executed.")
+			("format", value<string>()->default_value("json"), "The output format of the results: 'json' or 'csv'.")
+			("output", value<string>(), "Writes the results to the given file instead of the standard output.")
+			("min-time", value<double>()->default_value(0.2), "The minimal time (in seconds) of each measured repetition.")
+			("repetitions", value<unsigned int>()->default_value(5), "The number of measured repetitions per benchmark.")
+			("seed", value<unsigned int>()->default_value(42), "The seed used to generate random graphs.");
+
+	variables_map vm;
+	try {
+		store(parse_command_line(argc, argv, desc), vm);
+		notify(vm);
+	} catch(exception& e) {
+		cerr << "An error occurred while parsing parameters: " << e.what() << endl;
+		return ERR_UNKNOWN_PARAMETER;
+	}
+
+	if(vm.count("help")) {
+		cout << "uncover-bench: microbenchmarks for UnCoVer" << endl << endl << desc << endl;
+		return NO_ERROR;
+	}
+
+	string format = vm["format"].as<string>();
+	if(format.compare("json") && format.compare("csv")) {
+		cerr << "Unknown output format '" << format << "'." << endl;
+		return ERR_UNKNOWN_PARAMETER;
+	}
+
+	// only errors are of interest during benchmarks
+	gl_LogLevel = LogTypes::LT_CriticalError;
+
+	BenchmarkSuite suite(vm["min-time"].as<double>(), vm["repetitions"].as<unsigned int>());
+	RandomGraphGenerator generator(vm["seed"].as<unsigned int>());
+	addMatcherBenchmarks(suite, generator);
+	addOrderBenchmarks(suite, generator);
+	addPartitionBenchmarks(suite);
+	addPOCBenchmarks(suite);
+	addMinGraphListBenchmarks(suite, generator);
+	boost::filesystem::path ioFile = addIOBenchmarks(suite, generator);
+
+	if(vm.count("list")) {
+		for(auto& name : suite.getNames()) {
+			cout << name << endl;
+		}
+		boost::filesystem::remove(ioFile);
+		return NO_ERROR;
+	}
+
+	vector<BenchmarkResult> results;
+	try {
+		results = suite.run(vm["filter"].as<string>());
+	} catch(exception& e) {
+		cerr << "A benchmark failed: " << e.what() << endl;
+		boost::filesystem::remove(ioFile);
+		return ERR_BENCHMARK_FAILED;
+	}
+	boost::filesystem::remove(ioFile);
+
+	ofstream file;
+	if(vm.count("output")) {
+		file.open(vm["output"].as<string>().c_str());
+		if(!file.is_open()) {
+			cerr << "Could not open output file '" << vm["output"].as<string>() << "'." << endl;
+			return ERR_UNKNOWN_PARAMETER;
+		}
+	}
+	ostream& out = file.is_open() ? file : cout;
+	if(format.compare("csv")) {
+		BenchmarkSuite::writeJSON(out, results);
+	} else {
+		BenchmarkSuite::writeCSV(out, results);
+	}
+
+	return NO_ERROR;
+}
+
+#endif
@@ -374,6 +374,10 @@ namespace uncover {
 			return edges.size();
 		}
 
+		IDType AnonHypergraph::getLastUsedID() const {
+			return lastUsedID;
+		}
+
 		size_t AnonHypergraph::getVertexCount() const {
 			return vertices.size();
 		}
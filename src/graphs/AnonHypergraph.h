@@ -310,6 +310,13 @@ namespace uncover {
 				 */
 				size_t getEdgeCount() const;
 
+				/**
+				 * Returns the last ID assigned to a vertex or edge of this graph. All IDs of this graph are at most this
+				 * value, hence it can be used to size data structures indexed by IDs.
+				 * @return the last ID assigned to a vertex or edge
+				 */
+				IDType getLastUsedID() const;
+
 				/**
 				 * Returns an iterator to the first entry in the edge map. No order on the entries is guaranteed.
 				 * @return an iterator to the first entry in the edge map
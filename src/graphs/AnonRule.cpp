@@ -159,6 +159,26 @@ namespace uncover {
 			return true;
 		}
 
+		void AnonRule::fillMatchConstraints(MatchConstraints& constraints) const {
+
+			unordered_set<IDType> RwithPre;
+			for(Mapping::const_iterator it = interface.cbegin(); it != interface.cend(); ++it) {
+				RwithPre.insert(it->second);
+			}
+
+			for(auto it = right->cbeginVertices(); it != right->cendVertices(); ++it) {
+				if(!RwithPre.count(it->first)) {
+					constraints.addExclusive(it->first);
+					constraints.addExactDegree(it->first);
+				}
+			}
+			for(auto it = right->cbeginEdges(); it != right->cendEdges(); ++it) {
+				if(!RwithPre.count(it->first)) {
+					constraints.addExclusive(it->first);
+				}
+			}
+		}
+
 		void AnonRule::setMapping(Mapping const& map)
 		{
 			this->interface = map;
@@ -23,6 +23,7 @@
 
 #include "AnonHypergraph.h"
 #include "Mapping.h"
+#include "MatchConstraints.h"
 
 namespace uncover {
 	namespace graphs {
@@ -156,6 +157,16 @@ namespace uncover {
 				 */
 				virtual bool isBackApplicable(AnonHypergraph const& graph, Mapping const& match) const;
 
+				/**
+				 * Adds the conditions checked by isBackApplicable(...) to the given MatchConstraints, such that a
+				 * matcher respecting these constraints only finds co-matches for which this rule is backward
+				 * applicable. Elements of the right side without preimage in the left side are exclusive (identification
+				 * condition) and vertices without preimage require an exact degree (dangling condition; all edges
+				 * attached to such a vertex have no preimage as well, hence they are mapped injectively).
+				 * @param constraints the MatchConstraints to which the conditions are added
+				 */
+				virtual void fillMatchConstraints(MatchConstraints& constraints) const;
+
 				/**
 				 * Splits this rule into a total and a partial part and stores both subrules in the given pair.
 				 * The first rule p is the partial rule and the second rule t is the total rule, such that
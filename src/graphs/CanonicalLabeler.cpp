@@ -0,0 +1,471 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "CanonicalLabeler.h"
+#include "UQRuleInstance.h"
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+namespace uncover {
+	namespace graphs {
+
+		struct CanonicalLabeler::Search {
+
+			/**
+			 * Creates the compact representation of the given graph.
+			 * @param graph the graph whose canonical form will be searched
+			 */
+			Search(AnonHypergraph const& graph);
+
+			/**
+			 * Refines the given colors until the number of colors is stable. Afterwards the colors of vertices (and
+			 * edges) are numbered consecutively starting with 0.
+			 * @param vColors the colors of all vertices
+			 * @param eColors the colors of all edges
+			 */
+			void refine(vector<uint32_t>& vColors, vector<uint32_t>& eColors) const;
+
+			/**
+			 * Replaces the given keys by consecutive numbers preserving their lexicographic order.
+			 * @param keys the keys of all elements
+			 * @param colors the vector in which the resulting color of each element is stored
+			 * @return the number of distinct colors
+			 */
+			static size_t rank(vector<vector<uint32_t>> const& keys, vector<uint32_t>& colors);
+
+			/**
+			 * Performs the search below the node of the search tree given by the individualized vertices and the
+			 * current colors.
+			 * @param vColors the colors of all vertices
+			 * @param eColors the colors of all edges
+			 * @param prefix the vertices individualized on the way to this node
+			 */
+			void search(vector<uint32_t> vColors, vector<uint32_t> eColors, vector<uint32_t>& prefix);
+
+			/**
+			 * Processes a leaf of the search tree, i.e. a discrete coloring of the vertices.
+			 * @param vColors the (discrete) colors of all vertices
+			 */
+			void processLeaf(vector<uint32_t> const& vColors);
+
+			/**
+			 * Computes the orbits of all found automorphisms fixing the given vertices.
+			 * @param fixed the vertices which have to be fixed by the automorphisms
+			 * @return maps every vertex to a representative of its orbit
+			 */
+			vector<uint32_t> computeOrbits(vector<uint32_t> const& fixed) const;
+
+			/**
+			 * Encodes the graph, where the vertices are ordered by their (discrete) color.
+			 * @param vColors the (discrete) colors of all vertices
+			 * @return the encoding of the graph
+			 */
+			string encode(vector<uint32_t> const& vColors) const;
+
+			/**
+			 * Appends the given number to the given string (7 bits per byte).
+			 * @param str the string to which the number is appended
+			 * @param value the number to be appended
+			 */
+			static void append(string& str, uint64_t value);
+
+			/**
+			 * The IDs of all non-isolated vertices.
+			 */
+			vector<IDType> vertexIDs;
+
+			/**
+			 * The IDs of all isolated vertices.
+			 */
+			vector<IDType> isolatedIDs;
+
+			/**
+			 * All labels used in the graph in lexicographic order.
+			 */
+			vector<string> labels;
+
+			/**
+			 * The label of every edge (as position in labels).
+			 */
+			vector<uint32_t> edgeLabels;
+
+			/**
+			 * The attached vertices of every edge (as positions in vertexIDs).
+			 */
+			vector<vector<uint32_t>> edgeVertices;
+
+			/**
+			 * Stores for every vertex the attached edges and the position of the vertex in the edge.
+			 */
+			vector<vector<pair<uint32_t,uint32_t>>> attachments;
+
+			/**
+			 * The vertex ordering of the first leaf found.
+			 */
+			vector<uint32_t> firstLabeling;
+
+			/**
+			 * The encoding of the first leaf found.
+			 */
+			string firstEncoding;
+
+			/**
+			 * The vertex ordering of the leaf with the minimal encoding.
+			 */
+			vector<uint32_t> bestLabeling;
+
+			/**
+			 * The minimal encoding found so far.
+			 */
+			string bestEncoding;
+
+			/**
+			 * All automorphisms found so far, each mapping a vertex position to a vertex position.
+			 */
+			vector<vector<uint32_t>> automorphisms;
+
+		};
+
+		CanonicalLabeler::Search::Search(AnonHypergraph const& graph)
+			: vertexIDs(), isolatedIDs(), labels(), edgeLabels(), edgeVertices(), attachments(),
+			  firstLabeling(), firstEncoding(), bestLabeling(), bestEncoding(), automorphisms() {
+
+			unordered_map<IDType,uint32_t> positions;
+			for(auto it = graph.cbeginVertices(); it != graph.cendVertices(); ++it) {
+				if(graph.getConnEdgesCount(it->first) == 0) {
+					isolatedIDs.push_back(it->first);
+				} else {
+					positions[it->first] = vertexIDs.size();
+					vertexIDs.push_back(it->first);
+				}
+			}
+
+			for(auto it = graph.cbeginEdges(); it != graph.cendEdges(); ++it) {
+				labels.push_back(it->second.getLabel());
+			}
+			sort(labels.begin(), labels.end());
+			labels.erase(unique(labels.begin(), labels.end()), labels.end());
+
+			attachments.resize(vertexIDs.size());
+			for(auto it = graph.cbeginEdges(); it != graph.cendEdges(); ++it) {
+				uint32_t edge = edgeLabels.size();
+				edgeLabels.push_back(lower_bound(labels.begin(), labels.end(), it->second.getLabel()) - labels.begin());
+				edgeVertices.push_back(vector<uint32_t>());
+				vector<IDType> const& verts = it->second.getVertices();
+				for(uint32_t i = 0; i < verts.size(); ++i) {
+					uint32_t vertex = positions[verts[i]];
+					edgeVertices.back().push_back(vertex);
+					attachments[vertex].push_back(make_pair(edge, i));
+				}
+			}
+		}
+
+		size_t CanonicalLabeler::Search::rank(vector<vector<uint32_t>> const& keys, vector<uint32_t>& colors) {
+			vector<uint32_t> order(keys.size());
+			for(uint32_t i = 0; i < order.size(); ++i) {
+				order[i] = i;
+			}
+			sort(order.begin(), order.end(), [&keys](uint32_t i, uint32_t j) { return keys[i] < keys[j]; });
+
+			colors.assign(keys.size(), 0);
+			size_t count = 0;
+			for(size_t i = 0; i < order.size(); ++i) {
+				if(i > 0 && keys[order[i-1]] != keys[order[i]]) {
+					++count;
+				}
+				colors[order[i]] = count;
+			}
+			return order.empty() ? 0 : count + 1;
+		}
+
+		void CanonicalLabeler::Search::refine(vector<uint32_t>& vColors, vector<uint32_t>& eColors) const {
+
+			vector<vector<uint32_t>> vKeys(vColors.size());
+			vector<vector<uint32_t>> eKeys(eColors.size());
+			size_t colorCount = 0;
+
+			while(true) {
+
+				// edges are refined by the colors of their vertices (in order)
+				for(size_t e = 0; e < eColors.size(); ++e) {
+					eKeys[e].assign(1, eColors[e]);
+					for(uint32_t v : edgeVertices[e]) {
+						eKeys[e].push_back(vColors[v]);
+					}
+				}
+
+				// vertices are refined by the colors and positions of their attached edges
+				for(size_t v = 0; v < vColors.size(); ++v) {
+					vector<pair<uint32_t,uint32_t>> att;
+					for(auto const& p : attachments[v]) {
+						att.push_back(make_pair(eColors[p.first], p.second));
+					}
+					sort(att.begin(), att.end());
+					vKeys[v].assign(1, vColors[v]);
+					for(auto const& p : att) {
+						vKeys[v].push_back(p.first);
+						vKeys[v].push_back(p.second);
+					}
+				}
+
+				size_t newColorCount = rank(vKeys, vColors) + rank(eKeys, eColors);
+				if(newColorCount <= colorCount) {
+					break;
+				}
+				colorCount = newColorCount;
+			}
+		}
+
+		void CanonicalLabeler::Search::search(vector<uint32_t> vColors, vector<uint32_t> eColors, vector<uint32_t>& prefix) {
+
+			refine(vColors, eColors);
+
+			// choose the first color class with more than one vertex
+			vector<uint32_t> classSizes(vColors.size(), 0);
+			for(uint32_t c : vColors) {
+				++classSizes[c];
+			}
+			uint32_t target = 0;
+			while(target < classSizes.size() && classSizes[target] <= 1) {
+				++target;
+			}
+			if(target == classSizes.size()) {
+				processLeaf(vColors);
+				return;
+			}
+
+			// individualize every vertex of the class, skipping vertices equivalent to an already individualized one
+			vector<uint32_t> tried;
+			size_t knownAutomorphisms = 0;
+			vector<uint32_t> orbits;
+			for(uint32_t w = 0; w < vColors.size(); ++w) {
+				if(vColors[w] != target) {
+					continue;
+				}
+				if(knownAutomorphisms != automorphisms.size()) {
+					orbits = computeOrbits(prefix);
+					knownAutomorphisms = automorphisms.size();
+				}
+				bool equivalent = false;
+				for(uint32_t v : tried) {
+					if(!orbits.empty() && orbits[v] == orbits[w]) {
+						equivalent = true;
+						break;
+					}
+				}
+				if(equivalent) {
+					continue;
+				}
+				tried.push_back(w);
+
+				vector<uint32_t> newColors(vColors.size());
+				for(uint32_t v = 0; v < vColors.size(); ++v) {
+					newColors[v] = 2 * vColors[v] + ((vColors[v] == target && v != w) ? 1 : 0);
+				}
+				prefix.push_back(w);
+				search(newColors, eColors, prefix);
+				prefix.pop_back();
+			}
+		}
+
+		void CanonicalLabeler::Search::processLeaf(vector<uint32_t> const& vColors) {
+			vector<uint32_t> labeling(vColors.size());
+			for(uint32_t v = 0; v < vColors.size(); ++v) {
+				labeling[vColors[v]] = v;
+			}
+			string encoding = encode(vColors);
+
+			if(bestEncoding.empty()) {
+				firstLabeling = labeling;
+				firstEncoding = encoding;
+				bestLabeling = labeling;
+				bestEncoding = encoding;
+				return;
+			}
+
+			// equal encodings of two leaves yield an automorphism
+			vector<uint32_t> const* other = nullptr;
+			if(encoding == firstEncoding) {
+				other = &firstLabeling;
+			} else if(encoding == bestEncoding) {
+				other = &bestLabeling;
+			}
+			if(other) {
+				vector<uint32_t> automorphism(labeling.size());
+				for(size_t i = 0; i < labeling.size(); ++i) {
+					automorphism[(*other)[i]] = labeling[i];
+				}
+				automorphisms.push_back(automorphism);
+			} else if(encoding < bestEncoding) {
+				bestLabeling = labeling;
+				bestEncoding = encoding;
+			}
+		}
+
+		vector<uint32_t> CanonicalLabeler::Search::computeOrbits(vector<uint32_t> const& fixed) const {
+			vector<uint32_t> parent(vertexIDs.size());
+			for(uint32_t v = 0; v < parent.size(); ++v) {
+				parent[v] = v;
+			}
+			auto find = [&parent](uint32_t v) {
+				while(parent[v] != v) {
+					parent[v] = parent[parent[v]];
+					v = parent[v];
+				}
+				return v;
+			};
+
+			for(auto const& automorphism : automorphisms) {
+				bool fixesAll = true;
+				for(uint32_t v : fixed) {
+					if(automorphism[v] != v) {
+						fixesAll = false;
+						break;
+					}
+				}
+				if(!fixesAll) {
+					continue;
+				}
+				for(uint32_t v = 0; v < automorphism.size(); ++v) {
+					uint32_t r1 = find(v);
+					uint32_t r2 = find(automorphism[v]);
+					if(r1 != r2) {
+						parent[max(r1, r2)] = min(r1, r2);
+					}
+				}
+			}
+
+			for(uint32_t v = 0; v < parent.size(); ++v) {
+				parent[v] = find(v);
+			}
+			return parent;
+		}
+
+		string CanonicalLabeler::Search::encode(vector<uint32_t> const& vColors) const {
+			vector<vector<uint32_t>> edges;
+			edges.reserve(edgeLabels.size());
+			for(size_t e = 0; e < edgeLabels.size(); ++e) {
+				edges.push_back({edgeLabels[e], static_cast<uint32_t>(edgeVertices[e].size())});
+				for(uint32_t v : edgeVertices[e]) {
+					edges.back().push_back(vColors[v]);
+				}
+			}
+			sort(edges.begin(), edges.end());
+
+			string result;
+			append(result, vertexIDs.size());
+			append(result, isolatedIDs.size());
+			append(result, labels.size());
+			for(string const& label : labels) {
+				append(result, label.size());
+				result += label;
+			}
+			append(result, edges.size());
+			for(auto const& edge : edges) {
+				for(uint32_t value : edge) {
+					append(result, value);
+				}
+			}
+			return result;
+		}
+
+		void CanonicalLabeler::Search::append(string& str, uint64_t value) {
+			while(value >= 0x80) {
+				str.push_back(static_cast<char>((value & 0x7f) | 0x80));
+				value >>= 7;
+			}
+			str.push_back(static_cast<char>(value));
+		}
+
+		CanonicalLabeler::CanonicalLabeler() {}
+
+		CanonicalLabeler::~CanonicalLabeler() {}
+
+		string CanonicalLabeler::createCanonicalForm(AnonHypergraph const& graph) {
+			vector<IDType> ordering;
+			return createCanonicalForm(graph, ordering);
+		}
+
+		string CanonicalLabeler::createCanonicalForm(AnonHypergraph const& graph, vector<IDType>& ordering) {
+			Search search(graph);
+
+			// initially all vertices have the same color and edges are colored by label and arity
+			vector<uint32_t> vColors(search.vertexIDs.size(), 0);
+			vector<vector<uint32_t>> eKeys;
+			for(size_t e = 0; e < search.edgeLabels.size(); ++e) {
+				eKeys.push_back({search.edgeLabels[e], static_cast<uint32_t>(search.edgeVertices[e].size())});
+			}
+			vector<uint32_t> eColors;
+			Search::rank(eKeys, eColors);
+
+			vector<uint32_t> prefix;
+			search.search(vColors, eColors, prefix);
+
+			ordering.clear();
+			for(uint32_t v : search.bestLabeling) {
+				ordering.push_back(search.vertexIDs[v]);
+			}
+			ordering.insert(ordering.end(), search.isolatedIDs.begin(), search.isolatedIDs.end());
+			return search.bestEncoding;
+		}
+
+		string CanonicalLabeler::createCanonicalForm(AnonRule const& rule) {
+
+			// the rule is encoded as one graph: edges become vertices (connected to their attached vertices by an edge
+			// labeled with their label), vertices and edges of both sides are marked and the mapping is added as edges
+			UQRuleInstance const* uqRule = dynamic_cast<UQRuleInstance const*>(&rule);
+			AnonHypergraph combined;
+			unordered_map<IDType,IDType> leftIDs, rightIDs;
+			for(int side = 0; side < 2; ++side) {
+				AnonHypergraph_csp graph = (side == 0) ? rule.getLeft() : rule.getRight();
+				unordered_map<IDType,IDType>& ids = (side == 0) ? leftIDs : rightIDs;
+				string prefix = (side == 0) ? "L" : "R";
+				unordered_set<IDType> const* uqVertices = nullptr;
+				if(uqRule) {
+					uqVertices = (side == 0) ? &uqRule->getLeftUQVertices() : &uqRule->getRightUQVertices();
+				}
+
+				for(auto it = graph->cbeginVertices(); it != graph->cendVertices(); ++it) {
+					IDType vertex = combined.addVertex();
+					ids[it->first] = vertex;
+					bool quantified = uqVertices && uqVertices->count(it->first);
+					combined.addEdge("#" + prefix + (quantified ? "U" : ""), {vertex});
+				}
+				for(auto it = graph->cbeginEdges(); it != graph->cendEdges(); ++it) {
+					IDType edgeVertex = combined.addVertex();
+					ids[it->first] = edgeVertex;
+					vector<IDType> attached = {edgeVertex};
+					for(IDType v : it->second.getVertices()) {
+						attached.push_back(ids[v]);
+					}
+					combined.addEdge(prefix + ":" + it->second.getLabel(), attached);
+				}
+			}
+
+			for(auto it = rule.getMapping().cbegin(); it != rule.getMapping().cend(); ++it) {
+				combined.addEdge("#m", {leftIDs[it->first], rightIDs[it->second]});
+			}
+
+			return createCanonicalForm(combined);
+		}
+
+	} /* namespace graphs */
+} /* namespace uncover */
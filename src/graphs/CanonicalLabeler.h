@@ -0,0 +1,98 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef CANONICALLABELER_H_
+#define CANONICALLABELER_H_
+
+#include "Hypergraph.h"
+#include "AnonRule.h"
+
+namespace uncover {
+	namespace graphs {
+
+		/**
+		 * The CanonicalLabeler computes a canonical form of a Hypergraph, i.e. a byte string which is equal for two
+		 * graphs if and only if the graphs are isomorphic. The canonical form can therefore be used as exact key for
+		 * hash-based lookups of graphs up to isomorphism.
+		 *
+		 * <p>The canonical form is computed by individualization-refinement (in the style of nauty and bliss) on a
+		 * compact representation of the graph. Vertices and edges are colored and the colors are refined until they
+		 * are stable, where the color of an edge is refined by its label and the colors of its attached vertices (in
+		 * order) and the color of a vertex by the colors and positions of its attached edges. If a color class of
+		 * vertices still contains more than one vertex, each of its vertices is individualized in turn, which yields a
+		 * search tree whose leaves are orderings of all vertices. The canonical form is the minimal encoding of the
+		 * graph over all leaves. Automorphisms found during the search are used to skip equivalent subtrees.
+		 * Isolated vertices are only counted.</p>
+		 * @see IsomorphismChecker
+		 * @author Jan Stückrath
+		 */
+		class CanonicalLabeler {
+
+			public:
+
+				/**
+				 * Computes the canonical form of the given graph. The name and the IDs of the graph are ignored.
+				 * @param graph the graph whose canonical form will be computed
+				 * @return the canonical form of the graph
+				 */
+				static string createCanonicalForm(AnonHypergraph const& graph);
+
+				/**
+				 * Computes the canonical form of the given graph and the canonical ordering of its vertices. Two
+				 * isomorphic graphs yield the same form, and mapping the i-th vertex of the first ordering to the i-th
+				 * vertex of the second ordering is (on the vertices) an isomorphism between both graphs.
+				 * @param graph the graph whose canonical form will be computed
+				 * @param ordering this vector will be replaced by the IDs of all vertices in canonical order
+				 * @return the canonical form of the graph
+				 */
+				static string createCanonicalForm(AnonHypergraph const& graph, vector<IDType>& ordering);
+
+				/**
+				 * Computes the canonical form of the given rule, i.e. a byte string which is equal for two rules if and
+				 * only if there are isomorphisms between their left and right sides, which commute with the rule
+				 * mappings. If the rule is a UQRuleInstance, the isomorphisms also have to preserve universally
+				 * quantified vertices. The name of the rule is ignored.
+				 * @param rule the rule whose canonical form will be computed
+				 * @return the canonical form of the rule
+				 */
+				static string createCanonicalForm(AnonRule const& rule);
+
+				/**
+				 * Destroys this CanonicalLabeler.
+				 */
+				virtual ~CanonicalLabeler();
+
+			private:
+
+				/**
+				 * This constructor cannot be used.
+				 */
+				CanonicalLabeler();
+
+				/**
+				 * Stores the compact representation of a graph and the state of the search for its canonical form.
+				 */
+				struct Search;
+
+		};
+
+	} /* namespace graphs */
+} /* namespace uncover */
+
+#endif /* CANONICALLABELER_H_ */
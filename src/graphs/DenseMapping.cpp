@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "DenseMapping.h"
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+namespace uncover {
+	namespace graphs {
+
+		IDType const DenseMapping::undefined = numeric_limits<IDType>::max();
+
+		DenseMapping::DenseMapping(IDType maxSource) : tars(maxSource + 1, undefined), count(0) {}
+
+		DenseMapping::DenseMapping(Mapping const& mapp) : tars(), count(0) {
+			IDType maxSource = 0;
+			for(auto it = mapp.cbegin(); it != mapp.cend(); ++it) {
+				maxSource = max(maxSource, it->first);
+			}
+			tars.assign(maxSource + 1, undefined);
+			for(auto it = mapp.cbegin(); it != mapp.cend(); ++it) {
+				tars[it->first] = it->second;
+				++count;
+			}
+		}
+
+		void DenseMapping::setTar(IDType source, IDType target) {
+			if(source >= tars.size()) {
+				tars.resize(max<size_t>(source + 1, 2 * tars.size()), undefined);
+			}
+			if(tars[source] == undefined) {
+				++count;
+			}
+			tars[source] = target;
+		}
+
+		bool DenseMapping::delSrc(IDType source) {
+			if(hasSrc(source)) {
+				tars[source] = undefined;
+				--count;
+				return true;
+			}
+			return false;
+		}
+
+		void DenseMapping::clear() {
+			fill(tars.begin(), tars.end(), undefined);
+			count = 0;
+		}
+
+		Mapping DenseMapping::toMapping() const {
+			Mapping result;
+			toMapping(result);
+			return result;
+		}
+
+		void DenseMapping::toMapping(Mapping& mapp) const {
+			mapp.clear();
+			for(IDType source = 0; source < tars.size(); ++source) {
+				if(tars[source] != undefined) {
+					mapp[source] = tars[source];
+				}
+			}
+		}
+
+		DenseMapping::Inversion::Inversion() : offsets(), sources(), targets() {}
+
+		DenseMapping::Inversion::Inversion(DenseMapping const& mapp) : Inversion() {
+			assign(mapp);
+		}
+
+		DenseMapping::Inversion::Inversion(Mapping const& mapp) : Inversion() {
+			assign(mapp);
+		}
+
+		void DenseMapping::Inversion::assign(DenseMapping const& mapp) {
+			vector<pair<IDType,IDType>> pairs;
+			pairs.reserve(mapp.size());
+			IDType maxTarget = 0;
+			for(IDType source = 0; source < mapp.tars.size(); ++source) {
+				if(mapp.tars[source] != undefined) {
+					pairs.push_back(make_pair(source, mapp.tars[source]));
+					maxTarget = max(maxTarget, mapp.tars[source]);
+				}
+			}
+			build(pairs, maxTarget);
+		}
+
+		void DenseMapping::Inversion::assign(Mapping const& mapp) {
+			vector<pair<IDType,IDType>> pairs(mapp.cbegin(), mapp.cend());
+			IDType maxTarget = 0;
+			for(auto& p : pairs) {
+				maxTarget = max(maxTarget, p.second);
+			}
+			build(pairs, maxTarget);
+		}
+
+		void DenseMapping::Inversion::build(vector<pair<IDType,IDType>> const& pairs, IDType maxTarget) {
+
+			// count the preimages of each target, shifted by one such that the prefix sums yield the offsets
+			offsets.assign(pairs.empty() ? 0 : maxTarget + 2, 0);
+			for(auto& p : pairs) {
+				++offsets[p.second + 1];
+			}
+			targets.clear();
+			for(size_t t = 1; t < offsets.size(); ++t) {
+				if(offsets[t] > 0) {
+					targets.push_back(t - 1);
+				}
+				offsets[t] += offsets[t-1];
+			}
+
+			// fill the groups in the order of the pairs
+			sources.resize(pairs.size());
+			vector<size_t> next(offsets.begin(), offsets.end() - (offsets.empty() ? 0 : 1));
+			for(auto& p : pairs) {
+				sources[next[p.second]++] = p.first;
+			}
+		}
+
+	} /* namespace graphs */
+} /* namespace uncover */
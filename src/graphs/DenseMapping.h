@@ -0,0 +1,241 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef DENSEMAPPING_H_
+#define DENSEMAPPING_H_
+
+#include "Mapping.h"
+
+namespace uncover {
+	namespace graphs {
+
+		/**
+		 * This class stores a mapping of IDs like Mapping, but uses a flat array indexed by the source IDs instead
+		 * of a hash map. Since the IDs of a graph are assigned consecutively (see AnonHypergraph::getLastUsedID()),
+		 * the array is small and lookups, insertions and deletions are plain array accesses. Unmapped sources are
+		 * marked by the sentinel DenseMapping::undefined. This class is intended for the inner loops of matchers
+		 * and enumerators; results are converted to Mapping objects, which remain the type used by interfaces.
+		 * @author Jan Stückrath
+		 * @see Mapping
+		 */
+		class DenseMapping {
+
+			public:
+
+				/**
+				 * The inverse of a DenseMapping (or Mapping) stored in compressed sparse row format, i.e. all sources
+				 * are stored in one array grouped by their targets and an offset array indexed by the target IDs marks
+				 * the beginning of each group. An Inversion is a snapshot and does not change with the mapping it
+				 * was computed from.
+				 * @author Jan Stückrath
+				 */
+				class Inversion {
+
+					public:
+
+						/**
+						 * Creates an empty Inversion.
+						 */
+						Inversion();
+
+						/**
+						 * Creates the Inversion of the given DenseMapping.
+						 * @param mapp the DenseMapping to be inverted
+						 */
+						explicit Inversion(DenseMapping const& mapp);
+
+						/**
+						 * Creates the Inversion of the given Mapping.
+						 * @param mapp the Mapping to be inverted
+						 */
+						explicit Inversion(Mapping const& mapp);
+
+						/**
+						 * Replaces the content of this Inversion by the inversion of the given DenseMapping. The
+						 * sources of each target are stored in ascending order.
+						 * @param mapp the DenseMapping to be inverted
+						 */
+						void assign(DenseMapping const& mapp);
+
+						/**
+						 * Replaces the content of this Inversion by the inversion of the given Mapping.
+						 * @param mapp the Mapping to be inverted
+						 */
+						void assign(Mapping const& mapp);
+
+						/**
+						 * Returns the number of sources mapped to the given target.
+						 * @param target the target ID
+						 * @return the number of preimages of the target
+						 */
+						size_t count(IDType target) const {
+							return (target + 1 < offsets.size()) ? offsets[target+1] - offsets[target] : 0;
+						}
+
+						/**
+						 * Returns a pointer to the first source mapped to the given target. Together with
+						 * endSrc(IDType) this forms the range of all preimages of the target.
+						 * @param target the target ID
+						 * @return a pointer to the first preimage of the target
+						 */
+						IDType const* beginSrc(IDType target) const {
+							return (target + 1 < offsets.size()) ? sources.data() + offsets[target] : nullptr;
+						}
+
+						/**
+						 * Returns a pointer beyond the last source mapped to the given target.
+						 * @param target the target ID
+						 * @return a pointer beyond the last preimage of the target
+						 */
+						IDType const* endSrc(IDType target) const {
+							return (target + 1 < offsets.size()) ? sources.data() + offsets[target+1] : nullptr;
+						}
+
+						/**
+						 * Returns all targets with at least one preimage in ascending order.
+						 * @return the targets with preimages
+						 */
+						vector<IDType> const& getTargets() const { return targets; }
+
+					private:
+
+						/**
+						 * Stores for each target ID the index of its first preimage in sources. The preimages of
+						 * target t are stored at the indices offsets[t] to offsets[t+1]-1.
+						 */
+						vector<size_t> offsets;
+
+						/**
+						 * Stores the sources grouped by their targets.
+						 */
+						vector<IDType> sources;
+
+						/**
+						 * Stores all targets with at least one preimage.
+						 */
+						vector<IDType> targets;
+
+						/**
+						 * Computes offsets, sources and targets from the given pairs of sources and targets, where
+						 * maxTarget is the largest target occurring.
+						 * @param pairs the pairs of the inverted mapping
+						 * @param maxTarget the largest target in pairs
+						 */
+						void build(vector<pair<IDType,IDType>> const& pairs, IDType maxTarget);
+
+				};
+
+				/**
+				 * The value stored for sources without image.
+				 */
+				static IDType const undefined;
+
+				/**
+				 * Creates an empty DenseMapping with room for all sources up to the given ID. Larger sources can be
+				 * added later, but cause a reallocation.
+				 * @param maxSource the largest source ID expected
+				 */
+				explicit DenseMapping(IDType maxSource = 0);
+
+				/**
+				 * Creates a DenseMapping containing the same pairs as the given Mapping.
+				 * @param mapp the Mapping to be copied
+				 */
+				explicit DenseMapping(Mapping const& mapp);
+
+				/**
+				 * Returns whether the given ID is mapped to some ID by this mapping.
+				 * @param source the ID which should be checked
+				 * @return true, iff the given ID is mapped
+				 */
+				bool hasSrc(IDType source) const {
+					return source < tars.size() && tars[source] != undefined;
+				}
+
+				/**
+				 * Returns the ID to which the given ID is mapped or DenseMapping::undefined if it has no image.
+				 * @param source the ID which should be mapped
+				 * @return the image of the given ID or DenseMapping::undefined
+				 */
+				IDType getTar(IDType source) const {
+					return source < tars.size() ? tars[source] : undefined;
+				}
+
+				/**
+				 * Maps the given source to the given target, replacing an existing image.
+				 * @param source the source ID
+				 * @param target the new image of the source
+				 */
+				void setTar(IDType source, IDType target);
+
+				/**
+				 * Removes the image of the given ID, if it exists.
+				 * @param source the ID of which the mapping should be deleted
+				 * @return true, iff there was a mapping deleted
+				 */
+				bool delSrc(IDType source);
+
+				/**
+				 * Returns the number of sources with an image.
+				 * @return the number of mapped sources
+				 */
+				size_t size() const { return count; }
+
+				/**
+				 * Returns the number of source IDs for which this mapping currently has room. All mapped sources are
+				 * smaller than this value.
+				 * @return the size of the source domain
+				 */
+				size_t domainSize() const { return tars.size(); }
+
+				/**
+				 * Removes all pairs stored in this mapping, but keeps the allocated memory.
+				 */
+				void clear();
+
+				/**
+				 * Returns a Mapping containing the same pairs as this mapping.
+				 * @return a Mapping equal to this mapping
+				 */
+				Mapping toMapping() const;
+
+				/**
+				 * Clears the given Mapping and stores all pairs of this mapping in it.
+				 * @param mapp the Mapping which will be overwritten
+				 */
+				void toMapping(Mapping& mapp) const;
+
+			private:
+
+				/**
+				 * Stores the image of each source ID or DenseMapping::undefined.
+				 */
+				vector<IDType> tars;
+
+				/**
+				 * Stores the number of sources with an image.
+				 */
+				size_t count;
+
+		};
+
+	} /* namespace graphs */
+} /* namespace uncover */
+
+#endif /* DENSEMAPPING_H_ */
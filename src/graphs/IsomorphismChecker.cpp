@@ -18,15 +18,12 @@
  *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
  ***************************************************************************/
 
-#include <iostream>
 #include "IsomorphismChecker.h"
 #include "SignatureCreater.h"
-#include "../logging/message_logging.h"
-#include <set>
+#include <algorithm>
 
 using namespace std;
 using namespace uncover::graphs;
-using namespace uncover::logging;
 
 namespace uncover {
 	namespace graphs {
@@ -51,24 +48,41 @@ namespace uncover {
 
 			// graphs must have the same signature
 			if (sig1 != sig2) return false;
-			
+
+			return areIsomorphic(hg1, sigs1, hg2, sigs2);
+		}
+
+		bool IsomorphismChecker::areIsomorphic(Hypergraph const& hg1, HGSignature const& sigs1, Hypergraph const& hg2, HGSignature const& sigs2)
+		{
+
+			// graphs must have the same number of vertices and edges
+			if (hg1.getVertexCount() != hg2.getVertexCount() || hg1.getEdgeCount() != hg2.getEdgeCount()) return false;
+
+			// graphs must have the same multiset of vertex and edge signatures
+			vector<PartSig> colors1, colors2;
+			for (auto const& p : sigs1) colors1.push_back(p.second);
+			for (auto const& p : sigs2) colors2.push_back(p.second);
+			sort(colors1.begin(), colors1.end());
+			sort(colors2.begin(), colors2.end());
+			if (colors1 != colors2) return false;
+
 			// if nothing helps, start recursive check
 			map<IDType, IDType> mapF, mapB;
 			map<PartSig, list<IDType> > sigs2rev;
-			for (auto it = sigs2.cbegin(); it != sigs2.cend(); ++it)
+			for (auto it = hg2.cbeginEdges(); it != hg2.cendEdges(); ++it)
 			{
-				sigs2rev[it->second].push_back(it->first);
+				sigs2rev[sigs2.at(it->first)].push_back(it->first);
 			}
-			
-			// try all different mappings
+
+			// try all different mappings; isolated vertices need not be mapped, since their number is equal
 			return mapping(hg1, sigs1, hg2, sigs2, sigs2rev, mapF, mapB, hg1.cbeginEdges(), hg1.cendEdges());
 		}
 
 		bool IsomorphismChecker::mapping (
 				Hypergraph const& h0,
-				HGSignature& sigs0,
+				HGSignature const& sigs0,
 				Hypergraph const& h1,
-				HGSignature& sigs1,
+				HGSignature const& sigs1,
 				map<PartSig, list<IDType> >& sigs1rev,
 				map<IDType, IDType>& mappingsFor,
 				map<IDType, IDType>& mappingsBack,
@@ -78,126 +92,75 @@ namespace uncover {
 			if ( it == end )
 			{
 				// end of recursion
-				//assert(mappingsFor.size() == mappingsBack.size());
 				return true;
 			}
 
 			IDType currentID = it->first;
-			PartSig currentSig = sigs0[currentID];
-			
+			list<IDType> const& candidates = sigs1rev[sigs0.at(currentID)];
+
 			// in each function call we iterate over one edge e0 in h0.
 			// we try to map one edge e1 of h1 to h0 that has the same signaure like e0
-			for ( list<IDType>::iterator
-			        fitit = sigs1rev[currentSig].begin(); fitit != sigs1rev[currentSig].end(); ++fitit )
+			for ( auto fitit = candidates.cbegin(); fitit != candidates.cend(); ++fitit )
 			{
 
-				if (!h1.hasEdge(*fitit)){
-					logger.newWarning() << "Found a edges and a vertex with identical signatures." << endLogMessage;
+				// if the potential edge already has been mapped, do not map it again
+				if ( mappingsBack.find ( *fitit ) != mappingsBack.end() )
+				{
 					continue;
 				}
 
-				if (it->second.getLabel() != h1.getEdge(*fitit)->getLabel())
+				// edges with equal signatures may still differ in case of hash collisions
+				Edge const* e1 = h1.getEdge(*fitit);
+				if (it->second.getLabel() != e1->getLabel() || it->second.getVertices().size() != e1->getVertices().size())
 				{
-					logger.newWarning() << "Found edges with identical signatures and different labels." << endLogMessage;
 					continue;
 				}
 
-				// try mapping
-				// if the potential edge already has been mapped, do not map it again
-				if ( mappingsBack.find ( *fitit ) == mappingsBack.end() )
+				// save all new mappings so we can delete them in case of no success
+				vector<IDType> newMappings;
+				vector<IDType> const& verts0 = it->second.getVertices();
+				vector<IDType> const& verts1 = e1->getVertices();
+				bool success = true;
+
+				// iterate over all incident vertices
+				for (size_t i = 0; i < verts0.size() && success; ++i)
 				{
-					bool success = true;
-					
-					// save all temporal mappings so we can delete them in case of no success
-					set<IDType> newMappings;
-					set<IDType> newMappingsRev;
-					auto verts0 = h0.getVerticesOfEdge(currentID);
-					auto verts1 = h1.getVerticesOfEdge(*fitit);
-					auto i0 = verts0->cbegin();
-					auto i1 = verts1->cbegin();
-
-					//Iterate over all incident vertices
-					if (verts0->size() != verts1->size())
-					{
-						logger.newWarning() << "Error in edge detected while checking for isomorphisms. ";
-						logger.contMsg() << "Graph (id=" << h0.getID() << ") has edge with label '" << it->second.getLabel();
-						logger.contMsg() << "', arity " << verts0->size() << " and signature '" << sigs0[currentID] << "'. ";
-						logger.contMsg() << "Graph (id=" << h1.getID() << ") has edge with label '" << h1.getEdge(*fitit)->getLabel();
-						logger.contMsg() << "', arity " << verts1->size() << " and signature '" << sigs1[*fitit] << "'." << endLogMessage;
-					}
+					// vertices to fit must have the same signature and must not have been mapped in a different way
+					success = sigs0.at(verts0[i]) == sigs1.at(verts1[i])
+							&& insertIfValid ( mappingsFor, mappingsBack, verts0[i], verts1[i], newMappings );
+				}
 
-					while (i0 != verts0->cend())
-					{
-						// vertices to fit must have the same signature
-						if ( sigs0[*i0] != sigs1[*i1] )
-						{
-							success = false;
-							break;
-						}
-
-						// map the vertex if it has not been mapped in a different way earlier
-						success = insertIfValid ( mappingsFor, mappingsBack, *i0, *i1 );
-						if ( success )
-						{
-							newMappings.insert ( *i0 );
-							newMappingsRev.insert ( *i1 );
-						}
-						else
-						{
-							break;
-						}
-						i0++;
-						i1++;
-					}
-					
-					// success = we have mapped all adjacent edges successfully
-					if ( success )
-					{
-						// success &= we have also mapped our edge successfully
-						success = insertIfValid ( mappingsFor, mappingsBack, currentID, *fitit );
-						if ( success )
-						{
-							newMappings.insert ( currentID );
-							newMappingsRev.insert ( *fitit );
-							Hypergraph::EMap::const_iterator newIt = it;
-							newIt++;
-							
-							// everything of the current edge has been mapped, so let's continue with the next edge.
-							success = mapping ( h0, sigs0, h1, sigs1, sigs1rev, mappingsFor, mappingsBack, newIt, end );
-
-							if ( success )
-							{
-								// recursion came to a happy end
-								return true;
-							}
-						}
-					}
-					if (!success)
+				// map the edge itself and continue with the next edge
+				if ( success && insertIfValid ( mappingsFor, mappingsBack, currentID, *fitit, newMappings ) )
+				{
+					Hypergraph::EMap::const_iterator newIt = it;
+					++newIt;
+					if ( mapping ( h0, sigs0, h1, sigs1, sigs1rev, mappingsFor, mappingsBack, newIt, end ) )
 					{
-						//there was a problem with one of the steps above, so we have to undo all changed for this step
-						for ( set<IDType>::iterator
-								del = newMappings.begin(); del != newMappings.end(); ++del )
-						{
-							mappingsFor.erase ( *del );
-						}
-						for ( set<IDType>::iterator
-								del = newMappingsRev.begin(); del != newMappingsRev.end(); ++del )
-						{
-							mappingsBack.erase ( *del );
-						}
+						// recursion came to a happy end
+						return true;
 					}
 				}
+
+				// there was a problem with one of the steps above, so we have to undo all changes of this step
+				for ( IDType id : newMappings )
+				{
+					mappingsBack.erase ( mappingsFor[id] );
+					mappingsFor.erase ( id );
+				}
 			}
 			return false;
 		}
-		
-		
-		bool IsomorphismChecker::insertIfValid ( map<IDType, IDType>& forw, map<IDType, IDType>& backw, IDType id0, IDType id1 )
+
+		bool IsomorphismChecker::insertIfValid ( map<IDType, IDType>& forw, map<IDType, IDType>& backw, IDType id0, IDType id1,
+				vector<IDType>& added )
 		{
-			if ( forw.find ( id0 ) != forw.end() && forw[id0] != id1 ) return false;
-			if ( backw.find ( id1 ) != backw.end() && backw[id1] != id0 ) return false;
+			auto forwIt = forw.find ( id0 );
+			if ( forwIt != forw.end() ) return forwIt->second == id1;
+			if ( backw.find ( id1 ) != backw.end() ) return false;
 			forw.insert ( make_pair ( id0, id1 ) );
 			backw.insert ( make_pair ( id1, id0 ) );
+			added.push_back ( id0 );
 			return true;
 		}
 
@@ -30,9 +30,10 @@ namespace uncover {
 		/**
 		 * Checks whether two given Hypergraphs are isomorphic or not. The check is performed by the algorithm
 		 * described by Arend Rensink in "Isomorphism Checking in GROOVE" using signatures and certificates
-		 * as heuristics.
+		 * as heuristics. Edges are mapped one after another, where an edge may only be mapped to an edge with the same
+		 * signature (see SignatureCreater). Vertices are mapped along with their attached edges.
 		 * @author Jan Stückrath
-		 * @author Marvon Heumüller
+		 * @author Marvin Heumüller
 		 */
 		class IsomorphismChecker
 		{
@@ -52,6 +53,17 @@ namespace uncover {
 				 */
 				static bool areIsomorphic(Hypergraph const& hg1, Hypergraph const& hg2);
 
+				/**
+				 * Returns true if the two given graphs are isomorphic. This function can be used if the (detailed)
+				 * signatures of both graphs were already computed by the SignatureCreater.
+				 * @param hg1 the first graph to check
+				 * @param sigs1 the signature of the first graph
+				 * @param hg2 the second graph to check
+				 * @param sigs2 the signature of the second graph
+				 * @return true if the two given graphs are isomorphic
+				 */
+				static bool areIsomorphic(Hypergraph const& hg1, HGSignature const& sigs1, Hypergraph const& hg2, HGSignature const& sigs2);
+
 			private:
 
 				/**
@@ -61,14 +73,16 @@ namespace uncover {
 
 				/**
 				 * Inserts a pair of the given IDs to the given forward and backward maps if the resulting Mapping is still
-				 * bijective.
+				 * bijective. If the pair is already contained, nothing is changed.
 				 * @param forw the forward map to which (id0,id1) will be added
 				 * @param backw the backward map to which (id1,id0) will be added
 				 * @param id0 the first ID
 				 * @param id1 the second ID
-				 * @return true if the pairs where successfully added to the given maps
+				 * @param added if the pair was newly added, id0 is appended to this vector
+				 * @return true if the pair is contained in the given maps afterwards
 				 */
-				static bool insertIfValid(map<IDType, IDType>& forw, map<IDType, IDType>& backw, IDType id0, IDType id1);
+				static bool insertIfValid(map<IDType, IDType>& forw, map<IDType, IDType>& backw, IDType id0, IDType id1,
+						vector<IDType>& added);
 
 				/**
 				 * Checks all possible mappings for the given parameter and returns true, if one is an isomorphism.
@@ -76,7 +90,7 @@ namespace uncover {
 				 * @param sigs0 the signature computed for the first graph
 				 * @param h1 the second graph
 				 * @param sigs1 the signature comupted for the second graph
-				 * @param sigs1rev the inverse of the second graphs signature
+				 * @param sigs1rev maps each signature to the edges of the second graph having this signature
 				 * @param mappingFor the forward mapping; must be empty initially
 				 * @param mappingBak the backward mapping; must be empty initially
 				 * @param it must be an iterator to the first element of the edge map of the first graph
@@ -85,9 +99,9 @@ namespace uncover {
 				 */
 				static bool mapping(
 						Hypergraph const& h0,
-						HGSignature& sigs0,
+						HGSignature const& sigs0,
 						Hypergraph const& h1,
-						HGSignature& sigs1,
+						HGSignature const& sigs1,
 						map<PartSig, std::list<IDType> >& sigs1rev,
 						map<IDType, IDType>& mappingsFor,
 						map<IDType, IDType>& mappingsBack,
@@ -0,0 +1,75 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "IsomorphismFilter.h"
+#include "SignatureCreater.h"
+#include "IsomorphismChecker.h"
+
+using namespace std;
+
+namespace uncover {
+	namespace graphs {
+
+		IsomorphismFilter::IsomorphismFilter() : entries(), searched(), searchedSig() {}
+
+		IsomorphismFilter::~IsomorphismFilter() {}
+
+		Hypergraph_sp IsomorphismFilter::findOrInsert(Hypergraph_sp graph) {
+			Hypergraph_sp found = find(graph);
+			if(!found) {
+				insert(graph);
+			}
+			return found;
+		}
+
+		Hypergraph_sp IsomorphismFilter::find(Hypergraph_sp graph) {
+			searched.graph = graph;
+			searched.signature.clear();
+			searchedSig = SignatureCreater::createHGSignature(*graph, searched.signature);
+
+			auto range = entries.equal_range(searchedSig);
+			for(auto it = range.first; it != range.second; ++it) {
+				if(IsomorphismChecker::areIsomorphic(*it->second.graph, it->second.signature, *graph, searched.signature)) {
+					return it->second.graph;
+				}
+			}
+			return nullptr;
+		}
+
+		void IsomorphismFilter::insert(Hypergraph_sp graph) {
+			if(searched.graph != graph) {
+				searched.graph = graph;
+				searched.signature.clear();
+				searchedSig = SignatureCreater::createHGSignature(*graph, searched.signature);
+			}
+			entries.insert(make_pair(searchedSig, std::move(searched)));
+			searched = Entry();
+		}
+
+		void IsomorphismFilter::clear() {
+			entries.clear();
+			searched = Entry();
+		}
+
+		size_t IsomorphismFilter::size() const {
+			return entries.size();
+		}
+
+	} /* namespace graphs */
+} /* namespace uncover */
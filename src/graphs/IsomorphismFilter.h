@@ -0,0 +1,124 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef ISOMORPHISMFILTER_H_
+#define ISOMORPHISMFILTER_H_
+
+#include "Hypergraph.h"
+
+namespace uncover {
+	namespace graphs {
+
+		/**
+		 * An IsomorphismFilter stores a set of graphs and detects whether a new graph is isomorphic to one of the
+		 * stored graphs. The graphs are hashed by their signature (see SignatureCreater) and a graph is only compared
+		 * to stored graphs with the same signature using the IsomorphismChecker. This is used to drop isomorphic copies
+		 * of graphs before they are compared to all graphs of a MinGraphList.
+		 * @see SignatureCreater
+		 * @see IsomorphismChecker
+		 * @author Jan Stückrath
+		 */
+		class IsomorphismFilter {
+
+			public:
+
+				/**
+				 * Creates a new, empty IsomorphismFilter.
+				 */
+				IsomorphismFilter();
+
+				/**
+				 * Destroys this IsomorphismFilter.
+				 */
+				virtual ~IsomorphismFilter();
+
+				/**
+				 * Searches a stored graph isomorphic to the given graph. If such a graph exists it is returned and the
+				 * given graph is not stored. Otherwise the given graph is stored and a null pointer is returned.
+				 * @param graph the graph to be checked
+				 * @return a stored graph isomorphic to the given graph or a null pointer if there is none
+				 */
+				Hypergraph_sp findOrInsert(Hypergraph_sp graph);
+
+				/**
+				 * Searches a stored graph isomorphic to the given graph without storing the given graph. The signature
+				 * of the given graph is kept until the next call, such that a following insert(...) of the same graph
+				 * does not recompute it.
+				 * @param graph the graph to be checked
+				 * @return a stored graph isomorphic to the given graph or a null pointer if there is none
+				 */
+				Hypergraph_sp find(Hypergraph_sp graph);
+
+				/**
+				 * Stores the given graph without checking whether an isomorphic graph is already stored.
+				 * @param graph the graph to be stored
+				 */
+				void insert(Hypergraph_sp graph);
+
+				/**
+				 * Removes all stored graphs.
+				 */
+				void clear();
+
+				/**
+				 * Returns the number of stored graphs.
+				 * @return the number of stored graphs
+				 */
+				size_t size() const;
+
+			private:
+
+				/**
+				 * Stores a graph together with its detailed signature.
+				 */
+				struct Entry {
+
+					/**
+					 * The stored graph.
+					 */
+					Hypergraph_sp graph;
+
+					/**
+					 * The detailed signature of the stored graph.
+					 */
+					HGSignature signature;
+
+				};
+
+				/**
+				 * Stores all graphs indexed by their signature.
+				 */
+				std::unordered_multimap<PartSig,Entry> entries;
+
+				/**
+				 * Stores the graph of the last call of find(...) together with its signatures.
+				 */
+				Entry searched;
+
+				/**
+				 * Stores the partial signature of the graph of the last call of find(...).
+				 */
+				PartSig searchedSig;
+
+		};
+
+	} /* namespace graphs */
+} /* namespace uncover */
+
+#endif /* ISOMORPHISMFILTER_H_ */
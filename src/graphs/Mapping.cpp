@@ -204,6 +204,9 @@ namespace uncover {
 
 		std::ostream& operator<<(std::ostream& ost, Mapping const& map)
 		{
+			if(!ost.good()) {
+				return ost;
+			}
 			ost << "Mapping{";
 			for (Mapping::const_iterator matchit = map.match.begin(); matchit != map.match.end(); ++matchit) {
 				ost << '(' << matchit->first << ',' << matchit->second << ')';
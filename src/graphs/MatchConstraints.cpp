@@ -0,0 +1,50 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "MatchConstraints.h"
+
+namespace uncover {
+	namespace graphs {
+
+		MatchConstraints::MatchConstraints() : exclusive(), exactDegree() {}
+
+		MatchConstraints::~MatchConstraints() {}
+
+		void MatchConstraints::addExclusive(IDType id) {
+			exclusive.insert(id);
+		}
+
+		bool MatchConstraints::isExclusive(IDType id) const {
+			return exclusive.count(id) != 0;
+		}
+
+		void MatchConstraints::addExactDegree(IDType id) {
+			exactDegree.insert(id);
+		}
+
+		bool MatchConstraints::needsExactDegree(IDType id) const {
+			return exactDegree.count(id) != 0;
+		}
+
+		bool MatchConstraints::isEmpty() const {
+			return exclusive.empty() && exactDegree.empty();
+		}
+
+	} /* namespace graphs */
+} /* namespace uncover */
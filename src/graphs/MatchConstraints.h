@@ -0,0 +1,110 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef MATCHCONSTRAINTS_H_
+#define MATCHCONSTRAINTS_H_
+
+#include "../basic_types/globals.h"
+
+namespace uncover {
+	namespace graphs {
+
+		/**
+		 * MatchConstraints store conditions on the elements of a source graph, which a matcher checks while
+		 * extending a partial match instead of checking them on every complete match. They are used to encode
+		 * the conditions under which a rule is backward applicable (see AnonRule::fillMatchConstraints(...)).
+		 * An exclusive element (vertex or edge) may not share its image with any other element. The image of a
+		 * vertex requiring an exact degree must have as many connected edges as the vertex itself.
+		 * @author Jan Stückrath
+		 */
+		class MatchConstraints {
+
+			public:
+
+				/**
+				 * Creates new MatchConstraints without any constraint.
+				 */
+				MatchConstraints();
+
+				/**
+				 * Destroys these MatchConstraints.
+				 */
+				virtual ~MatchConstraints();
+
+				/**
+				 * Marks the element with the given ID as exclusive, i.e. no other element may be mapped to its image.
+				 * @param id the ID of the vertex or edge
+				 */
+				void addExclusive(IDType id);
+
+				/**
+				 * Returns true, iff the element with the given ID is exclusive.
+				 * @param id the ID of the vertex or edge
+				 * @return true, iff the element with the given ID is exclusive
+				 */
+				bool isExclusive(IDType id) const;
+
+				/**
+				 * Requires the image of the vertex with the given ID to have as many connected edges as the vertex.
+				 * @param id the ID of the vertex
+				 */
+				void addExactDegree(IDType id);
+
+				/**
+				 * Returns true, iff the image of the vertex with the given ID has to have as many connected edges as
+				 * the vertex.
+				 * @param id the ID of the vertex
+				 * @return true, iff the vertex requires an exact degree
+				 */
+				bool needsExactDegree(IDType id) const;
+
+				/**
+				 * Returns true, iff no constraint is stored.
+				 * @return true, iff no constraint is stored
+				 */
+				bool isEmpty() const;
+
+			private:
+
+				/**
+				 * Stores the IDs of all exclusive elements.
+				 */
+				unordered_set<IDType> exclusive;
+
+				/**
+				 * Stores the IDs of all vertices requiring an exact degree.
+				 */
+				unordered_set<IDType> exactDegree;
+
+		};
+
+		/**
+		 * Alias for a shared pointer to MatchConstraints.
+		 */
+		typedef shared_ptr<MatchConstraints> MatchConstraints_sp;
+
+		/**
+		 * Alias for a shared pointer to constant MatchConstraints.
+		 */
+		typedef shared_ptr<MatchConstraints const> MatchConstraints_csp;
+
+	} /* namespace graphs */
+} /* namespace uncover */
+
+#endif /* MATCHCONSTRAINTS_H_ */
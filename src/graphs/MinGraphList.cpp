@@ -35,7 +35,8 @@ namespace uncover {
 			:	order(order),
 			 	graphs(make_shared<vector<Hypergraph_sp>>()),
 			 	resHandler(resHandler),
-			 	idsInList() {}
+			 	idsInList(),
+			 	cancellation(nullptr) {}
 
 		MinGraphList::~MinGraphList() {}
 
@@ -45,16 +46,20 @@ namespace uncover {
 
 		bool MinGraphList::addGraph(Hypergraph_sp graph, shared_ptr<vector<Hypergraph_sp>> deletedGraphs) {
 
+			// the list is only changed after all comparisons, such that a cancelled call leaves it unchanged
 			bool canBeLarger = true;
-			vector<Hypergraph_sp>::iterator it = graphs->begin();
+			vector<size_t> largerGraphs;
+			for(size_t i = 0; i < graphs->size(); ++i) {
 
-			while(it != graphs->end()) {
+				if(cancellation) {
+					cancellation->throwIfCancelled();
+				}
 
 				// true if given graph is larger than some graph in the list
-				if(canBeLarger && order->isLessOrEq(**it,*graph)) {
+				if(canBeLarger && order->isLessOrEq(*(*graphs)[i],*graph)) {
 
 					if(resHandler) {
-						resHandler->wasDeletedBecauseOf(graph->getID(),(*it)->getID());
+						resHandler->wasDeletedBecauseOf(graph->getID(),(*graphs)[i]->getID());
 					}
 
 					return false;
@@ -62,25 +67,39 @@ namespace uncover {
 
 				// true if given graph is smaller than some graph in the list
 				// if this case is true, the first case can never be true anymore!
-				if(order->isLessOrEq(*graph,**it)) {
+				if(order->isLessOrEq(*graph,*(*graphs)[i])) {
+					largerGraphs.push_back(i);
+					canBeLarger = false;
+				}
+
+			}
+
+			// delete all larger graphs while keeping the order of the remaining graphs
+			size_t kept = 0;
+			auto largerIt = largerGraphs.cbegin();
+			for(size_t i = 0; i < graphs->size(); ++i) {
+				Hypergraph_sp& current = (*graphs)[i];
+				if(largerIt != largerGraphs.cend() && *largerIt == i) {
 
 					if(deletedGraphs) {
-						deletedGraphs->push_back(*it);
+						deletedGraphs->push_back(current);
 					}
 
 					if(resHandler) {
-						resHandler->wasDeletedBecauseOf((*it)->getID(),graph->getID());
+						resHandler->wasDeletedBecauseOf(current->getID(),graph->getID());
 					}
 
-					idsInList.erase((*it)->getID());
-					it = graphs->erase(it);
-					canBeLarger = false;
+					idsInList.erase(current->getID());
+					++largerIt;
 
 				} else {
-					++it;
+					if(kept != i) {
+						(*graphs)[kept] = std::move(current);
+					}
+					++kept;
 				}
-
 			}
+			graphs->resize(kept);
 
 			graphs->push_back(graph);
 			idsInList.insert(graph->getID());
@@ -106,5 +125,9 @@ namespace uncover {
 			return idsInList.count(graphID) > 0;
 		}
 
+		void MinGraphList::setCancellationToken(CancellationToken_csp token) {
+			cancellation = token;
+		}
+
 	} /* namespace graphs */
 } /* namespace uncover */
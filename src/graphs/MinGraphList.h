@@ -64,6 +64,8 @@ namespace uncover {
 				 * @param graph the graph to be added
 				 * @param deletedGraphs if not null, all deleted graphs will be added to this vector
 				 * @return true, iff the graph was added
+				 * @exception CancelledException if the CancellationToken of this list or of its Order was cancelled;
+				 * 				the list is only changed after all comparisons, hence it stays unchanged in this case
 				 */
 				bool addGraph(Hypergraph_sp graph, shared_ptr<vector<Hypergraph_sp>> deletedGraphs = nullptr);
 
@@ -72,6 +74,8 @@ namespace uncover {
 				 * is immediately dropped.
 				 * @param graphs the collection of graphs to be added
 				 * @return the number of graphs effectively added to this MinGraphList
+				 * @exception CancelledException if a CancellationToken was cancelled (see addGraph(...)); the graphs
+				 * 				not processed so far are not added
 				 */
 				size_t addGraphs(vector<Hypergraph_sp> const& graphs);
 
@@ -88,6 +92,13 @@ namespace uncover {
 				 */
 				bool contains(IDType graphID) const;
 
+				/**
+				 * Sets the CancellationToken checked before each comparison of two graphs. A null pointer (default)
+				 * deactivates the checks. Note that the Order checks its own CancellationToken.
+				 * @param token the CancellationToken to be checked or a null pointer
+				 */
+				void setCancellationToken(basic_types::CancellationToken_csp token);
+
 			private:
 
 				/**
@@ -110,6 +121,11 @@ namespace uncover {
 				 */
 				unordered_set<IDType> idsInList;
 
+				/**
+				 * Stores the CancellationToken checked before each comparison; may be null.
+				 */
+				basic_types::CancellationToken_csp cancellation;
+
 		};
 
 	} /* namespace graphs */
@@ -19,7 +19,7 @@
  ***************************************************************************/
 
 #include "SignatureCreater.h"
-#include <set>
+#include <algorithm>
 
 using namespace std;
 using namespace uncover::graphs;
@@ -34,96 +34,121 @@ namespace uncover {
 		PartSig SignatureCreater::createHGSignature(Hypergraph const& h, HGSignature& result)
 		{
 			result.clear();
-			
+
+			// initial colors: vertices are colored by degree, edges by label and arity
 			for (auto it = h.cbeginVertices(); it != h.cendVertices(); ++it)
 			{
-				result.insert(make_pair(it->first, 1));
+				result[it->first] = combine(1, h.getConnEdgesCount(it->first));
 			}
 
 			for (auto it = h.cbeginEdges(); it != h.cendEdges(); ++it)
 			{
-				result.insert(make_pair(it->first, hashFromString(it->second.getLabel())));
+				result[it->first] = combine(hashFromString(it->second.getLabel()), it->second.getVertices().size());
 			}
-			
-			set<PartSig> signatures;
-			signatures.insert(1);
-			size_t lastSize = 0;
-			PartSig sum = 0;
-			while (lastSize < signatures.size())
+
+			// refine until the number of colors is stable
+			size_t colorCount = countColors(result);
+			size_t maxRounds = h.getVertexCount() + h.getEdgeCount();
+			unordered_map<IDType, vector<PartSig>> attachments;
+			for (size_t round = 0; round < maxRounds; ++round)
 			{
-				lastSize = signatures.size();
-				signatures = set<PartSig>();
-				sum = 0;
-				HGSignature resCopy = result;
-				for (auto it = h.cbeginVertices(); it != h.cendVertices(); ++it)
+				HGSignature old = result;
+				attachments.clear();
+
+				for (auto it = h.cbeginEdges(); it != h.cendEdges(); ++it)
 				{
-					IDType id = it->first;
-					PartSig newC = resCopy[id];
-					auto neigh = *(h.getConnectedEdges(id));
-					for (auto it2 = neigh.cbegin(); it2 != neigh.cend(); ++it2)
+					PartSig edgeColor = old[it->first];
+					PartSig newColor = edgeColor;
+					vector<IDType> const& verts = it->second.getVertices();
+					for (size_t i = 0; i < verts.size(); ++i)
 					{
-						newC += resCopy[*it2];
+						newColor = combine(newColor, old[verts[i]]);
+						attachments[verts[i]].push_back(combine(edgeColor, i));
 					}
-					result[id] = newC;
-					signatures.insert(newC);
-					sum += newC;
+					result[it->first] = newColor;
 				}
-				
-				for (auto it = h.cbeginEdges(); it != h.cendEdges(); ++it)
+
+				for (auto it = h.cbeginVertices(); it != h.cendVertices(); ++it)
 				{
-					IDType id = it->first;
-					PartSig newC = resCopy[id];
-					vector<IDType> const* neigh = h.getVerticesOfEdge(id);
-					vector<PartSig> certs;
-					for (auto it2 = neigh->cbegin(); it2 != neigh->cend(); ++it2)
+					PartSig newColor = old[it->first];
+					auto attIt = attachments.find(it->first);
+					if (attIt != attachments.end())
 					{
-						certs.push_back(resCopy[*it2]);
+						sort(attIt->second.begin(), attIt->second.end());
+						for (PartSig att : attIt->second)
+						{
+							newColor = combine(newColor, att);
+						}
 					}
-					result[id] = newCert(resCopy[id], it->second.getLabel(), certs);
-					signatures.insert(newC);
-					sum += newC;
+					result[it->first] = newColor;
 				}
+
+				size_t newColorCount = countColors(result);
+				if (newColorCount <= colorCount)
+				{
+					break;
+				}
+				colorCount = newColorCount;
+			}
+
+			// the signature of the graph is determined by the multisets of vertex and edge colors
+			vector<PartSig> vertexColors;
+			vertexColors.reserve(h.getVertexCount());
+			for (auto it = h.cbeginVertices(); it != h.cendVertices(); ++it)
+			{
+				vertexColors.push_back(result[it->first]);
+			}
+			vector<PartSig> edgeColors;
+			edgeColors.reserve(h.getEdgeCount());
+			for (auto it = h.cbeginEdges(); it != h.cendEdges(); ++it)
+			{
+				edgeColors.push_back(result[it->first]);
 			}
+			sort(vertexColors.begin(), vertexColors.end());
+			sort(edgeColors.begin(), edgeColors.end());
 
-			return sum;
+			PartSig sig = combine(h.getVertexCount(), h.getEdgeCount());
+			for (PartSig c : vertexColors)
+			{
+				sig = combine(sig, c);
+			}
+			for (PartSig c : edgeColors)
+			{
+				sig = combine(sig, c);
+			}
+
+			return sig;
 		}
-		
-		PartSig SignatureCreater::hashFromString(string s)
+
+		PartSig SignatureCreater::hashFromString(string const& s)
 		{
-			PartSig hash = 0;
-			PartSig x = 0;
-			
-			for(std::size_t i = 0; i < s.length(); i++)
+			PartSig hash = 14695981039346656037ULL;
+			for (char c : s)
 			{
-				hash = (hash << 4) + s[i];
-				if((x = hash & 0xF0000000L) != 0)
-				{
-					hash ^= (x >> 24);
-				}
-				hash &= ~x;
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 1099511628211ULL;
 			}
-			
 			return hash;
 		}
-		
-		PartSig SignatureCreater::newCert(PartSig const& old, string label, vector<PartSig> const& neighborCerts)
+
+		PartSig SignatureCreater::combine(PartSig seed, PartSig value)
+		{
+			// mix the value (finalizer of splitmix64) before combining it with the seed
+			value += 0x9e3779b97f4a7c15ULL;
+			value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+			value ^= value >> 31;
+			return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+		}
+
+		size_t SignatureCreater::countColors(HGSignature const& signature)
 		{
-			int shift0 = (hashFromString(label) & 0xf) + 1;
-			int shift1 = 8;
-			bool alter = true;
-			PartSig res = old;
-			for (auto it = neighborCerts.cbegin(); it != neighborCerts.cend(); ++it)
+			unordered_set<PartSig> colors;
+			for (auto const& p : signature)
 			{
-				if (alter)
-				{
-					res += (*it << shift0) | (*it >> (32-shift0));
-				}
-				else
-				{
-					res += (*it << shift1) | (*it >> (32-shift1));
-				}
+				colors.insert(p.second);
 			}
-			return res;
+			return colors.size();
 		}
 	}
 
@@ -28,8 +28,14 @@ namespace uncover {
 
 		/**
 		 * The SignatureCreater provides functions to generate signatures for Hypergraphs. A signature is a hash
-		 * satisfying that two Hypergraphs are isomorphic if their signatures are equal. The other way does not
+		 * satisfying that two Hypergraphs are isomorphic only if their signatures are equal. The other way does not
 		 * necessarily hold!
+		 *
+		 * <p>Signatures are computed by color refinement (a hypergraph variant of the Weisfeiler-Lehman algorithm).
+		 * Initially every vertex is colored by its degree and every edge by its label and arity. In every round the
+		 * color of an edge is refined by the colors of its attached vertices (in order) and the color of a vertex by
+		 * the multiset of colors and positions of its attached edges. The refinement stops as soon as the number of
+		 * colors does not increase anymore. The signature of the graph is a hash of the multiset of all colors.</p>
 		 * @see Hypergraph
 		 * @see HGSignature
 		 * @author Jan Stückrath
@@ -42,7 +48,9 @@ namespace uncover {
 
 				/**
 				 * Computes the signature for a Hypergraph. The current content of the given 'signature' parameter is
-				 * deleted and replaced by a detailed signature. A shorter signature is returned.
+				 * deleted and replaced by a detailed signature, i.e. the final color of each vertex and edge. Vertices
+				 * and edges of isomorphic graphs mapped to each other by an isomorphism have the same color. A shorter
+				 * signature of the whole graph is returned.
 				 * @param graph the Hypergraph for which the signature will be created
 				 * @param signature a container to store the computed (detailed) signature
 				 * @return a short signature
@@ -62,21 +70,27 @@ namespace uncover {
 				SignatureCreater();
 
 				/**
-				 * Computes a hash value for a string. This function uses the ELF hash function to generate hash values
-				 * for labels of edges.
+				 * Computes a hash value for a string using the FNV-1a hash function. This function is used to generate
+				 * hash values for labels of edges.
 				 * @param s the string to be hashed
 				 * @return a hash value
 				 */
-				static PartSig hashFromString(string s);
+				static PartSig hashFromString(string const& s);
 
 				/**
-				 * Computes a hash value for an edge based on its label and attached vertices.
-				 * @param old the old hash of the edge (usually the a hash of the label)
-				 * @param label the label of the edge
-				 * @param neighborCert the hash values of each attached vertices
-				 * @return a hash of the edge
+				 * Combines the given hash value with another value. The result depends on the order of combination.
+				 * @param seed the hash value to be extended
+				 * @param value the value added to the hash
+				 * @return the combined hash value
 				 */
-				static PartSig newCert(PartSig const& old, string label, vector<PartSig> const& neighborCert);
+				static PartSig combine(PartSig seed, PartSig value);
+
+				/**
+				 * Returns the number of distinct colors in the given signature.
+				 * @param signature the signature whose colors will be counted
+				 * @return the number of distinct colors
+				 */
+				static size_t countColors(HGSignature const& signature);
 
 		};
 
@@ -79,6 +79,13 @@ namespace uncover {
 			return true;
 		}
 
+		void UQRuleInstance::fillMatchConstraints(MatchConstraints& constraints) const {
+			AnonRule::fillMatchConstraints(constraints);
+			for(auto vIt = rightUQVertices.cbegin(); vIt != rightUQVertices.cend(); ++vIt) {
+				constraints.addExactDegree(*vIt);
+			}
+		}
+
 		void UQRuleInstance::fillSplitRule(pair<AnonRule_sp, AnonRule_sp>& rulePair) const {
 
 			UQRuleInstance_sp total = make_shared<UQRuleInstance>(*this);
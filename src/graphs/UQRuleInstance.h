@@ -117,6 +117,14 @@ namespace uncover {
 				 */
 				virtual bool isBackApplicable(AnonHypergraph const& graph, Mapping const& match) const override;
 
+				/**
+				 * Adds the conditions checked by isBackApplicable(...) to the given MatchConstraints. Additionally
+				 * to the conditions of the AnonRule, every image of a universally quantified vertex requires an
+				 * exact degree.
+				 * @param constraints the MatchConstraints to which the conditions are added
+				 */
+				virtual void fillMatchConstraints(MatchConstraints& constraints) const override;
+
 				virtual void fillSplitRule(pair<AnonRule_sp, AnonRule_sp>& rulePair) const override;
 
 			protected:
@@ -0,0 +1,184 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef CONCURRENTRINGBUFFER_H_
+#define CONCURRENTRINGBUFFER_H_
+
+#include <atomic>
+#include <utility>
+#include "../basic_types/globals.h"
+
+namespace uncover {
+	namespace logging {
+
+		/**
+		 * ConcurrentRingBuffer is a bounded, lock-free queue which can be used by an arbitrary number of producer and
+		 * consumer threads at the same time. The capacity is rounded up to the next power of two and fixed at
+		 * construction. Every slot carries a sequence number, which tells producers and consumers whether the slot
+		 * is currently free or filled, such that neither side ever has to acquire a lock. The algorithm is the
+		 * bounded MPMC queue of Dmitry Vyukov.
+		 * @author Jan Stückrath
+		 */
+		template<typename T>
+		class ConcurrentRingBuffer {
+
+			public:
+
+				/**
+				 * Creates a new, empty ConcurrentRingBuffer which can store at least the given number of elements.
+				 * @param capacity the minimal number of elements this buffer can store at the same time
+				 */
+				ConcurrentRingBuffer(size_t capacity) : cells(nullptr), mask(0), enqueuePos(0), dequeuePos(0) {
+					size_t realCapacity = 2;
+					while(realCapacity < capacity) {
+						realCapacity <<= 1;
+					}
+					mask = realCapacity - 1;
+					cells.reset(new Cell[realCapacity]);
+					for(size_t i = 0; i < realCapacity; ++i) {
+						cells[i].sequence.store(i, std::memory_order_relaxed);
+					}
+				}
+
+				/**
+				 * Destroys this ConcurrentRingBuffer and all elements still stored.
+				 */
+				~ConcurrentRingBuffer() {}
+
+				/**
+				 * Tries to append the given element at the end of this buffer. If the buffer is full, the element is not
+				 * moved and false is returned.
+				 * @param element the element to be appended; is moved into the buffer on success
+				 * @return true, iff the element was added
+				 */
+				bool tryPush(T& element) {
+					size_t pos = enqueuePos.load(std::memory_order_relaxed);
+					while(true) {
+						Cell& cell = cells[pos & mask];
+						size_t seq = cell.sequence.load(std::memory_order_acquire);
+						long diff = (long)seq - (long)pos;
+						if(diff == 0) {
+							// the slot is free, try to claim it
+							if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+								cell.data = std::move(element);
+								cell.sequence.store(pos + 1, std::memory_order_release);
+								return true;
+							}
+						} else if(diff < 0) {
+							// the slot was not consumed yet, i.e. the buffer is full
+							return false;
+						} else {
+							pos = enqueuePos.load(std::memory_order_relaxed);
+						}
+					}
+				}
+
+				/**
+				 * Tries to remove the first element of this buffer. If the buffer is empty, the given reference is not
+				 * changed and false is returned.
+				 * @param element the reference to which the removed element is moved on success
+				 * @return true, iff an element was removed
+				 */
+				bool tryPop(T& element) {
+					size_t pos = dequeuePos.load(std::memory_order_relaxed);
+					while(true) {
+						Cell& cell = cells[pos & mask];
+						size_t seq = cell.sequence.load(std::memory_order_acquire);
+						long diff = (long)seq - (long)(pos + 1);
+						if(diff == 0) {
+							// the slot is filled, try to claim it
+							if(dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+								element = std::move(cell.data);
+								cell.sequence.store(pos + mask + 1, std::memory_order_release);
+								return true;
+							}
+						} else if(diff < 0) {
+							// the slot was not filled yet, i.e. the buffer is empty
+							return false;
+						} else {
+							pos = dequeuePos.load(std::memory_order_relaxed);
+						}
+					}
+				}
+
+				/**
+				 * Returns the number of elements which can be stored in this buffer at the same time.
+				 * @return the capacity of this buffer
+				 */
+				size_t capacity() const {
+					return mask + 1;
+				}
+
+			private:
+
+				/**
+				 * A single slot of the buffer. The sequence number states whether the slot can be written to (sequence
+				 * equals the position of the writer) or read from (sequence equals the position of the reader plus one).
+				 */
+				struct Cell {
+
+					/**
+					 * Stores the sequence number of this slot.
+					 */
+					std::atomic<size_t> sequence;
+
+					/**
+					 * Stores the element of this slot, if the slot is filled.
+					 */
+					T data;
+
+				};
+
+				/**
+				 * Padding used to place the positions of producers and consumers on different cache lines.
+				 */
+				typedef char CacheLinePad[64];
+
+				/**
+				 * Stores all slots of this buffer.
+				 */
+				unique_ptr<Cell[]> cells;
+
+				/**
+				 * Stores the capacity minus one, used to compute positions modulo the capacity.
+				 */
+				size_t mask;
+
+				CacheLinePad pad0;
+
+				/**
+				 * Stores the next position to which an element will be written.
+				 */
+				std::atomic<size_t> enqueuePos;
+
+				CacheLinePad pad1;
+
+				/**
+				 * Stores the next position from which an element will be read.
+				 */
+				std::atomic<size_t> dequeuePos;
+
+				CacheLinePad pad2;
+
+		};
+
+	} /* namespace logging */
+} /* namespace uncover */
+
+#endif /* CONCURRENTRINGBUFFER_H_ */
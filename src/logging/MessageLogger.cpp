@@ -20,41 +20,113 @@
 #include "MessageLogger.h"
 #include <time.h>
 #include <iomanip>
+#include <sstream>
+#include <chrono>
 
 using namespace std;
 
 namespace uncover {
 	namespace logging {
 
-		MessageLogger::MessageLogger(std::ostream& ostr) : devnull(nullptr),
-				mainstream(ostr),
-				currLevel(LogTypes::LT_None),
-				messageStreaming(false) {}
+		struct MessageLogger::ThreadState {
+
+			ThreadState() : buffer(),
+					devnull(nullptr),
+					currLevel(LogTypes::LT_None),
+					messageStreaming(false),
+					owner(nullptr),
+					lastTime(0),
+					lastTimeString() {}
+
+			/**
+			 * The buffer containing the message currently streamed by this thread.
+			 */
+			ostringstream buffer;
+
+			/**
+			 * This output stream discards all information sent to it.
+			 */
+			std::ostream devnull;
+
+			/**
+			 * Stores the log level of the message currently streamed.
+			 */
+			LogTypes currLevel;
+
+			/**
+			 * Stores whether there is a message currently streamed.
+			 */
+			bool messageStreaming;
+
+			/**
+			 * The MessageLogger to which the message currently streamed belongs.
+			 */
+			MessageLogger* owner;
+
+			/**
+			 * The time (in seconds) for which lastTimeString was generated.
+			 */
+			time_t lastTime;
+
+			/**
+			 * The formatted time stamp of lastTime.
+			 */
+			string lastTimeString;
+
+		};
+
+		MessageLogger::MessageLogger(std::ostream& ostr, bool async) : mainstream(ostr),
+				async(async),
+				queue(4096),
+				pending(0),
+				stopFlusher(false),
+				streamMutex(),
+				flusher() {
+			if(async) {
+				flusher = thread(&MessageLogger::runFlusher, this);
+			}
+		}
+
+		MessageLogger::~MessageLogger() {
+			if(flusher.joinable()) {
+				stopFlusher.store(true);
+				flusher.join();
+			}
+			mainstream.flush();
+		}
 
-		MessageLogger::~MessageLogger() {}
+		MessageLogger::ThreadState& MessageLogger::getThreadState() {
+			static thread_local ThreadState state;
+			return state;
+		}
 
 		ostream& MessageLogger::newMsg(LogTypes logType) {
-			if(messageStreaming) {
+			ThreadState& state = getThreadState();
+			if(state.messageStreaming) {
 				endMsg();
 			}
-			currLevel = logType;
-			messageStreaming = true;
-			if(currLevel <= gl_LogLevel) {
-				streamHeader(mainstream,currLevel);
-				return mainstream;
+			state.owner = this;
+			state.currLevel = logType;
+			state.messageStreaming = true;
+			if(logType <= gl_LogLevel) {
+				state.buffer.str(string());
+				state.buffer.clear();
+				streamHeader(state,logType);
+				return state.buffer;
 			} else {
-				return devnull;
+				return state.devnull;
 			}
 		}
 
 		ostream& MessageLogger::contMsg() {
-			if(!messageStreaming) {
+			ThreadState& state = getThreadState();
+			if(!state.messageStreaming) {
 				newMsg(LogTypes::LT_None);
 			}
-			if(currLevel <= gl_LogLevel) {
-				return mainstream;
+			if(state.currLevel <= gl_LogLevel) {
+				return state.buffer;
 			} else {
-				return devnull;
+				return state.devnull;
 			}
 		}
 
@@ -79,27 +151,100 @@ namespace uncover {
 		}
 
 		void MessageLogger::endMsg() {
-			if(currLevel <= gl_LogLevel) {
-				mainstream << endl;
+			ThreadState& state = getThreadState();
+			if(state.messageStreaming && state.currLevel <= gl_LogLevel) {
+				// the message is published by the logger which started it
+				MessageLogger* target = state.owner ? state.owner : this;
+				state.buffer << '\n';
+				string message = state.buffer.str();
+				target->publish(message,state.currLevel);
+			}
+			state.currLevel = LogTypes::LT_None;
+			state.messageStreaming = false;
+			state.owner = nullptr;
+		}
+
+		bool MessageLogger::isActive(LogTypes logType) const {
+			return logType <= gl_LogLevel;
+		}
+
+		void MessageLogger::flush() {
+			while(pending.load() > 0) {
+				this_thread::yield();
 			}
-			currLevel = LogTypes::LT_None;
-			messageStreaming = false;
+			lock_guard<mutex> lock(streamMutex);
+			mainstream.flush();
 		}
 
-		void MessageLogger::streamCurrentTime(ostream& ost) {
+		void MessageLogger::streamHeader(ThreadState& state, LogTypes logType) {
 			time_t rawtime;
 			time(&rawtime);
-			struct tm * timeinfo = localtime(&rawtime);
-			ost << setfill('0') << setw(2) << timeinfo->tm_mday << "." << setw(2) << (timeinfo->tm_mon+1)
-					<< "." << setw(4) << (timeinfo->tm_year+1900) << " " << setw(2) << timeinfo->tm_hour
-					<< ":" << setw(2) << timeinfo->tm_min << ":" << setw(2) << timeinfo->tm_sec;
+			if(rawtime != state.lastTime || state.lastTimeString.empty()) {
+				struct tm timeinfo;
+				localtime_r(&rawtime,&timeinfo);
+				ostringstream ost;
+				ost << setfill('0') << setw(2) << timeinfo.tm_mday << "." << setw(2) << (timeinfo.tm_mon+1)
+						<< "." << setw(4) << (timeinfo.tm_year+1900) << " " << setw(2) << timeinfo.tm_hour
+						<< ":" << setw(2) << timeinfo.tm_min << ":" << setw(2) << timeinfo.tm_sec;
+				state.lastTime = rawtime;
+				state.lastTimeString = ost.str();
+			}
+			state.buffer << "[" << state.lastTimeString << " " << gl_logTypeToString(logType) << "] ";
+		}
+
+		void MessageLogger::publish(string& message, LogTypes logType) {
+			if(!async) {
+				lock_guard<mutex> lock(streamMutex);
+				mainstream << message;
+				mainstream.flush();
+				return;
+			}
+			++pending;
+			// messages are never dropped; if the buffer is full, wait for the background thread
+			while(!queue.tryPush(message)) {
+				this_thread::yield();
+			}
+			if(logType == LogTypes::LT_CriticalError) {
+				flush();
+			}
 		}
 
-		ostream& MessageLogger::streamHeader(ostream& ost, LogTypes logType) {
-			ost << "[";
-			streamCurrentTime(ost);
-			ost << " " << gl_logTypeToString(logType) << "] ";
-			return ost;
+		void MessageLogger::runFlusher() {
+			unsigned int idleRounds = 0;
+			while(true) {
+				bool written;
+				{
+					lock_guard<mutex> lock(streamMutex);
+					written = writeQueued();
+				}
+				if(written) {
+					idleRounds = 0;
+				} else if(stopFlusher.load()) {
+					// messages may have been pushed after the last check
+					lock_guard<mutex> lock(streamMutex);
+					writeQueued();
+					return;
+				} else if(idleRounds < 64) {
+					++idleRounds;
+					this_thread::yield();
+				} else {
+					this_thread::sleep_for(chrono::milliseconds(2));
+				}
+			}
+		}
+
+		bool MessageLogger::writeQueued() {
+			string message;
+			bool written = false;
+			while(queue.tryPop(message)) {
+				mainstream << message;
+				--pending;
+				written = true;
+			}
+			if(written) {
+				mainstream.flush();
+			}
+			return written;
 		}
 
 	} /* namespace logging */
@@ -21,8 +21,12 @@
 #define MESSAGELOGGER_H_
 
 #include <ostream>
+#include <atomic>
+#include <thread>
+#include <mutex>
 #include "../basic_types/globals.h"
 #include "../basic_types/standard_operators.h"
+#include "ConcurrentRingBuffer.h"
 
 namespace uncover {
 	namespace logging {
@@ -32,6 +36,10 @@ namespace uncover {
 		 * which will return a reference to an output stream. This stream can then be used to stream the message. If the message is finished,
 		 * the endMsg() function needs to be called. If the message is still unfinished, contMsg() can be used to retrieve the current
 		 * output stream.
+		 * Every thread streams its messages into its own buffer, hence messages of different threads never interleave. By default
+		 * finished messages are handed to a lock-free ring buffer and written to the output stream by a background thread, such
+		 * that logging never waits for the output stream. Messages of a log type above gl_LogLevel are streamed into a stream in
+		 * a failed state, i.e. their arguments are not formatted at all.
 		 * @author Jan Stückrath
 		 */
 		class MessageLogger {
@@ -39,12 +47,17 @@ namespace uncover {
 			public:
 
 				/**
-				 * Creates a new MessageLogger which will use the given output stream to stream messages.
+				 * Creates a new MessageLogger which will use the given output stream to stream messages. If asynchronous
+				 * logging is enabled (default), finished messages are written to the output stream by a background thread.
+				 * Otherwise every message is written and flushed when it is ended.
+				 * @param ostr the output stream to which all messages are written
+				 * @param async if true (default), messages are written by a background thread
 				 */
-				MessageLogger(std::ostream& ostr);
+				MessageLogger(std::ostream& ostr, bool async = true);
 
 				/**
-				 * Destroys the current MessageLogger instance.
+				 * Destroys the current MessageLogger instance. All messages ended before are written to the output stream
+				 * before the background thread (if any) is stopped.
 				 */
 				virtual ~MessageLogger();
 
@@ -105,30 +118,65 @@ namespace uncover {
 				std::ostream& newCriticalError();
 
 				/**
-				 * Ends the currently stream message.
+				 * Ends the message currently streamed by the calling thread. Critical errors are written to the output
+				 * stream before this function returns.
 				 */
 				void endMsg();
 
+				/**
+				 * Returns true, iff messages of the given log type are currently written to the output stream. Can be used
+				 * to skip expensive computations which are only needed for a log message.
+				 * @param logType the log type to check
+				 * @return true, iff messages of the given log type are not discarded
+				 */
+				bool isActive(LogTypes logType) const;
+
+				/**
+				 * Blocks until all messages ended before calling this function are written to the output stream and
+				 * flushes the output stream.
+				 */
+				void flush();
+
 			private:
 
 				/**
-				 * Streams the current time stamp in the format 'day.month.year hour:minute:second'.
-				 * @param ost the stream to which the current time stamp will be printed
+				 * Stores the message streamed by one thread. Each thread has exactly one ThreadState.
+				 */
+				struct ThreadState;
+
+				/**
+				 * Returns the ThreadState of the calling thread.
+				 * @return the ThreadState of the calling thread
 				 */
-				void streamCurrentTime(std::ostream& ost);
+				static ThreadState& getThreadState();
 
 				/**
-				 * Streams a header for a log message of the given type to the given stream. This includes a time stamp
-				 * and an abbreviation of the messages log type.
-				 * @param ost the stream to which the header will be printed
+				 * Streams a header for a log message of the given type to the buffer of the given ThreadState. This includes
+				 * a time stamp in the format 'day.month.year hour:minute:second' and an abbreviation of the messages log type.
+				 * @param state the ThreadState to whose buffer the header will be printed
 				 * @param logType the type of the log message for which the header will be generated
 				 */
-				std::ostream& streamHeader(std::ostream& ost, LogTypes logType);
+				void streamHeader(ThreadState& state, LogTypes logType);
 
 				/**
-				 * This output stream discards all information sent to it.
+				 * Writes the given finished message to the output stream or hands it over to the background thread.
+				 * @param message the finished message, including its header and line break
+				 * @param logType the type of the finished message
 				 */
-				std::ostream devnull;
+				void publish(string& message, LogTypes logType);
+
+				/**
+				 * The function executed by the background thread. Writes all messages of the ring buffer to the output stream
+				 * until the MessageLogger is destroyed.
+				 */
+				void runFlusher();
+
+				/**
+				 * Writes all messages currently stored in the ring buffer to the output stream. The streamMutex has to be
+				 * locked by the caller.
+				 * @return true, iff at least one message was written
+				 */
+				bool writeQueued();
 
 				/**
 				 * Stores the output stream given this MessageLogger while instantiation. Will be used for streaming the log messages.
@@ -136,14 +184,34 @@ namespace uncover {
 				std::ostream& mainstream;
 
 				/**
-				 * Stores the log level of the message currently streamed.
+				 * Stores whether messages are written by a background thread.
+				 */
+				const bool async;
+
+				/**
+				 * Stores all finished messages which were not yet written to the output stream.
+				 */
+				ConcurrentRingBuffer<string> queue;
+
+				/**
+				 * Stores the number of finished messages which were not yet written to the output stream.
+				 */
+				std::atomic<size_t> pending;
+
+				/**
+				 * Is set to true if the background thread should terminate.
+				 */
+				std::atomic<bool> stopFlusher;
+
+				/**
+				 * Guards all write operations on the output stream.
 				 */
-				LogTypes currLevel;
+				std::mutex streamMutex;
 
 				/**
-				 * Stores whether there is a message currently streamed.
+				 * Stores the background thread writing messages to the output stream, if asynchronous logging is used.
 				 */
-				bool messageStreaming;
+				std::thread flusher;
 
 		};
 
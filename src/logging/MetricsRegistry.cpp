@@ -0,0 +1,208 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "MetricsRegistry.h"
+#include <limits>
+
+using namespace std;
+
+namespace uncover {
+	namespace logging {
+
+		Counter::Counter() : value(0) {}
+
+		Counter::~Counter() {}
+
+		uint64_t Counter::getValue() const {
+			return value.load(memory_order_relaxed);
+		}
+
+		void Counter::reset() {
+			value.store(0, memory_order_relaxed);
+		}
+
+		Gauge::Gauge() : value(0) {}
+
+		Gauge::~Gauge() {}
+
+		int64_t Gauge::getValue() const {
+			return value.load(memory_order_relaxed);
+		}
+
+		void Gauge::reset() {
+			value.store(0, memory_order_relaxed);
+		}
+
+		Histogram::Histogram() : count(0), sum(0), min(numeric_limits<uint64_t>::max()), max(0) {
+			for(size_t i = 0; i < BUCKET_COUNT; ++i) {
+				buckets[i].store(0, memory_order_relaxed);
+			}
+		}
+
+		Histogram::~Histogram() {}
+
+		void Histogram::record(uint64_t value) {
+			size_t bucket = 0;
+			for(uint64_t rest = value; rest > 0; rest >>= 1) {
+				++bucket;
+			}
+			buckets[bucket].fetch_add(1, memory_order_relaxed);
+			count.fetch_add(1, memory_order_relaxed);
+			sum.fetch_add(value, memory_order_relaxed);
+			uint64_t current = min.load(memory_order_relaxed);
+			while(value < current && !min.compare_exchange_weak(current, value, memory_order_relaxed)) {}
+			current = max.load(memory_order_relaxed);
+			while(value > current && !max.compare_exchange_weak(current, value, memory_order_relaxed)) {}
+		}
+
+		uint64_t Histogram::getCount() const {
+			return count.load(memory_order_relaxed);
+		}
+
+		uint64_t Histogram::getSum() const {
+			return sum.load(memory_order_relaxed);
+		}
+
+		uint64_t Histogram::getMin() const {
+			return (getCount() == 0) ? 0 : min.load(memory_order_relaxed);
+		}
+
+		uint64_t Histogram::getMax() const {
+			return max.load(memory_order_relaxed);
+		}
+
+		uint64_t Histogram::getBucketCount(size_t bucket) const {
+			return buckets[bucket].load(memory_order_relaxed);
+		}
+
+		void Histogram::reset() {
+			count.store(0, memory_order_relaxed);
+			sum.store(0, memory_order_relaxed);
+			min.store(numeric_limits<uint64_t>::max(), memory_order_relaxed);
+			max.store(0, memory_order_relaxed);
+			for(size_t i = 0; i < BUCKET_COUNT; ++i) {
+				buckets[i].store(0, memory_order_relaxed);
+			}
+		}
+
+		MetricsRegistry::MetricsRegistry() : registryMutex(), enabled(false), counters(), gauges(), histograms() {}
+
+		MetricsRegistry::~MetricsRegistry() {}
+
+		Counter& MetricsRegistry::getCounter(string const& name) {
+			lock_guard<mutex> lock(registryMutex);
+			unique_ptr<Counter>& entry = counters[name];
+			if(!entry) {
+				entry.reset(new Counter());
+			}
+			return *entry;
+		}
+
+		Gauge& MetricsRegistry::getGauge(string const& name) {
+			lock_guard<mutex> lock(registryMutex);
+			unique_ptr<Gauge>& entry = gauges[name];
+			if(!entry) {
+				entry.reset(new Gauge());
+			}
+			return *entry;
+		}
+
+		Histogram& MetricsRegistry::getHistogram(string const& name) {
+			lock_guard<mutex> lock(registryMutex);
+			unique_ptr<Histogram>& entry = histograms[name];
+			if(!entry) {
+				entry.reset(new Histogram());
+			}
+			return *entry;
+		}
+
+		bool MetricsRegistry::isEnabled() const {
+			return enabled.load(memory_order_relaxed);
+		}
+
+		void MetricsRegistry::setEnabled(bool enabled) {
+			this->enabled.store(enabled, memory_order_relaxed);
+		}
+
+		void MetricsRegistry::reset() {
+			lock_guard<mutex> lock(registryMutex);
+			for(auto& entry : counters) {
+				entry.second->reset();
+			}
+			for(auto& entry : gauges) {
+				entry.second->reset();
+			}
+			for(auto& entry : histograms) {
+				entry.second->reset();
+			}
+		}
+
+		void MetricsRegistry::writeJSON(ostream& ost, string const& label) const {
+			lock_guard<mutex> lock(registryMutex);
+			ost << "{\"label\":\"" << label << "\",\"counters\":{";
+			for(auto it = counters.cbegin(); it != counters.cend(); ++it) {
+				if(it != counters.cbegin()) ost << ",";
+				ost << "\"" << it->first << "\":" << it->second->getValue();
+			}
+			ost << "},\"gauges\":{";
+			for(auto it = gauges.cbegin(); it != gauges.cend(); ++it) {
+				if(it != gauges.cbegin()) ost << ",";
+				ost << "\"" << it->first << "\":" << it->second->getValue();
+			}
+			ost << "},\"histograms\":{";
+			for(auto it = histograms.cbegin(); it != histograms.cend(); ++it) {
+				if(it != histograms.cbegin()) ost << ",";
+				Histogram const& hist = *(it->second);
+				ost << "\"" << it->first << "\":{\"count\":" << hist.getCount() << ",\"sum\":" << hist.getSum();
+				ost << ",\"min\":" << hist.getMin() << ",\"max\":" << hist.getMax() << ",\"buckets\":[";
+				// omit trailing empty buckets
+				size_t used = Histogram::BUCKET_COUNT;
+				while(used > 0 && hist.getBucketCount(used-1) == 0) {
+					--used;
+				}
+				for(size_t i = 0; i < used; ++i) {
+					if(i > 0) ost << ",";
+					ost << hist.getBucketCount(i);
+				}
+				ost << "]}";
+			}
+			ost << "}}" << "\n";
+		}
+
+		void MetricsRegistry::writeCSV(ostream& ost, string const& label) const {
+			lock_guard<mutex> lock(registryMutex);
+			for(auto it = counters.cbegin(); it != counters.cend(); ++it) {
+				ost << label << ",counter," << it->first << "," << it->second->getValue() << ",,,\n";
+			}
+			for(auto it = gauges.cbegin(); it != gauges.cend(); ++it) {
+				ost << label << ",gauge," << it->first << "," << it->second->getValue() << ",,,\n";
+			}
+			for(auto it = histograms.cbegin(); it != histograms.cend(); ++it) {
+				Histogram const& hist = *(it->second);
+				ost << label << ",histogram," << it->first << "," << hist.getSum() << "," << hist.getCount();
+				ost << "," << hist.getMin() << "," << hist.getMax() << "\n";
+			}
+		}
+
+		void MetricsRegistry::writeCSVHeader(ostream& ost) {
+			ost << "label,type,name,value,count,min,max\n";
+		}
+
+	} /* namespace logging */
+} /* namespace uncover */
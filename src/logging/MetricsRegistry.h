@@ -0,0 +1,342 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef METRICSREGISTRY_H_
+#define METRICSREGISTRY_H_
+
+#include <ostream>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <cstdint>
+#include "../basic_types/globals.h"
+
+namespace uncover {
+	namespace logging {
+
+		/**
+		 * A Counter is a monotonically increasing metric, e.g. the number of processed graphs. Increasing a Counter is
+		 * lock-free and may be done by several threads at the same time.
+		 * @author Jan Stückrath
+		 */
+		class Counter {
+
+			public:
+
+				/**
+				 * Creates a new Counter with value 0.
+				 */
+				Counter();
+
+				/**
+				 * Destroys this Counter.
+				 */
+				virtual ~Counter();
+
+				/**
+				 * Increases the value of this Counter by the given amount.
+				 * @param amount the value which will be added
+				 */
+				void increment(uint64_t amount = 1) {
+					value.fetch_add(amount, std::memory_order_relaxed);
+				}
+
+				/**
+				 * Returns the current value of this Counter.
+				 * @return the current value of this Counter
+				 */
+				uint64_t getValue() const;
+
+				/**
+				 * Sets the value of this Counter to 0.
+				 */
+				void reset();
+
+			private:
+
+				/**
+				 * Stores the current value.
+				 */
+				std::atomic<uint64_t> value;
+
+		};
+
+		/**
+		 * A Gauge is a metric which stores the last value it was set to, e.g. the size of a list.
+		 * @author Jan Stückrath
+		 */
+		class Gauge {
+
+			public:
+
+				/**
+				 * Creates a new Gauge with value 0.
+				 */
+				Gauge();
+
+				/**
+				 * Destroys this Gauge.
+				 */
+				virtual ~Gauge();
+
+				/**
+				 * Sets the value of this Gauge.
+				 * @param newValue the new value
+				 */
+				void set(int64_t newValue) {
+					value.store(newValue, std::memory_order_relaxed);
+				}
+
+				/**
+				 * Returns the current value of this Gauge.
+				 * @return the current value of this Gauge
+				 */
+				int64_t getValue() const;
+
+				/**
+				 * Sets the value of this Gauge to 0.
+				 */
+				void reset();
+
+			private:
+
+				/**
+				 * Stores the current value.
+				 */
+				std::atomic<int64_t> value;
+
+		};
+
+		/**
+		 * A Histogram records the distribution of values, e.g. the time needed for an operation. Besides count, sum,
+		 * minimum and maximum of all recorded values, the number of values in each bucket is stored, where bucket i
+		 * contains all values v with 2^(i-1) <= v < 2^i (bucket 0 contains only the value 0). Recording values is
+		 * lock-free and may be done by several threads at the same time.
+		 * @author Jan Stückrath
+		 */
+		class Histogram {
+
+			public:
+
+				/**
+				 * The number of buckets of every Histogram.
+				 */
+				static const size_t BUCKET_COUNT = 65;
+
+				/**
+				 * Creates a new, empty Histogram.
+				 */
+				Histogram();
+
+				/**
+				 * Destroys this Histogram.
+				 */
+				virtual ~Histogram();
+
+				/**
+				 * Records the given value.
+				 * @param value the value to be recorded
+				 */
+				void record(uint64_t value);
+
+				/**
+				 * Returns the number of recorded values.
+				 * @return the number of recorded values
+				 */
+				uint64_t getCount() const;
+
+				/**
+				 * Returns the sum of all recorded values.
+				 * @return the sum of all recorded values
+				 */
+				uint64_t getSum() const;
+
+				/**
+				 * Returns the smallest recorded value or 0 if no value was recorded.
+				 * @return the smallest recorded value
+				 */
+				uint64_t getMin() const;
+
+				/**
+				 * Returns the largest recorded value or 0 if no value was recorded.
+				 * @return the largest recorded value
+				 */
+				uint64_t getMax() const;
+
+				/**
+				 * Returns the number of recorded values in the given bucket.
+				 * @param bucket the index of the bucket (smaller than BUCKET_COUNT)
+				 * @return the number of values recorded in the given bucket
+				 */
+				uint64_t getBucketCount(size_t bucket) const;
+
+				/**
+				 * Removes all recorded values.
+				 */
+				void reset();
+
+			private:
+
+				/**
+				 * Stores the number of recorded values.
+				 */
+				std::atomic<uint64_t> count;
+
+				/**
+				 * Stores the sum of all recorded values.
+				 */
+				std::atomic<uint64_t> sum;
+
+				/**
+				 * Stores the smallest recorded value.
+				 */
+				std::atomic<uint64_t> min;
+
+				/**
+				 * Stores the largest recorded value.
+				 */
+				std::atomic<uint64_t> max;
+
+				/**
+				 * Stores the number of values recorded per bucket.
+				 */
+				std::atomic<uint64_t> buckets[BUCKET_COUNT];
+
+		};
+
+		/**
+		 * The MetricsRegistry stores named Counter, Gauge and Histogram objects and can write all their values as JSON
+		 * or CSV. Metrics are created on first request and are never deleted, hence references to them can be stored
+		 * (e.g. in static variables) and used without looking them up again. Names should be hierarchical, separated
+		 * by dots (e.g. 'analysis.graphs.processed').
+		 * @author Jan Stückrath
+		 */
+		class MetricsRegistry {
+
+			public:
+
+				/**
+				 * Creates a new, empty MetricsRegistry, which is disabled.
+				 */
+				MetricsRegistry();
+
+				/**
+				 * Destroys this MetricsRegistry and all its metrics.
+				 */
+				virtual ~MetricsRegistry();
+
+				/**
+				 * Returns the Counter with the given name. If it does not exist, it will be created.
+				 * @param name the name of the Counter
+				 * @return the Counter with the given name
+				 */
+				Counter& getCounter(string const& name);
+
+				/**
+				 * Returns the Gauge with the given name. If it does not exist, it will be created.
+				 * @param name the name of the Gauge
+				 * @return the Gauge with the given name
+				 */
+				Gauge& getGauge(string const& name);
+
+				/**
+				 * Returns the Histogram with the given name. If it does not exist, it will be created.
+				 * @param name the name of the Histogram
+				 * @return the Histogram with the given name
+				 */
+				Histogram& getHistogram(string const& name);
+
+				/**
+				 * Returns true, iff expensive metrics (e.g. time measurements) should be collected. Cheap metrics (e.g.
+				 * counters) are always collected.
+				 * @return true, iff expensive metrics should be collected
+				 */
+				bool isEnabled() const;
+
+				/**
+				 * Sets whether expensive metrics (e.g. time measurements) should be collected.
+				 * @param enabled true, iff expensive metrics should be collected
+				 */
+				void setEnabled(bool enabled);
+
+				/**
+				 * Resets the values of all stored metrics.
+				 */
+				void reset();
+
+				/**
+				 * Writes the values of all metrics as a single line JSON object to the given stream. The object contains
+				 * the given label and one object for each metric type.
+				 * @param ost the stream to which the metrics will be written
+				 * @param label the label identifying this snapshot (e.g. the number of the backward step)
+				 */
+				void writeJSON(std::ostream& ost, string const& label) const;
+
+				/**
+				 * Writes the values of all metrics as CSV to the given stream. Every metric is written in its own line,
+				 * with the columns given by writeCSVHeader().
+				 * @param ost the stream to which the metrics will be written
+				 * @param label the label identifying this snapshot (e.g. the number of the backward step)
+				 */
+				void writeCSV(std::ostream& ost, string const& label) const;
+
+				/**
+				 * Writes the header line of the CSV format used by writeCSV() to the given stream.
+				 * @param ost the stream to which the header will be written
+				 */
+				static void writeCSVHeader(std::ostream& ost);
+
+			private:
+
+				/**
+				 * Guards the creation and enumeration of metrics.
+				 */
+				mutable std::mutex registryMutex;
+
+				/**
+				 * Stores whether expensive metrics should be collected.
+				 */
+				std::atomic<bool> enabled;
+
+				/**
+				 * Maps names to counters.
+				 */
+				std::map<string,unique_ptr<Counter>> counters;
+
+				/**
+				 * Maps names to gauges.
+				 */
+				std::map<string,unique_ptr<Gauge>> gauges;
+
+				/**
+				 * Maps names to histograms.
+				 */
+				std::map<string,unique_ptr<Histogram>> histograms;
+
+		};
+
+		/**
+		 * The main registry for all metrics. Has to be initialized by the main program.
+		 */
+		extern MetricsRegistry metrics;
+
+	} /* namespace logging */
+} /* namespace uncover */
+
+#endif /* METRICSREGISTRY_H_ */
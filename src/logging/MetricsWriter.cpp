@@ -0,0 +1,121 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "MetricsWriter.h"
+#include "../basic_types/InitialisationException.h"
+#include <chrono>
+#include <sstream>
+
+using namespace std;
+using namespace uncover::basic_types;
+
+namespace uncover {
+	namespace logging {
+
+		MetricsWriter::MetricsWriter(MetricsRegistry& registry, string const& filename, MetricsFormat format)
+				: registry(registry),
+				  format(format),
+				  output(filename.c_str(), ios::out | ios::trunc),
+				  periodicOutput(),
+				  periodicMutex(),
+				  periodicCondition(),
+				  stopPeriodic(false),
+				  periodicThread() {
+			if(!output.is_open()) {
+				throw InitialisationException("Could not open file '" + filename + "' for writing metrics.");
+			}
+			if(format == MetricsFormat::MF_CSV) {
+				MetricsRegistry::writeCSVHeader(output);
+			}
+		}
+
+		MetricsWriter::~MetricsWriter() {
+			stopPeriodicSnapshots();
+		}
+
+		void MetricsWriter::writeSnapshot(string const& label) {
+			writeTo(output, label);
+		}
+
+		void MetricsWriter::startPeriodicSnapshots(string const& filename, unsigned int interval) {
+			if(periodicThread.joinable()) {
+				return;
+			}
+			periodicOutput.open(filename.c_str(), ios::out | ios::trunc);
+			if(!periodicOutput.is_open()) {
+				throw InitialisationException("Could not open file '" + filename + "' for writing periodic metrics.");
+			}
+			if(format == MetricsFormat::MF_CSV) {
+				MetricsRegistry::writeCSVHeader(periodicOutput);
+			}
+			stopPeriodic = false;
+			periodicThread = thread(&MetricsWriter::runPeriodic, this, (interval == 0) ? 1 : interval);
+		}
+
+		void MetricsWriter::stopPeriodicSnapshots() {
+			if(!periodicThread.joinable()) {
+				return;
+			}
+			{
+				lock_guard<mutex> lock(periodicMutex);
+				stopPeriodic = true;
+			}
+			periodicCondition.notify_all();
+			periodicThread.join();
+			periodicOutput.close();
+		}
+
+		MetricsFormat MetricsWriter::getFormat() const {
+			return format;
+		}
+
+		string MetricsWriter::getFileExtension(MetricsFormat format) {
+			switch(format) {
+				case MetricsFormat::MF_CSV:
+					return "csv";
+				default:
+					return "json";
+			}
+		}
+
+		void MetricsWriter::writeTo(ofstream& ost, string const& label) {
+			if(format == MetricsFormat::MF_CSV) {
+				registry.writeCSV(ost, label);
+			} else {
+				registry.writeJSON(ost, label);
+			}
+			ost.flush();
+		}
+
+		void MetricsWriter::runPeriodic(unsigned int interval) {
+			auto start = chrono::steady_clock::now();
+			unique_lock<mutex> lock(periodicMutex);
+			while(true) {
+				bool stopped = periodicCondition.wait_for(lock, chrono::seconds(interval), [this]() { return stopPeriodic; });
+				stringstream label;
+				label << chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now() - start).count() << "s";
+				writeTo(periodicOutput, label.str());
+				if(stopped) {
+					return;
+				}
+			}
+		}
+
+	} /* namespace logging */
+} /* namespace uncover */
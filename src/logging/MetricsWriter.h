@@ -0,0 +1,163 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef METRICSWRITER_H_
+#define METRICSWRITER_H_
+
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "MetricsRegistry.h"
+
+namespace uncover {
+	namespace logging {
+
+		/**
+		 * The formats in which metrics can be written.
+		 */
+		enum MetricsFormat {
+			MF_JSON, //!< one JSON object per snapshot and line
+			MF_CSV //!< one CSV line per metric and snapshot
+		};
+
+		/**
+		 * A MetricsWriter appends snapshots of all metrics of a MetricsRegistry to a file. Snapshots can be written on
+		 * request (e.g. after each backward step) and periodically by a background thread, which uses its own file.
+		 * @author Jan Stückrath
+		 */
+		class MetricsWriter {
+
+			public:
+
+				/**
+				 * Creates a new MetricsWriter, writing the metrics of the given registry to the given file. An existing
+				 * file will be overwritten.
+				 * @param registry the registry whose metrics will be written
+				 * @param filename the file to which snapshots will be written
+				 * @param format the format of the snapshots
+				 * @exception InitialisationException if the file could not be opened
+				 */
+				MetricsWriter(MetricsRegistry& registry, string const& filename, MetricsFormat format);
+
+				/**
+				 * Stops periodic snapshots (if started) and closes all files.
+				 */
+				virtual ~MetricsWriter();
+
+				/**
+				 * Appends a snapshot of all metrics to the file given at construction.
+				 * @param label the label identifying this snapshot
+				 */
+				void writeSnapshot(string const& label);
+
+				/**
+				 * Starts a background thread, which appends a snapshot to the given file every given number of seconds.
+				 * The snapshots are labeled with the number of seconds elapsed since this function was called. Calling
+				 * this function while periodic snapshots are running has no effect.
+				 * @param filename the file to which periodic snapshots will be written
+				 * @param interval the number of seconds between two snapshots (at least 1)
+				 * @exception InitialisationException if the file could not be opened
+				 */
+				void startPeriodicSnapshots(string const& filename, unsigned int interval);
+
+				/**
+				 * Stops the periodic snapshots and writes a final snapshot. Does nothing if no periodic snapshots are written.
+				 */
+				void stopPeriodicSnapshots();
+
+				/**
+				 * Returns the format in which snapshots are written.
+				 * @return the format of all snapshots
+				 */
+				MetricsFormat getFormat() const;
+
+				/**
+				 * Returns the file extension (without dot) usually used for the given format.
+				 * @param format the format
+				 * @return the file extension of the given format
+				 */
+				static string getFileExtension(MetricsFormat format);
+
+			private:
+
+				/**
+				 * Writes a snapshot with the given label to the given stream.
+				 * @param ost the stream to which the snapshot is written
+				 * @param label the label of the snapshot
+				 */
+				void writeTo(std::ofstream& ost, string const& label);
+
+				/**
+				 * The function executed by the background thread writing periodic snapshots.
+				 * @param interval the number of seconds between two snapshots
+				 */
+				void runPeriodic(unsigned int interval);
+
+				/**
+				 * The registry whose metrics are written.
+				 */
+				MetricsRegistry& registry;
+
+				/**
+				 * The format of all snapshots.
+				 */
+				MetricsFormat format;
+
+				/**
+				 * The file to which snapshots are written on request.
+				 */
+				std::ofstream output;
+
+				/**
+				 * The file to which periodic snapshots are written.
+				 */
+				std::ofstream periodicOutput;
+
+				/**
+				 * Guards the stop flag of the background thread.
+				 */
+				std::mutex periodicMutex;
+
+				/**
+				 * Used to wake the background thread when it should stop.
+				 */
+				std::condition_variable periodicCondition;
+
+				/**
+				 * Is set to true if the background thread should stop.
+				 */
+				bool stopPeriodic;
+
+				/**
+				 * The background thread writing periodic snapshots.
+				 */
+				std::thread periodicThread;
+
+		};
+
+		/**
+		 * Alias for a shared pointer to a MetricsWriter.
+		 */
+		typedef shared_ptr<MetricsWriter> MetricsWriter_sp;
+
+	} /* namespace logging */
+} /* namespace uncover */
+
+#endif /* METRICSWRITER_H_ */
@@ -17,14 +17,16 @@
  *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
  ***************************************************************************/
 
-#ifndef COMPILE_UNIT_TESTS
+#if !defined(COMPILE_UNIT_TESTS) && !defined(COMPILE_BENCHMARKS)
 
 #include <string.h>
 #include <sstream>
 #include <iostream>
+#include <sys/resource.h>
 #include "basic_types/Scenario.h"
 #include "scenarios/ScenarioLoader.h"
 #include "logging/message_logging.h"
+#include "logging/MetricsRegistry.h"
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 #include "basic_types/Timer.h"
@@ -48,6 +50,9 @@ using namespace uncover::scenarios;
 // initializing the message logger to be cout
 MessageLogger uncover::logging::logger(cout);
 
+// initializing the metrics registry
+MetricsRegistry uncover::logging::metrics;
+
 /**
  * Formats the given quantity of seconds as: w day(s) x hour(s) y minute(s) z second(s)
  * @param seconds the duration of the time span
@@ -94,9 +99,26 @@ void tokenizeAndAddNE(string const& str, vector<string>& vec) {
 	}
 }
 
+/**
+ * Returns the peak resident set size of this process in kilobytes.
+ * @return the peak resident set size in kilobytes or -1 if it could not be determined
+ */
+long getPeakMemoryUsage() {
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF, &usage) != 0) {
+		return -1;
+	}
+#ifdef __APPLE__
+	return usage.ru_maxrss / 1024; // Mac OS X reports bytes
+#else
+	return usage.ru_maxrss;
+#endif
+}
+
 /**
  * Encapsulates a timer, which is started when the TerminationMessage is created. When the TerminationMessage
- * is destroyed, a log message is generated that the scenario has ended, printing also the elapsed time.
+ * is destroyed, a log message is generated that the scenario has ended, printing also the elapsed time and the
+ * peak memory usage.
  * @see Timer
  * @author Jan Stückrath
  */
@@ -113,10 +135,11 @@ class TerminationMessage {
 
 		/**
 		 * Destroys this TerminationMessage. This also prints a log message stating that the scenario has terminated and
-		 * printing the elapsed time.
+		 * printing the elapsed time and peak memory usage.
 		 */
 		~TerminationMessage() {
 			logger.newUserInfo() << "Scenario terminated after " << formatTimeSpan(timer.getElapsedTime()) << "." << endLogMessage;
+			logger.newUserInfo() << "Peak memory usage: " << getPeakMemoryUsage() << " KB." << endLogMessage;
 		}
 
 	private:
@@ -222,7 +245,7 @@ int main ( int argc, char** argv )
 		if(vm.count("output-level")) {
 			int oLevel = vm["output-level"].as<int>();
 			if(oLevel < -1 || oLevel > 4) {
-				cout << WARN_INIT_TEXT << "Invalid output level '" << oLevel << "'. Using default." << endLogMessage;
+				cout << WARN_INIT_TEXT << "Invalid output level '" << oLevel << "'. Using default." << endl;
 			} else {
 				gl_LogLevel = LogTypes(oLevel);
 			}
@@ -82,16 +82,20 @@ namespace uncover {
 			}
 
 			// try every possible mappings for the edges
+			DenseMapping mapp(bigger.getLastUsedID());
+			DenseMapping::Inversion invMapp;
+			unordered_set<IDType> preservedEdges;
 			do {
 
+				if(cancellation) {
+					cancellation->throwIfCancelled();
+				}
+
 				// first generate the corresponding Mapping (of node IDs only)
-				Mapping mapp;
-				unordered_set<IDType> preservedEdges;
 				if(!generateMapp(smaller,bigger,edgesInS,edgesInB,currentEdgeMap,mapp,preservedEdges)) {
 					continue;
 				}
-				Mapping::Inversion invMapp;
-				mapp.getInverseMatch(invMapp);
+				invMapp.assign(mapp);
 
 				// try all possible contractions of other edges
 				if(checkContractions(bigger,mapp,invMapp,preservedEdges,isoNodes)) {
@@ -106,8 +110,8 @@ namespace uncover {
 
 		bool MinorOrder::checkContractions(
 				Hypergraph const& graphB,
-				Mapping const& nodeMap,
-				Mapping::Inversion const& invNodeMap,
+				DenseMapping const& nodeMap,
+				DenseMapping::Inversion const& invNodeMap,
 				unordered_set<IDType> const& preservedEdges,
 				int isoNodes) const {
 
@@ -127,6 +131,11 @@ namespace uncover {
 			size_t skip = 0;
 			do {
 
+				// this loop enumerates exponentially many mergings, hence the token is checked for each of them
+				if(cancellation) {
+					cancellation->throwIfCancelled();
+				}
+
 				// generate initial partition with all non-isolated nodes in an own subpartition
 				IDPartition partition;
 				for(auto it = graphB.cbeginVertices(); it != graphB.cendVertices(); ++it) {
@@ -158,7 +167,7 @@ namespace uncover {
 			return false;
 		}
 
-		inline bool MinorOrder::enoughIsolated(IDPartition const& part, Mapping const& mapp, int num) const {
+		inline bool MinorOrder::enoughIsolated(IDPartition const& part, DenseMapping const& mapp, int num) const {
 
 			// there are at least as much isolated nodes in the larger graph as there are in the smaller graph
 			if(num <= 0) {
@@ -190,13 +199,13 @@ namespace uncover {
 			return true;
 		}
 
-		inline bool MinorOrder::isIncludedIn(IDPartition const& part, Mapping::Inversion const& mapp) const {
+		inline bool MinorOrder::isIncludedIn(IDPartition const& part, DenseMapping::Inversion const& mapp) const {
 
 			// for each set of IDs with the same images under mapp
-			for(auto it = mapp.cbegin(); it != mapp.cend(); ++it) {
+			for(IDType image : mapp.getTargets()) {
 
 				// take one ID and search for the SubIDPartition in which it is contained
-				auto inIt = it->second.cbegin();
+				IDType const* inIt = mapp.beginSrc(image);
 				SubIDPartition const* subPart = nullptr;
 				for(auto& el : part) {
 					if(el.count(*inIt) > 0) {
@@ -212,7 +221,7 @@ namespace uncover {
 					return false;
 				} else {
 					++inIt;
-					for(;inIt != it->second.cend(); ++inIt) {
+					for(;inIt != mapp.endSrc(image); ++inIt) {
 						if(subPart->count(*inIt) == 0) {
 							return false;
 						}
@@ -229,7 +238,7 @@ namespace uncover {
 				map<string, vector<IDType>> const& edgeMapS,
 				map<string, vector<IDType>> const& edgeMapB,
 				vector<pair<string,vector<size_t>>> const& edgesToEdges,
-				graphs::Mapping& nodeMap,
+				graphs::DenseMapping& nodeMap,
 				unordered_set<IDType>& preservedEdges) const {
 
 			nodeMap.clear();
@@ -247,10 +256,10 @@ namespace uncover {
 
 						// add a map entry if none is defined
 						if(!nodeMap.hasSrc(*edgeBit)) {
-							nodeMap[*edgeBit] = *edgeSit;
+							nodeMap.setTar(*edgeBit, *edgeSit);
 
 						// abort if an entry exists and is inconsistent with this mapping
-						} else if (nodeMap[*edgeBit] != *edgeSit) {
+						} else if (nodeMap.getTar(*edgeBit) != *edgeSit) {
 							return false;
 						} // else do nothing
 
@@ -363,7 +372,7 @@ namespace uncover {
 			return vec.size();
 		}
 
-		inline bool MinorOrder::isFiner(IDPartition const& part, Mapping const& mapp) const {
+		inline bool MinorOrder::isFiner(IDPartition const& part, DenseMapping const& mapp) const {
 
 			for(auto& sp : part) {
 				IDType id = 0;
@@ -21,7 +21,7 @@
 #define MINORORDER_H_
 
 #include "../graphs/Hypergraph.h"
-#include "../graphs/Mapping.h"
+#include "../graphs/DenseMapping.h"
 #include "../basic_types/Order.h"
 #include "../basic_types/IDPartitionEnumerator.h"
 
@@ -53,6 +53,7 @@ namespace uncover {
 				 * @param smaller the possible minor
 				 * @param bigger the possibly larger graph
 				 * @return true iff the first graph is a minor of the second
+				 * @exception CancelledException if the set CancellationToken was cancelled during the check
 				 */
 				virtual bool isLessOrEq(graphs::Hypergraph const& smaller, graphs::Hypergraph const& bigger) const override;
 
@@ -60,7 +61,7 @@ namespace uncover {
 
 				/**
 				 * Checks if edges of the given graph can be contracted to obtain a smaller graph. The smaller graph is
-				 * implicitly given by the Mapping and Mapping::Inversion parameters.
+				 * implicitly given by the DenseMapping and DenseMapping::Inversion parameters.
 				 * @param graphB the graph of which edge contractions are simulated
 				 * @param nodeMap the map of nodes of graphB to the smaller graph
 				 * @param invNodeMap the inversion of nodeMap
@@ -70,8 +71,8 @@ namespace uncover {
 				 */
 				bool checkContractions(
 						graphs::Hypergraph const& graphB,
-						graphs::Mapping const& nodeMap,
-						graphs::Mapping::Inversion const& invNodeMap,
+						graphs::DenseMapping const& nodeMap,
+						graphs::DenseMapping::Inversion const& invNodeMap,
 						unordered_set<IDType> const& preservedEdges,
 						int isoNodes) const;
 
@@ -100,7 +101,7 @@ namespace uncover {
 						map<string, vector<IDType>> const& edgeMapS,
 						map<string, vector<IDType>> const& edgeMapB,
 						vector<pair<string,vector<size_t>>> const& edgesToEdges,
-						graphs::Mapping& nodeMap,
+						graphs::DenseMapping& nodeMap,
 						unordered_set<IDType>& preservedEdges) const;
 
 				/**
@@ -158,7 +159,7 @@ namespace uncover {
 				 * @param mapp the Mapping to be tested
 				 * @return true iff the partition is finer (or equally fine)
 				 */
-				bool isFiner(basic_types::IDPartition const& part, graphs::Mapping const& mapp) const;
+				bool isFiner(basic_types::IDPartition const& part, graphs::DenseMapping const& mapp) const;
 
 				/**
 				 * Checks if the given partition is included in the inverse Mapping. A partition is included in an inverse
@@ -167,7 +168,7 @@ namespace uncover {
 				 * @param mapp the inverse Mapping to be tested
 				 * @return true, iff the partition is included in the inverse Mapping
 				 */
-				bool isIncludedIn(basic_types::IDPartition const& part, graphs::Mapping::Inversion const& mapp) const;
+				bool isIncludedIn(basic_types::IDPartition const& part, graphs::DenseMapping::Inversion const& mapp) const;
 
 				/**
 				 * Checks if the given partition has enough subpartitions to be mapped to isolated nodes. Such a mapping is
@@ -178,7 +179,7 @@ namespace uncover {
 				 * @param num the number of isolated nodes the smaller graph has more than the larger graph (may be negative)
 				 * @return true, iff enough subpartitions exist
 				 */
-				bool enoughIsolated(basic_types::IDPartition const& part, graphs::Mapping const& mapp, int num) const;
+				bool enoughIsolated(basic_types::IDPartition const& part, graphs::DenseMapping const& mapp, int num) const;
 
 		};
 
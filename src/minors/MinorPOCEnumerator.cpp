@@ -83,8 +83,13 @@ namespace uncover {
 				logger.contMsg() << "cause results to be incorrect." << endLogMessage;
 			}
 
+			// the split of the rule does not depend on the graph and is cached by the PreparedGTS if available
+			SplitRule_csp split = prepGTS ? prepGTS->getSplitRule(rule) : make_shared<SplitRule>(*rule);
+
+			// the old enumerator is discarded first, since creating the new one may be cancelled
 			if(partialEnumerator) delete partialEnumerator;
-			partialEnumerator = new PartialPOCEnumerator(rule,graph,false,originalRules);
+			partialEnumerator = nullptr;
+			partialEnumerator = new PartialPOCEnumerator(split,graph,false,originalRules,upToIsomorphism,cancellation);
 
 			if(resultHandler && !partialEnumerator->ended()) {
 				resultHandler->wasGeneratedByFrom(partialEnumerator->getGraph(),ruleID,graphID);
@@ -19,9 +19,9 @@
 
 #include "MinorRulePreparer.h"
 #include <sstream>
-#include <math.h>
+#include <set>
+#include <algorithm>
 #include "../logging/message_logging.h"
-#include "../basic_types/RunException.h"
 #include "../basic_types/standard_operators.h"
 #include "../basic_types/IDPartitionEnumerator.h"
 #include "../analysis/rule_preparation_helper.h"
@@ -40,9 +40,29 @@ namespace uncover {
 		MinorRulePreparer::~MinorRulePreparer() {}
 
 		/**
-		 * Adds one IDPartitionEnumerator to the given vector for each edge in genFrom, but only if the edge can be
-		 * contracted in a way which is not also a simple deletion. A real contraction is possible if the edge is
-		 * incident to at least two different vertices which are not already marked to be deleted.
+		 * Advances the given subset, represented by one flag per element, to the next subset in binary counting
+		 * order. Since the number of flags is not limited, arbitrarily large sets can be enumerated.
+		 * @param subset the subset to be advanced
+		 * @return false, iff all subsets were enumerated, i.e. the subset wrapped around to the empty set
+		 */
+		bool nextSubset(vector<bool>& subset) {
+			for(size_t i = 0; i < subset.size(); ++i) {
+				if(subset[i]) {
+					subset[i] = false;
+				} else {
+					subset[i] = true;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Adds one IDPartitionEnumerator to the given vector for each set of vertices which can be merged by
+		 * contracting an edge of genFrom. A real contraction is only possible if the edge is incident to at least
+		 * two different vertices which are not marked to be deleted. Sets of vertices contained in another set are
+		 * ignored, since every partition they contribute to the transitive closure can also be generated by the
+		 * enumerator of the larger set. This avoids enumerating the same partitions multiple times.
 		 * @param enumList the vector to which generated IDPartitionEnumerators will be added
 		 * @param genFrom the set of edges for which IDPartitionEnumerators should be generated
 		 * @param delVertices the set of vertices which are marked to be deleted
@@ -53,39 +73,130 @@ namespace uncover {
 							unordered_set<IDType> const& delVertices,
 							AnonHypergraph const& graph) {
 
+			// search edges for all vertices which are not deleted (and hence mergeable)
+			vector<set<IDType>> mergeableSets;
 			for(auto eit = genFrom.cbegin(); eit != genFrom.cend(); ++eit) {
+				set<IDType> mergeableVertices;
+				vector<IDType> const* attached = graph.getVerticesOfEdge(*eit);
+				for(auto vit = attached->cbegin(); vit != attached->cend(); ++vit) {
+					if(!delVertices.count(*vit)) {
+						mergeableVertices.insert(*vit);
+					}
+				}
+				// ignore edges with at most one non-deleted vertex
+				if(mergeableVertices.size() > 1) {
+					mergeableSets.push_back(mergeableVertices);
+				}
+			}
 
-				// search edges for all nodes which are not deleted (and hence mergeable)
-				vector<IDType> mergeableVertices = *graph.getVerticesOfEdge(*eit);
-				vector<IDType>::iterator vit = mergeableVertices.begin();
-				while(vit != mergeableVertices.end()) {
-					if(delVertices.count(*vit)) {
-						vit = mergeableVertices.erase(vit);
-					} else {
-						++vit;
+			// only keep sets not contained in another set, larger sets first
+			sort(mergeableSets.begin(), mergeableSets.end(), [](set<IDType> const& s1, set<IDType> const& s2) {
+				return s1.size() > s2.size() || (s1.size() == s2.size() && s1 < s2);
+			});
+			vector<set<IDType>*> kept;
+			for(set<IDType>& candidate : mergeableSets) {
+				bool contained = false;
+				for(set<IDType>* larger : kept) {
+					if(includes(larger->cbegin(), larger->cend(), candidate.cbegin(), candidate.cend())) {
+						contained = true;
+						break;
 					}
 				}
+				if(!contained) {
+					kept.push_back(&candidate);
+					enumList.push_back(IDPartitionEnumerator(vector<IDType>(candidate.cbegin(), candidate.cend())));
+				}
+			}
+		}
 
-				// ignore edges with at most one non-deleted node
-				if(mergeableVertices.size() > 1) {
-					// check if the current edge is incident to at least two different vertices
-					// ignore any edge for which this is not the case
-					vit = mergeableVertices.begin();
-					IDType oneID(*vit);
-					++vit;
-					for(; vit != mergeableVertices.end(); ++vit) {
-						if(oneID != *vit) {
-							enumList.push_back(IDPartitionEnumerator(mergeableVertices));
-							break;
+		/**
+		 * Creates the rule resulting from concatenating the given rule with the minor morphism deleting the given
+		 * vertices and edges and merging the vertices as given by the partition. The resulting rule is only
+		 * created and added to the callback, if optimization is disabled or the rule is no no-op rule. The latter
+		 * is checked on the mapping alone, i.e. no-op rules are never materialized.
+		 * @param rule the rule to be concatenated
+		 * @param callback a callback for storing newly generated rules
+		 * @param deletedVertices the vertices of the right-hand side to be deleted
+		 * @param deletedEdges the edges of the right-hand side to be deleted (including all edges attached to
+		 * 				deleted vertices)
+		 * @param partition the partition of vertices to be merged or null, if no vertices are merged
+		 * @param vertexIDs all vertices of the right-hand side
+		 * @param edgeIDs all edges of the right-hand side
+		 * @param name the name of the resulting rule
+		 */
+		template<typename T>
+		void addMinorRule(T const& rule,
+				CollectionCallback<shared_ptr<T>>& callback,
+				unordered_set<IDType> const& deletedVertices,
+				unordered_set<IDType> const& deletedEdges,
+				IDPartition const* partition,
+				vector<IDType> const& vertexIDs,
+				vector<IDType> const& edgeIDs,
+				bool optimize,
+				string const& name) {
+
+			// compute the mapping of the resulting rule, merged vertices are represented by the first vertex of their class
+			Mapping newMapping(rule.getMapping());
+			newMapping.delTar(deletedVertices);
+			newMapping.delTar(deletedEdges);
+			unordered_map<IDType, IDType> mergedInto;
+			if(partition) {
+				for(auto partIt = partition->cbegin(); partIt != partition->cend(); ++partIt) {
+					if(partIt->size() > 1) {
+						IDType representative = *partIt->cbegin();
+						for(auto innerIt = partIt->cbegin(); innerIt != partIt->cend(); ++innerIt) {
+							if(*innerIt != representative) {
+								mergedInto[*innerIt] = representative;
+							}
 						}
 					}
-				} // else do nothing
+				}
+				for(auto mapIt = newMapping.begin(); mapIt != newMapping.end(); ++mapIt) {
+					auto mergedIt = mergedInto.find(mapIt->second);
+					if(mergedIt != mergedInto.end()) {
+						mapIt->second = mergedIt->second;
+					}
+				}
+			}
+
+			if(optimize) {
+				vector<IDType> remainingVertices;
+				for(IDType vid : vertexIDs) {
+					if(!deletedVertices.count(vid) && !mergedInto.count(vid)) {
+						remainingVertices.push_back(vid);
+					}
+				}
+				vector<IDType> remainingEdges;
+				for(IDType eid : edgeIDs) {
+					if(!deletedEdges.count(eid)) {
+						remainingEdges.push_back(eid);
+					}
+				}
+				if(MinorRulePreparer::isNoOpMorphism(*rule.getLeft(), newMapping, remainingVertices, remainingEdges)) {
+					return;
+				}
+			}
 
+			// materialize the right-hand side
+			auto newRight = make_shared<AnonHypergraph>(*rule.getRight());
+			for(IDType vid : deletedVertices) {
+				newRight->deleteVertex(vid);
+			}
+			for(IDType eid : deletedEdges) {
+				newRight->deleteEdge(eid);
+			}
+			for(auto mergedIt = mergedInto.cbegin(); mergedIt != mergedInto.cend(); ++mergedIt) {
+				newRight->mergeVertexIntoFirst(mergedIt->second, mergedIt->first);
 			}
+
+			callback.insert(createRuleFrom(rule, name, make_shared<AnonHypergraph>(*rule.getLeft()), newRight, newMapping));
 		}
 
 		/**
 		 * Serves as an implementation of the MinorRulePreparer::prepareRule(...) variants for normal and UQRules.
+		 * All sets of vertices to be deleted are enumerated, followed by all sets of remaining edges to be deleted
+		 * or contracted and all partitions of vertices resulting from contractions. The number of vertices and edges
+		 * is not limited, but the number of enumerated combinations is exponential in the size of the right-hand side.
 		 * @param rule a reference to the rule to be prepared
 		 * @param callback a callback for storing newly generated rules
 		 * @param rulePreparer the RulePreparer used for preparation
@@ -96,114 +207,66 @@ namespace uncover {
 				RulePreparer const& rulePreparer) {
 
 			auto rightSide = rule.getRight();
+			bool optimize = rulePreparer.willOptimize();
 
-			size_t nodeCount = rightSide->getVertexCount();
-			size_t edgeCount = rightSide->getEdgeCount();
-			if(nodeCount > 31 || edgeCount > 31) {
-				throw RunException("Cannot prepare rules with more than 31 nodes or edges on the right side. Any way this would generate at least 2^32 new rules (before optimization)!");
+			vector<IDType> nodeID;
+			for(auto it = rightSide->cbeginVertices(); it != rightSide->cendVertices(); ++it) {
+				nodeID.push_back(it->first);
 			}
-			// each digit of this integer specifies if some node deleted (1) or not (0)
-			// all mappings are enumerated by increasing this variable
-			unsigned int nodeDefMap;
-			unsigned int nodeDefMapMax = (unsigned int)pow(2,nodeCount);
-			// maps digits of nodeDefMap to node IDs
-			IDType nodeID[nodeCount];
-			// defines an order on edges, for easier enumeration on edges
-			IDType edgeID[edgeCount];
-			// stores an int which represents the set (not multiset) of attached nodes
-			unsigned int edgeAttachMap[edgeCount];
-
-			{ // initializes the variables above
-				unsigned int counter = 0;
-				unordered_map<IDType, size_t> reverseNodeID;
-				for(auto it = rightSide->cbeginVertices(); it != rightSide->cendVertices(); ++it, ++counter) {
-					nodeID[counter] = it->first;
-					reverseNodeID[it->first] = counter;
-				}
-				counter = 0;
-				for(auto it = rightSide->cbeginEdges(); it != rightSide->cendEdges(); ++it, ++counter) {
-					edgeID[counter] = it->first;
-					vector<IDType> const* conNodes = rightSide->getVerticesOfEdge(it->first);
-					edgeAttachMap[counter] = 0;
-					for(vector<IDType>::const_iterator nIt = conNodes->cbegin(); nIt != conNodes->cend(); ++nIt) {
-						edgeAttachMap[counter] = edgeAttachMap[counter] | (1 << reverseNodeID[(*nIt)]);
-					}
-				}
+			vector<IDType> edgeID;
+			for(auto it = rightSide->cbeginEdges(); it != rightSide->cendEdges(); ++it) {
+				edgeID.push_back(it->first);
 			}
 
-			// actual enumeration of mappings
+			// each flag specifies if the corresponding vertex is deleted or not
+			// all mappings are enumerated by advancing this subset
+			vector<bool> nodeDefMap(nodeID.size(), false);
 			unsigned int counter = 0;
-			for(nodeDefMap = 0; nodeDefMap < nodeDefMapMax; ++nodeDefMap) {
-
-				// generate a copy of the right graph
-				auto newRight = make_shared<AnonHypergraph>(*rightSide);
+			do {
 
+				// calculate all vertices which will be deleted in this iteration and their attached edges
 				unordered_set<IDType> deletedVertices;
 				unordered_set<IDType> deletedEdges;
-
-				// calculate all nodes which will be deleted in this iteration and their attached edges
-				for(unsigned int i = 0; i < nodeCount; ++i) {
-					if(nodeDefMap & (1 << i)) {
+				for(size_t i = 0; i < nodeID.size(); ++i) {
+					if(nodeDefMap[i]) {
 						deletedVertices.insert(nodeID[i]);
-						newRight->deleteVertex(nodeID[i], &deletedEdges);
+						AnonHypergraph::ESet const* connected = rightSide->getConnectedEdges(nodeID[i]);
+						deletedEdges.insert(connected->cbegin(), connected->cend());
 					}
 				}
 
-				// also delete mappings of deleted nodes
-				Mapping newMapping(rule.getMapping());
-				newMapping.delTar(deletedVertices);
-				newMapping.delTar(deletedEdges);
-
 				// find all non-deleted edges
 				vector<IDType> remainingEdges;
-				for(unsigned int i = 0; i < edgeCount; ++i) {
-					if(deletedEdges.count(edgeID[i]) == 0) {
-						remainingEdges.push_back(edgeID[i]);
+				for(IDType eid : edgeID) {
+					if(deletedEdges.count(eid) == 0) {
+						remainingEdges.push_back(eid);
 					}
 				}
 
 				// now enumerate all undeleted edges and contract them using all possible partitions
-				unsigned int edgeDefMap;
-				unsigned int edgeDefMapMax = (unsigned int)pow(2,remainingEdges.size());
-				for(edgeDefMap = 0; edgeDefMap < edgeDefMapMax; ++edgeDefMap) {
+				vector<bool> edgeDefMap(remainingEdges.size(), false);
+				do {
 
 					// calculate additional edges, where no attached nodes where deleted
 					unordered_set<IDType> additionalDeletedEdges = deletedEdges;
-					for(unsigned int i = 0; i < remainingEdges.size(); ++i) {
-						if(edgeDefMap & (1 << i)) {
-							additionalDeletedEdges.insert(remainingEdges.at(i));
+					for(size_t i = 0; i < remainingEdges.size(); ++i) {
+						if(edgeDefMap[i]) {
+							additionalDeletedEdges.insert(remainingEdges[i]);
 						}
 					}
 
 					// enumerate over all possible contractions of deleted edges
 					vector<IDPartitionEnumerator> partitionEnums;
-					generateIDEnumerator(partitionEnums, deletedEdges, deletedVertices, *rightSide);
 					generateIDEnumerator(partitionEnums, additionalDeletedEdges, deletedVertices, *rightSide);
 
 					if(partitionEnums.size() == 0) {
 
-						// generate a full copy of the rule, including all changes to this point
-						auto finalNewRight = make_shared<AnonHypergraph>(*newRight);
+						// no contractions performed
 						stringstream converter;
 						converter << (rule.getName()) << "-v" << counter;
 						++counter;
-						shared_ptr<T> newRule = createRuleFrom(rule,
-																									 converter.str(),
-																									 make_shared<AnonHypergraph>(*rule.getLeft()),
-																									 finalNewRight,
-																									 newMapping);
-						Mapping& finalNewMapping = newRule->getMapping();
-
-						// also delete additional edges
-						for(unordered_set<IDType>::iterator eit = additionalDeletedEdges.begin(); eit != additionalDeletedEdges.end(); ++eit) {
-							finalNewRight->deleteEdge(*eit);
-						}
-						finalNewMapping.delTar(additionalDeletedEdges);
-
-						// no contractions performed
-						if(!rulePreparer.willOptimize() || !rulePreparer.isNoOpRule(*newRule)) {
-							callback.insert(newRule);
-						}
+						addMinorRule(rule, callback, deletedVertices, additionalDeletedEdges, nullptr,
+								nodeID, edgeID, optimize, converter.str());
 
 					} else {
 
@@ -221,64 +284,11 @@ namespace uncover {
 
 							// add a new rule if new partition was generated
 							if(enumedPartitions.insert(finalPartition).second) {
-
-								// generate a full copy of the rule, including all changes to this point
-								auto finalNewRight = make_shared<AnonHypergraph>(*newRight);
 								stringstream converter;
 								converter << (rule.getName()) << "-v" << counter;
 								++counter;
-								shared_ptr<T> newRule = createRuleFrom(rule,
-																											 converter.str(),
-																											 make_shared<AnonHypergraph>(*rule.getLeft()),
-																											 finalNewRight,
-																											 newMapping);
-								Mapping& finalNewMapping = newRule->getMapping();
-
-								// also delete additional edges
-								for(auto eit = additionalDeletedEdges.begin(); eit != additionalDeletedEdges.end(); ++eit) {
-									finalNewRight->deleteEdge(*eit);
-								}
-								finalNewMapping.delTar(additionalDeletedEdges);
-
-								// perform contractions
-								for(auto partIt = finalPartition.cbegin(); partIt != finalPartition.cend(); ++partIt) {
-
-									if(partIt->size() <= 1) {
-										continue;
-									}
-
-									unordered_set<IDType>::const_iterator innerPartIt = partIt->cbegin();
-									IDType currentID = *innerPartIt;
-									++innerPartIt;
-
-									for(; innerPartIt != partIt->cend(); ++innerPartIt) {
-
-										// merge vertices in graph
-										IDType oldID = currentID;
-										currentID = finalNewRight->mergeVertices(currentID, *innerPartIt);
-
-										// correct mappings to old currentID
-										if(currentID != oldID) {
-											unordered_set<IDType> oldMaps = finalNewMapping.getInverseMatch(oldID);
-											for(auto oldMapsIt = oldMaps.cbegin(); oldMapsIt != oldMaps.cend(); ++oldMapsIt) {
-												finalNewMapping[*oldMapsIt] = currentID;
-											}
-										}
-
-										// correct mappings to *innerPartIt
-										if(currentID != *innerPartIt) {
-											unordered_set<IDType> oldMaps = finalNewMapping.getInverseMatch(*innerPartIt);
-											for(auto oldMapsIt = oldMaps.cbegin(); oldMapsIt != oldMaps.cend(); ++oldMapsIt) {
-												finalNewMapping[*oldMapsIt] = currentID;
-											}
-										}
-									}
-								}
-
-								// add rule
-								if(!rulePreparer.willOptimize() || !rulePreparer.isNoOpRule(*newRule)) {
-									callback.insert(newRule);
-								}
+								addMinorRule(rule, callback, deletedVertices, additionalDeletedEdges, &finalPartition,
+										nodeID, edgeID, optimize, converter.str());
 							}
 
 							// increase partitionEnums
@@ -296,8 +306,8 @@ namespace uncover {
 						}
 					}
 
-				}
-			}
+				} while(nextSubset(edgeDefMap));
+			} while(nextSubset(nodeDefMap));
 
 		}
 
@@ -311,25 +321,39 @@ namespace uncover {
 
 		bool MinorRulePreparer::isNoOpRule(AnonRule const& rule) const {
 
-			Mapping const& oldMapping = rule.getMapping();
 			auto rgraph = rule.getRight();
-			auto lgraph = rule.getLeft();
+			vector<IDType> rightVertices;
+			for(auto it = rgraph->cbeginVertices(); it != rgraph->cendVertices(); ++it) {
+				rightVertices.push_back(it->first);
+			}
+			vector<IDType> rightEdges;
+			for(auto it = rgraph->cbeginEdges(); it != rgraph->cendEdges(); ++it) {
+				rightEdges.push_back(it->first);
+			}
+
+			return isNoOpMorphism(*rule.getLeft(), rule.getMapping(), rightVertices, rightEdges);
+		}
+
+		bool MinorRulePreparer::isNoOpMorphism(AnonHypergraph const& left,
+				Mapping const& oldMapping,
+				vector<IDType> const& rightVertices,
+				vector<IDType> const& rightEdges) {
 
 			Mapping::Inversion inverseMapping;
 			oldMapping.getInverseMatch(inverseMapping);
 
 			// check surjectivity on vertices
-			for(auto it = rgraph->cbeginVertices(); it != rgraph->cendVertices(); ++it) {
-				if(!inverseMapping.count(it->first)) {
+			for(IDType vid : rightVertices) {
+				if(!inverseMapping.count(vid)) {
 					return false;
 				}
 			}
 
 			// check injectivity and surjectivity on edges
-			for(auto it = rgraph->cbeginEdges(); it != rgraph->cendEdges(); ++it) {
-				if(!inverseMapping.count(it->first)) {
+			for(IDType eid : rightEdges) {
+				if(!inverseMapping.count(eid)) {
 					return false; // not surjective
-				} else if(inverseMapping[it->first].size() != 1) {
+				} else if(inverseMapping[eid].size() != 1) {
 					return false; // not injective
 				}
 			}
@@ -351,7 +375,7 @@ namespace uncover {
 					todoIDs.pop_back();
 					foundIDs.insert(currentID);
 
-					auto conEdges = lgraph->getConnectedEdges(currentID);
+					auto conEdges = left.getConnectedEdges(currentID);
 					for(auto eit = conEdges->cbegin(); eit != conEdges->cend(); ++eit) {
 
 						// ignore non-contracted edges
@@ -359,7 +383,7 @@ namespace uncover {
 							continue;
 						}
 
-						vector<IDType> const* attachedV = lgraph->getVerticesOfEdge(*eit);
+						vector<IDType> const* attachedV = left.getVerticesOfEdge(*eit);
 						for(vector<IDType>::const_iterator vit = attachedV->cbegin(); vit != attachedV->cend(); ++vit) {
 							if(it->second.count(*vit) && !foundIDs.count(*vit)) {
 								foundIDs.insert(*vit);
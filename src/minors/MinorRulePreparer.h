@@ -53,6 +53,21 @@ namespace uncover {
 
 				virtual bool isNoOpRule(graphs::AnonRule const& rule) const override;
 
+				/**
+				 * Checks whether a rule with the given left-hand side and mapping, whose right-hand side consists of
+				 * the given vertices and edges, is a no-op rule (see isNoOpRule(...)). This check only needs the IDs of
+				 * the right-hand side, hence the right-hand side does not have to be materialized.
+				 * @param left the left-hand side of the rule
+				 * @param mapping the mapping of the rule
+				 * @param rightVertices the vertices of the right-hand side
+				 * @param rightEdges the edges of the right-hand side
+				 * @return true iff the described rule can be ignored by the backward analysis without loss of correctness
+				 */
+				static bool isNoOpMorphism(graphs::AnonHypergraph const& left,
+						graphs::Mapping const& mapping,
+						vector<IDType> const& rightVertices,
+						vector<IDType> const& rightEdges);
+
 		};
 
 		/**
@@ -0,0 +1,269 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "ConflictFreeTotalPOCEnumerator.h"
+
+using namespace uncover::graphs;
+using namespace uncover::basic_types;
+
+namespace uncover {
+	namespace rule_engine {
+
+		ConflictFreeTotalPOCEnumerator::ConflictFreeTotalPOCEnumerator(
+				AnonRule_csp rule,
+				Hypergraph_csp graph,
+				MatchConstraints_csp constraints,
+				shared_ptr<vector<Mapping>> matches)
+			: TotalPOCEnumerator(rule, graph, false, constraints, matches),
+			  edgeEnums(),
+			  vertexEnums(),
+			  templateGraphOr(),
+			  templateMappOr(),
+			  templateGraphME(),
+			  templateMappME(),
+			  mappPOCtoGraph() {}
+
+		ConflictFreeTotalPOCEnumerator::~ConflictFreeTotalPOCEnumerator() {}
+
+		TotalPOCEnumerator_up ConflictFreeTotalPOCEnumerator::createFor(shared_ptr<vector<Mapping>> matches) const {
+			return TotalPOCEnumerator_up(new ConflictFreeTotalPOCEnumerator(rule, graph, constraints, matches));
+		}
+
+		void ConflictFreeTotalPOCEnumerator::initFirstPOC() {
+			initEdgeTemplates();
+			initVertexTemplates();
+			computePOC();
+		}
+
+		TotalPOCEnumerator& ConflictFreeTotalPOCEnumerator::operator++() {
+
+			// ignore operator call if enumerator ended
+			if(ended()) {
+				return *this;
+			}
+
+			// compute next vertex merging if possible, then next edge merging if possible, then next match
+			if(incEnums(vertexEnums)) {
+				// do nothing
+			} else if (incEnums(edgeEnums)) {
+				// note: at least one vertex merging exists for each edge merging
+				initVertexTemplates();
+			} else {
+
+				// initialize fields for new match if one was found
+				if(chooseNextMatch()) {
+					initEdgeTemplates();
+					initVertexTemplates();
+				} else {
+					currGraph = nullptr;
+					currMapp = nullptr;
+					return *this;
+				}
+
+			}
+
+			// delete old current and generate new one
+			computePOC();
+
+			return *this;
+		}
+
+		void ConflictFreeTotalPOCEnumerator::initEdgeTemplates() {
+
+			// generate templateGraphOr as L + D~ (optimized) and the mapping mappPOCtoGraph
+			generateNonMergedPOC(templateGraphOr, templateMappOr, mappPOCtoGraph);
+
+			// will contain one empty partition for each equivalence class (of edges) of \equiv_{g'}
+			vector<IDPartition> partList;
+			// stores the set of IDs used for each enumerator
+			vector<unordered_set<IDType>> idsOfPartList;
+
+			Mapping::Inversion invTmpMapp;
+			mappPOCtoGraph.getInverseMatch(invTmpMapp);
+			for(auto it = invTmpMapp.cbegin(); it != invTmpMapp.cend(); ++it) {
+				if(graph->hasEdge(it->first) && it->second.size() > 1) {
+					idsOfPartList.push_back(it->second);
+					partList.push_back(IDPartition());
+				} // else the equivalence class can be ignored, since there will be always exactly one possible merging
+			}
+
+			// fill partition list with sets of equivalence classes of \equiv_f;
+			// each set contains all equivalence classes which are subsets of the same class of \equiv_{g'}
+			Mapping::Inversion invRule;
+			rule->getMapping().getInverseMatch(invRule);
+			for(auto it = invRule.cbegin(); it != invRule.cend(); ++it) {
+				if(rule->getRight()->hasEdge(it->first) && it->second.size() > 1) {
+
+					IDType representant = *it->second.begin();
+					for(size_t i = 0; i < idsOfPartList.size(); ++i) {
+						if(idsOfPartList.at(i).count(representant)) {
+							partList.at(i).insert(it->second);
+							break; // the representant cannot be in any other partition
+						}
+					}
+
+				} // classes with only one element have no effect, thus can be dropped
+			}
+
+			// fill enumerator list
+			edgeEnums.clear();
+			for(size_t i = 0; i < idsOfPartList.size(); ++i) {
+				edgeEnums.push_back(IDClosureEnumerator(idsOfPartList.at(i),partList.at(i)));
+			}
+
+		}
+
+		void ConflictFreeTotalPOCEnumerator::initVertexTemplates() {
+
+			// generate copies of templateOr fields
+			templateGraphME = templateGraphOr;
+			templateMappME = templateMappOr;
+
+			// perform edge merging and implied node mergings
+			Mapping tmpMapp(mappPOCtoGraph);
+
+			for(vector<IDClosureEnumerator>::const_iterator it = edgeEnums.cbegin(); it != edgeEnums.cend(); ++it) {
+
+				IDPartition const& tmpPart = **it;
+				for(IDPartition::const_iterator partIt = tmpPart.cbegin(); partIt != tmpPart.cend(); ++partIt) {
+
+					// no need to merge sets smaller than 2
+					if(partIt->size() < 2) continue;
+
+					// merge edges
+					IDType newID = templateGraphME.mergeEdges(*partIt);
+
+					// adjust mappings (from POC to the matched graph) of edges
+					IDType newIDMap = mappPOCtoGraph.getTar(*partIt->begin());
+					tmpMapp.delSrc(*partIt);
+					tmpMapp[newID] = newIDMap;
+
+					vector<IDType> const* newNodeIDs = templateGraphME.getVerticesOfEdge(newID);
+
+					// adjust other mappings
+					for(unordered_set<IDType>::const_iterator innerIt = partIt->cbegin(); innerIt != partIt->cend(); ++innerIt) {
+
+						// adjust mappings (from L to POC) for edges
+						// only if the element has a preimage in the left side, we have to adjust the mapping
+						// note: templateMappOr is the identity
+						if(templateMappOr.hasSrc(*innerIt)) {
+							templateMappME[*innerIt] = newID;
+						}
+
+						// do the same for attached nodes
+						vector<IDType> const* innerItNodes = templateGraphOr.getVerticesOfEdge(*innerIt);
+						for(size_t i = 0; i < innerItNodes->size(); ++i) {
+
+							// adjust mappings (from L to POC) for nodes attached to merges edges
+							if(templateMappOr.hasSrc(innerItNodes->at(i))) {
+								templateMappME[innerItNodes->at(i)] = newNodeIDs->at(i);
+							}
+
+							// adjust mappings (from POC to the matched graph) for nodes attached to the merges edges
+							IDType newNodeIDMap = mappPOCtoGraph.getTar(innerItNodes->at(i));
+							tmpMapp.delSrc(innerItNodes->at(i));
+							tmpMapp[newNodeIDs->at(i)] = newNodeIDMap;
+
+						}
+
+					}
+
+				}
+
+			}
+
+			// will contain one empty partition for each equivalence class (of nodes) of \equiv_{g'}
+			vector<IDPartition> partList;
+			// stores the set of IDs used for each enumerator
+			vector<unordered_set<IDType>> idsOfPartList;
+
+			Mapping::Inversion invTmpMapp;
+			tmpMapp.getInverseMatch(invTmpMapp);
+			for(auto it = invTmpMapp.cbegin(); it != invTmpMapp.cend(); ++it) {
+				if(graph->hasVertex(it->first) && it->second.size() > 1) {
+					idsOfPartList.push_back(it->second);
+					partList.push_back(IDPartition());
+				} // else the equivalence class can be ignored, since there will be always exactly one possible merging
+			}
+
+			// fill partition list with sets of equivalence classes of \equiv_f;
+			// each set contains all equivalence classes which are subsets of the same class of \equiv_{g'}
+			Mapping::Inversion invRule;
+			rule->getMapping().getInverseMatch(invRule);
+			for(auto it = invRule.cbegin(); it != invRule.cend(); ++it) {
+				if(rule->getRight()->hasVertex(it->first)) {
+
+					// nodes have to be mapped to POC first, since templateMappME may be non-injective
+					unordered_set<IDType> newEquivClass;
+					for(unordered_set<IDType>::const_iterator innerIt = it->second.cbegin(); innerIt != it->second.cend(); ++innerIt) {
+						newEquivClass.insert(templateMappME.getTar(*innerIt));
+					}
+
+					// no entries for equivalence classes with only one element
+					if(newEquivClass.size() <= 1) continue;
+
+					IDType representant = *newEquivClass.begin();
+					for(size_t i = 0; i < idsOfPartList.size(); ++i) {
+						if(idsOfPartList.at(i).count(representant)) {
+							partList.at(i).insert(newEquivClass);
+							break; // the representant cannot be in any other partition
+						}
+					}
+
+				} // classes with only one element have no effect, thus can be dropped
+			}
+
+			// fill enumerator list
+			vertexEnums.clear();
+			for(size_t i = 0; i < idsOfPartList.size(); ++i) {
+				vertexEnums.push_back(IDClosureEnumerator(idsOfPartList.at(i),partList.at(i)));
+			}
+
+		}
+
+		void ConflictFreeTotalPOCEnumerator::computePOC() {
+
+			currGraph = make_shared<Hypergraph>(templateGraphME);
+			currMapp = make_shared<Mapping>(templateMappME);
+
+			// for each partition in each equivalence
+			for(auto it = vertexEnums.cbegin(); it != vertexEnums.cend(); ++it) {
+
+				IDPartition const& tmpPart = **it;
+				for(auto partIt = tmpPart.cbegin(); partIt != tmpPart.cend(); ++partIt) {
+
+					// no need to merge sets smaller than 2
+					if(partIt->size() < 2) continue;
+
+					// merge vertices and adjust mapping
+					IDType newID = currGraph->mergeVertices(*partIt);
+					for(auto innerIt = partIt->cbegin(); innerIt != partIt->cend(); ++innerIt) {
+						// only if the element has a preimage in the left side, we have to adjust the mapping
+						if(templateMappME.hasTar(*innerIt)) {
+							(*currMapp)[*innerIt] = newID;
+						}
+					}
+
+				}
+
+			}
+		}
+
+	} /* namespace rule_engine */
+} /* namespace uncover */
@@ -0,0 +1,128 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef CONFLICTFREETOTALPOCENUMERATOR_H_
+#define CONFLICTFREETOTALPOCENUMERATOR_H_
+
+#include "TotalPOCEnumerator.h"
+
+namespace uncover {
+	namespace rule_engine {
+
+		/**
+		 * This TotalPOCEnumerator is used if the rule is non-injective and the matches (from L to the POC) may be
+		 * non-injective, i.e. conflict-free. For every co-match, all possible equivalences on the edges and
+		 * afterwards on the vertices of the non-merged pushout complement are enumerated.
+		 * @author Jan Stückrath
+		 * @see TotalPOCEnumerator::create(...)
+		 */
+		class ConflictFreeTotalPOCEnumerator : public TotalPOCEnumerator {
+
+			public:
+
+				/**
+				 * Initializes a new ConflictFreeTotalPOCEnumerator. No pushout complement is computed; use
+				 * TotalPOCEnumerator::create(...) to obtain a ready to use enumerator.
+				 * @param rule the non-injective rule which should be applied backwards
+				 * @param graph the graph to which the co-matches will be computed
+				 * @param constraints the MatchConstraints of the given rule or null
+				 * @param matches the co-matches to be used or null, if they should be computed by reset()
+				 */
+				ConflictFreeTotalPOCEnumerator(
+						graphs::AnonRule_csp rule,
+						graphs::Hypergraph_csp graph,
+						graphs::MatchConstraints_csp constraints,
+						shared_ptr<vector<graphs::Mapping>> matches);
+
+				/**
+				 * Destroys this instance of the ConflictFreeTotalPOCEnumerator.
+				 */
+				virtual ~ConflictFreeTotalPOCEnumerator();
+
+				virtual TotalPOCEnumerator& operator++() override;
+
+			protected:
+
+				virtual TotalPOCEnumerator_up createFor(shared_ptr<vector<graphs::Mapping>> matches) const override;
+
+				virtual void initFirstPOC() override;
+
+			private:
+
+				/**
+				 * Generates enumerators for the equivalences on edges and computes an initial,
+				 * non-merged POC. Initializes the fields: edgeEnums, templateGraphOr, templateMappOr
+				 * and mappPOCtoGraph.
+				 */
+				void initEdgeTemplates();
+
+				/**
+				 * First performs merging of vertices and edges according to the current equivalence
+				 * on the edges, and then generates the enumerators for possible equivalences on
+				 * vertices. Initializes the fields: vertexEnums, templateGraphME and templateMappME.
+				 */
+				void initVertexTemplates();
+
+				/**
+				 * Computes the current pushout complement from the temporary values computed to far.
+				 */
+				void computePOC();
+
+				/**
+				 * A list of enumerators for enumerating all possible equivalences on edges.
+				 */
+				vector<IDClosureEnumerator> edgeEnums;
+
+				/**
+				 * A list of enumerators for enumerating all possible equivalences on vertices.
+				 */
+				vector<IDClosureEnumerator> vertexEnums;
+
+				/**
+				 * A copy of an initially non-merged POC.
+				 */
+				graphs::AnonHypergraph templateGraphOr;
+
+				/**
+				 * The mapping from L to templateGraphOr.
+				 */
+				graphs::Mapping templateMappOr;
+
+				/**
+				 * A copy of the POC after performing the mergings of edges (including implied
+				 * mergings on vertices).
+				 */
+				graphs::AnonHypergraph templateGraphME;
+
+				/**
+				 * The mapping from L to templateGraphME.
+				 */
+				graphs::Mapping templateMappME;
+
+				/**
+				 * The mapping from templateGraphOr to the matched graph.
+				 */
+				graphs::Mapping mappPOCtoGraph;
+
+		};
+
+	} /* namespace rule_engine */
+} /* namespace uncover */
+
+#endif /* CONFLICTFREETOTALPOCENUMERATOR_H_ */
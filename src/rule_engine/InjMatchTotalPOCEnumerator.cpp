@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "InjMatchTotalPOCEnumerator.h"
+
+using namespace uncover::graphs;
+
+namespace uncover {
+	namespace rule_engine {
+
+		InjMatchTotalPOCEnumerator::InjMatchTotalPOCEnumerator(
+				AnonRule_csp rule,
+				Hypergraph_csp graph,
+				MatchConstraints_csp constraints,
+				shared_ptr<vector<Mapping>> matches)
+			: TotalPOCEnumerator(rule, graph, true, constraints, matches),
+			  vertexEnums(),
+			  templateGraph(),
+			  templateMapp(),
+			  mappPOCtoGraph() {}
+
+		InjMatchTotalPOCEnumerator::~InjMatchTotalPOCEnumerator() {}
+
+		TotalPOCEnumerator_up InjMatchTotalPOCEnumerator::createFor(shared_ptr<vector<Mapping>> matches) const {
+			return TotalPOCEnumerator_up(new InjMatchTotalPOCEnumerator(rule, graph, constraints, matches));
+		}
+
+		void InjMatchTotalPOCEnumerator::initFirstPOC() {
+			initTemplates();
+			computePOC();
+		}
+
+		TotalPOCEnumerator& InjMatchTotalPOCEnumerator::operator++() {
+
+			// ignore operator call if enumerator ended
+			if(ended()) {
+				return *this;
+			}
+
+			// use next node merging if possible, otherwise use next match
+			if(!incEnums(vertexEnums)) {
+				if(chooseNextMatch()) {
+					initTemplates();
+				} else {
+					currGraph = nullptr;
+					currMapp = nullptr;
+					return *this;
+				}
+			}
+
+			computePOC();
+
+			return *this;
+		}
+
+		void InjMatchTotalPOCEnumerator::initTemplates() {
+
+			// generate templateGraph as L + D~ (optimized) and the mappings mappPOCtoGraph, templateMapp
+			generateNonMergedPOC(templateGraph, templateMapp, mappPOCtoGraph);
+
+			vertexEnums.clear();
+
+			Mapping::Inversion invPOC2Graph;
+			mappPOCtoGraph.getInverseMatch(invPOC2Graph);
+			for(auto it = invPOC2Graph.cbegin(); it != invPOC2Graph.cend(); ++it) {
+
+				// ignore edges and injective parts of matchings
+				if(graph->hasVertex(it->first) && it->second.size() > 1) {
+
+					// split the found set into:
+					unordered_set<IDType> withPre;
+					unordered_set<IDType> withoutPre;
+					for(auto innerIt = it->second.cbegin(); innerIt != it->second.cend(); ++innerIt) {
+						// note: templateMapp is currently the identity
+						if(templateMapp.hasSrc(*innerIt)) {
+							withPre.insert(*innerIt);
+						} else {
+							withoutPre.insert(*innerIt);
+						}
+					}
+
+					if(withPre.size() == 1) {
+						// merge everything immediately, there is only one possibility
+						IDType mergeIntoID = *withPre.cbegin();
+						for(auto innerIt = withoutPre.cbegin(); innerIt != withoutPre.cend(); ++innerIt) {
+							templateGraph.mergeVertexIntoFirst(mergeIntoID, *innerIt);
+						}
+					} else if(withoutPre.size() > 0) {
+
+						// we know: there are more than one elements in withPre and withoutPre
+						for(auto innerIt = withoutPre.cbegin(); innerIt != withoutPre.cend(); ++innerIt) {
+							vertexEnums.push_back(IDtoIDEnumerator(*innerIt,withPre));
+						}
+
+					}
+
+				}
+
+			}
+
+		}
+
+		void InjMatchTotalPOCEnumerator::computePOC() {
+
+			currGraph = make_shared<Hypergraph>(templateGraph);
+			currMapp = make_shared<Mapping>(templateMapp);
+
+			// for each tentacle of each edge without preimage in the right side:
+			// attach the tentacle to a node in the POC which will be mapped to the right node in the mapped graph
+			for(auto it = vertexEnums.cbegin(); it != vertexEnums.cend(); ++it) {
+				currGraph->mergeVertexIntoFirst(it->getTarget(),it->getSource());
+			}
+
+		}
+
+	} /* namespace rule_engine */
+} /* namespace uncover */
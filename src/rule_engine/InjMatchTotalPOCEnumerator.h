@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef INJMATCHTOTALPOCENUMERATOR_H_
+#define INJMATCHTOTALPOCENUMERATOR_H_
+
+#include "TotalPOCEnumerator.h"
+
+namespace uncover {
+	namespace rule_engine {
+
+		/**
+		 * This TotalPOCEnumerator is used if the rule is non-injective and only injective matches (from L to the
+		 * POC) are wanted. For every co-match, the edges of the matched graph without preimage are attached to
+		 * the split vertices of the pushout complement in all possible ways.
+		 * @author Jan Stückrath
+		 * @see TotalPOCEnumerator::create(...)
+		 */
+		class InjMatchTotalPOCEnumerator : public TotalPOCEnumerator {
+
+			public:
+
+				/**
+				 * Initializes a new InjMatchTotalPOCEnumerator. No pushout complement is computed; use
+				 * TotalPOCEnumerator::create(...) to obtain a ready to use enumerator.
+				 * @param rule the non-injective rule which should be applied backwards
+				 * @param graph the graph to which the co-matches will be computed
+				 * @param constraints the MatchConstraints of the given rule or null
+				 * @param matches the co-matches to be used or null, if they should be computed by reset()
+				 */
+				InjMatchTotalPOCEnumerator(
+						graphs::AnonRule_csp rule,
+						graphs::Hypergraph_csp graph,
+						graphs::MatchConstraints_csp constraints,
+						shared_ptr<vector<graphs::Mapping>> matches);
+
+				/**
+				 * Destroys this instance of the InjMatchTotalPOCEnumerator.
+				 */
+				virtual ~InjMatchTotalPOCEnumerator();
+
+				virtual TotalPOCEnumerator& operator++() override;
+
+			protected:
+
+				virtual TotalPOCEnumerator_up createFor(shared_ptr<vector<graphs::Mapping>> matches) const override;
+
+				virtual void initFirstPOC() override;
+
+			private:
+
+				/**
+				 * Generates enumerators for attaching edges in all possible ways to split vertices in
+				 * the POC and generates an initial non-merged POC. Initializes the fields: vertexEnums,
+				 * templateGraph, templateMapp and mappPOCtoGraph.
+				 */
+				void initTemplates();
+
+				/**
+				 * Computes the current pushout complement from the temporary values computed to far.
+				 */
+				void computePOC();
+
+				/**
+				 * A list of enumerators for enumerating possibilities to attach edges to split vertices.
+				 */
+				vector<IDtoIDEnumerator> vertexEnums;
+
+				/**
+				 * A copy of an initially non-merged POC.
+				 */
+				graphs::AnonHypergraph templateGraph;
+
+				/**
+				 * The mapping from L to templateGraph.
+				 */
+				graphs::Mapping templateMapp;
+
+				/**
+				 * The mapping from templateGraph to the matched graph.
+				 */
+				graphs::Mapping mappPOCtoGraph;
+
+		};
+
+	} /* namespace rule_engine */
+} /* namespace uncover */
+
+#endif /* INJMATCHTOTALPOCENUMERATOR_H_ */
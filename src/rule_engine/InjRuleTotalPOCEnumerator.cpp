@@ -0,0 +1,83 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "InjRuleTotalPOCEnumerator.h"
+#include "../graphs/DenseMapping.h"
+
+using namespace uncover::graphs;
+
+namespace uncover {
+	namespace rule_engine {
+
+		InjRuleTotalPOCEnumerator::InjRuleTotalPOCEnumerator(
+				AnonRule_csp rule,
+				Hypergraph_csp graph,
+				bool injective,
+				MatchConstraints_csp constraints,
+				shared_ptr<vector<Mapping>> matches)
+			: TotalPOCEnumerator(rule, graph, injective, constraints, matches) {}
+
+		InjRuleTotalPOCEnumerator::~InjRuleTotalPOCEnumerator() {}
+
+		TotalPOCEnumerator_up InjRuleTotalPOCEnumerator::createFor(shared_ptr<vector<Mapping>> matches) const {
+			return TotalPOCEnumerator_up(new InjRuleTotalPOCEnumerator(rule, graph, injective, constraints, matches));
+		}
+
+		void InjRuleTotalPOCEnumerator::initFirstPOC() {
+			computePOC();
+		}
+
+		TotalPOCEnumerator& InjRuleTotalPOCEnumerator::operator++() {
+
+			// ignore operator call if enumerator ended
+			if(chooseNextMatch()) {
+				computePOC();
+			}
+
+			return *this;
+		}
+
+		void InjRuleTotalPOCEnumerator::computePOC() {
+
+			currGraph = make_shared<Hypergraph>(*graph);
+			currMapp = make_shared<Mapping>(rule->getMapping());
+			currMapp->concat(matchList->back());
+
+			DenseMapping::Inversion invRule(rule->getMapping());
+			DenseMapping::Inversion invMatch(matchList->back());
+
+			// delete every element in the copied graph which as a preimage in the right side but none in the left side
+			// note: it was already checked that the pushout complement exists (which is used here)
+			for(IDType image : invMatch.getTargets()) {
+
+				// according to the gluing condition all preimages in R have preimages in L iff one has
+				IDType preimage = *invMatch.beginSrc(image);
+				if(!invRule.count(preimage)) {
+					if(graph->hasVertex(image)) {
+						currGraph->deleteVertex(image);
+					} else {
+						currGraph->deleteEdge(image);
+					}
+				}
+			}
+
+		}
+
+	} /* namespace rule_engine */
+} /* namespace uncover */
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef INJRULETOTALPOCENUMERATOR_H_
+#define INJRULETOTALPOCENUMERATOR_H_
+
+#include "TotalPOCEnumerator.h"
+
+namespace uncover {
+	namespace rule_engine {
+
+		/**
+		 * This TotalPOCEnumerator is used if the rule is injective. In this case there is exactly one pushout
+		 * complement for every co-match, which is computed directly from the matched graph without any temporary
+		 * data.
+		 * @author Jan Stückrath
+		 * @see TotalPOCEnumerator::create(...)
+		 */
+		class InjRuleTotalPOCEnumerator : public TotalPOCEnumerator {
+
+			public:
+
+				/**
+				 * Initializes a new InjRuleTotalPOCEnumerator. No pushout complement is computed; use
+				 * TotalPOCEnumerator::create(...) to obtain a ready to use enumerator.
+				 * @param rule the injective rule which should be applied backwards
+				 * @param graph the graph to which the co-matches will be computed
+				 * @param injective set to true if only injective POCs are wanted
+				 * @param constraints the MatchConstraints of the given rule or null
+				 * @param matches the co-matches to be used or null, if they should be computed by reset()
+				 */
+				InjRuleTotalPOCEnumerator(
+						graphs::AnonRule_csp rule,
+						graphs::Hypergraph_csp graph,
+						bool injective,
+						graphs::MatchConstraints_csp constraints,
+						shared_ptr<vector<graphs::Mapping>> matches);
+
+				/**
+				 * Destroys this instance of the InjRuleTotalPOCEnumerator.
+				 */
+				virtual ~InjRuleTotalPOCEnumerator();
+
+				virtual TotalPOCEnumerator& operator++() override;
+
+			protected:
+
+				virtual TotalPOCEnumerator_up createFor(shared_ptr<vector<graphs::Mapping>> matches) const override;
+
+				virtual void initFirstPOC() override;
+
+			private:
+
+				/**
+				 * Computes the pushout complement of the current co-match.
+				 */
+				void computePOC();
+
+		};
+
+	} /* namespace rule_engine */
+} /* namespace uncover */
+
+#endif /* INJRULETOTALPOCENUMERATOR_H_ */
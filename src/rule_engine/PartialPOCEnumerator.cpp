@@ -37,7 +37,8 @@ using namespace uncover::logging;
  * A. Initialization
  * -- is performed when calling reset() or generating a new object of this enumerator
  * 1. split rule into a partial part p and total part t such that the concatenation
- *    --p--> --t--> results in the original rule
+ *    --p--> --t--> results in the original rule; this step is skipped if an already
+ *    split rule (SplitRule) is given, e.g. the one cached by the PreparedGTS
  * 2. initialize TotalPOCEnumerator with the given graph and total rule part (and
  *    the boolean specifying injective or conflict-free matching)
  * 3. initialize template variables (B)
@@ -94,10 +95,45 @@ namespace uncover {
 				graphs::Hypergraph_csp graph,
 				bool inj,
 				shared_ptr<vector<AnonRule_csp>> orRules)
-			: partialRule(nullptr),
+			: PartialPOCEnumerator(make_shared<SplitRule>(*rule),graph,inj,orRules) {}
+
+		PartialPOCEnumerator::PartialPOCEnumerator(
+				SplitRule_csp split,
+				graphs::Hypergraph_csp graph,
+				bool inj,
+				shared_ptr<vector<AnonRule_csp>> orRules,
+				bool upToIso,
+				CancellationToken_csp cancellation)
+			: splitRule(nullptr),
 			  originalRules(nullptr),
 			  injective(inj),
 			  totalPOCs(nullptr),
+			  coMatch(nullptr),
+			  currentGraph(nullptr),
+			  currentMapp(nullptr),
+			  templateGraph(nullptr),
+			  templateMapp(nullptr),
+			  vertexMergings(nullptr),
+			  mergableEdges(nullptr),
+			  edgeMergings(nullptr),
+			  nodesAlreadyMerged(false),
+			  cancellation(nullptr) {
+
+			this->reset(split,graph,inj,orRules,upToIso,cancellation);
+
+		}
+
+		PartialPOCEnumerator::PartialPOCEnumerator(
+				SplitRule_csp split,
+				TotalPOCEnumerator_up total,
+				bool inj,
+				shared_ptr<vector<AnonRule_csp>> orRules,
+				CancellationToken_csp cancellation)
+			: splitRule(split),
+			  originalRules(orRules),
+			  injective(inj),
+			  totalPOCs(total.release()),
+			  coMatch(nullptr),
 			  currentGraph(nullptr),
 			  currentMapp(nullptr),
 			  templateGraph(nullptr),
@@ -105,16 +141,46 @@ namespace uncover {
 			  vertexMergings(nullptr),
 			  mergableEdges(nullptr),
 			  edgeMergings(nullptr),
-			  nodesAlreadyMerged(false) {
+			  nodesAlreadyMerged(false),
+			  cancellation(cancellation) {
+
+			this->initFromTotalPOCs();
+
+		}
+
+		PartialPOCEnumerator::PartialPOCEnumerator(PartialPOCEnumerator const& parent, IDPartitionEnumerator&& mergings)
+			: splitRule(parent.splitRule),
+			  originalRules(parent.originalRules),
+			  injective(parent.injective),
+			  totalPOCs(nullptr),
+			  coMatch(make_shared<Mapping>(parent.getCurrentCoMatch())),
+			  currentGraph(nullptr),
+			  currentMapp(nullptr),
+			  templateGraph(parent.templateGraph),
+			  templateMapp(parent.templateMapp),
+			  vertexMergings(new IDPartitionEnumerator(std::move(mergings))),
+			  mergableEdges(new vector<IDType>(*parent.mergableEdges)),
+			  edgeMergings(nullptr),
+			  nodesAlreadyMerged(false),
+			  cancellation(parent.cancellation) {
 
-			this->reset(rule,graph,inj,orRules);
+			// the template graph and mapping are not modified after their generation, hence they can be shared
+			prepEdgeMergings();
+			computeCurrent();
+
+			// if the first match is not conflict-free, find another one
+			if(!cfWrtOriginalRule()) {
+				++(*this);
+			}
 
 		}
 
 		PartialPOCEnumerator::PartialPOCEnumerator(PartialPOCEnumerator&& oldEnum)
-			: partialRule(oldEnum.partialRule),
+			: splitRule(oldEnum.splitRule),
+			  originalRules(oldEnum.originalRules),
 			  injective(oldEnum.injective),
 			  totalPOCs(oldEnum.totalPOCs),
+			  coMatch(oldEnum.coMatch),
 			  currentGraph(oldEnum.currentGraph),
 			  currentMapp(oldEnum.currentMapp),
 			  templateGraph(oldEnum.templateGraph),
@@ -122,10 +188,12 @@ namespace uncover {
 			  vertexMergings(oldEnum.vertexMergings),
 			  mergableEdges(oldEnum.mergableEdges),
 			  edgeMergings(oldEnum.edgeMergings),
-			  nodesAlreadyMerged(oldEnum.nodesAlreadyMerged) {
+			  nodesAlreadyMerged(oldEnum.nodesAlreadyMerged),
+			  cancellation(oldEnum.cancellation) {
 
-			oldEnum.partialRule = nullptr;
+			oldEnum.splitRule = nullptr;
 			oldEnum.totalPOCs = nullptr;
+			oldEnum.coMatch = nullptr;
 			oldEnum.currentGraph = nullptr;
 			oldEnum.currentMapp = nullptr;
 			oldEnum.templateGraph = nullptr;
@@ -160,35 +228,30 @@ namespace uncover {
 
 			// we reuse the total POC as initial partial POC
 			templateGraph = totalPOCs->getGraph();
-			templateMapp = make_shared<Mapping>(partialRule->getMapping());
+			templateMapp = make_shared<Mapping>(splitRule->getPartialRule()->getMapping());
 			templateMapp->concat(*totalPOCs->getMapping());
 
-			auto leftGraph = partialRule->getLeft();
-			Mapping const& partMapp = partialRule->getMapping();
+			auto leftGraph = splitRule->getPartialRule()->getLeft();
 
 			// add all vertices without image via the partial rule
 			vector<IDType> delVertices;
-			for(auto iter = leftGraph->cbeginVertices(); iter != leftGraph->cendVertices(); ++iter) {
-				if(!partMapp.hasSrc(iter->first)) {
-					delVertices.push_back(templateGraph->addVertex());
-					(*templateMapp)[iter->first] = delVertices.back();
-				} //else ignore
+			for(IDType vertex : splitRule->getDeletedVertices()) {
+				delVertices.push_back(templateGraph->addVertex());
+				(*templateMapp)[vertex] = delVertices.back();
 			}
 
 			// add all edges without preimage via the partial rule
 			mergableEdges = new vector<IDType>();
-			for(auto iter = leftGraph->cbeginEdges(); iter != leftGraph->cendEdges(); ++iter) {
-				if(!partMapp.hasSrc(iter->first)) {
-
-					vector<IDType> newVertices;
-					auto oldVertices = leftGraph->getVerticesOfEdge(iter->first);
-					for(size_t i = 0; i < oldVertices->size(); ++i) {
-						newVertices.push_back(templateMapp->getTar(oldVertices->at(i)));
-					}
-					mergableEdges->push_back(templateGraph->addEdge(iter->second.getLabel(),newVertices));
-					(*templateMapp)[iter->first] = mergableEdges->back();
+			for(IDType edge : splitRule->getDeletedEdges()) {
 
+				vector<IDType> newVertices;
+				auto oldVertices = leftGraph->getVerticesOfEdge(edge);
+				for(size_t i = 0; i < oldVertices->size(); ++i) {
+					newVertices.push_back(templateMapp->getTar(oldVertices->at(i)));
 				}
+				mergableEdges->push_back(templateGraph->addEdge(leftGraph->getEdge(edge)->getLabel(),newVertices));
+				(*templateMapp)[edge] = mergableEdges->back();
+
 			}
 
 			// initialize vertex and edge mergings if applicable
@@ -331,10 +394,20 @@ namespace uncover {
 				Hypergraph_csp graph,
 				bool inj,
 				shared_ptr<vector<AnonRule_csp>> orRules) {
+			this->reset(make_shared<SplitRule>(*rule),graph,inj,orRules);
+		}
+
+		void PartialPOCEnumerator::reset(SplitRule_csp split,
+				Hypergraph_csp graph,
+				bool inj,
+				shared_ptr<vector<AnonRule_csp>> orRules,
+				bool upToIso,
+				CancellationToken_csp cancellation) {
 
 			// delete all old content
 			if(totalPOCs) delete totalPOCs;
 			totalPOCs = nullptr;
+			coMatch = nullptr;
 			currentGraph = nullptr;
 			currentMapp = nullptr;
 			templateGraph = nullptr;
@@ -350,13 +423,21 @@ namespace uncover {
 			// set data unchanged
 			injective = inj;
 			originalRules = orRules;
+			this->cancellation = cancellation;
+
+			// the rule is already split in partial and total part, initialize TotalPOCEnumerator; co-matches may
+			// only be reduced by symmetry if the conflict-freeness wrt. the original rules is not checked
+			splitRule = split;
+			bool checksOriginal = !injective && originalRules && originalRules->size() > 0;
+			totalPOCs = TotalPOCEnumerator::create(splitRule->getTotalRule(), graph, this->injective,
+					splitRule->getTotalConstraints(),
+					(upToIso && !checksOriginal) ? splitRule->getInterchangeableNodes() : nullptr, cancellation).release();
 
-			// split the rule in partial and total part and initialize TotalPOCEnumerator
-			pair<AnonRule_sp, AnonRule_sp> splitRule(nullptr,nullptr);
-			rule->fillSplitRule(splitRule);
-			partialRule = splitRule.first;
+			initFromTotalPOCs();
 
-			totalPOCs = new TotalPOCEnumerator(splitRule.second, graph, this->injective);
+		}
+
+		void PartialPOCEnumerator::initFromTotalPOCs() {
 
 			// if there are no total POCs, this enumerator immediately ends
 			if(!totalPOCs->ended()) {
@@ -404,6 +485,9 @@ namespace uncover {
 				// skip the POC if conflict-free rules are used and all original rules are not
 				// conflict-free wrt. the current match
 				while(!injective && stillWork && !cfWrtOriginalRule()) {
+					if(cancellation) {
+						cancellation->throwIfCancelled();
+					}
 					stillWork = getNext();
 				}
 
@@ -434,8 +518,11 @@ namespace uncover {
 
 			// at this point the POCs are injective or no more mergings are possible
 
-			++(*totalPOCs);
-			if(totalPOCs->ended()) {
+			// an enumerator split from the vertex mergings of another one ends with its last vertex merging
+			if(totalPOCs) {
+				++(*totalPOCs);
+			}
+			if(!totalPOCs || totalPOCs->ended()) {
 
 				// clear all data
 				currentGraph = nullptr;
@@ -476,10 +563,34 @@ namespace uncover {
 				throw InvalidStateException("PartialPOCEnumerator cannot return the currently used match, "
 						"since it has ended.");
 			} else {
-				return totalPOCs->getCurrentCoMatch();
+				return totalPOCs ? totalPOCs->getCurrentCoMatch() : *coMatch;
 			}
 		}
 
+		PartialPOCEnumerator_up PartialPOCEnumerator::split() {
+
+			if(this->ended()) {
+				return nullptr;
+			}
+
+			// split along the unused co-matches first, since this splits off the largest part
+			TotalPOCEnumerator_up otherTotal = totalPOCs ? totalPOCs->split() : nullptr;
+			if(otherTotal) {
+				return PartialPOCEnumerator_up(new PartialPOCEnumerator(splitRule, std::move(otherTotal), injective, originalRules,
+						cancellation));
+			}
+
+			// otherwise split the vertex mergings of the current total POC
+			if(!injective) {
+				IDPartitionEnumerator otherMergings = vertexMergings->split();
+				if(!otherMergings.ended()) {
+					return PartialPOCEnumerator_up(new PartialPOCEnumerator(*this, std::move(otherMergings)));
+				}
+			}
+
+			return nullptr;
+		}
+
 		inline bool PartialPOCEnumerator::cfWrtOriginalRule() const {
 
 			if(originalRules && originalRules->size() > 0) {
@@ -22,6 +22,7 @@
 
 #include "../graphs/AnonRule.h"
 #include "TotalPOCEnumerator.h"
+#include "SplitRule.h"
 
 namespace uncover {
 	namespace rule_engine {
@@ -58,6 +59,29 @@ namespace uncover {
 						bool inj,
 						shared_ptr<vector<graphs::AnonRule_csp>> orRules);
 
+				/**
+				 * Generates a new PartialPOCEnumerator with the given already split rule and graph. This constructor
+				 * behaves like the one taking the unsplit rule, but reuses the given SplitRule instead of splitting
+				 * the rule again.
+				 * @param split the split of the rule which will be applied backwards
+				 * @param graph the graph to which the rule will be applied backwards
+				 * @param inj set to true iff only injective matching should be used
+				 * @param orRules a collection of all original rules; this parameter is ignored if inj=true, it is null
+				 *        or it is empty
+				 * @param upToIso set to true, if the pushout complements are only needed up to isomorphism; then
+				 * 				co-matches differing only by a permutation of interchangeable vertices are used only once
+				 * 				(see SplitRule::getInterchangeableNodes()), unless original rules are given
+				 * @param cancellation the CancellationToken checked while searching for co-matches and while skipping
+				 * 				pushout complements, or null (default); if it is cancelled, a CancelledException is thrown
+				 * 				and the enumerator has to be reset before being used again
+				 */
+				PartialPOCEnumerator(SplitRule_csp split,
+						graphs::Hypergraph_csp graph,
+						bool inj,
+						shared_ptr<vector<graphs::AnonRule_csp>> orRules,
+						bool upToIso = false,
+						basic_types::CancellationToken_csp cancellation = nullptr);
+
 				/**
 				 * Move constructor. Creates a new PartialPOCEnumerator using the data of the given one. The given
 				 * enumerator will be invalidated in the process and must be reset before being usable again.
@@ -94,6 +118,26 @@ namespace uncover {
 						bool inj,
 						shared_ptr<vector<graphs::AnonRule_csp>> orRules);
 
+				/**
+				 * Reinitializes the enumerator with the given already split rule and graph. This function behaves
+				 * like the one taking the unsplit rule, but reuses the given SplitRule instead of splitting the rule
+				 * again.
+				 * @param split the split of the rule which will be applied backwards
+				 * @param graph the graph to which the rule will be applied backwards
+				 * @param inj set to true iff only injective matching should be used
+				 * @param orRules a collection of all original rules; this parameter is ignored if inj=true, it is
+				 *        null or it is empty
+				 * @param upToIso set to true, if the pushout complements are only needed up to isomorphism (see
+				 * 				the constructor)
+				 * @param cancellation the CancellationToken to be checked or null (default; see the constructor)
+				 */
+				void reset(SplitRule_csp split,
+						graphs::Hypergraph_csp graph,
+						bool inj,
+						shared_ptr<vector<graphs::AnonRule_csp>> orRules,
+						bool upToIso = false,
+						basic_types::CancellationToken_csp cancellation = nullptr);
+
 				/**
 				 * Computes the next element in the enumeration. If the last element was already computed, this
 				 * call is ignored.
@@ -120,8 +164,50 @@ namespace uncover {
 				 */
 				graphs::Hypergraph_sp getGraph() const;
 
+				/**
+				 * Splits the remaining enumeration into two independent parts. If the TotalPOCEnumerator has unused
+				 * co-matches left, it is split along these co-matches (see TotalPOCEnumerator::split()). Otherwise, if
+				 * matches may be non-injective, the remaining vertex mergings of the current total pushout complement
+				 * are split (see basic_types::IDPartitionEnumerator::split()). The returned enumerator computes one
+				 * part of the remaining pushout complements and this enumerator the other part. Both may be used by
+				 * different threads. If the remaining enumeration cannot be split, null is returned. Note that the
+				 * returned enumerator may have already ended, if none of its pushout complements is conflict-free
+				 * wrt. an original rule.
+				 * @return an enumerator computing a part of the remaining pushout complements or null
+				 */
+				unique_ptr<PartialPOCEnumerator> split();
+
 			private:
 
+				/**
+				 * Generates a new PartialPOCEnumerator computing the pushout complements for the total pushout
+				 * complements of the given TotalPOCEnumerator. Used by split().
+				 * @param split the split of the rule which will be applied backwards
+				 * @param total the enumerator computing the total pushout complements
+				 * @param inj set to true iff only injective matching should be used
+				 * @param orRules a collection of all original rules
+				 * @param cancellation the CancellationToken to be checked or null
+				 */
+				PartialPOCEnumerator(SplitRule_csp split,
+						TotalPOCEnumerator_up total,
+						bool inj,
+						shared_ptr<vector<graphs::AnonRule_csp>> orRules,
+						basic_types::CancellationToken_csp cancellation);
+
+				/**
+				 * Generates a new PartialPOCEnumerator computing the pushout complements of the current total
+				 * pushout complement of the given enumerator for the given vertex mergings. This enumerator ends
+				 * when all these vertex mergings were enumerated. Used by split().
+				 * @param parent the enumerator of which the templates are used
+				 * @param mergings the vertex mergings to be enumerated
+				 */
+				PartialPOCEnumerator(PartialPOCEnumerator const& parent, basic_types::IDPartitionEnumerator&& mergings);
+
+				/**
+				 * Computes the first pushout complement from the current total pushout complement, if there is one.
+				 */
+				void initFromTotalPOCs();
+
 				/**
 				 * Uses the current graph and mapping returned by the TotalPOCEnumerator and initializes the template
 				 * fields with them. These include templateGraph, templateMapp and additionally vertexMergings,
@@ -183,9 +269,9 @@ namespace uncover {
 				inline bool cfWrtOriginalRule() const;
 
 				/**
-				 * Stores the partial part of the rule. This morphism is injective, surjective, but partial.
+				 * Stores the split of the rule into a partial and a total part.
 				 */
-				graphs::AnonRule_csp partialRule;
+				SplitRule_csp splitRule;
 
 				/**
 				 * Stores the collection of original rules. (only used for non-injective matches)
@@ -199,10 +285,16 @@ namespace uncover {
 
 				/**
 				 * Stores a TotalPOCEnumerator for computing pushout complement for the total part
-				 * of the rule.
+				 * of the rule. This is null, if the enumerator was created by splitting the vertex mergings
+				 * of another enumerator.
 				 */
 				TotalPOCEnumerator* totalPOCs;
 
+				/**
+				 * Stores the co-match used by this enumerator, if it has no TotalPOCEnumerator.
+				 */
+				graphs::Mapping_sp coMatch;
+
 				/**
 				 * Stores the last computed (partial) pushout complement.
 				 */
@@ -249,8 +341,18 @@ namespace uncover {
 				 */
 				bool nodesAlreadyMerged;
 
+				/**
+				 * Stores the CancellationToken checked by this enumerator; may be null.
+				 */
+				basic_types::CancellationToken_csp cancellation;
+
 		};
 
+		/**
+		 * Alias for a unique pointer to a PartialPOCEnumerator.
+		 */
+		typedef unique_ptr<PartialPOCEnumerator> PartialPOCEnumerator_up;
+
 	} /* namespace rule_engine */
 } /* namespace uncover */
 
@@ -0,0 +1,124 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#include "SplitRule.h"
+#include <map>
+#include <tuple>
+
+using namespace std;
+using namespace uncover::graphs;
+using namespace uncover::basic_types;
+
+namespace uncover {
+	namespace rule_engine {
+
+		SplitRule::SplitRule(AnonRule const& rule)
+			: partialRule(nullptr),
+			  totalRule(nullptr),
+			  totalConstraints(nullptr),
+			  deletedVertices(),
+			  deletedEdges(),
+			  interchangeableNodes(nullptr) {
+
+			pair<AnonRule_sp, AnonRule_sp> split(nullptr,nullptr);
+			rule.fillSplitRule(split);
+			partialRule = split.first;
+			totalRule = split.second;
+
+			MatchConstraints_sp constraints = make_shared<MatchConstraints>();
+			totalRule->fillMatchConstraints(*constraints);
+			totalConstraints = constraints;
+
+			auto leftGraph = partialRule->getLeft();
+			Mapping const& partMapp = partialRule->getMapping();
+			for(auto iter = leftGraph->cbeginVertices(); iter != leftGraph->cendVertices(); ++iter) {
+				if(!partMapp.hasSrc(iter->first)) {
+					deletedVertices.push_back(iter->first);
+				}
+			}
+			for(auto iter = leftGraph->cbeginEdges(); iter != leftGraph->cendEdges(); ++iter) {
+				if(!partMapp.hasSrc(iter->first)) {
+					deletedEdges.push_back(iter->first);
+				}
+			}
+
+			// group the isolated vertices of the right side with only isolated preimages by their number of preimages
+			// and their match constraints, since vertices with differing constraints (e.g. the universally quantified
+			// vertices of a UQRuleInstance) cannot be swapped without changing which co-matches are valid
+			Mapping::Inversion invRule;
+			rule.getMapping().getInverseMatch(invRule);
+			map<tuple<size_t,bool,bool>,SubIDPartition> isolatedByPreimages;
+			for(auto iter = rule.getRight()->cbeginVertices(); iter != rule.getRight()->cendVertices(); ++iter) {
+				if(rule.getRight()->getConnEdgesCount(iter->first) > 0) {
+					continue;
+				}
+				size_t preimages = 0;
+				bool isolatedPreimages = true;
+				auto invIt = invRule.find(iter->first);
+				if(invIt != invRule.end()) {
+					preimages = invIt->second.size();
+					for(IDType preimage : invIt->second) {
+						isolatedPreimages = isolatedPreimages && rule.getLeft()->getConnEdgesCount(preimage) == 0;
+					}
+				}
+				if(isolatedPreimages) {
+					isolatedByPreimages[make_tuple(preimages, totalConstraints->isExclusive(iter->first),
+							totalConstraints->needsExactDegree(iter->first))].insert(iter->first);
+				}
+			}
+			shared_ptr<IDPartition> classes = make_shared<IDPartition>();
+			for(auto iter = isolatedByPreimages.cbegin(); iter != isolatedByPreimages.cend(); ++iter) {
+				if(iter->second.size() > 1) {
+					classes->insert(iter->second);
+				}
+			}
+			if(!classes->empty()) {
+				interchangeableNodes = classes;
+			}
+
+		}
+
+		SplitRule::~SplitRule() {}
+
+		AnonRule_csp SplitRule::getPartialRule() const {
+			return partialRule;
+		}
+
+		AnonRule_csp SplitRule::getTotalRule() const {
+			return totalRule;
+		}
+
+		MatchConstraints_csp SplitRule::getTotalConstraints() const {
+			return totalConstraints;
+		}
+
+		vector<IDType> const& SplitRule::getDeletedVertices() const {
+			return deletedVertices;
+		}
+
+		vector<IDType> const& SplitRule::getDeletedEdges() const {
+			return deletedEdges;
+		}
+
+		shared_ptr<IDPartition const> SplitRule::getInterchangeableNodes() const {
+			return interchangeableNodes;
+		}
+
+	} /* namespace rule_engine */
+} /* namespace uncover */
@@ -0,0 +1,144 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifndef SPLITRULE_H_
+#define SPLITRULE_H_
+
+#include "../graphs/AnonRule.h"
+#include "../graphs/MatchConstraints.h"
+#include "../basic_types/IDPartition.h"
+
+namespace uncover {
+	namespace rule_engine {
+
+		/**
+		 * A SplitRule stores all data of a rule needed by the PartialPOCEnumerator, which does not depend on the
+		 * graph the rule is applied to. This is the split of the rule into a partial and a total part (see
+		 * graphs::AnonRule::fillSplitRule(...)), the MatchConstraints of the total part and the vertices and edges
+		 * of the left side on which the partial part is undefined. Since this data is the same for every graph, a
+		 * SplitRule can be computed once per rule and shared by all enumerators (see analysis::PreparedGTS).
+		 * @author Jan Stückrath
+		 * @see PartialPOCEnumerator
+		 */
+		class SplitRule {
+
+			public:
+
+				/**
+				 * Splits the given rule and computes all data derived from the split.
+				 * @param rule the rule to be split
+				 */
+				SplitRule(graphs::AnonRule const& rule);
+
+				/**
+				 * Destroys this SplitRule.
+				 */
+				virtual ~SplitRule();
+
+				/**
+				 * Returns the partial part of the rule. This morphism is injective, surjective, but partial.
+				 * @return the partial part of the rule
+				 */
+				graphs::AnonRule_csp getPartialRule() const;
+
+				/**
+				 * Returns the total part of the rule.
+				 * @return the total part of the rule
+				 */
+				graphs::AnonRule_csp getTotalRule() const;
+
+				/**
+				 * Returns the MatchConstraints of the total part of the rule.
+				 * @return the MatchConstraints of the total part
+				 */
+				graphs::MatchConstraints_csp getTotalConstraints() const;
+
+				/**
+				 * Returns the IDs of all vertices of the left side, on which the partial part is undefined, ordered
+				 * as in the left side.
+				 * @return the IDs of all deleted vertices
+				 */
+				vector<IDType> const& getDeletedVertices() const;
+
+				/**
+				 * Returns the IDs of all edges of the left side, on which the partial part is undefined, ordered
+				 * as in the left side.
+				 * @return the IDs of all deleted edges
+				 */
+				vector<IDType> const& getDeletedEdges() const;
+
+				/**
+				 * Returns the classes of interchangeable isolated vertices of the right side. Two isolated vertices
+				 * are interchangeable, if they have equally many preimages in the left side, all of these are isolated
+				 * as well and both vertices have the same constraints in the total rule (see getTotalConstraints()).
+				 * Then the rule has an automorphism swapping both vertices, hence co-matches
+				 * differing only by a permutation of interchangeable vertices lead to isomorphic pushout complements
+				 * (see StdMatchFinder::setInterchangeableNodes(...)).
+				 * @return the classes of interchangeable vertices with at least two elements or null, if there are none
+				 */
+				shared_ptr<basic_types::IDPartition const> getInterchangeableNodes() const;
+
+			private:
+
+				/**
+				 * Stores the partial part of the rule.
+				 */
+				graphs::AnonRule_csp partialRule;
+
+				/**
+				 * Stores the total part of the rule.
+				 */
+				graphs::AnonRule_csp totalRule;
+
+				/**
+				 * Stores the MatchConstraints of the total part.
+				 */
+				graphs::MatchConstraints_csp totalConstraints;
+
+				/**
+				 * Stores the IDs of all deleted vertices.
+				 */
+				vector<IDType> deletedVertices;
+
+				/**
+				 * Stores the IDs of all deleted edges.
+				 */
+				vector<IDType> deletedEdges;
+
+				/**
+				 * Stores the classes of interchangeable isolated vertices of the right side; may be null.
+				 */
+				shared_ptr<basic_types::IDPartition const> interchangeableNodes;
+
+		};
+
+		/**
+		 * Alias for a shared pointer to a SplitRule.
+		 */
+		typedef shared_ptr<SplitRule> SplitRule_sp;
+
+		/**
+		 * Alias for a shared pointer to a constant SplitRule.
+		 */
+		typedef shared_ptr<SplitRule const> SplitRule_csp;
+
+	} /* namespace rule_engine */
+} /* namespace uncover */
+
+#endif /* SPLITRULE_H_ */
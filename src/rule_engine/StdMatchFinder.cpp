@@ -20,21 +20,37 @@
 #include "StdMatchFinder.h"
 #include "../basic_types/RunException.h"
 #include "../logging/message_logging.h"
+#include "../logging/MetricsRegistry.h"
 #include "ExpEnumerator.h"
+#include <thread>
+#include <mutex>
+#include <algorithm>
+#include <limits>
 
 using namespace uncover::graphs;
 using namespace uncover::basic_types;
 using namespace uncover::logging;
+using namespace std;
 
 namespace uncover {
 	namespace rule_engine {
 
-		StdMatchFinder::StdMatchFinder(bool injective, bool stopFast) : matchInjective(injective), stopOnFirstFind(stopFast) {}
+		StdMatchFinder::StdMatchFinder(bool injective, bool stopFast)
+			: matchInjective(injective),
+			  stopOnFirstFind(stopFast),
+			  constraints(nullptr),
+			  interchangeable(),
+			  threadCount(1),
+			  parallelThreshold(64),
+			  cancellation(nullptr) {
+			selectEdgeSearch();
+		}
 
 		StdMatchFinder::~StdMatchFinder() {}
 
 		void StdMatchFinder::setInjectivity(bool injective) {
 			matchInjective = injective;
+			selectEdgeSearch();
 		}
 
 		bool StdMatchFinder::matchesInjectively() const {
@@ -43,20 +59,98 @@ namespace uncover {
 
 		void StdMatchFinder::setStopOnFirstFind(bool stopFast) {
 			stopOnFirstFind = stopFast;
+			selectEdgeSearch();
 		}
 
 		bool StdMatchFinder::stopsOnFirstFind() const {
 			return stopOnFirstFind;
 		}
 
+		void StdMatchFinder::setConstraints(MatchConstraints_csp constraints) {
+			this->constraints = (constraints && !constraints->isEmpty()) ? constraints : nullptr;
+			selectEdgeSearch();
+		}
+
+		MatchConstraints_csp StdMatchFinder::getConstraints() const {
+			return constraints;
+		}
+
+		void StdMatchFinder::setInterchangeableNodes(IDPartition const& classes) {
+			interchangeable.clear();
+			size_t index = 0;
+			for(auto classIt = classes.cbegin(); classIt != classes.cend(); ++classIt) {
+				// a single vertex is not interchangeable with any other
+				if(classIt->size() > 1) {
+					for(IDType node : *classIt) {
+						interchangeable[node] = index;
+					}
+					++index;
+				}
+			}
+		}
+
+		bool StdMatchFinder::hasInterchangeableNodes() const {
+			return !interchangeable.empty();
+		}
+
+		void StdMatchFinder::setThreadCount(unsigned int threadCount) {
+			this->threadCount = threadCount;
+		}
+
+		unsigned int StdMatchFinder::getThreadCount() const {
+			return threadCount;
+		}
+
+		void StdMatchFinder::setParallelThreshold(size_t minCandidates) {
+			parallelThreshold = minCandidates;
+		}
+
+		size_t StdMatchFinder::getParallelThreshold() const {
+			return parallelThreshold;
+		}
+
+		void StdMatchFinder::setCancellationToken(CancellationToken_csp token) {
+			cancellation = token;
+		}
+
+		CancellationToken_csp StdMatchFinder::getCancellationToken() const {
+			return cancellation;
+		}
+
+		void StdMatchFinder::selectEdgeSearch() {
+			// the instantiations are indexed by the bits injectivity (1), fast stopping (2) and constraints (4)
+			static EdgeSearch const searches[] = {
+					&StdMatchFinder::searchEdges<false,false,false>,
+					&StdMatchFinder::searchEdges<true,false,false>,
+					&StdMatchFinder::searchEdges<false,true,false>,
+					&StdMatchFinder::searchEdges<true,true,false>,
+					&StdMatchFinder::searchEdges<false,false,true>,
+					&StdMatchFinder::searchEdges<true,false,true>,
+					&StdMatchFinder::searchEdges<false,true,true>,
+					&StdMatchFinder::searchEdges<true,true,true>};
+			edgeSearch = searches[(matchInjective ? 1 : 0) | (stopOnFirstFind ? 2 : 0) | (constraints ? 4 : 0)];
+		}
+
 		shared_ptr<vector<Mapping>> StdMatchFinder::findMatches(
 				AnonHypergraph const& source,
 				AnonHypergraph const& target) const {
 
+			// this is the hottest call of the analysis and used by many threads at once, hence its shared metrics are
+			// only collected if expensive metrics are enabled
+			static Counter& callCounter = metrics.getCounter("matcher.calls");
+			static Histogram& matchHistogram = metrics.getHistogram("matcher.matches");
+			bool measured = metrics.isEnabled();
+			if(measured) {
+				callCounter.increment();
+			}
+
 			shared_ptr<vector<Mapping>> resultMappings = make_shared<vector<Mapping>>();
 			// source graph is bigger than target graph => no injective matching possible
 			if(matchInjective) {
 				if(source.getVertexCount() > target.getVertexCount() || source.getEdgeCount() > target.getEdgeCount()) {
+					if(measured) {
+						matchHistogram.record(0);
+					}
 					return resultMappings;
 				}
 			}
@@ -67,29 +161,50 @@ namespace uncover {
 				Mapping tempMap;
 				resultMappings->push_back(tempMap);
 			} else {
-				// if there is at least one edge, mapEdge will recursively map all edges and their attached nodes, in all possible ways
-				unordered_set<IDType> mappableEdges;
-				Mapping currentMapping;
-				Mapping revCurrentMapping;
-				mapEdges(source, target, edgesToGo, mappableEdges, currentMapping, revCurrentMapping, resultMappings);
+				(this->*edgeSearch)(source, target, edgesToGo, resultMappings);
 			}
 
 			// just map the remaining isolated nodes and return the result
-			return mapIsolatedNodes(source, target, resultMappings);
+			resultMappings = mapIsolatedNodes(source, target, resultMappings);
+			if(measured) {
+				matchHistogram.record(resultMappings->size());
+			}
+			return resultMappings;
+		}
+
+		template<bool Injective, bool StopFast, bool Constrained>
+		void StdMatchFinder::searchEdges(
+				AnonHypergraph const& source,
+				AnonHypergraph const& target,
+				size_t edgesToGo,
+				shared_ptr<vector<Mapping>> foundMappings) const {
+
+			if(threadCount != 1) {
+				mapEdgesParallel<Injective,StopFast,Constrained>(source, target, edgesToGo, foundMappings);
+			} else {
+				// if there is at least one edge, mapEdge will recursively map all edges and their attached nodes, in all possible ways
+				unordered_set<IDType> mappableEdges;
+				DenseMapping currentMapping(source.getLastUsedID());
+				DenseMapping revCurrentMapping(target.getLastUsedID());
+				mapEdges<Injective,StopFast,Constrained>(source, target, edgesToGo, mappableEdges, currentMapping,
+						revCurrentMapping, foundMappings);
+			}
 		}
 
+		template<bool Injective, bool StopFast, bool Constrained>
 		void StdMatchFinder::mapEdges(
 				AnonHypergraph const& source,
 				AnonHypergraph const& target,
 				size_t edgesToGo,
 				unordered_set<IDType>& mappableEdges,
-				Mapping& currentMapping,
-				Mapping& revCurrentMapping,
-				shared_ptr<vector<Mapping>> foundMappings) const {
+				DenseMapping& currentMapping,
+				DenseMapping& revCurrentMapping,
+				shared_ptr<vector<Mapping>> foundMappings,
+				std::atomic<bool> const* cancel) const {
 
 			// all edges were mapped, match found
 			if(edgesToGo == 0) {
-				foundMappings->push_back(currentMapping);
+				foundMappings->push_back(currentMapping.toMapping());
 			} else {
 
 				IDType currentEdge;
@@ -101,7 +216,8 @@ namespace uncover {
 					currentEdge = getNewEntryPoint(source, currentMapping);
 					// since the edge is completely new, all edges of the target graph are potential targets
 					for(auto iter = target.beginEdges(); iter != target.endEdges(); ++iter) {
-						if(isMapPossible(source, currentEdge, target, iter->first, currentMapping, revCurrentMapping)) {
+						if(isMapPossible<Injective,StopFast,Constrained>(source, currentEdge, target, iter->first, currentMapping,
+								revCurrentMapping)) {
 							possibleTargets.push_back(iter->first);
 						}
 					}
@@ -114,7 +230,7 @@ namespace uncover {
 					AnonHypergraph::ESet const* edgeCandidates = nullptr;
 					for(vector<IDType>::const_iterator iter = srcNodes->begin(); iter != srcNodes->end(); ++iter) {
 						if(currentMapping.hasSrc(*iter)) {
-							edgeCandidates = target.getConnectedEdges(currentMapping[*iter]);
+							edgeCandidates = target.getConnectedEdges(currentMapping.getTar(*iter));
 							break;
 						}
 					}
@@ -131,7 +247,8 @@ namespace uncover {
 					// since the edge is completely new, all edges of the target graph are potential targets
 					for(auto iter = edgeCandidates->cbegin(); iter != edgeCandidates->cend(); ++iter) {
 						if(dublicationCheck.count(*iter) == 0 &&
-								isMapPossible(source, currentEdge, target, *iter, currentMapping, revCurrentMapping)) {
+								isMapPossible<Injective,StopFast,Constrained>(source, currentEdge, target, *iter, currentMapping,
+										revCurrentMapping)) {
 							possibleTargets.push_back(*iter);
 							dublicationCheck.insert(*iter);
 						}
@@ -141,67 +258,193 @@ namespace uncover {
 				bool mappableEdgeDeleted = (mappableEdges.erase(currentEdge) > 0);
 				// recursively choose a possibleTarget and check if further matching is possible
 				for(vector<IDType>::iterator iter = possibleTargets.begin(); iter != possibleTargets.end(); ++iter) {
-					// map the edge and calculate differences
-					vector<IDType> currentMappingDiff;
-					vector<IDType> revCurrentMappingDiff;
-					vector<IDType> mappableEdgesDiff;
-					{
-						currentMapping[currentEdge] = *iter;
-						currentMappingDiff.push_back(currentEdge);
-						if(matchInjective) {
-							revCurrentMapping[*iter] = currentEdge;
-							revCurrentMappingDiff.push_back(*iter);
-						}
 
-						vector<IDType> const* srcNodes = source.getVerticesOfEdge(currentEdge);
-						for(vector<IDType>::const_iterator srcIt = srcNodes->begin(), tarIt = target.getVerticesOfEdge(*iter)->begin();
-								srcIt != srcNodes->end(); ++srcIt, ++tarIt) {
-							if(!currentMapping.hasSrc(*srcIt)) {
-								currentMapping[*srcIt] = *tarIt;
-								currentMappingDiff.push_back(*srcIt);
-								if(matchInjective) {
-									revCurrentMapping[*tarIt] = *srcIt;
-									revCurrentMappingDiff.push_back(*tarIt);
-								}
+					// stop if another thread requested it
+					if(cancel && cancel->load()) {
+						return;
+					}
 
-								auto conEdges = source.getConnectedEdges(*srcIt);
-								for(auto conEdgesIt = conEdges->cbegin(); conEdgesIt != conEdges->cend(); ++conEdgesIt) {
-									if(!currentMapping.hasSrc(*conEdgesIt) && (mappableEdges.count(*conEdgesIt) == 0)) {
-										mappableEdges.insert(*conEdgesIt);
-										mappableEdgesDiff.push_back(*conEdgesIt);
-									}
-								}
-							}
-						}
+					// abort the whole search if the caller requested it
+					if(cancellation) {
+						cancellation->throwIfCancelled();
 					}
 
-					// recursion checks the other edges of the left rule graph for possible matches
-					mapEdges(source, target, edgesToGo-1, mappableEdges, currentMapping, revCurrentMapping, foundMappings);
+					mapEdgeTo<Injective,StopFast,Constrained>(source, target, edgesToGo, currentEdge, *iter, mappableEdges,
+							currentMapping, revCurrentMapping, foundMappings, cancel);
 
 					// stop if just one mapping is searched for
-					if(stopOnFirstFind && (foundMappings->size() != 0)) {
+					if(StopFast && (foundMappings->size() != 0)) {
 						return;
 					}
+				}
+
+				if(mappableEdgeDeleted) {
+					mappableEdges.insert(currentEdge);
+				}
+			}
+		}
+
+		template<bool Injective, bool StopFast, bool Constrained>
+		void StdMatchFinder::mapEdgesParallel(
+				AnonHypergraph const& source,
+				AnonHypergraph const& target,
+				size_t edgesToGo,
+				shared_ptr<vector<Mapping>> foundMappings) const {
+
+			static Counter& parallelCounter = metrics.getCounter("matcher.parallel");
+
+			// compute the candidates of the first edge as the sequential search would do
+			unordered_set<IDType> mappableEdges;
+			DenseMapping currentMapping(source.getLastUsedID());
+			DenseMapping revCurrentMapping(target.getLastUsedID());
+			IDType entryEdge = getNewEntryPoint(source, currentMapping);
+			vector<IDType> candidates;
+			for(auto iter = target.beginEdges(); iter != target.endEdges(); ++iter) {
+				if(isMapPossible<Injective,StopFast,Constrained>(source, entryEdge, target, iter->first, currentMapping,
+						revCurrentMapping)) {
+					candidates.push_back(iter->first);
+				}
+			}
 
-					// undo all changes to currentMapping, foundTargets and mappableEdges
-					for(vector<IDType>::iterator iter2 = currentMappingDiff.begin(); iter2 != currentMappingDiff.end(); ++iter2) {
-						currentMapping.delSrc(*iter2);
+			unsigned int threads = threadCount;
+			if(threads == 0) {
+				threads = max(thread::hardware_concurrency(), 1u);
+			}
+			threads = min<size_t>(threads, candidates.size());
+
+			// starting threads does not pay off for few candidates
+			if(threads <= 1 || candidates.size() < parallelThreshold) {
+				for(IDType candidate : candidates) {
+					mapEdgeTo<Injective,StopFast,Constrained>(source, target, edgesToGo, entryEdge, candidate, mappableEdges,
+							currentMapping, revCurrentMapping, foundMappings, nullptr);
+					if(StopFast && (foundMappings->size() != 0)) {
+						return;
 					}
-					for(vector<IDType>::iterator iter2 = revCurrentMappingDiff.begin(); iter2 != revCurrentMappingDiff.end(); ++iter2) {
-						revCurrentMapping.delSrc(*iter2);
+				}
+				return;
+			}
+
+			parallelCounter.increment();
+
+			// the matches of each candidate are stored separately, such that the result has the same order as if
+			// the search was sequential
+			vector<shared_ptr<vector<Mapping>>> candidateMappings(candidates.size(), nullptr);
+			atomic<size_t> next(0);
+			atomic<bool> stop(false);
+			exception_ptr failure = nullptr;
+			mutex failureMutex;
+
+			// every thread takes the next candidate until all candidates are processed or one match suffices
+			auto worker = [&]() {
+				try {
+					unordered_set<IDType> workerMappableEdges;
+					DenseMapping workerMapping(source.getLastUsedID());
+					DenseMapping workerRevMapping(target.getLastUsedID());
+					for(size_t i = next++; i < candidates.size() && !stop.load(); i = next++) {
+						candidateMappings[i] = make_shared<vector<Mapping>>();
+						mapEdgeTo<Injective,StopFast,Constrained>(source, target, edgesToGo, entryEdge, candidates[i],
+								workerMappableEdges, workerMapping, workerRevMapping, candidateMappings[i], &stop);
+						if(StopFast && candidateMappings[i]->size() != 0) {
+							stop.store(true);
+						}
 					}
-					for(vector<IDType>::iterator iter2 = mappableEdgesDiff.begin(); iter2 != mappableEdgesDiff.end(); ++iter2) {
-						mappableEdges.erase(*iter2);
+				} catch(...) {
+					lock_guard<mutex> lock(failureMutex);
+					if(!failure) {
+						failure = current_exception();
 					}
+					stop.store(true);
 				}
+			};
 
-				if(mappableEdgeDeleted) {
-					mappableEdges.insert(currentEdge);
+			vector<thread> workers;
+			for(unsigned int i = 0; i < threads; ++i) {
+				workers.push_back(thread(worker));
+			}
+			for(thread& t : workers) {
+				t.join();
+			}
+
+			if(failure) {
+				rethrow_exception(failure);
+			}
+
+			for(shared_ptr<vector<Mapping>> const& mappings : candidateMappings) {
+				if(mappings) {
+					for(Mapping& mapping : *mappings) {
+						foundMappings->push_back(std::move(mapping));
+						if(StopFast) {
+							return;
+						}
+					}
+				}
+			}
+		}
+
+		template<bool Injective, bool StopFast, bool Constrained>
+		void StdMatchFinder::mapEdgeTo(
+				AnonHypergraph const& source,
+				AnonHypergraph const& target,
+				size_t edgesToGo,
+				IDType srcEdge,
+				IDType tarEdge,
+				unordered_set<IDType>& mappableEdges,
+				DenseMapping& currentMapping,
+				DenseMapping& revCurrentMapping,
+				shared_ptr<vector<Mapping>> foundMappings,
+				std::atomic<bool> const* cancel) const {
+
+			// map the edge and calculate differences
+			vector<IDType> currentMappingDiff;
+			vector<IDType> revCurrentMappingDiff;
+			vector<IDType> mappableEdgesDiff;
+			{
+				currentMapping.setTar(srcEdge, tarEdge);
+				currentMappingDiff.push_back(srcEdge);
+				if((Injective || Constrained) && !revCurrentMapping.hasSrc(tarEdge)) {
+					revCurrentMapping.setTar(tarEdge, srcEdge);
+					revCurrentMappingDiff.push_back(tarEdge);
+				}
+
+				vector<IDType> const* srcNodes = source.getVerticesOfEdge(srcEdge);
+				for(vector<IDType>::const_iterator srcIt = srcNodes->begin(), tarIt = target.getVerticesOfEdge(tarEdge)->begin();
+						srcIt != srcNodes->end(); ++srcIt, ++tarIt) {
+					if(!currentMapping.hasSrc(*srcIt)) {
+						currentMapping.setTar(*srcIt, *tarIt);
+						currentMappingDiff.push_back(*srcIt);
+						if((Injective || Constrained) && !revCurrentMapping.hasSrc(*tarIt)) {
+							revCurrentMapping.setTar(*tarIt, *srcIt);
+							revCurrentMappingDiff.push_back(*tarIt);
+						}
+
+						auto conEdges = source.getConnectedEdges(*srcIt);
+						for(auto conEdgesIt = conEdges->cbegin(); conEdgesIt != conEdges->cend(); ++conEdgesIt) {
+							if(!currentMapping.hasSrc(*conEdgesIt) && (mappableEdges.count(*conEdgesIt) == 0)) {
+								mappableEdges.insert(*conEdgesIt);
+								mappableEdgesDiff.push_back(*conEdgesIt);
+							}
+						}
+					}
 				}
 			}
+
+			// recursion checks the other edges of the left rule graph for possible matches
+			mapEdges<Injective,StopFast,Constrained>(source, target, edgesToGo-1, mappableEdges, currentMapping, revCurrentMapping,
+					foundMappings, cancel);
+
+			// undo all changes to currentMapping, foundTargets and mappableEdges
+			for(vector<IDType>::iterator iter2 = currentMappingDiff.begin(); iter2 != currentMappingDiff.end(); ++iter2) {
+				currentMapping.delSrc(*iter2);
+			}
+			for(vector<IDType>::iterator iter2 = revCurrentMappingDiff.begin(); iter2 != revCurrentMappingDiff.end(); ++iter2) {
+				revCurrentMapping.delSrc(*iter2);
+			}
+			for(vector<IDType>::iterator iter2 = mappableEdgesDiff.begin(); iter2 != mappableEdgesDiff.end(); ++iter2) {
+				mappableEdges.erase(*iter2);
+			}
 		}
 
-		IDType StdMatchFinder::getNewEntryPoint(AnonHypergraph const& source, const Mapping& currentMapping) const {
+		IDType StdMatchFinder::getNewEntryPoint(AnonHypergraph const& source, DenseMapping const& currentMapping) const {
 			IDType startEdge;
 			int lastArity = -1;
 			for(auto iter = source.beginEdges(); iter != source.endEdges(); ++iter) {
@@ -217,42 +460,80 @@ namespace uncover {
 			return startEdge;
 		}
 
+		template<bool Injective, bool StopFast, bool Constrained>
 		bool StdMatchFinder::isMapPossible(
 				AnonHypergraph const& source,
 				IDType srcEdge,
 				AnonHypergraph const& target,
 				IDType tarEdge,
-				Mapping& currentMapping,
-				Mapping& revCurrentMapping) const {
+				DenseMapping& currentMapping,
+				DenseMapping& revCurrentMapping) const {
 
 			// check if labels are equal, additionally check if target is already mapped to in injective case
-			if(!(matchInjective && revCurrentMapping.hasSrc(tarEdge)) &&
+			if(!(Injective && revCurrentMapping.hasSrc(tarEdge)) &&
 					(source.getEdge(srcEdge)->getLabel().compare(target.getEdge(tarEdge)->getLabel()) == 0)) {
+
+				// an exclusive edge may not share its image with another edge
+				if(Constrained && revCurrentMapping.hasSrc(tarEdge) &&
+						(constraints->isExclusive(srcEdge) || constraints->isExclusive(revCurrentMapping.getTar(tarEdge)))) {
+					return false;
+				}
+
 				vector<IDType> const* srcNodes = source.getVerticesOfEdge(srcEdge);
 				vector<IDType> const* tarNodes = target.getVerticesOfEdge(tarEdge);
 				if(srcNodes->size() != tarNodes->size()) {
 					logger.newWarning() << "An edge label is used for two different arities! No Matching possible." << endLogMessage;
 				} else {
 
-					unordered_map<IDType,IDType> tempMapping;
-					for(vector<IDType>::const_iterator srcIt = srcNodes->begin(), tarIt = tarNodes->begin(); srcIt != srcNodes->end(); ++srcIt, ++tarIt) {
+					// the pairs added by this edge are exactly the pairs at the earlier positions of both edges; since
+					// edges have small arities, these positions are searched linearly instead of storing the pairs
+					IDType const undefined = DenseMapping::undefined;
+					size_t arity = srcNodes->size();
+					for(size_t i = 0; i < arity; ++i) {
+
+						IDType src = (*srcNodes)[i];
+						IDType tar = (*tarNodes)[i];
+						IDType currentTar = currentMapping.getTar(src);
+
+						// check the constraints of nodes which will be mapped newly
+						if(Constrained && currentTar == undefined) {
+							if(constraints->needsExactDegree(src) &&
+									source.getConnEdgesCount(src) != target.getConnEdgesCount(tar)) {
+								return false;
+							}
+							IDType otherSrc = revCurrentMapping.getTar(tar);
+							for(size_t j = 0; otherSrc == undefined && j < i; ++j) {
+								if((*tarNodes)[j] == tar && !currentMapping.hasSrc((*srcNodes)[j])) {
+									otherSrc = (*srcNodes)[j];
+								}
+							}
+							if(otherSrc != undefined && otherSrc != src &&
+									(constraints->isExclusive(src) || constraints->isExclusive(otherSrc))) {
+								return false;
+							}
+						}
 
 						// if a node is already mapped, abort, if the mapping is not compatible
-						if(currentMapping.hasSrc(*srcIt) && (currentMapping[*srcIt] != *tarIt)) {
+						if(currentTar != undefined && currentTar != tar) {
 							return false;
 						}
 
 						// in the injective case a node may not be mapped to, if it is already mapped to from a different node
-						if(matchInjective && revCurrentMapping.hasSrc(*tarIt) && (revCurrentMapping[*tarIt] != *srcIt)) {
-							return false;
+						if(Injective) {
+							IDType revSrc = revCurrentMapping.getTar(tar);
+							if(revSrc != undefined && revSrc != src) {
+								return false;
+							}
 						}
 
 						// if the source edge has an id multiple times, it also has to be the same in the target edge
-						if((tempMapping.count(*srcIt) != 0) && (tempMapping[*srcIt] != *tarIt)) {
-							return false;
-						} else {
-							// (compatible) mappings already in currentMapping are also added to tempMapping in this way
-							tempMapping[*srcIt] = *tarIt;
+						for(size_t j = 0; j < i; ++j) {
+							if((*srcNodes)[j] == src) {
+								if((*tarNodes)[j] != tar) {
+									return false;
+								}
+								break;
+							}
 						}
 					}
 				}
@@ -289,8 +570,8 @@ namespace uncover {
 			// at this point it is clear that isolated nodes have to be mapped
 			shared_ptr<vector<Mapping>> result = make_shared<vector<Mapping>>();
 
-			// just map the nodes in some way
-			if(stopOnFirstFind) {
+			// just map the nodes in some way (constraints may forbid this, so all mappings are searched then)
+			if(stopOnFirstFind && !constraints) {
 				Mapping& mapp = *(foundMappings->begin());
 				if(!matchInjective) {
 					IDType targetID = target.beginVertices()->first;
@@ -314,7 +595,27 @@ namespace uncover {
 				return result;
 			}
 
-			// mapping isolated nodes in all possible ways
+			// order the isolated nodes such that interchangeable nodes are consecutive and mark them
+			vector<bool> sameClass;
+			if(!interchangeable.empty()) {
+				size_t noClass = numeric_limits<size_t>::max();
+				auto classOf = [&](IDType node) {
+					auto classIt = interchangeable.find(node);
+					return classIt == interchangeable.end() ? noClass : classIt->second;
+				};
+				stable_sort(isolatedNodes.begin(), isolatedNodes.end(),
+						[&](IDType n1, IDType n2) { return classOf(n1) < classOf(n2); });
+				for(size_t i = 0; i < isolatedNodes.size(); ++i) {
+					size_t nodeClass = classOf(isolatedNodes[i]);
+					sameClass.push_back(i > 0 && nodeClass != noClass && nodeClass == classOf(isolatedNodes[i-1]));
+				}
+				// no two isolated nodes are interchangeable
+				if(find(sameClass.cbegin(), sameClass.cend(), true) == sameClass.cend()) {
+					sameClass.clear();
+				}
+			}
+
+			// mapping isolated nodes in all possible ways (up to permutations of interchangeable nodes)
 			vector<IDType> possibleTargets;
 			// in the non-injective case the possible targets do not depend on the already found mapping
 			if(!matchInjective) {
@@ -332,6 +633,11 @@ namespace uncover {
 							possibleTargets.push_back(iter->first);
 						}
 					}
+				}
+				if(!sameClass.empty()) {
+					unordered_set<IDType> noTargets;
+					enumIsoNodesUpToSymmetry(isolatedNodes, sameClass, 0, 0, possibleTargets, noTargets, *mapIt, result);
+				} else if(matchInjective) {
 					unordered_set<IDType> noTargets;
 					enumAllIsoNodesInj(isolatedNodes, 0, possibleTargets, noTargets, *mapIt, result);
 				} else { // non-injective case
@@ -339,9 +645,42 @@ namespace uncover {
 				}
 			}
 
+			if(constraints) {
+				shared_ptr<vector<Mapping>> filtered = make_shared<vector<Mapping>>();
+				for(vector<Mapping>::iterator mapIt = result->begin(); mapIt != result->end(); ++mapIt) {
+					if(satisfiesConstraints(target, isolatedNodes, *mapIt)) {
+						filtered->push_back(std::move(*mapIt));
+						if(stopOnFirstFind) {
+							break;
+						}
+					}
+				}
+				result = filtered;
+			}
+
 			return result;
 		}
 
+		bool StdMatchFinder::satisfiesConstraints(
+				AnonHypergraph const& target,
+				vector<IDType> const& isolatedNodes,
+				Mapping const& mapping) const {
+
+			for(IDType node : isolatedNodes) {
+				IDType image = mapping.getTar(node);
+				if(constraints->needsExactDegree(node) && target.getConnEdgesCount(image) > 0) {
+					return false;
+				}
+				for(auto it = mapping.cbegin(); it != mapping.cend(); ++it) {
+					if(it->second == image && it->first != node &&
+							(constraints->isExclusive(node) || constraints->isExclusive(it->first))) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
 		void StdMatchFinder::enumAllIsoNodesInj(
 				vector<IDType>& isolatedNodes,
 				size_t isolatedNodesPos,
@@ -351,6 +690,9 @@ namespace uncover {
 				shared_ptr<vector<Mapping>> allMappings) const {
 
 			if(isolatedNodesPos >= isolatedNodes.size()) {
+				if(cancellation) {
+					cancellation->throwIfCancelled();
+				}
 				allMappings->push_back(currentMapping);
 			} else {
 				for(vector<IDType>::iterator iter = targets.begin(); iter != targets.end(); ++iter) {
@@ -364,6 +706,42 @@ namespace uncover {
 			}
 		}
 
+		void StdMatchFinder::enumIsoNodesUpToSymmetry(
+				vector<IDType> const& isolatedNodes,
+				vector<bool> const& sameClass,
+				size_t isolatedNodesPos,
+				size_t minTarget,
+				vector<IDType> const& targets,
+				unordered_set<IDType>& noTargets,
+				Mapping& currentMapping,
+				shared_ptr<vector<Mapping>> allMappings) const {
+
+			if(isolatedNodesPos >= isolatedNodes.size()) {
+				if(cancellation) {
+					cancellation->throwIfCancelled();
+				}
+				allMappings->push_back(currentMapping);
+			} else {
+				// an interchangeable node may not use an earlier target than its predecessor, such that every
+				// multiset (or subset) of targets is used only once
+				size_t first = sameClass.at(isolatedNodesPos) ? minTarget : 0;
+				for(size_t i = first; i < targets.size(); ++i) {
+					if(matchInjective) {
+						if(noTargets.count(targets.at(i))) {
+							continue;
+						}
+						noTargets.insert(targets.at(i));
+					}
+					currentMapping[isolatedNodes.at(isolatedNodesPos)] = targets.at(i);
+					enumIsoNodesUpToSymmetry(isolatedNodes, sameClass, isolatedNodesPos + 1, matchInjective ? i + 1 : i,
+							targets, noTargets, currentMapping, allMappings);
+					if(matchInjective) {
+						noTargets.erase(targets.at(i));
+					}
+				}
+			}
+		}
+
 		void StdMatchFinder::enumAllIsoNodesNonInj(
 				vector<IDType>& isolatedNodes,
 				vector<IDType>& targets,
@@ -378,6 +756,9 @@ namespace uncover {
 				for(size_t i = 0; i < isolatedNodes.size(); ++i) {
 					currentMapping[isolatedNodes.at(i)] = targets.at(enumerator[i]);
 				}
+				if(cancellation) {
+					cancellation->throwIfCancelled();
+				}
 				allMappings->push_back(currentMapping);
 				if(enumerator.canCountUp()) {
 					++enumerator;
@@ -23,6 +23,11 @@
 #include "../basic_types/globals.h"
 #include "../graphs/AnonHypergraph.h"
 #include "../graphs/Mapping.h"
+#include "../graphs/DenseMapping.h"
+#include "../graphs/MatchConstraints.h"
+#include "../basic_types/IDPartition.h"
+#include "../basic_types/CancellationToken.h"
+#include <atomic>
 
 namespace uncover {
 	namespace rule_engine {
@@ -30,7 +35,9 @@ namespace uncover {
 		/**
 		 * StdMatchFinder provides a simple algorithm which takes two arbitrary graphs and calculates all matchings from
 		 * one to the other. The Matcher can calculate injective as well as non-injective matches and can search for all
-		 * or just one match. The result is a collection of Mappings.
+		 * or just one match. The result is a collection of Mappings. The search can be parallelized by distributing the
+		 * candidates for the first edge of the source graph to several threads (see setThreadCount(...)), which is useful
+		 * if the target graph is large.
 		 * @author Jan Stückrath
 		 * @see graphs::Hypergraph
 		 * @see graphs::Mapping
@@ -75,6 +82,83 @@ namespace uncover {
 				 */
 				bool stopsOnFirstFind() const;
 
+				/**
+				 * Sets the MatchConstraints which every found match has to satisfy. The constraints are checked
+				 * whenever a partial match is extended, hence partial matches violating them are not completed. A null
+				 * pointer deactivates the constraints (default).
+				 * @param constraints the MatchConstraints on the elements of the source graph or a null pointer
+				 */
+				void setConstraints(graphs::MatchConstraints_csp constraints);
+
+				/**
+				 * Returns the MatchConstraints which every found match has to satisfy or a null pointer, if there are none.
+				 * @return the MatchConstraints used by this matcher
+				 */
+				graphs::MatchConstraints_csp getConstraints() const;
+
+				/**
+				 * Declares classes of interchangeable vertices of the source graph. If the caller only needs the
+				 * matches up to permutations of interchangeable vertices, e.g. because it only uses the results up to
+				 * isomorphism, the isolated vertices of a class are mapped in only one way per such permutation: as a
+				 * multiset of target vertices if the matches may be non-injective, or as a subset if they are
+				 * injective. The caller has to ensure that the vertices of a class satisfy the same MatchConstraints.
+				 * Vertices not contained in any class and vertices which are not isolated are mapped in all possible
+				 * ways. An empty partition (default) deactivates this reduction.
+				 * @param classes a partition of (some of) the vertices of the source graph into interchangeable vertices
+				 */
+				void setInterchangeableNodes(basic_types::IDPartition const& classes);
+
+				/**
+				 * Returns true, iff classes of interchangeable vertices are set (see setInterchangeableNodes(...)).
+				 * @return true, iff classes of interchangeable vertices are set
+				 */
+				bool hasInterchangeableNodes() const;
+
+				/**
+				 * Sets the number of threads used to search for matches. If more than one thread is used, the edges of
+				 * the target graph to which the first edge of the source graph can be mapped are distributed to the
+				 * threads, each continuing the search for its candidates sequentially. The found matches are ordered as
+				 * if the search was sequential. If the matcher stops after the first match, the other threads are
+				 * cancelled as soon as one match is found. Note that callers which already use several threads, e.g. the
+				 * UpwardClosureChecker, should use only one thread here.
+				 * @param threadCount the number of threads; 1 (default) searches sequentially, 0 uses one thread per
+				 * 				available core
+				 */
+				void setThreadCount(unsigned int threadCount);
+
+				/**
+				 * Returns the number of threads used to search for matches.
+				 * @return the number of threads used to search for matches; 0 means one thread per available core
+				 */
+				unsigned int getThreadCount() const;
+
+				/**
+				 * Sets the minimal number of candidates for the first edge, for which the search is parallelized. If
+				 * there are fewer candidates, the search is sequential, since starting threads does not pay off.
+				 * @param minCandidates the minimal number of candidates of a parallel search (default 64)
+				 */
+				void setParallelThreshold(size_t minCandidates);
+
+				/**
+				 * Returns the minimal number of candidates for the first edge, for which the search is parallelized.
+				 * @return the minimal number of candidates of a parallel search
+				 */
+				size_t getParallelThreshold() const;
+
+				/**
+				 * Sets the CancellationToken checked while searching for matches. If it is cancelled, the search stops
+				 * within a bounded number of steps and findMatches(...) throws a CancelledException. A null pointer
+				 * (default) deactivates the checks.
+				 * @param token the CancellationToken to be checked or a null pointer
+				 */
+				void setCancellationToken(basic_types::CancellationToken_csp token);
+
+				/**
+				 * Returns the CancellationToken checked while searching for matches or a null pointer, if there is none.
+				 * @return the CancellationToken checked while searching for matches
+				 */
+				basic_types::CancellationToken_csp getCancellationToken() const;
+
 				/**
 				 * This method takes two graphs and calculates all matches from the source to the target graph.
 				 * According to the parameter it is either searched for injective or non-injective matches.
@@ -84,6 +168,7 @@ namespace uncover {
 				 * @param target the target graph, which is mapped from the source graph
 				 * @return a collection of all matchings from the source graph to the target graph (an empty
 				 * 				 collection, if none exist)
+				 * @exception CancelledException if the set CancellationToken was cancelled during the search
 				 */
 				shared_ptr<vector<graphs::Mapping>> findMatches(
 						graphs::AnonHypergraph const& source,
@@ -91,6 +176,26 @@ namespace uncover {
 
 			protected:
 
+				/**
+				 * Maps all edges of the source graph to the target graph, sequentially or in parallel depending on the
+				 * thread count. This and the following search methods are instantiated for every combination of the
+				 * injectivity, the fast stopping and the existence of constraints, such that the innermost loops of the
+				 * search contain no checks and bookkeeping not needed by the current configuration. The instantiation
+				 * used is selected whenever one of these settings changes (see selectEdgeSearch()). In particular,
+				 * the reverse Mapping is only maintained if the matches are injective or constraints are set.
+				 * @param source the source graph, the Mapping maps from
+				 * @param target the target graph, the Mapping maps to
+				 * @param edgesToGo the number of edges of the source graph (at least one)
+				 * @param foundMappings the collection to which all found (total) Mappings are added; initially has to
+				 * 				be an empty vector
+				 */
+				template<bool Injective, bool StopFast, bool Constrained>
+				void searchEdges(
+						graphs::AnonHypergraph const& source,
+						graphs::AnonHypergraph const& target,
+						size_t edgesToGo,
+						shared_ptr<vector<graphs::Mapping>> foundMappings) const;
+
 				/**
 				 * Maps all edges of the target graph recursively to all edges of the source graph, including
 				 * the induced mapping on the nodes. Either searches for one or all Mappings. These Mappings
@@ -102,39 +207,92 @@ namespace uncover {
 				 * @param mappableEdges a working set of edges, which are not yet mapped, but attached to
 				 * 				already mapped nodes; initially this has to be an empty set
 				 * @param currentMapping the currently worked on (partial) Mapping; initially has to be an
-				 * 				empty Mapping
-				 * @param revCurrentMapping the reverse of currentMapping; only used if injective=true;
-				 * 				initially has to be an empty Mapping
+				 * 				empty DenseMapping
+				 * @param revCurrentMapping the reverse of currentMapping mapping every target to its first preimage; only
+				 * 				used if injective=true or constraints are set; initially has to be an empty DenseMapping
 				 * @param foundMappings the steadily growing collection of found (total) Mappings; initially
 				 * 				has to be an empty vector
+				 * @param cancel if not null, the search stops as soon as the pointed to flag is set; the partial Mapping
+				 * 				and the working set are not restored in this case
+				 * @exception CancelledException if the set CancellationToken is cancelled; the partial Mapping and the
+				 * 				working set are not restored in this case either
 				 */
+				template<bool Injective, bool StopFast, bool Constrained>
 				void mapEdges(
 						graphs::AnonHypergraph const& source,
 						graphs::AnonHypergraph const& target,
 						size_t edgesToGo,
 						unordered_set<IDType>& mappableEdges,
-						graphs::Mapping& currentMapping,
-						graphs::Mapping& revCurrentMapping,
+						graphs::DenseMapping& currentMapping,
+						graphs::DenseMapping& revCurrentMapping,
+						shared_ptr<vector<graphs::Mapping>> foundMappings,
+						std::atomic<bool> const* cancel = nullptr) const;
+
+				/**
+				 * Maps the given source edge to the given target edge, including the attached nodes, and continues the
+				 * search for the remaining edges via mapEdges(...). Afterwards, all changes to the partial Mapping and the
+				 * working set are undone.
+				 * @param source the source graph, the Mapping maps from
+				 * @param target the target graph, the Mapping maps to
+				 * @param edgesToGo the number of edges of the source graph, which still have to be mapped (including
+				 * 				the given source edge)
+				 * @param srcEdge the source edge to be mapped
+				 * @param tarEdge the target edge to which the source edge is mapped; isMapPossible(...) must be true
+				 * @param mappableEdges the working set of edges (see mapEdges(...))
+				 * @param currentMapping the currently worked on (partial) Mapping
+				 * @param revCurrentMapping the reverse of currentMapping (see mapEdges(...))
+				 * @param foundMappings the steadily growing collection of found (total) Mappings
+				 * @param cancel if not null, the search stops as soon as the pointed to flag is set
+				 */
+				template<bool Injective, bool StopFast, bool Constrained>
+				void mapEdgeTo(
+						graphs::AnonHypergraph const& source,
+						graphs::AnonHypergraph const& target,
+						size_t edgesToGo,
+						IDType srcEdge,
+						IDType tarEdge,
+						unordered_set<IDType>& mappableEdges,
+						graphs::DenseMapping& currentMapping,
+						graphs::DenseMapping& revCurrentMapping,
+						shared_ptr<vector<graphs::Mapping>> foundMappings,
+						std::atomic<bool> const* cancel) const;
+
+				/**
+				 * Maps all edges of the source graph like mapEdges(...), but distributes the candidates of the first
+				 * edge to the configured number of threads. If there are fewer candidates than the parallel threshold,
+				 * the candidates are processed sequentially.
+				 * @param source the source graph, the Mapping maps from
+				 * @param target the target graph, the Mapping maps to
+				 * @param edgesToGo the number of edges of the source graph (at least one)
+				 * @param foundMappings the collection to which all found (total) Mappings are added; initially has to
+				 * 				be an empty vector
+				 */
+				template<bool Injective, bool StopFast, bool Constrained>
+				void mapEdgesParallel(
+						graphs::AnonHypergraph const& source,
+						graphs::AnonHypergraph const& target,
+						size_t edgesToGo,
 						shared_ptr<vector<graphs::Mapping>> foundMappings) const;
 
 				/**
 				 * Checks if a given edge of the source graph can be mapped to a given edge of the target graph. This includes
 				 * checking for label equality and if the result is still a Mapping (and not a relation). If necessary, the
-				 * injectivity of the Mapping is also checked.
+				 * injectivity of the Mapping and the MatchConstraints are also checked.
 				 * @param source the source graph
 				 * @param srcEdge the source edge ID to check (must be part of the source graph)
 				 * @param target the target graph
 				 * @param tarEdge the target edge ID to check (must be part of the target graph)
 				 * @param currentMapping the currently worked on (partial) Mapping
-				 * @param revCurrentMapping the reverse of currentMapping; only used if injective=true
+				 * @param revCurrentMapping the reverse of currentMapping; only used if injective=true or constraints are set
 				 */
+				template<bool Injective, bool StopFast, bool Constrained>
 				bool isMapPossible(
 						graphs::AnonHypergraph const& source,
 						IDType srcEdge,
 						graphs::AnonHypergraph const& target,
 						IDType tarEdge,
-						graphs::Mapping& currentMapping,
-						graphs::Mapping& revCurrentMapping) const;
+						graphs::DenseMapping& currentMapping,
+						graphs::DenseMapping& revCurrentMapping) const;
 
 				/**
 				 * Searched for an unmapped edge in the source graph according to a simple optimization criterion. This criterion is:
@@ -145,7 +303,7 @@ namespace uncover {
 				 */
 				IDType getNewEntryPoint(
 						graphs::AnonHypergraph const& source,
-						graphs::Mapping const& currentMapping) const;
+						graphs::DenseMapping const& currentMapping) const;
 
 				/**
 				 * Maps all isolated notes of the source graph to the target graph. According to the parameters, either one or all
@@ -196,8 +354,67 @@ namespace uncover {
 						graphs::Mapping& currentMapping,
 						shared_ptr<vector<graphs::Mapping>> allMappings) const;
 
+				/**
+				 * Enumerates the possibilities to map the isolated nodes to the target graph, where consecutive isolated
+				 * nodes of the same class of interchangeable nodes are mapped in only one order, i.e. to target nodes
+				 * with non-decreasing positions in the list of targets (strictly increasing if injective). For each such
+				 * possibility a new Mapping is added to the collection of all Mappings.
+				 * @param isolatedNodes a vector containing all isolated nodes of the source graph, ordered such that
+				 * 				interchangeable nodes are consecutive
+				 * @param sameClass stores for each isolated node, whether it is interchangeable with its predecessor
+				 * @param isolatedNodesPos the current position in the list of isolated nodes; initially has to be 0
+				 * @param minTarget the first position in the list of targets, to which the node at isolatedNodesPos may
+				 * 				be mapped if it is interchangeable with its predecessor
+				 * @param targets a collection of all nodes of the target graph, where the isolated nodes can be mapped to
+				 * @param noTargets a set of all targets already used for isolated node mapping in the injective case;
+				 * 				initially has to be an empty set
+				 * @param currentMapping the currently worked on (partial) Mapping
+				 * @param allMappings a collection, where all resulting Mappings will be stored; should be empty initially
+				 */
+				void enumIsoNodesUpToSymmetry(
+						vector<IDType> const& isolatedNodes,
+						vector<bool> const& sameClass,
+						size_t isolatedNodesPos,
+						size_t minTarget,
+						vector<IDType> const& targets,
+						unordered_set<IDType>& noTargets,
+						graphs::Mapping& currentMapping,
+						shared_ptr<vector<graphs::Mapping>> allMappings) const;
+
+				/**
+				 * Checks whether the given (total) Mapping satisfies the MatchConstraints for all given isolated nodes.
+				 * The constraints of all other elements are already checked while mapping the edges.
+				 * @param target the target graph, mapped to
+				 * @param isolatedNodes a vector containing all isolated nodes of the source graph
+				 * @param mapping the Mapping to be checked
+				 * @return true, iff the constraints of all isolated nodes are satisfied
+				 */
+				bool satisfiesConstraints(graphs::AnonHypergraph const& target,
+						vector<IDType> const& isolatedNodes,
+						graphs::Mapping const& mapping) const;
+
 			private:
 
+				/**
+				 * The type of the instantiations of searchEdges(...).
+				 */
+				typedef void (StdMatchFinder::*EdgeSearch)(
+						graphs::AnonHypergraph const&,
+						graphs::AnonHypergraph const&,
+						size_t,
+						shared_ptr<vector<graphs::Mapping>>) const;
+
+				/**
+				 * Selects the instantiation of searchEdges(...) matching the current injectivity, fast stopping and
+				 * constraints. Has to be called whenever one of these settings changes.
+				 */
+				void selectEdgeSearch();
+
+				/**
+				 * Stores the instantiation of searchEdges(...) used by findMatches(...).
+				 */
+				EdgeSearch edgeSearch;
+
 				/**
 				 * Stores whether the used matches should injective or not.
 				 */
@@ -208,6 +425,32 @@ namespace uncover {
 				 */
 				bool stopOnFirstFind;
 
+				/**
+				 * Stores the MatchConstraints every match has to satisfy; may be null.
+				 */
+				graphs::MatchConstraints_csp constraints;
+
+				/**
+				 * Maps every vertex of a class of interchangeable vertices with at least two elements to the index of
+				 * its class; empty if no classes are set.
+				 */
+				unordered_map<IDType,size_t> interchangeable;
+
+				/**
+				 * Stores the number of threads used to search for matches; 0 means one thread per available core.
+				 */
+				unsigned int threadCount;
+
+				/**
+				 * Stores the minimal number of candidates for the first edge, for which the search is parallelized.
+				 */
+				size_t parallelThreshold;
+
+				/**
+				 * Stores the CancellationToken checked while searching for matches; may be null.
+				 */
+				basic_types::CancellationToken_csp cancellation;
+
 		};
 
 	} /* namespace rule_engine */
@@ -22,17 +22,30 @@
 
 #include "../graphs/AnonRule.h"
 #include "../graphs/Hypergraph.h"
-#include "StdMatchFinder.h"
+#include "../graphs/MatchConstraints.h"
+#include "../basic_types/IDPartition.h"
+#include "../basic_types/CancellationToken.h"
 #include "IDClosureEnumerator.h"
 #include "IDtoIDEnumerator.h"
 
 namespace uncover {
 	namespace rule_engine {
 
+		class TotalPOCEnumerator;
+
+		/**
+		 * Alias for a unique pointer to a TotalPOCEnumerator.
+		 */
+		typedef unique_ptr<TotalPOCEnumerator> TotalPOCEnumerator_up;
+
 		/**
 		 * This enumerator computes all pushout complements for all co-matches from a total (given) rule to
 		 * a given graph. The enumerator can be configured to compute only pushout complements, where the
 		 * match (from L to the POC) is injective.
+		 * This class manages the co-matches, while the pushout complements of a single co-match are computed by
+		 * one of three subclasses, depending on whether the rule and the co-matches are injective (see
+		 * InjRuleTotalPOCEnumerator, InjMatchTotalPOCEnumerator and ConflictFreeTotalPOCEnumerator). Instances
+		 * are created with create(...), which chooses the appropriate subclass.
 		 * @author Jan Stückrath
 		 */
 		class TotalPOCEnumerator {
@@ -40,24 +53,31 @@ namespace uncover {
 			public:
 
 				/**
-				 * Initializes a new TotalPOCEnumerator with the given graph and rule as parameters. The given
-				 * rule must be a total morphism. The matches can be set to injective or conflict-free.
+				 * Creates a new TotalPOCEnumerator for the given graph and rule. The given rule must be a total
+				 * morphism. The matches can be set to injective or conflict-free. The returned enumerator is
+				 * specialized for the injectivity of the rule and the matches.
 				 * @param rule the rule which should be applied backwards
 				 * @param graph the graph to which the co-matches will be computed
 				 * @param injective set to true if only injective POCs are wanted
-				 */
-				TotalPOCEnumerator(
+				 * @param constraints the MatchConstraints of the given rule (see
+				 * 				graphs::AnonRule::fillMatchConstraints(...)); if null (default), they are computed from
+				 * 				the rule
+				 * @param interchangeable classes of interchangeable vertices of the right side of the rule (see
+				 * 				SplitRule::getInterchangeableNodes()); if not null, co-matches differing only by a
+				 * 				permutation of these vertices are used only once, hence the pushout complements are only
+				 * 				computed up to isomorphism; if null (default), all co-matches are used
+				 * @param cancellation the CancellationToken checked while searching for co-matches or null (default)
+				 * @return the new enumerator, already pointing to the first pushout complement (if any)
+				 * @exception CancelledException if the given CancellationToken was cancelled during the search for
+				 * 				co-matches
+				 */
+				static TotalPOCEnumerator_up create(
 						graphs::AnonRule_csp rule,
 						graphs::Hypergraph_csp graph,
-						bool injective);
-
-				/**
-				 * Move constructor. Constructs a new TotalPOCEnumerator and moves the content of the given
-				 * TotalPOCEnumerator to the new one. Thereafter the old enumerator is invalid and may cause
-				 * exceptions and/or undefined behaviour if used.
-				 * @param oldEnum the enumerator of which the contents will be moved
-				 */
-				TotalPOCEnumerator(TotalPOCEnumerator&& oldEnum);
+						bool injective,
+						graphs::MatchConstraints_csp constraints = nullptr,
+						shared_ptr<basic_types::IDPartition const> interchangeable = nullptr,
+						basic_types::CancellationToken_csp cancellation = nullptr);
 
 				/**
 				 * Destroys this instance of the TotalPOCEnumerator.
@@ -67,6 +87,7 @@ namespace uncover {
 				/**
 				 * Resets this enumerator to its initial values. After this call will cause the enumeration
 				 * process to start from the beginning.
+				 * @exception CancelledException if the CancellationToken was cancelled during the search for co-matches
 				 */
 				void reset();
 
@@ -82,7 +103,7 @@ namespace uncover {
 				 * it behaves as a no-op.
 				 * @return a reference to this enumerator
 				 */
-				TotalPOCEnumerator& operator++();
+				virtual TotalPOCEnumerator& operator++() = 0;
 
 				/**
 				 * Returns the last computed Mapping (from L to the POC).
@@ -102,94 +123,100 @@ namespace uncover {
 				 */
 				graphs::Mapping const& getCurrentCoMatch() const;
 
-			private:
-
-				/**
-				 * Generates enumerators for the equivalences on edges and computes an initial,
-				 * non-merged POC. Only used if the rule is non-injective and matchings may be
-				 * non-injective. Initializes the fields: edgeEnums, templateGraphOr,
-				 * templateMappOr and mappPOCtoGraph.
-				 */
-				void initEdgeTemplates();
-
 				/**
-				 * First performs merging of vertices and edges according to the current equivalence
-				 * on the edges, and then generates the enumerators for possible equivalences on
-				 * vertices. Only used if the rule is non-injective and matchings may be non-injective.
-				 * Initializes the fields: vertexEnums, templateGraphME and templateMappME.
+				 * Splits the remaining enumeration along the co-matches. The returned enumerator takes half of the
+				 * co-matches which were not used so far, while this enumerator keeps the current co-match and the
+				 * other half. Both enumerators together compute every remaining pushout complement exactly once and
+				 * are independent of each other, i.e. they may be used by different threads. The mergings enumerated
+				 * for the current co-match are not split. If there is no unused co-match left, nothing is split and
+				 * null is returned.
+				 * @return an enumerator computing the pushout complements of half of the unused co-matches or null
 				 */
-				void initVertexTemplates();
+				TotalPOCEnumerator_up split();
 
-				/**
-				 * Generates enumerators for attaching edges in all possible ways to split vertices in
-				 * the POC and generates an initial non-merged POC. Only used if the rule is non-injective
-				 * and matchings are set to be injective. Initializes the fields: vertexEnumsInj,
-				 * templateGraphOr and templateMappOr.
-				 */
-				void initTemplatesInj();
+			protected:
 
 				/**
-				 * Generates an initial POC without any mergings. Only used if the rule is non-injective.
-				 * The initial POC is generated in the following way:
-				 * 1) Generate a copy of the left side L.
-				 * 2) Add a vertex for each vertex of the matched graph G without a preimage in R.
-				 * 3) Add an edge for each edge of G without a preimage in R. Attach this edge to new
-				 * vertices (adding them), except the vertex was already added in the previous step.
+				 * Initializes the fields shared by all TotalPOCEnumerators. No pushout complement is computed; this
+				 * is done by reset() or, if co-matches are given, by initFirstPOC().
+				 * @param rule the rule which should be applied backwards
+				 * @param graph the graph to which the co-matches will be computed
+				 * @param injective set to true if only injective POCs are wanted
+				 * @param constraints the MatchConstraints of the given rule or null
+				 * @param matches the co-matches to be used, the last co-match is used first; if null, the co-matches
+				 * 				are computed by reset()
 				 */
-				void generateNonMergedPOC();
+				TotalPOCEnumerator(
+						graphs::AnonRule_csp rule,
+						graphs::Hypergraph_csp graph,
+						bool injective,
+						graphs::MatchConstraints_csp constraints,
+						shared_ptr<vector<graphs::Mapping>> matches);
 
 				/**
-				 * Computes the current pushout complement from the temporary values computed to far.
-				 * Only used if the rule is non-injective and matchings may be non-injective.
+				 * Creates a new enumerator of the same type as this one, which uses the given co-matches instead of
+				 * searching for them. The first pushout complement is not computed yet. Used by split().
+				 * @param matches the co-matches to be used, the last co-match is used first
+				 * @return the new enumerator
 				 */
-				void computePOC();
+				virtual TotalPOCEnumerator_up createFor(shared_ptr<vector<graphs::Mapping>> matches) const = 0;
 
 				/**
-				 * Computes the current pushout complement from the temporary values computed to far.
-				 * Only used if the rule is non-injective and matchings are set to be injective.
+				 * Computes the first pushout complement for the current co-match. There has to be at least one
+				 * co-match left.
 				 */
-				void computePOCInj();
+				virtual void initFirstPOC() = 0;
 
 				/**
-				 * Computes the current pushout complement without use of any temporary computed
-				 * values. Only used if the rule is injective.
+				 * Discards the current co-match and continues with the next one. Since the matcher only finds matches
+				 * satisfying the constraints of the rule, pushout complements exist for every match.
+				 * @return true iff a match was found, i.e. the enumerator did not end
 				 */
-				void computePOCInjRule();
+				bool chooseNextMatch();
 
 				/**
-				 * Searches for the next match where pushout complements exist. Discards all matches
-				 * where no POCs exist.
-				 * @return true iff a match was found, i.e. the enumerator did not end
+				 * Generates an initial POC without any mergings. Only used if the rule is non-injective.
+				 * The initial POC is generated in the following way:
+				 * 1) Generate a copy of the left side L.
+				 * 2) Add a vertex for each vertex of the matched graph G without a preimage in R.
+				 * 3) Add an edge for each edge of G without a preimage in R. Attach this edge to new
+				 * vertices (adding them), except the vertex was already added in the previous step.
+				 * @param templateGraph the graph in which the initial POC is stored
+				 * @param templateMapp the mapping in which the (identical) mapping from L to the POC is stored
+				 * @param mappPOCtoGraph the mapping in which the mapping from the POC to the matched graph is stored
 				 */
-				bool chooseNextMatch();
+				void generateNonMergedPOC(
+						graphs::AnonHypergraph& templateGraph,
+						graphs::Mapping& templateMapp,
+						graphs::Mapping& mappPOCtoGraph) const;
 
 				/**
 				 * Increments the given collection of enumerators such that the next POC can be
-				 * generated from it. Only used if the rule is non-injective and matchings may be
-				 * non-injective.
+				 * generated from it.
+				 * @param enums the enumerators to be incremented
 				 * @return true iff the increment was possible, i.e. not all possibilities where
 				 * 				 enumerated yet
 				 */
-				bool incEnums(vector<IDClosureEnumerator>& enums);
+				static bool incEnums(vector<IDClosureEnumerator>& enums);
 
 				/**
 				 * Increments the given collection of enumerators such that the next POC can be
-				 * generated from it. Only used if the rule is non-injective and matchings are
-				 * set to be injective.
+				 * generated from it.
+				 * @param enums the enumerators to be incremented
 				 * @return true iff the increment was possible, i.e. not all possibilities where
 				 * 				 enumerated yet
 				 */
-				bool incEnums(vector<IDtoIDEnumerator>& enums);
+				static bool incEnums(vector<IDtoIDEnumerator>& enums);
 
 				/**
-				 * Deletes all temporary fields used in the POC computation (freeing their memory).
+				 * The rule which should be applied backwards.
 				 */
-				void deleteTemporaryFields();
+				graphs::AnonRule_csp rule;
 
 				/**
-				 * The rule which should be applied backwards.
+				 * Stores the MatchConstraints of the rule, which are checked while searching for co-matches.
 				 */
-				graphs::AnonRule_csp rule;
+				graphs::MatchConstraints_csp constraints;
 
 				/**
 				 * The graph to be matched to.
@@ -202,14 +229,14 @@ namespace uncover {
 				const bool injective;
 
 				/**
-				 * Stores if the rule is injective.
+				 * Stores the classes of interchangeable vertices of the right side passed to the matcher; may be null.
 				 */
-				const bool injectiveRule;
+				shared_ptr<basic_types::IDPartition const> interchangeable;
 
 				/**
-				 * Stores a matcher used to compute matchings from the right side to the given graph.
+				 * Stores the CancellationToken passed to the matcher; may be null.
 				 */
-				StdMatchFinder* matcher;
+				basic_types::CancellationToken_csp cancellation;
 
 				/**
 				 * A list of all co-matches computed. The last element is used as the current match and
@@ -227,57 +254,6 @@ namespace uncover {
 				 */
 				graphs::Mapping_sp currMapp;
 
-				///////////////////////////////////////////////////////////////
-				// fields used to enumerate all POCs of one applicable match //
-				///////////////////////////////////////////////////////////////
-
-				/**
-				 * A list of enumerators for enumerating all possible equivalences on edges.
-				 * Only used if rule is non-injective and matchings may be non-injective.
-				 */
-				vector<IDClosureEnumerator>* edgeEnums;
-
-				/**
-				 * A list of enumerators for enumerating all possible equivalences on vertices.
-				 * Only used if rule is non-injective and matchings may be non-injective.
-				 */
-				vector<IDClosureEnumerator>* vertexEnums;
-
-				/**
-				 * A copy of an initially non-merged POC. Only used if rule is non-injective.
-				 */
-				graphs::Hypergraph* templateGraphOr;
-
-				/**
-				 * The mapping from L to templateGraphOr. Only used if rule is non-injective.
-				 */
-				graphs::Mapping* templateMappOr;
-
-				/**
-				 * A copy of the POC after performing the mergings of edges (including implied
-				 * mergings on vertices. Only used if rule is non-injective and matchings may
-				 * be non-injective.
-				 */
-				graphs::Hypergraph* templateGraphME;
-
-				/**
-				 * The mapping from L to templateGraphME. Only used if rule is non-injective
-				 * and matchings may be non-injective.
-				 */
-				graphs::Mapping* templateMappME;
-
-				/**
-				 * The mapping from templateGraphOr to the matched graph. Only used if rule
-				 * is non-injective.
-				 */
-				graphs::Mapping* mappPOCtoGraph;
-
-				/**
-				 * A list of enumerators for enumerating possibilities to attach edges to split
-				 * vertices. Only used if rule is non-injective and matchings are set to be injective.
-				 */
-				vector<IDtoIDEnumerator>* vertexEnumsInj;
-
 		};
 
 	} /* namespace rule_engine */
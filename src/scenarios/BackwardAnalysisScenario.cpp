@@ -29,9 +29,13 @@
 #include "../subgraphs/SubgraphRulePreparer.h"
 #include "../subgraphs/SubgraphPOCEnumerator.h"
 #include "../analysis/InstantWriterResultHandler.h"
+#include "../analysis/BreadthFirstStrategy.h"
+#include "../analysis/SmallestFirstStrategy.h"
+#include "../analysis/FanOutStrategy.h"
 #include "../basic_types/InitialisationException.h"
 #include "../logging/message_logging.h"
 #include <sstream>
+#include <fstream>
 #include <boost/regex.hpp>
 #include <boost/lexical_cast.hpp>
 
@@ -54,7 +58,7 @@ namespace uncover {
 				"This scenario performs a backward search algorithm. It takes a graph transformation system and a "
 				"set of error graphs as input and computes the set of graphs, from which the given graphs are coverable. "
 				"Use the parameters to specify the order and result storage.", {SCN_BACKWARD_ANALYSIS_SHORT_1}),
-				backwardAnalysis(nullptr), resultHandler(nullptr), resultFolder("") {
+				backwardAnalysis(nullptr), resultHandler(nullptr), resultFolder(""), metricsWriter(nullptr), metricsInterval(0) {
 			this->addParameter("gts", "An XML file (in GTXL) containing the GTS which will be analyzed.", true);
 			this->addParameter("error-graph", "A GXL file containing the set of error graph which should not be coverable.", true);
 			this->addSynonymFor("error-graph", "err");
@@ -70,9 +74,36 @@ namespace uncover {
 					"of the initial graphs is represented by the calculated graph set and the analysis will stop if the check "
 					"succeeds. Default is 'false'.", false);
 			this->addSynonymFor("check-initial","ci");
+			this->addParameter("check-initial-threads", "The number of threads used to check whether one of the initial "
+					"graphs is represented by the calculated graphs (see check-initial). This pays off for many or large "
+					"initial graphs. Default is 1, 0 uses one thread per available core.", false);
+			this->addSynonymFor("check-initial-threads","cit");
+			this->addParameter("drop-isomorphic", "If set to true (default), graphs isomorphic to a graph computed earlier in "
+					"the same backward step are dropped before minimization. Set to 'false' to deactivate this check.", false);
+			this->addSynonymFor("drop-isomorphic","di");
+			this->addParameter("prune-rules", "If set to true, prepared rules whose backward application only yields graphs "
+					"subsumed by the results of another prepared rule are removed before the analysis starts. Default is 'false'.", false);
+			this->addSynonymFor("prune-rules","pr");
+			this->addParameter("exploration", "Defines the order in which the graphs of a backward step are processed. "
+					"Available are: 'bfs' (default, the order in which the graphs were found, latest first), 'smallest' "
+					"(smallest graphs first) and 'fanout' (graphs with the lowest estimated number of predecessors first).", false);
+			this->addSynonymFor("exploration","ex");
 			this->addParameter("matching", "Defines the type of matchings used. Available are: 'conflictfree' (default, alias: 'cf') "
 					"and 'injective' (alias: 'inj')", false);
 			this->addSynonymFor("matching", "m");
+			this->addParameter("matcher-threads", "The number of threads used by the subgraph order to search for an "
+					"embedding of one graph in another. This pays off for large graphs, e.g. large initial graphs. "
+					"Default is 1, 0 uses one thread per available core.", false);
+			this->addSynonymFor("matcher-threads", "mt");
+			this->addParameter("metrics", "If set, metrics about the backward search (e.g. processed graphs, order calls and "
+					"their duration) are written after each backward step to the file 'metrics.json' or 'metrics.csv' in the "
+					"result folder. Available formats are: 'json' and 'csv'", false);
+			this->addParameter("metrics-interval", "If metrics are written, additionally a snapshot of all metrics is written "
+					"every given number of seconds to the file 'metrics-periodic.json' or 'metrics-periodic.csv'.", false);
+			this->addParameter("prepared-cache", "A folder in which the prepared GTS is cached. If the same GTS was already "
+					"prepared for the same order and matching, the cached rules are loaded instead of preparing them again. "
+					"The cache is updated when the analysis terminates.", false);
+			this->addSynonymFor("prepared-cache", "pc");
 		}
 
 		BackwardAnalysisScenario::~BackwardAnalysisScenario() {
@@ -124,6 +155,16 @@ namespace uncover {
 				}
 			}
 
+			// read number of threads used by the matcher of the subgraph order
+			unsigned int matcherThreads = 1;
+			if(parameters.count("matcher-threads")) {
+				try {
+					matcherThreads = lexical_cast<unsigned int>(parameters["matcher-threads"]);
+				}	catch(bad_lexical_cast& ex) {
+						logger.newWarning() << "Invalid thread count '" << parameters["matcher-threads"] << "'. Using one thread." << endLogMessage;
+				}
+			}
+
 			// read if initial graphs should be checked
 			bool checkInitial = false;
 			if(parameters.count("check-initial")) {
@@ -137,6 +178,55 @@ namespace uncover {
 				}
 			}
 
+			// read number of threads used to check the initial graphs
+			unsigned int initialThreads = 1;
+			if(parameters.count("check-initial-threads")) {
+				try {
+					initialThreads = lexical_cast<unsigned int>(parameters["check-initial-threads"]);
+				}	catch(bad_lexical_cast& ex) {
+						logger.newWarning() << "Invalid thread count '" << parameters["check-initial-threads"] << "'. Using one thread." << endLogMessage;
+				}
+			}
+
+			// read if isomorphic graphs should be dropped early
+			bool dropIsomorphic = true;
+			if(parameters.count("drop-isomorphic")) {
+				if(!parameters["drop-isomorphic"].compare("true")) {
+					dropIsomorphic = true;
+				} else if(!parameters["drop-isomorphic"].compare("false")) {
+					dropIsomorphic = false;
+				} else {
+					logger.newWarning() << "Invalid value '" << parameters["drop-isomorphic"] << "' for drop-isomorphic parameter.";
+					logger.contMsg() << " Using default (true)." << endLogMessage;
+				}
+			}
+
+			// read if dominated prepared rules should be removed
+			bool pruneRules = false;
+			if(parameters.count("prune-rules")) {
+				if(!parameters["prune-rules"].compare("true")) {
+					pruneRules = true;
+				} else if(!parameters["prune-rules"].compare("false")) {
+					pruneRules = false;
+				} else {
+					logger.newWarning() << "Invalid value '" << parameters["prune-rules"] << "' for prune-rules parameter.";
+					logger.contMsg() << " Using default (false)." << endLogMessage;
+				}
+			}
+
+			// read the exploration strategy
+			ExplorationStrategy_sp strategy = make_shared<BreadthFirstStrategy>();
+			if(parameters.count("exploration")) {
+				if(!parameters["exploration"].compare("smallest")) {
+					strategy = make_shared<SmallestFirstStrategy>();
+				} else if(!parameters["exploration"].compare("fanout")) {
+					strategy = make_shared<FanOutStrategy>();
+				} else if(parameters["exploration"].compare("bfs")) {
+					logger.newWarning() << "Invalid value '" << parameters["exploration"] << "' for exploration parameter.";
+					logger.contMsg() << " Using default (bfs)." << endLogMessage;
+				}
+			}
+
 			bool injective = false;
 			if(parameters.count("matching")) {
 				if(!parameters["matching"].compare("injective") || !parameters["matching"].compare("inj")) {
@@ -149,6 +239,33 @@ namespace uncover {
 				}
 			}
 
+			// initialize metrics if requested
+			if(parameters.count("metrics")) {
+				MetricsFormat format = MetricsFormat::MF_JSON;
+				bool validFormat = true;
+				if(!parameters["metrics"].compare("csv")) {
+					format = MetricsFormat::MF_CSV;
+				} else if(parameters["metrics"].compare("json")) {
+					validFormat = false;
+					logger.newWarning() << "Invalid value '" << parameters["metrics"] << "' for metrics parameter.";
+					logger.contMsg() << " No metrics will be written." << endLogMessage;
+				}
+				if(validFormat) {
+					path metricsFile = resultFolder;
+					metricsFile /= "metrics." + MetricsWriter::getFileExtension(format);
+					metricsWriter = make_shared<MetricsWriter>(metrics, metricsFile.string(), format);
+					metrics.setEnabled(true);
+					if(parameters.count("metrics-interval")) {
+						try {
+							metricsInterval = lexical_cast<unsigned int>(parameters["metrics-interval"]);
+						}	catch(bad_lexical_cast& ex) {
+							logger.newWarning() << "Invalid metrics interval '" << parameters["metrics-interval"];
+							logger.contMsg() << "'. No periodic metrics will be written." << endLogMessage;
+						}
+					}
+				}
+			}
+
 			// read order specific components and initialize BackwardAnalysis object
 			boost::regex subgraphExpression("subgraph\\[([0-9]+|-)\\]");
 			boost::smatch subgraphResults;
@@ -203,7 +320,7 @@ namespace uncover {
 					backwardAnalysis = new BackwardAnalysis(
 							gts,
 							errorGraphs,
-							make_shared<SubgraphOrder>(),
+							make_shared<SubgraphOrder>(matcherThreads),
 							make_shared<SubgraphRulePreparer>(),
 							make_shared<SubgraphPOCEnumerator>(injective, bound),
 							checkInitial,
@@ -214,10 +331,40 @@ namespace uncover {
 			} else {
 				throw InitialisationException("Failed to initialize scenario '" + this->scenarioName + "', because the order '" + parameters["order"] + "' is unknown.");
 			}
+
+			backwardAnalysis->setMetricsWriter(metricsWriter);
+			backwardAnalysis->setDropIsomorphicGraphs(dropIsomorphic);
+			backwardAnalysis->setInitialCheckThreads(initialThreads);
+			backwardAnalysis->setPruneDominatedRules(pruneRules);
+			backwardAnalysis->setExplorationStrategy(strategy);
+
+			// initialize the cache of the prepared GTS if requested
+			if(parameters.count("prepared-cache")) {
+				path cacheFolder(parameters["prepared-cache"]);
+				if(exists(cacheFolder) && is_directory(cacheFolder)) {
+					uint64_t key = PreparedGTSCache::createKey(parameters["gts"],
+							{parameters["order"], injective ? "injective" : "conflictfree", pruneRules ? "pruned" : "unpruned"});
+					stringstream ss;
+					ss << "prepared-" << std::hex << key << ".bin";
+					cacheFolder /= ss.str();
+					backwardAnalysis->setPreparedGTSCache(make_shared<PreparedGTSCache>(cacheFolder.string(), key));
+				} else {
+					logger.newError() << "The given cache folder '" << parameters["prepared-cache"];
+					logger.contMsg() << "' does not exist or is no folder. The prepared GTS will not be cached!" << endLogMessage;
+				}
+			}
 		}
 
 		void BackwardAnalysisScenario::run() {
+			if(metricsWriter && metricsInterval > 0) {
+				path metricsFile = resultFolder;
+				metricsFile /= "metrics-periodic." + MetricsWriter::getFileExtension(metricsWriter->getFormat());
+				metricsWriter->startPeriodicSnapshots(metricsFile.string(), metricsInterval);
+			}
 			shared_ptr<vector<Hypergraph_sp>> errorGraphs = backwardAnalysis->performAnalysis();
+			if(metricsWriter) {
+				metricsWriter->stopPeriodicSnapshots();
+			}
 			unique_ptr<GTXLWriter> writer = GTXLWriter::newUniqueWriter();
 			logger.newUserInfo() << "Writing error graphs (" << errorGraphs->size() << " in total)." << endLogMessage;
 
@@ -229,6 +376,20 @@ namespace uncover {
 				filename /= "ErrorGraphs.xml";
 			}
 			writer->writeGXL(*errorGraphs, filename);
+
+			// report the costs of all rules
+			RuleProfiler_csp profiler = backwardAnalysis->getRuleProfiler();
+			if(profiler) {
+				profiler->logReport();
+				path profileFile = resultFolder;
+				profileFile /= "rule-profile.csv";
+				std::ofstream profileStream(profileFile.string().c_str());
+				if(profileStream.is_open()) {
+					profiler->writeCSV(profileStream);
+				} else {
+					logger.newError() << "Could not write the rule profile to '" << profileFile.string() << "'." << endLogMessage;
+				}
+			}
 		}
 
 	} /* namespace scenarios */
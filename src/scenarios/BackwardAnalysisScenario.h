@@ -54,7 +54,8 @@ namespace uncover {
 				 * Performs the backward analysis. This includes normally a preparation of the rules and performing
 				 * backward steps as long as necessary. The set of resulting error graphs is written to the file
 				 * system as XML document. The analysis may terminate before computing all error graphs if specified
-				 * its parameters
+				 * its parameters. Afterwards the costs of all rules are logged and written to the file 'rule-profile.csv'
+				 * in the result folder.
 				 */
 				virtual void run() override;
 
@@ -77,6 +78,16 @@ namespace uncover {
 				 */
 				boost::filesystem::path resultFolder;
 
+				/**
+				 * Stores the MetricsWriter used to write snapshots of all metrics, if requested.
+				 */
+				logging::MetricsWriter_sp metricsWriter;
+
+				/**
+				 * Stores the number of seconds between two periodic metrics snapshots; 0 deactivates periodic snapshots.
+				 */
+				unsigned int metricsInterval;
+
 		};
 
 	} /* namespace scenarios */
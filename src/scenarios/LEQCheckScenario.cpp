@@ -26,12 +26,17 @@
 #include "../io/XMLioException.h"
 #include "../logging/message_logging.h"
 #include <sstream>
+#include <fstream>
+#include <boost/lexical_cast.hpp>
 
+using namespace uncover::analysis;
 using namespace uncover::basic_types;
 using namespace uncover::graphs;
 using namespace uncover::io;
 using namespace uncover::logging;
 using namespace std;
+using boost::lexical_cast;
+using boost::bad_lexical_cast;
 
 namespace uncover {
 	namespace scenarios {
@@ -41,9 +46,11 @@ namespace uncover {
 				"parameter defines the order, the second parameter must specify the minimal elements of an upward-closed "
 				"class of graphs, and the third parameter is the set of graphs to be checked. More precisely this "
 				"scenario will check if there exists a graph G in the first set which is smaller or equal to a graph H in "
-				"the second set. If 'faststop' is set to false, then the scenario will not stop after the first H found. "
-				"If the involved graphs have names, these will be printed if a related pair or graphs was found.",
-				{SCN_LEQ_CHECK_SHORT_1}), faststop(false), order(nullptr), minimalGraphs(nullptr), checkGraphs(nullptr) {
+				"the second set. The check of a graph H stops after the first G found. If 'faststop' is set to true, the "
+				"scenario will stop after the first H found. The result is printed as a table containing the names (or IDs) "
+				"of the checked graphs and representing minimal graphs.",
+				{SCN_LEQ_CHECK_SHORT_1}), faststop(false), order(nullptr), threadCount(0), resultFile(),
+				minimalGraphs(nullptr), checkGraphs(nullptr) {
 
 			this->addParameter("order","Sets the order used for the check. May be 'minor' or 'subgraph'.",true);
 			this->addSynonymFor("order", "o");
@@ -60,19 +67,25 @@ namespace uncover {
 					"all graphs of the checkset. If 'true', the scenario will terminate after the first related pair was found.", false);
 			this->addSynonymFor("faststop","s");
 
-		}
+			this->addParameter("threads", "The number of threads used to check the graphs. If 0 (default), one thread per "
+					"hardware thread is used.", false);
+			this->addSynonymFor("threads","t");
+
+			this->addParameter("resultfile", "If given, the result table is written as CSV file with the given name instead "
+					"of printing it.", false);
+			this->addSynonymFor("resultfile","r");
 
-		LEQCheckScenario::~LEQCheckScenario() {
-			if(order) delete order;
 		}
 
+		LEQCheckScenario::~LEQCheckScenario() {}
+
 		void LEQCheckScenario::initialize(unordered_map<string, string>& parameters) {
 
 			// initialize order
 			if(!parameters["order"].compare("minor")) {
-				order = new minors::MinorOrder();
+				order = make_shared<minors::MinorOrder>();
 			} else if(!parameters["order"].compare("subgraph")) {
-				order = new subgraphs::SubgraphOrder();
+				order = make_shared<subgraphs::SubgraphOrder>();
 			} else {
 				stringstream ss;
 				ss << "Failed to recognize the given order '" << parameters["order"] << "'. Available options are: minor, subgraph";
@@ -104,7 +117,7 @@ namespace uncover {
 				if(!parameters["faststop"].compare("true")) {
 					faststop = true;
 				} else if(!parameters["faststop"].compare("false")) {
-					faststop = true;
+					faststop = false;
 				} else {
 					logger.newWarning() << "Unrecognized value '" << parameters["faststop"] << "' for parameter faststop. ";
 					logger.contMsg() << "Using default ('false')." << endLogMessage;
@@ -114,57 +127,63 @@ namespace uncover {
 				faststop = false;
 			}
 
+			// read optional parameter threads
+			threadCount = 0;
+			if(parameters.count("threads")) {
+				try {
+					threadCount = lexical_cast<unsigned int>(parameters["threads"]);
+				}	catch(bad_lexical_cast& ex) {
+					logger.newWarning() << "Invalid number of threads '" << parameters["threads"] << "'. ";
+					logger.contMsg() << "Using one thread per hardware thread." << endLogMessage;
+				}
+			}
+
+			// read optional parameter resultfile
+			if(parameters.count("resultfile")) {
+				resultFile = parameters["resultfile"];
+			} else {
+				resultFile = "";
+			}
+
 		}
 
 		void LEQCheckScenario::run() {
 
-			size_t count = 0;
-			size_t graphCount = 0;
-			bool newGraph = true;
-			for(auto graphToCheck : *checkGraphs) {
-
-				newGraph = true;
-
-				for(auto miniGraph : *minimalGraphs) {
-
-					if(order->isLessOrEq(*miniGraph, *graphToCheck)) {
-
-						++count;
-						if(newGraph) {
-							++graphCount;
-							newGraph = false;
-						}
-
-						if(!miniGraph->getName().empty() && !graphToCheck->getName().empty()) {
-							logger.newUserInfo() << "The graph '" << graphToCheck->getName() << "' has found to be represented ";
-							logger.contMsg() << "by the minimal graph '" << miniGraph->getName() << "'." << endLogMessage;
-						} else if(!miniGraph->getName().empty()) {
-							logger.newUserInfo() << "An unnamed graph (id=" << graphToCheck->getID() << ") was represented by ";
-							logger.contMsg() << "the minimal graph '" << miniGraph->getName() << "'." << endLogMessage;
-						} else if(!graphToCheck->getName().empty()) {
-							logger.newUserInfo() << "The graph '" << graphToCheck->getName() << "' has found to be represented ";
-							logger.contMsg() << "by an unnamed minimal graph (id=" << miniGraph->getID() << ")." << endLogMessage;
-						} else {
-							logger.newUserInfo() << "The unnamed graph (id=" << graphToCheck->getID() << ") has found to be ";
-							logger.contMsg() << "represented by an unnamed minimal graph (id=" << miniGraph->getID() << ")." << endLogMessage;
-						}
-
-						if(faststop) {
-							logger.newUserInfo() << "Skipped further checks due to faststop." << endLogMessage;
-							return;
-						}
+			UpwardClosureChecker checker(order, *minimalGraphs);
+			vector<MembershipResult> results = checker.checkAll(*checkGraphs, threadCount, faststop);
 
+			size_t checkedCount = 0;
+			size_t graphCount = 0;
+			size_t orderChecks = 0;
+			for(auto const& result : results) {
+				if(result.checked) {
+					++checkedCount;
+					orderChecks += result.orderChecks;
+					if(result.covered) {
+						++graphCount;
 					}
-
 				}
 			}
 
-			logger.newUserInfo() << "In total " << count;
-			if(count == 1) {
-				logger.contMsg() << " relation between graphs was found and ";
+			if(resultFile.empty()) {
+				stringstream ss;
+				writeTable(ss, results);
+				logger.newUserInfo() << "Results of the check:" << endl << ss.str() << endLogMessage;
 			} else {
-				logger.contMsg() << " relations between graphs where found and ";
+				std::ofstream resultStream(resultFile.c_str());
+				if(resultStream.is_open()) {
+					writeTable(resultStream, results);
+				} else {
+					logger.newError() << "Could not write the result table to '" << resultFile << "'." << endLogMessage;
+				}
+			}
+
+			if(checkedCount < checkGraphs->size()) {
+				logger.newUserInfo() << "Skipped further checks due to faststop." << endLogMessage;
 			}
+
+			logger.newUserInfo() << "In total " << checkedCount << " graphs were checked using " << orderChecks;
+			logger.contMsg() << " comparisons (instead of " << checkedCount * minimalGraphs->size() << ") and ";
 			if(graphCount == 1) {
 				logger.contMsg() << graphCount << " graph is represented by minimal elements." << endLogMessage;
 			} else {
@@ -173,5 +192,31 @@ namespace uncover {
 
 		}
 
+		string LEQCheckScenario::describe(Hypergraph const& graph) {
+			if(graph.getName().empty()) {
+				stringstream ss;
+				ss << "id=" << graph.getID();
+				return ss.str();
+			} else {
+				return graph.getName();
+			}
+		}
+
+		void LEQCheckScenario::writeTable(ostream& ost, vector<MembershipResult> const& results) const {
+			ost << "graph,represented,minimal graph,comparisons";
+			for(size_t i = 0; i < results.size(); ++i) {
+				if(!results[i].checked) {
+					continue;
+				}
+				ost << endl << describe(*(*checkGraphs)[i]) << ",";
+				if(results[i].covered) {
+					ost << "yes," << describe(*(*minimalGraphs)[results[i].coveringIndex]);
+				} else {
+					ost << "no,";
+				}
+				ost << "," << results[i].orderChecks;
+			}
+		}
+
 	} /* namespace scenarios */
 } /* namespace uncover */
@@ -20,9 +20,11 @@
 #ifndef LEQCHECKSCENARIO_H_
 #define LEQCHECKSCENARIO_H_
 
+#include <ostream>
 #include "../basic_types/Scenario.h"
 #include "../graphs/Hypergraph.h"
 #include "../basic_types/Order.h"
+#include "../analysis/UpwardClosureChecker.h"
 
 namespace uncover {
 	namespace scenarios {
@@ -30,9 +32,11 @@ namespace uncover {
 		/**
 		 * This Scenario allows to check whether graphs of a given set are represented by another given, upward-closed set.
 		 * The caller needs to fix the order, give the upward-closed set of graphs as its minimal elements and another
-		 * (finite) set of graphs to be checked. The scenario will then print all found relations, i.e. whenever a
-		 * minimal graph is smaller than a graph to be checked, and a total of graphs represented. If desired, the scenario
-		 * can terminate after the first found relation.
+		 * (finite) set of graphs to be checked. The graphs to be checked are distributed among several threads and each
+		 * graph is only compared to minimal graphs which are not excluded by their invariants (see UpwardClosureChecker).
+		 * The scenario will then print a table containing for each checked graph whether it is represented and by which
+		 * minimal graph, and a total of graphs represented. If desired, the scenario can terminate after the first
+		 * represented graph was found.
 		 *
 		 * <p><b>Note:</b> For a meaningful output, the graphs need to have names. Otherwise this Scenario can only output
 		 * the IDs automatically generated when reading the graphs!</p>
@@ -60,6 +64,20 @@ namespace uncover {
 
 			private:
 
+				/**
+				 * Returns the name of the given graph or, if the graph has no name, its ID.
+				 * @param graph the graph to be described
+				 * @return the name or ID of the graph
+				 */
+				static string describe(graphs::Hypergraph const& graph);
+
+				/**
+				 * Writes the given results as CSV table to the given stream, one line for each checked graph.
+				 * @param ost the stream to which the table will be written
+				 * @param results the results of all graphs in checkGraphs
+				 */
+				void writeTable(std::ostream& ost, vector<analysis::MembershipResult> const& results) const;
+
 				/**
 				 * Stores whether this Scenario should terminate after the first related pair of graphs was found.
 				 */
@@ -68,7 +86,17 @@ namespace uncover {
 				/**
 				 * Stores the Order used by this Scenario.
 				 */
-				basic_types::Order* order;
+				basic_types::Order_sp order;
+
+				/**
+				 * Stores the number of threads used for the check (0 means one per hardware thread).
+				 */
+				unsigned int threadCount;
+
+				/**
+				 * Stores the file to which the result table is written. If empty, the table is written to the log.
+				 */
+				string resultFile;
 
 				/**
 				 * Stores the set of minimal graphs of an upward closed set.
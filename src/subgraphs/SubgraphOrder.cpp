@@ -25,7 +25,9 @@ using namespace uncover::rule_engine;
 namespace uncover {
 	namespace subgraphs {
 
-		SubgraphOrder::SubgraphOrder() : matchFinder(true,true) {}
+		SubgraphOrder::SubgraphOrder(unsigned int threadCount) : matchFinder(true,true) {
+			matchFinder.setThreadCount(threadCount);
+		}
 
 		SubgraphOrder::~SubgraphOrder() {}
 
@@ -33,5 +35,10 @@ namespace uncover {
 			return matchFinder.findMatches(smaller, bigger)->size() != 0;
 		}
 
+		void SubgraphOrder::setCancellationToken(basic_types::CancellationToken_csp token) {
+			Order::setCancellationToken(token);
+			matchFinder.setCancellationToken(token);
+		}
+
 	} /* namespace subgraphs */
 } /* namespace uncover */
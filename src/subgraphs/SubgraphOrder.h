@@ -36,9 +36,12 @@ namespace uncover {
 			public:
 
 				/**
-				 * Creates a new SubgraphOrder object.
+				 * Creates a new SubgraphOrder object. The embedding of the smaller graph can be searched with several
+				 * threads, which pays off if the larger graphs are large (see rule_engine::StdMatchFinder::setThreadCount(...)).
+				 * @param threadCount the number of threads used by a single comparison; 1 (default) compares sequentially,
+				 * 				0 uses one thread per available core
 				 */
-				SubgraphOrder();
+				SubgraphOrder(unsigned int threadCount = 1);
 
 				/**
 				 * Destroys the current instance of this SubgraphOrder.
@@ -51,9 +54,16 @@ namespace uncover {
 				 * @param smaller the potential subgraph
 				 * @param bigger the potential larger graph
 				 * @return true, iff the smaller graph is a subgraph of the larger graph
+				 * @exception CancelledException if the set CancellationToken was cancelled during the check
 				 */
 				virtual bool isLessOrEq(graphs::Hypergraph const& smaller, graphs::Hypergraph const& bigger) const override;
 
+				/**
+				 * Sets the CancellationToken of this order, which is checked by the search for an embedding.
+				 * @param token the CancellationToken to be checked or a null pointer
+				 */
+				virtual void setCancellationToken(basic_types::CancellationToken_csp token) override;
+
 			private:
 
 				/**
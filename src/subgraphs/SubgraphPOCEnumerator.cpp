@@ -58,6 +58,8 @@ namespace uncover {
 
 		bool SubgraphPOCEnumerator::resetWith(AnonRule_csp rule, IDType ruleID, Hypergraph_csp graph) {
 
+			droppedByBound = 0;
+
 			if(rule == nullptr || graph == nullptr) {
 				return false;
 			}
@@ -77,8 +79,13 @@ namespace uncover {
 				}
 			}
 
+			// the split of the rule does not depend on the graph and is cached by the PreparedGTS if available
+			SplitRule_csp split = prepGTS ? prepGTS->getSplitRule(rule) : make_shared<SplitRule>(*rule);
+
+			// the old enumerator is discarded first, since creating the new one may be cancelled
 			if(partialEnumerator) delete partialEnumerator;
-			partialEnumerator = new PartialPOCEnumerator(rule,graph,injective,originalRules);
+			partialEnumerator = nullptr;
+			partialEnumerator = new PartialPOCEnumerator(split,graph,injective,originalRules,upToIsomorphism,cancellation);
 
 			if(!partialEnumerator->ended()) {
 
@@ -103,6 +110,9 @@ namespace uncover {
 
 			while(!partialEnumerator->ended() && exceedsBound()) {
 
+				if(cancellation) {
+					cancellation->throwIfCancelled();
+				}
 				++(*partialEnumerator);
 				if(resultHandler && !partialEnumerator->ended()) {
 					resultHandler->wasGeneratedByFrom(partialEnumerator->getGraph(),ruleID,graphID);
@@ -126,17 +136,21 @@ namespace uncover {
 			}
 		}
 
-		bool SubgraphPOCEnumerator::exceedsBound() const {
+		bool SubgraphPOCEnumerator::exceedsBound() {
 
 			if(pathbound >= 0) {
 				if(PathChecker::hasPath(*partialEnumerator->getGraph(),pathbound+1)) {
 
+					++droppedByBound;
+
 					if(resultHandler) {
 						resultHandler->wasNoValidGraph(partialEnumerator->getGraph()->getID());
 					}
 
-					logger.newUserInfo() << "A graph (with id=" << partialEnumerator->getGraph()->getID();
-					logger.contMsg() << ") has exceeded the pathbound and was dropped." << endLogMessage;
+					if(logger.isActive(LogTypes::LT_UserInfo)) {
+						logger.newUserInfo() << "A graph (with id=" << partialEnumerator->getGraph()->getID();
+						logger.contMsg() << ") has exceeded the pathbound and was dropped." << endLogMessage;
+					}
 
 					return true;
 
@@ -82,10 +82,11 @@ namespace uncover {
 
 				/**
 				 * Checks if the last graph computed by the stored PartialPOCEnumerator exceeds the path bound. If this
-				 * check fails, or if this check is disabled, false is returned.
+				 * check fails, or if this check is disabled, false is returned. Every graph exceeding the bound is
+				 * counted as dropped.
 				 * @return true, iff the path bound is positive and the current graph exceeds it.
 				 */
-				bool exceedsBound() const;
+				bool exceedsBound();
 
 				/**
 				 * Stores the path bound used by this enumerator. May be negative.
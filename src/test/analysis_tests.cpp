@@ -0,0 +1,599 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifdef COMPILE_UNIT_TESTS
+
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include "graph_generator.h"
+#include "../analysis/RuleProfiler.h"
+#include "../analysis/UpwardClosureChecker.h"
+#include "../analysis/InitialGraphIndex.h"
+#include "../analysis/BackwardAnalysis.h"
+#include "../analysis/NoRulePreparer.h"
+#include "../analysis/BreadthFirstStrategy.h"
+#include "../analysis/SmallestFirstStrategy.h"
+#include "../analysis/FanOutStrategy.h"
+#include "../subgraphs/SubgraphRulePreparer.h"
+#include "../subgraphs/SubgraphOrder.h"
+#include "../subgraphs/SubgraphPOCEnumerator.h"
+#include "../minors/MinorOrder.h"
+#include "../minors/MinorRulePreparer.h"
+#include "../basic_types/VectorCallback.h"
+#include "../basic_types/CancelledException.h"
+#include "../logging/message_logging.h"
+
+using namespace std;
+using namespace uncover::analysis;
+using namespace uncover::graphs;
+using namespace uncover::subgraphs;
+using namespace uncover::minors;
+using namespace uncover::basic_types;
+using namespace uncover::logging;
+
+namespace uncover {
+	namespace test {
+
+		BOOST_AUTO_TEST_SUITE(analysis_tests)
+
+		BOOST_AUTO_TEST_CASE(rule_profiler_test)
+		{
+			Rule_sp rule = getRule(0);
+			GTS::RuleMap rules;
+			rules[rule->getID()] = rule;
+			GTS gts("test gts", rules);
+			PreparedGTS_sp prepGTS = make_shared<PreparedGTS>(gts, make_shared<SubgraphRulePreparer>());
+			BOOST_REQUIRE(prepGTS->getStdRuleCount() > 0);
+
+			RuleProfiler profiler;
+			profiler.setPreparedGTS(prepGTS);
+			uint64_t time = 1;
+			for(auto ruleIt = prepGTS->getStdRules().cbegin(); ruleIt != prepGTS->getStdRules().cend(); ++ruleIt) {
+				RuleProfile& profile = profiler.getStdRuleProfile(ruleIt->first);
+				BOOST_CHECK_EQUAL(&profile, &profiler.getStdRuleProfile(ruleIt->first));
+				profile.applications += 1;
+				profile.enumerationTime += time++;
+				profile.produced += 3;
+				profile.survived += 2;
+				profile.droppedByBound += 1;
+			}
+
+			size_t count = prepGTS->getStdRuleCount();
+			vector<RuleProfile> prepared = profiler.getPreparedProfiles();
+			BOOST_CHECK_EQUAL(prepared.size(), count);
+			BOOST_CHECK_EQUAL(prepared.front().getTotalTime(), count);
+
+			vector<RuleProfile> original = profiler.getOriginalProfiles();
+			BOOST_REQUIRE_EQUAL(original.size(), 1);
+			BOOST_CHECK_EQUAL(original.front().ruleID, rule->getID());
+			BOOST_CHECK_EQUAL(original.front().applications, count);
+			BOOST_CHECK_EQUAL(original.front().produced, 3 * count);
+			BOOST_CHECK_EQUAL(original.front().survived, 2 * count);
+			BOOST_CHECK_EQUAL(original.front().droppedByBound, count);
+			BOOST_CHECK_EQUAL(original.front().getTotalTime(), count * (count + 1) / 2);
+
+			stringstream csv;
+			profiler.writeCSV(csv);
+			string line;
+			size_t lines = 0;
+			while(getline(csv, line)) {
+				++lines;
+			}
+			BOOST_CHECK_EQUAL(lines, count + 2);
+		}
+
+		/**
+		 * A PreparedGTS whose only prepared rule originates from all rules of the given GTS.
+		 */
+		class SharedRuleGTS : public PreparedGTS {
+
+			public:
+
+				SharedRuleGTS(GTS const& gts, Rule_sp preparedRule, vector<IDType> const& originalIDs)
+					: PreparedGTS(gts, make_shared<SubgraphRulePreparer>(), false, vector<Rule_sp>(1, preparedRule),
+							vector<vector<IDType>>(1, originalIDs)) {}
+
+		};
+
+		BOOST_AUTO_TEST_CASE(rule_profiler_shared_rule_test)
+		{
+			GTS::RuleMap rules;
+			vector<IDType> ids;
+			for(size_t i = 0; i < 3; ++i) {
+				Rule_sp rule = getRule(0);
+				rules[rule->getID()] = rule;
+				ids.push_back(rule->getID());
+			}
+			Rule_sp prepared = getRule(0);
+			PreparedGTS_sp prepGTS = make_shared<SharedRuleGTS>(GTS("test gts", rules), prepared, ids);
+			BOOST_REQUIRE_EQUAL(prepGTS->getStdRuleCount(), 1);
+			IDType preparedID = prepGTS->getStdRules().cbegin()->first;
+			BOOST_REQUIRE_EQUAL(prepGTS->getOriginalRules(preparedID)->size(), 3);
+
+			RuleProfiler profiler;
+			profiler.setPreparedGTS(prepGTS);
+			RuleProfile& profile = profiler.getStdRuleProfile(preparedID);
+			profile.applications = 4;
+			profile.resetTime = 10;
+			profile.enumerationTime = 20;
+			profile.produced = 2;
+			profile.survived = 1;
+			profile.droppedByBound = 3;
+
+			// the costs of the shared prepared rule are split among its originals and not counted three times
+			vector<RuleProfile> original = profiler.getOriginalProfiles();
+			BOOST_REQUIRE_EQUAL(original.size(), 3);
+			RuleProfile total;
+			for(RuleProfile const& origProfile : original) {
+				BOOST_CHECK(find(ids.cbegin(), ids.cend(), origProfile.ruleID) != ids.cend());
+				BOOST_CHECK(origProfile.getTotalTime() >= 9 && origProfile.getTotalTime() <= 11);
+				total.add(origProfile);
+			}
+			BOOST_CHECK_EQUAL(total.applications, 4);
+			BOOST_CHECK_EQUAL(total.getTotalTime(), 30);
+			BOOST_CHECK_EQUAL(total.produced, 2);
+			BOOST_CHECK_EQUAL(total.survived, 1);
+			BOOST_CHECK_EQUAL(total.droppedByBound, 3);
+		}
+
+		BOOST_AUTO_TEST_CASE(parallel_rule_preparation_test)
+		{
+			GTS::RuleMap rules;
+			for(size_t i = 0; i < 7; ++i) {
+				Rule_sp rule = getRule(i);
+				rules[rule->getID()] = rule;
+			}
+			GTS gts("test gts", rules);
+
+			// the prepared rules (ordered by ID) and their origins have to be independent of the thread count
+			vector<vector<pair<string, IDType>>> results;
+			for(unsigned int threads : {1u, 4u}) {
+				PreparedGTS prepGTS(gts, make_shared<MinorRulePreparer>(), true, threads);
+				map<IDType, Rule_sp> ordered(prepGTS.getStdRules().cbegin(), prepGTS.getStdRules().cend());
+				results.push_back(vector<pair<string, IDType>>());
+				for(auto it = ordered.cbegin(); it != ordered.cend(); ++it) {
+					auto originals = prepGTS.getOriginalRules(it->first);
+					BOOST_REQUIRE_EQUAL(originals->size(), 1);
+					results.back().push_back(make_pair(it->second->getName(), static_pointer_cast<Rule const>(originals->front())->getID()));
+				}
+			}
+			BOOST_REQUIRE(results.front().size() > rules.size());
+			BOOST_CHECK(results.front() == results.back());
+		}
+
+		BOOST_AUTO_TEST_CASE(minor_rule_preparer_test)
+		{
+			Rule_sp rule = getRule(3);
+			MinorRulePreparer preparer;
+
+			preparer.setOptimization(false);
+			vector<Rule_sp> allRules;
+			VectorCallback<Rule_sp> allCallback(allRules);
+			preparer.prepareRule(*rule, allCallback);
+			BOOST_CHECK_EQUAL(allRules.size(), 34);
+
+			// no-op rules are dropped without changing the remaining rules
+			preparer.setOptimization(true);
+			vector<Rule_sp> optRules;
+			VectorCallback<Rule_sp> optCallback(optRules);
+			preparer.prepareRule(*rule, optCallback);
+			BOOST_CHECK_EQUAL(optRules.size(), 30);
+			unordered_set<string> names;
+			for(Rule_sp& prepared : allRules) {
+				names.insert(prepared->getName());
+			}
+			for(Rule_sp& prepared : optRules) {
+				BOOST_CHECK(!preparer.isNoOpRule(*prepared));
+				BOOST_CHECK(names.count(prepared->getName()));
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(dominated_rule_pruning_test)
+		{
+			// creates a rule relabeling an A-edge to a B-edge, optionally with a C-edge as context, which is
+			// preserved or deleted together with its target vertex
+			auto createRule = [](string name, bool context, bool preserveContext) {
+				AnonHypergraph_sp left = make_shared<AnonHypergraph>();
+				AnonHypergraph_sp right = make_shared<AnonHypergraph>();
+				Mapping mapping;
+				IDType lv1 = left->addVertex(), lv2 = left->addVertex();
+				IDType rv1 = right->addVertex(), rv2 = right->addVertex();
+				mapping[lv1] = rv1;
+				mapping[lv2] = rv2;
+				left->addEdge("A", {lv1, lv2});
+				right->addEdge("B", {rv1, rv2});
+				if(context) {
+					IDType lv3 = left->addVertex();
+					IDType le = left->addEdge("C", {lv2, lv3});
+					if(preserveContext) {
+						IDType rv3 = right->addVertex();
+						mapping[lv3] = rv3;
+						mapping[le] = right->addEdge("C", {rv2, rv3});
+					}
+				}
+				return make_shared<Rule>(name, left, right, mapping);
+			};
+
+			Rule_sp base = createRule("base", false, false);
+			Rule_sp copy = createRule("copy", false, false);
+			Rule_sp extended = createRule("extended", true, true);
+			Rule_sp deleting = createRule("deleting", true, false);
+			GTS::RuleMap rules;
+			for(Rule_sp rule : {base, copy, extended, deleting}) {
+				rules[rule->getID()] = rule;
+			}
+			GTS gts("test gts", rules);
+
+			// the copy is isomorphic to the base rule and the extended rule only adds preserved context, hence both
+			// are dominated by the base rule
+			PreparedGTS prepGTS(gts, make_shared<NoRulePreparer>());
+			BOOST_CHECK_EQUAL(prepGTS.removeDominatedRules(), 2);
+			BOOST_REQUIRE_EQUAL(prepGTS.getStdRuleCount(), 2);
+			unordered_map<string, size_t> originalCounts;
+			for(auto it = prepGTS.getStdRules().cbegin(); it != prepGTS.getStdRules().cend(); ++it) {
+				originalCounts[it->second->getName()] = prepGTS.getOriginalRules(it->first)->size();
+			}
+			BOOST_CHECK_EQUAL(originalCounts["base"], 1);
+			BOOST_CHECK_EQUAL(originalCounts["deleting"], 1);
+			BOOST_CHECK_EQUAL(prepGTS.removeDominatedRules(), 0);
+
+			// without optimization the minor preparer generates no-op rules, which are removed as well
+			GTS::RuleMap minorRules;
+			Rule_sp minorRule = getRule(3);
+			minorRules[minorRule->getID()] = minorRule;
+			PreparedGTS minorGTS(GTS("minor gts", minorRules), make_shared<MinorRulePreparer>(), false);
+			BOOST_REQUIRE_EQUAL(minorGTS.getStdRuleCount(), 34);
+			BOOST_CHECK(minorGTS.removeDominatedRules() >= 4);
+			BOOST_CHECK(minorGTS.getStdRuleCount() <= 30);
+		}
+
+		BOOST_AUTO_TEST_CASE(exploration_strategy_test)
+		{
+			vector<Hypergraph_sp> graphs;
+			for(size_t i = 0; i < 8; ++i) {
+				graphs.push_back(getGraph(i));
+			}
+			auto takeAll = [&graphs](ExplorationStrategy& strategy) {
+				for(Hypergraph_sp& graph : graphs) {
+					strategy.add(graph);
+				}
+				BOOST_CHECK_EQUAL(strategy.size(), graphs.size());
+				vector<Hypergraph_sp> result;
+				while(!strategy.empty()) {
+					result.push_back(strategy.next());
+				}
+				BOOST_CHECK(strategy.next() == nullptr);
+				return result;
+			};
+
+			// the default strategy takes the latest graph first
+			BreadthFirstStrategy bfs;
+			vector<Hypergraph_sp> bfsOrder = takeAll(bfs);
+			BOOST_CHECK(vector<Hypergraph_sp>(graphs.rbegin(), graphs.rend()) == bfsOrder);
+
+			SmallestFirstStrategy smallest;
+			vector<Hypergraph_sp> smallestOrder = takeAll(smallest);
+			BOOST_REQUIRE_EQUAL(smallestOrder.size(), graphs.size());
+			for(size_t i = 1; i < smallestOrder.size(); ++i) {
+				BOOST_CHECK(smallestOrder[i-1]->getVertexCount() + smallestOrder[i-1]->getEdgeCount()
+						<= smallestOrder[i]->getVertexCount() + smallestOrder[i]->getEdgeCount());
+			}
+
+			// without profiling data every rule is expected to produce one graph per edge with a matching label
+			GTS::RuleMap rules;
+			for(size_t i = 0; i < 4; ++i) {
+				Rule_sp rule = getRule(i);
+				rules[rule->getID()] = rule;
+			}
+			PreparedGTS_sp prepGTS = make_shared<PreparedGTS>(GTS("test gts", rules), make_shared<NoRulePreparer>());
+			FanOutStrategy fanOut;
+			fanOut.initialize(prepGTS, make_shared<RuleProfiler>());
+			auto estimate = [&prepGTS](Hypergraph const& graph) {
+				size_t result = 0;
+				for(auto ruleIt = prepGTS->getStdRules().cbegin(); ruleIt != prepGTS->getStdRules().cend(); ++ruleIt) {
+					AnonHypergraph_csp right = ruleIt->second->getRight();
+					if(right->getEdgeCount() == 0) {
+						result += graph.getVertexCount();
+					}
+					for(auto rEdge = right->cbeginEdges(); rEdge != right->cendEdges(); ++rEdge) {
+						for(auto gEdge = graph.cbeginEdges(); gEdge != graph.cendEdges(); ++gEdge) {
+							result += (rEdge->second.getLabel() == gEdge->second.getLabel()) ? 1 : 0;
+						}
+					}
+				}
+				return result;
+			};
+			vector<Hypergraph_sp> fanOutOrder = takeAll(fanOut);
+			BOOST_REQUIRE_EQUAL(fanOutOrder.size(), graphs.size());
+			for(size_t i = 1; i < fanOutOrder.size(); ++i) {
+				BOOST_CHECK(estimate(*fanOutOrder[i-1]) <= estimate(*fanOutOrder[i]));
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(upward_closure_checker_test)
+		{
+			vector<Hypergraph_sp> graphs;
+			for(size_t i = 0; getGraph(i); ++i) {
+				graphs.push_back(getGraph(i));
+			}
+			vector<Hypergraph_sp> minimalGraphs(graphs.begin(), graphs.begin() + 8);
+
+			vector<Order_sp> orders = {make_shared<SubgraphOrder>(), make_shared<MinorOrder>()};
+			for(Order_sp order : orders) {
+				UpwardClosureChecker checker(order, minimalGraphs);
+				BOOST_CHECK_EQUAL(checker.getMinimalGraphCount(), minimalGraphs.size());
+
+				// compare with the unpruned result of the order
+				for(unsigned int threads : {1u, 4u}) {
+					vector<MembershipResult> results = checker.checkAll(graphs, threads);
+					BOOST_REQUIRE_EQUAL(results.size(), graphs.size());
+					for(size_t i = 0; i < graphs.size(); ++i) {
+						bool expected = false;
+						for(auto const& miniGraph : minimalGraphs) {
+							expected = expected || order->isLessOrEq(*miniGraph, *graphs[i]);
+						}
+						BOOST_CHECK(results[i].checked);
+						BOOST_CHECK_EQUAL(results[i].covered, expected);
+						BOOST_CHECK(results[i].orderChecks <= minimalGraphs.size());
+						if(results[i].covered) {
+							BOOST_CHECK(order->isLessOrEq(*minimalGraphs[results[i].coveringIndex], *graphs[i]));
+						}
+					}
+				}
+
+				// every minimal graph represents itself
+				for(size_t i = 0; i < minimalGraphs.size(); ++i) {
+					BOOST_CHECK(checker.check(*minimalGraphs[i]).covered);
+				}
+
+				// with early stopping only the first represented graph has to be checked
+				vector<MembershipResult> results = checker.checkAll(graphs, 1, true);
+				BOOST_CHECK(results[0].checked && results[0].covered);
+				BOOST_CHECK(!results.back().checked);
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(initial_graph_index_test)
+		{
+			// later test graphs reuse labels with other arities, which the matcher does not support
+			vector<Hypergraph_sp> graphs;
+			for(size_t i = 0; i < 13; ++i) {
+				graphs.push_back(getGraph(i));
+			}
+			vector<Hypergraph_sp> initialGraphs(graphs.begin() + 8, graphs.end());
+
+			vector<Order_sp> orders = {make_shared<SubgraphOrder>(), make_shared<MinorOrder>()};
+			for(Order_sp order : orders) {
+				InitialGraphIndex index(order, initialGraphs);
+				InitialGraphIndex unpruned(order, initialGraphs, false);
+				BOOST_CHECK_EQUAL(index.getInitialGraphCount(), initialGraphs.size());
+				BOOST_CHECK(index.getInitialGraph(2) == initialGraphs[2]);
+
+				// compare single graphs with the unpruned result of the order
+				for(size_t i = 0; i < graphs.size(); ++i) {
+					size_t expected = initialGraphs.size();
+					for(size_t j = 0; j < initialGraphs.size() && expected == initialGraphs.size(); ++j) {
+						if(order->isLessOrEq(*graphs[i], *initialGraphs[j])) {
+							expected = j;
+						}
+					}
+					CoverageResult result = index.check(*graphs[i]);
+					BOOST_CHECK_EQUAL(result.covered, expected < initialGraphs.size());
+					BOOST_CHECK(result.orderChecks <= unpruned.check(*graphs[i]).orderChecks);
+					if(result.covered) {
+						BOOST_CHECK_EQUAL(result.initialIndex, expected);
+					}
+				}
+
+				// a batch reports the first covering graph independent of the number of threads
+				vector<Hypergraph_sp> batch(graphs.begin(), graphs.begin() + 8);
+				size_t firstCovering = 0;
+				while(firstCovering < batch.size() && !index.check(*batch[firstCovering]).covered) {
+					++firstCovering;
+				}
+				for(unsigned int threads : {1u, 4u}) {
+					CoverageResult result = index.checkAll(batch, threads);
+					BOOST_CHECK_EQUAL(result.covered, firstCovering < batch.size());
+					if(result.covered) {
+						BOOST_CHECK_EQUAL(result.graphIndex, firstCovering);
+						BOOST_CHECK_EQUAL(result.initialIndex, index.check(*batch[firstCovering]).initialIndex);
+					}
+				}
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(initial_coverage_test)
+		{
+			// the rule adds an A-loop to a node, hence the error graph (an A-loop) is reached from a single node
+			Hypergraph_sp left = make_shared<Hypergraph>();
+			IDType leftNode = left->addVertex();
+			Hypergraph_sp right = make_shared<Hypergraph>();
+			IDType rightNode = right->addVertex();
+			right->addEdge("A", {rightNode});
+			Mapping mapp;
+			mapp[leftNode] = rightNode;
+			Rule_sp rule = make_shared<Rule>("add loop", left, right, mapp);
+
+			Hypergraph_sp initialGraph = make_shared<Hypergraph>("init");
+			initialGraph->addVertex();
+			initialGraph->addEdge("B", {initialGraph->addVertex()});
+			Hypergraph_sp errorGraph = make_shared<Hypergraph>();
+			errorGraph->addEdge("A", {errorGraph->addVertex()});
+
+			GTS::RuleMap rules;
+			rules[rule->getID()] = rule;
+			GTS_sp gts = make_shared<GTS>("test gts", rules, GTS::UQRuleMap(), vector<Hypergraph_sp>({initialGraph}));
+			BackwardAnalysis analysis(gts, make_shared<vector<Hypergraph_sp>>(1, errorGraph), make_shared<SubgraphOrder>(),
+					make_shared<SubgraphRulePreparer>(), make_shared<SubgraphPOCEnumerator>(true, -1), true);
+			analysis.setInitialCheckThreads(2);
+			analysis.performAnalysis();
+
+			InitialCoverage const& coverage = analysis.getInitialCoverage();
+			BOOST_REQUIRE(coverage.covered);
+			BOOST_CHECK(coverage.initialGraph == initialGraph);
+			BOOST_REQUIRE_EQUAL(coverage.graphChain.size(), 2);
+			BOOST_REQUIRE_EQUAL(coverage.ruleChain.size(), 1);
+			BOOST_CHECK_EQUAL(coverage.graphChain.back(), errorGraph->getID());
+		}
+
+		/**
+		 * A BackwardResultHandler cancelling the given token when the given number of graphs was generated.
+		 */
+		class CancellingResultHandler : public BackwardResultHandler {
+
+			public:
+
+				CancellingResultHandler(CancellationToken_sp token, size_t cancelAt)
+					: token(token), cancelAt(cancelAt), generated(0) {}
+
+				virtual void setOldGTS(GTS_csp gts) override {}
+				virtual void setPreparedGTS(PreparedGTS_csp gts) override {}
+				virtual void setFirstGraphs(shared_ptr<const vector<Hypergraph_sp>> graphs) override {}
+				virtual void wasDeletedBecauseOf(IDType deletedGraph, IDType reasonGraph) override {}
+				virtual void wasNoValidGraph(IDType deletedGraph) override {}
+				virtual void startingNewBackwardStep() override {}
+				virtual void finishedBackwardStep() override {}
+
+				virtual void wasGeneratedByFrom(Hypergraph_sp genGraph, IDType rule, IDType srcGraph) override {
+					if(++generated == cancelAt) {
+						token->cancel();
+					}
+				}
+
+				size_t getGenerated() const {
+					return generated;
+				}
+
+			private:
+
+				CancellationToken_sp token;
+				size_t cancelAt;
+				size_t generated;
+
+		};
+
+		BOOST_AUTO_TEST_CASE(cancelled_analysis_test)
+		{
+			// one rule adds an A-loop to a node, the other one a B-edge between two nodes
+			Hypergraph_sp loopLeft = make_shared<Hypergraph>();
+			Hypergraph_sp loopRight = make_shared<Hypergraph>();
+			Mapping loopMapp;
+			loopMapp[loopLeft->addVertex()] = loopRight->addVertex();
+			loopRight->addEdge("A", {loopRight->beginVertices()->first});
+			Hypergraph_sp edgeLeft = make_shared<Hypergraph>();
+			Hypergraph_sp edgeRight = make_shared<Hypergraph>();
+			Mapping edgeMapp;
+			IDType rv1 = edgeRight->addVertex(), rv2 = edgeRight->addVertex();
+			edgeMapp[edgeLeft->addVertex()] = rv1;
+			edgeMapp[edgeLeft->addVertex()] = rv2;
+			edgeRight->addEdge("B", {rv1, rv2});
+			GTS::RuleMap rules;
+			for(Rule_sp rule : {make_shared<Rule>("add loop", loopLeft, loopRight, loopMapp),
+					make_shared<Rule>("add edge", edgeLeft, edgeRight, edgeMapp)}) {
+				rules[rule->getID()] = rule;
+			}
+			GTS_sp gts = make_shared<GTS>("test gts", rules);
+
+			Hypergraph_sp errorGraph = make_shared<Hypergraph>();
+			IDType ev1 = errorGraph->addVertex(), ev2 = errorGraph->addVertex();
+			errorGraph->addEdge("A", {ev1});
+			errorGraph->addEdge("A", {ev2});
+			errorGraph->addEdge("B", {ev1, ev2});
+			auto errorGraphs = make_shared<vector<Hypergraph_sp>>(1, errorGraph);
+
+			// the complete result, which is not influenced by a token that is never cancelled
+			SubgraphOrder order;
+			Order_sp analysisOrder = make_shared<SubgraphOrder>();
+			CancellationToken_sp unused = make_shared<CancellationToken>();
+			auto neverCancelled = make_shared<CancellingResultHandler>(unused, 0);
+			BackwardAnalysis complete(gts, errorGraphs, analysisOrder, make_shared<SubgraphRulePreparer>(),
+					make_shared<SubgraphPOCEnumerator>(false, -1), false, neverCancelled);
+			complete.setCancellationToken(unused);
+			auto completeResult = complete.performAnalysis();
+			BOOST_CHECK(!unused->isCancelled());
+			BOOST_CHECK(analysisOrder->getCancellationToken() == nullptr);
+			BOOST_REQUIRE(neverCancelled->getGenerated() > 2);
+
+			// a cancelled analysis stops at once, but its result still represents the error graph and is covered by
+			// the complete result
+			for(size_t cancelAt = 1; cancelAt <= neverCancelled->getGenerated(); ++cancelAt) {
+				CancellationToken_sp token = make_shared<CancellationToken>();
+				auto handler = make_shared<CancellingResultHandler>(token, cancelAt);
+				BackwardAnalysis analysis(gts, errorGraphs, make_shared<SubgraphOrder>(), make_shared<SubgraphRulePreparer>(),
+						make_shared<SubgraphPOCEnumerator>(false, -1), false, handler);
+				analysis.setCancellationToken(token);
+				BOOST_CHECK(analysis.getCancellationToken() == token);
+				shared_ptr<vector<Hypergraph_sp>> result;
+				BOOST_REQUIRE_NO_THROW(result = analysis.performAnalysis());
+				BOOST_CHECK(token->isCancelled());
+				BOOST_CHECK_EQUAL(handler->getGenerated(), cancelAt);
+				BOOST_CHECK(any_of(result->cbegin(), result->cend(),
+						[&](Hypergraph_sp const& graph) { return order.isLessOrEq(*graph, *errorGraph); }));
+				for(Hypergraph_sp const& graph : *result) {
+					BOOST_CHECK(any_of(completeResult->cbegin(), completeResult->cend(),
+							[&](Hypergraph_sp const& minimal) { return order.isLessOrEq(*minimal, *graph); }));
+					BOOST_CHECK(!graph->getName().empty());
+				}
+				// the graphs of the unfinished step are discarded, hence the result is minimal
+				for(size_t i = 0; i < result->size(); ++i) {
+					for(size_t j = 0; j < result->size(); ++j) {
+						BOOST_CHECK(i == j || !order.isLessOrEq(*(*result)[i], *(*result)[j]));
+					}
+				}
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(timeout_message_test)
+		{
+			// testbench/perform-benchmark.sh reports a run as timed out iff its log contains "timeout reached"
+			Hypergraph_sp errorGraph = make_shared<Hypergraph>();
+			errorGraph->addEdge("A", {errorGraph->addVertex()});
+			auto errorGraphs = make_shared<vector<Hypergraph_sp>>(1, errorGraph);
+			GTS_sp gts = make_shared<GTS>("test gts", GTS::RuleMap());
+
+			LogTypes storedLevel = gl_LogLevel;
+			gl_LogLevel = LogTypes::LT_Warning;
+			for(bool explicitly : {false, true}) {
+				CancellationToken_sp token = make_shared<CancellationToken>();
+				if(explicitly) {
+					token->cancel();
+				} else {
+					token->setDeadline(CancellationToken::Clock::now());
+				}
+				BackwardAnalysis analysis(gts, errorGraphs, make_shared<SubgraphOrder>(),
+						make_shared<SubgraphRulePreparer>(), make_shared<SubgraphPOCEnumerator>(false, -1));
+				analysis.setCancellationToken(token);
+
+				stringstream output;
+				streambuf* coutBuffer = cout.rdbuf(output.rdbuf());
+				analysis.performAnalysis();
+				cout.rdbuf(coutBuffer);
+
+				BOOST_CHECK(output.str().find("Stopping") != string::npos);
+				BOOST_CHECK_EQUAL(output.str().find("timeout reached") != string::npos, !explicitly);
+			}
+			gl_LogLevel = storedLevel;
+		}
+
+		BOOST_AUTO_TEST_SUITE_END()
+
+	}
+}
+
+#endif
@@ -22,6 +22,7 @@
 #define BOOST_TEST_MODULE "all tests"
 #include <boost/test/included/unit_test.hpp>
 #include "../logging/message_logging.h"
+#include "../logging/MetricsRegistry.h"
 
 // disable buffering of cout because of issues with Boost.Test
 static struct DisableStdCoutBuffering
@@ -34,8 +35,11 @@ static struct DisableStdCoutBuffering
 
 using namespace uncover::logging;
 
-// initializing the message logger to be cout
-MessageLogger uncover::logging::logger(std::cout);
+// initializing the message logger to be cout (synchronous to keep the order of log and test messages)
+MessageLogger uncover::logging::logger(std::cout, false);
+
+// initializing the metrics registry
+MetricsRegistry uncover::logging::metrics;
 
 // **********************************************************************
 // all test suites are loaded automatically
@@ -17,7 +17,7 @@
  *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
  ***************************************************************************/
 
-#ifdef COMPILE_UNIT_TESTS
+#if defined(COMPILE_UNIT_TESTS) || defined(COMPILE_BENCHMARKS)
 
 #ifndef GRAPH_GENERATOR_H_
 #define GRAPH_GENERATOR_H_
@@ -0,0 +1,247 @@
+/***************************************************************************
+ *   Copyright (C) 2015 by Jan Stückrath <jan.stueckrath@uni-due.de>       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA 02110, USA                    *
+ ***************************************************************************/
+
+#ifdef COMPILE_UNIT_TESTS
+
+#include <boost/test/unit_test.hpp>
+#include "graph_generator.h"
+#include "../graphs/SignatureCreater.h"
+#include "../graphs/IsomorphismChecker.h"
+#include "../graphs/IsomorphismFilter.h"
+#include "../graphs/CanonicalLabeler.h"
+#include <algorithm>
+#include <random>
+
+using namespace uncover::graphs;
+
+namespace uncover {
+	namespace test {
+
+		/**
+		 * Creates a copy of the given graph, in which vertices and edges are added in reverse order. Hence the copy
+		 * is isomorphic to the given graph, but uses different IDs.
+		 * @param graph the graph to be copied
+		 * @return the reversed copy
+		 */
+		Hypergraph_sp reversedCopy(Hypergraph const& graph) {
+			Hypergraph_sp copy = make_shared<Hypergraph>();
+			unordered_map<IDType,IDType> vertexMap;
+			vector<IDType> vertices;
+			for(auto it = graph.cbeginVertices(); it != graph.cendVertices(); ++it) {
+				vertices.push_back(it->first);
+			}
+			for(auto it = vertices.crbegin(); it != vertices.crend(); ++it) {
+				vertexMap[*it] = copy->addVertex();
+			}
+			vector<pair<string,vector<IDType>>> edges;
+			for(auto it = graph.cbeginEdges(); it != graph.cendEdges(); ++it) {
+				vector<IDType> verts;
+				for(IDType v : it->second.getVertices()) {
+					verts.push_back(vertexMap[v]);
+				}
+				edges.push_back(make_pair(it->second.getLabel(), verts));
+			}
+			for(auto it = edges.crbegin(); it != edges.crend(); ++it) {
+				copy->addEdge(it->first, it->second);
+			}
+			return copy;
+		}
+
+		BOOST_AUTO_TEST_SUITE(isomorphism)
+
+		BOOST_AUTO_TEST_CASE(isomorphism_checker)
+		{
+			vector<Hypergraph_sp> graphs;
+			for(size_t i = 0; getGraph(i); ++i) {
+				graphs.push_back(getGraph(i));
+			}
+
+			for(size_t i = 0; i < graphs.size(); ++i) {
+				Hypergraph_sp copy = reversedCopy(*graphs[i]);
+				HGSignature sigs1, sigs2;
+				BOOST_CHECK_EQUAL(SignatureCreater::createHGSignature(*graphs[i], sigs1),
+						SignatureCreater::createHGSignature(*copy, sigs2));
+				BOOST_CHECK(IsomorphismChecker::areIsomorphic(*graphs[i], *copy));
+				BOOST_CHECK(IsomorphismChecker::areIsomorphic(*copy, *graphs[i]));
+
+				for(size_t j = 0; j < graphs.size(); ++j) {
+					bool iso = IsomorphismChecker::areIsomorphic(*graphs[i], *graphs[j]);
+					BOOST_CHECK_EQUAL(iso, IsomorphismChecker::areIsomorphic(*graphs[j], *copy));
+					if(iso) {
+						HGSignature sigs3;
+						BOOST_CHECK_EQUAL(SignatureCreater::createHGSignature(*graphs[j], sigs3),
+								SignatureCreater::createHGSignature(*graphs[i], sigs1));
+					}
+				}
+			}
+
+			// same labels and degrees, but different order of attached vertices
+			Hypergraph g1, g2;
+			IDType v1 = g1.addVertex(), v2 = g1.addVertex(), v3 = g1.addVertex();
+			g1.addEdge("A", {v1, v2});
+			g1.addEdge("A", {v2, v3});
+			IDType w1 = g2.addVertex(), w2 = g2.addVertex(), w3 = g2.addVertex();
+			g2.addEdge("A", {w1, w2});
+			g2.addEdge("A", {w3, w2});
+			BOOST_CHECK(!IsomorphismChecker::areIsomorphic(g1, g2));
+			BOOST_CHECK(IsomorphismChecker::areIsomorphic(g1, g1));
+
+			// two cycles of length 3 are not isomorphic to one cycle of length 6
+			Hypergraph c1, c2;
+			vector<IDType> vs1, vs2;
+			for(int i = 0; i < 6; ++i) {
+				vs1.push_back(c1.addVertex());
+				vs2.push_back(c2.addVertex());
+			}
+			for(int i = 0; i < 3; ++i) {
+				c1.addEdge("B", {vs1[i], vs1[(i+1)%3]});
+				c1.addEdge("B", {vs1[3+i], vs1[3+(i+1)%3]});
+			}
+			for(int i = 0; i < 6; ++i) {
+				c2.addEdge("B", {vs2[i], vs2[(i+1)%6]});
+			}
+			BOOST_CHECK(!IsomorphismChecker::areIsomorphic(c1, c2));
+		}
+
+		BOOST_AUTO_TEST_CASE(isomorphism_filter)
+		{
+			IsomorphismFilter filter;
+			Hypergraph_sp graph = getGraph(5);
+			Hypergraph_sp copy = reversedCopy(*graph);
+			BOOST_CHECK(!filter.findOrInsert(graph));
+			BOOST_CHECK_EQUAL(filter.findOrInsert(copy), graph);
+			BOOST_CHECK_EQUAL(filter.size(), 1);
+			BOOST_CHECK(!filter.findOrInsert(getGraph(6)) || IsomorphismChecker::areIsomorphic(*getGraph(6), *graph));
+			filter.clear();
+			BOOST_CHECK_EQUAL(filter.size(), 0);
+			BOOST_CHECK(!filter.findOrInsert(copy));
+
+			// searching does not store the graph
+			filter.clear();
+			BOOST_CHECK(!filter.find(graph));
+			BOOST_CHECK(!filter.find(copy));
+			BOOST_CHECK_EQUAL(filter.size(), 0);
+			filter.insert(copy);
+			BOOST_CHECK_EQUAL(filter.size(), 1);
+			BOOST_CHECK_EQUAL(filter.find(graph), copy);
+			filter.insert(getGraph(6));
+			BOOST_CHECK_EQUAL(filter.size(), 2);
+			BOOST_CHECK_EQUAL(filter.find(copy), copy);
+		}
+
+		BOOST_AUTO_TEST_CASE(canonical_form)
+		{
+			vector<Hypergraph_sp> graphs;
+			for(size_t i = 0; getGraph(i); ++i) {
+				graphs.push_back(getGraph(i));
+			}
+
+			for(size_t i = 0; i < graphs.size(); ++i) {
+				Hypergraph_sp copy = reversedCopy(*graphs[i]);
+				vector<IDType> ordering1, ordering2;
+				string form = CanonicalLabeler::createCanonicalForm(*graphs[i], ordering1);
+				BOOST_CHECK(form == CanonicalLabeler::createCanonicalForm(*copy, ordering2));
+
+				// the canonical orderings induce an isomorphism
+				BOOST_REQUIRE_EQUAL(ordering1.size(), graphs[i]->getVertexCount());
+				BOOST_REQUIRE_EQUAL(ordering2.size(), copy->getVertexCount());
+				unordered_map<IDType,IDType> iso;
+				for(size_t j = 0; j < ordering1.size(); ++j) {
+					iso[ordering1[j]] = ordering2[j];
+				}
+				vector<pair<string,vector<IDType>>> edges1, edges2;
+				for(auto it = graphs[i]->cbeginEdges(); it != graphs[i]->cendEdges(); ++it) {
+					vector<IDType> verts;
+					for(IDType v : it->second.getVertices()) {
+						verts.push_back(iso[v]);
+					}
+					edges1.push_back(make_pair(it->second.getLabel(), verts));
+				}
+				for(auto it = copy->cbeginEdges(); it != copy->cendEdges(); ++it) {
+					edges2.push_back(make_pair(it->second.getLabel(), it->second.getVertices()));
+				}
+				sort(edges1.begin(), edges1.end());
+				sort(edges2.begin(), edges2.end());
+				BOOST_CHECK(edges1 == edges2);
+
+				// the canonical forms are equal iff the graphs are isomorphic
+				for(size_t j = 0; j < graphs.size(); ++j) {
+					BOOST_CHECK_EQUAL(form == CanonicalLabeler::createCanonicalForm(*graphs[j]),
+							IsomorphismChecker::areIsomorphic(*graphs[i], *graphs[j]));
+				}
+			}
+
+			// graphs with many automorphisms: disjoint cycles of length 3 and 4 (with the same number of vertices)
+			Hypergraph c1, c2;
+			vector<IDType> vs1, vs2;
+			for(int i = 0; i < 24; ++i) {
+				vs1.push_back(c1.addVertex());
+				vs2.push_back(c2.addVertex());
+			}
+			for(int i = 0; i < 24; ++i) {
+				c1.addEdge("C", {vs1[i], vs1[i - i%3 + (i+1)%3]});
+				c2.addEdge("C", {vs2[i], vs2[i - i%4 + (i+1)%4]});
+			}
+			BOOST_CHECK(CanonicalLabeler::createCanonicalForm(c1) != CanonicalLabeler::createCanonicalForm(c2));
+			BOOST_CHECK(CanonicalLabeler::createCanonicalForm(c1) == CanonicalLabeler::createCanonicalForm(*reversedCopy(c1)));
+
+			// randomly permuted random graphs
+			std::mt19937 random(42);
+			for(int round = 0; round < 50; ++round) {
+				size_t vertexCount = 1 + random() % 8;
+				Hypergraph g1, g2;
+				vector<IDType> verts1, verts2;
+				for(size_t i = 0; i < vertexCount; ++i) {
+					verts1.push_back(g1.addVertex());
+					verts2.push_back(g2.addVertex());
+				}
+				vector<size_t> perm(vertexCount);
+				for(size_t i = 0; i < vertexCount; ++i) {
+					perm[i] = i;
+				}
+				std::shuffle(perm.begin(), perm.end(), random);
+				size_t edgeCount = random() % 12;
+				for(size_t i = 0; i < edgeCount; ++i) {
+					string label = (random() % 2) ? "A" : "B";
+					size_t arity = 1 + random() % 3;
+					vector<IDType> att1, att2;
+					for(size_t j = 0; j < arity; ++j) {
+						size_t v = random() % vertexCount;
+						att1.push_back(verts1[v]);
+						att2.push_back(verts2[perm[v]]);
+					}
+					g1.addEdge(label + std::to_string(arity), att1);
+					g2.addEdge(label + std::to_string(arity), att2);
+				}
+				BOOST_CHECK(CanonicalLabeler::createCanonicalForm(g1) == CanonicalLabeler::createCanonicalForm(g2));
+
+				// deleting an edge leads to a different form
+				if(edgeCount > 0) {
+					g2.deleteEdge(g2.cbeginEdges()->first);
+					BOOST_CHECK(CanonicalLabeler::createCanonicalForm(g1) != CanonicalLabeler::createCanonicalForm(g2));
+				}
+			}
+		}
+
+		BOOST_AUTO_TEST_SUITE_END()
+
+	}
+}
+
+#endif
@@ -20,9 +20,18 @@
 #ifdef COMPILE_UNIT_TESTS
 
 #include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <thread>
 #include "../logging/message_logging.h"
+#include "../logging/MetricsRegistry.h"
+#include "../graphs/DenseMapping.h"
+#include "../basic_types/CancellationToken.h"
+#include "../basic_types/CancelledException.h"
+#include "../basic_types/Streamable.h"
 
 using namespace uncover::logging;
+using namespace uncover::graphs;
+using namespace uncover::basic_types;
 
 namespace uncover {
 	namespace test {
@@ -48,6 +57,215 @@ namespace uncover {
 			gl_LogLevel = store;
 		}
 
+		BOOST_AUTO_TEST_CASE(async_logging_test)
+		{
+			LogTypes store = gl_LogLevel;
+			gl_LogLevel = LogTypes::LT_Warning;
+			std::ostringstream output;
+			unsigned int threadCount = 4;
+			unsigned int msgCount = 5000;
+			{
+				MessageLogger localLogger(output);
+				vector<std::thread> threads;
+				for(unsigned int t = 0; t < threadCount; ++t) {
+					threads.push_back(std::thread([&localLogger,t,msgCount]() {
+						for(unsigned int i = 0; i < msgCount; ++i) {
+							localLogger.newWarning() << "Thread " << t << " message " << i << "." << endLogMessage;
+							localLogger.newDebug() << "This is a discarded debug message." << endLogMessage;
+						}
+					}));
+				}
+				for(auto& thread : threads) {
+					thread.join();
+				}
+			}
+
+			std::istringstream input(output.str());
+			string line;
+			unsigned int lineCount = 0;
+			while(std::getline(input,line)) {
+				++lineCount;
+				BOOST_CHECK(line.find("Thread ") != string::npos);
+				BOOST_CHECK(line.find("This is a discarded debug message.") == string::npos);
+			}
+			BOOST_CHECK_EQUAL(lineCount, threadCount * msgCount);
+
+			gl_LogLevel = store;
+		}
+
+		/**
+		 * A Streamable counting how often it was streamed.
+		 */
+		class CountingStreamable : public Streamable {
+
+			public:
+
+				CountingStreamable() : calls(0) {}
+
+				virtual void streamTo(std::ostream& ost) const override {
+					++calls;
+					ost << "counted";
+				}
+
+				mutable size_t calls;
+
+		};
+
+		BOOST_AUTO_TEST_CASE(filtered_logging_test)
+		{
+			LogTypes store = gl_LogLevel;
+			gl_LogLevel = LogTypes::LT_Warning;
+			std::ostringstream output;
+			CountingStreamable data;
+			{
+				MessageLogger localLogger(output, false);
+				BOOST_CHECK(localLogger.isActive(LogTypes::LT_Warning));
+				BOOST_CHECK(!localLogger.isActive(LogTypes::LT_Debug));
+
+				// a filtered message neither formats its arguments nor reaches the output
+				if(localLogger.isActive(LogTypes::LT_Debug)) {
+					localLogger.newDebug() << "guarded " << data << endLogMessage;
+				}
+				localLogger.newDebug() << "unguarded " << data << endLogMessage;
+				BOOST_CHECK_EQUAL(data.calls, 0);
+
+				localLogger.newWarning() << "active " << data << endLogMessage;
+				BOOST_CHECK_EQUAL(data.calls, 1);
+			}
+			BOOST_CHECK(output.str().find("active counted") != string::npos);
+			BOOST_CHECK(output.str().find("guarded") == string::npos);
+			gl_LogLevel = store;
+		}
+
+		BOOST_AUTO_TEST_CASE(metrics_test)
+		{
+			MetricsRegistry registry;
+			Counter& counter = registry.getCounter("test.counter");
+			BOOST_CHECK_EQUAL(&counter, &registry.getCounter("test.counter"));
+
+			vector<std::thread> threads;
+			for(unsigned int t = 0; t < 4; ++t) {
+				threads.push_back(std::thread([&registry]() {
+					for(unsigned int i = 0; i < 1000; ++i) {
+						registry.getCounter("test.counter").increment();
+						registry.getHistogram("test.histogram").record(i);
+					}
+				}));
+			}
+			for(auto& thread : threads) {
+				thread.join();
+			}
+			registry.getGauge("test.gauge").set(-5);
+
+			Histogram& hist = registry.getHistogram("test.histogram");
+			BOOST_CHECK_EQUAL(counter.getValue(), 4000);
+			BOOST_CHECK_EQUAL(hist.getCount(), 4000);
+			BOOST_CHECK_EQUAL(hist.getSum(), 4 * 999 * 500);
+			BOOST_CHECK_EQUAL(hist.getMin(), 0);
+			BOOST_CHECK_EQUAL(hist.getMax(), 999);
+			BOOST_CHECK_EQUAL(hist.getBucketCount(0), 4);
+			BOOST_CHECK_EQUAL(hist.getBucketCount(10), 4 * 488);
+
+			std::ostringstream json;
+			registry.writeJSON(json, "step1");
+			BOOST_CHECK_EQUAL(json.str().find("{\"label\":\"step1\",\"counters\":{\"test.counter\":4000},\"gauges\":{\"test.gauge\":-5}"), 0);
+
+			std::ostringstream csv;
+			registry.writeCSV(csv, "step1");
+			BOOST_CHECK(csv.str().find("step1,counter,test.counter,4000,,,\n") != string::npos);
+			BOOST_CHECK(csv.str().find("step1,histogram,test.histogram,1998000,4000,0,999\n") != string::npos);
+
+			registry.reset();
+			BOOST_CHECK_EQUAL(counter.getValue(), 0);
+			BOOST_CHECK_EQUAL(hist.getCount(), 0);
+			BOOST_CHECK_EQUAL(hist.getMin(), 0);
+		}
+
+		BOOST_AUTO_TEST_CASE(dense_mapping_test)
+		{
+			Mapping mapp;
+			mapp[1] = 7;
+			mapp[2] = 7;
+			mapp[4] = 3;
+			mapp[9] = 7;
+
+			DenseMapping dense(mapp);
+			BOOST_CHECK_EQUAL(dense.size(), 4);
+			BOOST_CHECK(dense.hasSrc(4));
+			BOOST_CHECK(!dense.hasSrc(3));
+			BOOST_CHECK(!dense.hasSrc(100));
+			BOOST_CHECK_EQUAL(dense.getTar(9), 7);
+			BOOST_CHECK_EQUAL(dense.getTar(100), DenseMapping::undefined);
+			BOOST_CHECK(dense.toMapping() == mapp);
+
+			// the inversion stores the preimages grouped by targets in ascending order
+			DenseMapping::Inversion inv(dense);
+			BOOST_CHECK(inv.getTargets() == vector<IDType>({3, 7}));
+			BOOST_CHECK_EQUAL(inv.count(7), 3);
+			BOOST_CHECK_EQUAL(inv.count(5), 0);
+			BOOST_CHECK_EQUAL(inv.count(100), 0);
+			BOOST_CHECK(vector<IDType>(inv.beginSrc(7), inv.endSrc(7)) == vector<IDType>({1, 2, 9}));
+			BOOST_CHECK(vector<IDType>(inv.beginSrc(3), inv.endSrc(3)) == vector<IDType>({4}));
+			DenseMapping::Inversion invMapp(mapp);
+			BOOST_CHECK(invMapp.getTargets() == inv.getTargets());
+			BOOST_CHECK_EQUAL(invMapp.count(7), 3);
+
+			// sources beyond the initial domain extend it
+			BOOST_CHECK(dense.delSrc(2));
+			BOOST_CHECK(!dense.delSrc(2));
+			dense.setTar(20, 1);
+			BOOST_CHECK_EQUAL(dense.size(), 4);
+			BOOST_CHECK_EQUAL(dense.getTar(20), 1);
+			inv.assign(dense);
+			BOOST_CHECK(inv.getTargets() == vector<IDType>({1, 3, 7}));
+			BOOST_CHECK_EQUAL(inv.count(7), 2);
+
+			dense.clear();
+			BOOST_CHECK_EQUAL(dense.size(), 0);
+			BOOST_CHECK(!dense.hasSrc(1));
+			inv.assign(dense);
+			BOOST_CHECK(inv.getTargets().empty());
+			BOOST_CHECK_EQUAL(inv.count(7), 0);
+		}
+
+		BOOST_AUTO_TEST_CASE(cancellation_token_test)
+		{
+			CancellationToken token;
+			BOOST_CHECK(!token.isCancelled());
+			BOOST_CHECK(!token.hasDeadline());
+			BOOST_CHECK_NO_THROW(token.throwIfCancelled());
+
+			// a deadline in the future does not cancel the token, a reached one does
+			token.setTimeout(std::chrono::hours(1));
+			BOOST_CHECK(token.hasDeadline());
+			BOOST_CHECK(!token.isCancelled());
+			token.setDeadline(CancellationToken::Clock::now());
+			BOOST_CHECK(token.isCancelled());
+			BOOST_CHECK(!token.wasCancelledExplicitly());
+			BOOST_CHECK_THROW(token.throwIfCancelled(), CancelledException);
+			token.clearDeadline();
+			BOOST_CHECK(!token.isCancelled());
+
+			// a short timeout is noticed within milliseconds
+			token.setTimeout(std::chrono::milliseconds(20));
+			auto start = CancellationToken::Clock::now();
+			while(!token.isCancelled()) {}
+			BOOST_CHECK(CancellationToken::Clock::now() - start >= std::chrono::milliseconds(20));
+			BOOST_CHECK(CancellationToken::Clock::now() - start < std::chrono::milliseconds(500));
+
+			// an explicit cancellation from another thread is not undone by removing the deadline
+			token.clearDeadline();
+			std::thread canceller([&token]() { token.cancel(); });
+			canceller.join();
+			BOOST_CHECK(token.isCancelled());
+			BOOST_CHECK(token.wasCancelledExplicitly());
+			token.clearDeadline();
+			BOOST_CHECK(token.isCancelled());
+			token.reset();
+			BOOST_CHECK(!token.isCancelled());
+			BOOST_CHECK(!token.hasDeadline());
+		}
+
 		BOOST_AUTO_TEST_SUITE_END()
 
 	}
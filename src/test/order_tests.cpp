@@ -22,6 +22,8 @@
 #include <boost/test/unit_test.hpp>
 #include "../subgraphs/SubgraphOrder.h"
 #include "../minors/MinorOrder.h"
+#include "../graphs/MinGraphList.h"
+#include "../basic_types/CancelledException.h"
 #include "graph_generator.h"
 
 using namespace std;
@@ -147,6 +149,113 @@ namespace uncover {
 		}
 
 
+		BOOST_AUTO_TEST_SUITE_END()
+
+		//////////////////////////////////////////////////////////////////////////////////////
+		// Cancellation Tests
+		//////////////////////////////////////////////////////////////////////////////////////
+
+		/**
+		 * Wraps the subgraph order and cancels the given token at the given call of isLessOrEq(...). Calls are only
+		 * counted while a CancellationToken is set.
+		 */
+		class CancellingOrder : public Order {
+
+			public:
+
+				CancellingOrder(CancellationToken_sp token, size_t cancelAt) : token(token), cancelAt(cancelAt), calls(0) {}
+
+				virtual bool isLessOrEq(Hypergraph const& smaller, Hypergraph const& bigger) const override {
+					if(cancellation) {
+						if(++calls == cancelAt) {
+							token->cancel();
+						}
+						cancellation->throwIfCancelled();
+					}
+					return order.isLessOrEq(smaller, bigger);
+				}
+
+			private:
+
+				CancellationToken_sp token;
+				size_t cancelAt;
+				mutable size_t calls;
+				SubgraphOrder order;
+
+		};
+
+		/**
+		 * Creates a graph with one vertex per given label, each with a unary edge of this label.
+		 */
+		Hypergraph_sp createUnaryGraph(vector<string> const& labels) {
+			Hypergraph_sp graph = make_shared<Hypergraph>();
+			for(string const& label : labels) {
+				graph->addEdge(label, {graph->addVertex()});
+			}
+			return graph;
+		}
+
+		BOOST_AUTO_TEST_SUITE(order_cancellation)
+
+		BOOST_AUTO_TEST_CASE(cancelled_orders)
+		{
+			CancellationToken_sp token = make_shared<CancellationToken>();
+			vector<pair<Order_sp,Hypergraph_csp>> inputs;
+			inputs.push_back(make_pair(make_shared<SubgraphOrder>(), getGraph(1)));
+			inputs.push_back(make_pair(make_shared<SubgraphOrder>(4), getGraph(1)));
+			inputs.push_back(make_pair(make_shared<MinorOrder>(), getGraph(22)));
+			for(auto& input : inputs) {
+				input.first->setCancellationToken(token);
+				BOOST_CHECK(input.first->getCancellationToken() == token);
+				token->cancel();
+				BOOST_CHECK_THROW(input.first->isLessOrEq(*input.second, *input.second), CancelledException);
+				token->reset();
+				BOOST_CHECK(input.first->isLessOrEq(*input.second, *input.second));
+				token->setTimeout(chrono::seconds(0));
+				BOOST_CHECK_THROW(input.first->isLessOrEq(*input.second, *input.second), CancelledException);
+				input.first->setCancellationToken(nullptr);
+				BOOST_CHECK(input.first->isLessOrEq(*input.second, *input.second));
+				token->reset();
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(cancelled_min_graph_list)
+		{
+			// the small graph is smaller than both graphs in the list, which are incomparable
+			Hypergraph_sp big1 = createUnaryGraph({"A", "B"});
+			Hypergraph_sp big2 = createUnaryGraph({"A", "C"});
+			Hypergraph_sp small = createUnaryGraph({"A"});
+
+			// the small graph is compared twice with big1 (larger, smaller) and, since big1 is larger, once with big2
+			for(size_t cancelAt = 1; cancelAt <= 4; ++cancelAt) {
+				CancellationToken_sp token = make_shared<CancellationToken>();
+				Order_sp order = make_shared<CancellingOrder>(token, cancelAt);
+				MinGraphList list(order);
+				list.addGraphs({big1, big2});
+				order->setCancellationToken(token);
+				if(cancelAt <= 3) {
+					BOOST_CHECK_THROW(list.addGraph(small), CancelledException);
+				} else {
+					BOOST_CHECK(list.addGraph(small));
+				}
+				// a cancelled call leaves the list unchanged, even if big1 was already found to be larger
+				BOOST_CHECK_EQUAL(list.contains(big1->getID()), cancelAt <= 3);
+				BOOST_CHECK_EQUAL(list.contains(small->getID()), cancelAt > 3);
+				BOOST_CHECK_EQUAL(list.contains(big2->getID()), cancelAt <= 3);
+				BOOST_CHECK_EQUAL(list.size(), (cancelAt <= 3) ? 2 : 1);
+			}
+
+			// the list checks its own token before each comparison
+			CancellationToken_sp token = make_shared<CancellationToken>();
+			MinGraphList list(make_shared<SubgraphOrder>());
+			list.addGraphs({big1, big2});
+			list.setCancellationToken(token);
+			token->cancel();
+			BOOST_CHECK_THROW(list.addGraph(small), CancelledException);
+			BOOST_CHECK_EQUAL(list.size(), 2);
+			BOOST_CHECK(!list.contains(small->getID()));
+		}
+
 		BOOST_AUTO_TEST_SUITE_END()
 
 		//////////////////////////////////////////////////////////////////////////////////////
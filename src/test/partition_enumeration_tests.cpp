@@ -22,6 +22,7 @@
 #include <boost/test/unit_test.hpp>
 #include "../basic_types/IDPartitionEnumerator.h"
 #include "../basic_types/standard_operators.h"
+#include <algorithm>
 
 using namespace std;
 using namespace uncover::basic_types;
@@ -44,6 +45,30 @@ namespace uncover {
 			BOOST_REQUIRE_EQUAL(counter, 15);
 		}
 
+		BOOST_AUTO_TEST_CASE(id_enumeration_split)
+		{
+			vector<IDType> testIDs = {1,2,3,4};
+
+			// split off a new enumerator after every element; all enumerators together have to enumerate
+			// every partition exactly once
+			vector<IDPartition> found;
+			vector<IDPartitionEnumerator> work;
+			work.push_back(IDPartitionEnumerator(testIDs));
+			while(!work.empty()) {
+				IDPartitionEnumerator enumerator(std::move(work.back()));
+				work.pop_back();
+				for(; !enumerator.ended(); ++enumerator) {
+					BOOST_CHECK(find(found.cbegin(), found.cend(), *enumerator) == found.cend());
+					found.push_back(*enumerator);
+					IDPartitionEnumerator other = enumerator.split();
+					if(!other.ended()) {
+						work.push_back(std::move(other));
+					}
+				}
+			}
+			BOOST_REQUIRE_EQUAL(found.size(), 15);
+		}
+
 		BOOST_AUTO_TEST_CASE(transitive_closure1)
 		{
 			IDPartition part1 = {{1},{3,4},{7}};
@@ -45,12 +45,19 @@
 
 #include <boost/test/unit_test.hpp>
 #include "../rule_engine/TotalPOCEnumerator.h"
+#include "../rule_engine/StdMatchFinder.h"
+#include "../rule_engine/SplitRule.h"
+#include "../graphs/UQRuleInstance.h"
 #include "../basic_types/standard_operators.h"
+#include "../basic_types/CancelledException.h"
 #include "../subgraphs/SubgraphPOCEnumerator.h"
 #include "../subgraphs/SubgraphRulePreparer.h"
 #include "../minors/MinorPOCEnumerator.h"
 #include "../minors/MinorRulePreparer.h"
+#include "../graphs/CanonicalLabeler.h"
 #include "graph_generator.h"
+#include <algorithm>
+#include <set>
 
 using namespace std;
 using namespace uncover::rule_engine;
@@ -122,11 +129,11 @@ namespace uncover {
 
 		void performTPOCTest(Rule_csp rule, Hypergraph_csp target, bool injective, size_t count, bool print) {
 
-			TotalPOCEnumerator enumerator(rule,target,injective);
+			TotalPOCEnumerator_up enumerator = TotalPOCEnumerator::create(rule,target,injective);
 			if(injective) {
-				executeTestI<TotalPOCEnumerator>(enumerator,count,print);
+				executeTestI<TotalPOCEnumerator>(*enumerator,count,print);
 			} else {
-				executeTestNI<TotalPOCEnumerator>(enumerator,count,print);
+				executeTestNI<TotalPOCEnumerator>(*enumerator,count,print);
 			}
 
 		}
@@ -149,6 +156,31 @@ namespace uncover {
 
 		}
 
+		template<typename E>
+		vector<string> collectPOCs(unique_ptr<E> enumerator, bool split) {
+
+			// splits off a new enumerator after every pushout complement, if split is true
+			vector<string> forms;
+			vector<unique_ptr<E>> work;
+			work.push_back(std::move(enumerator));
+			while(!work.empty()) {
+				unique_ptr<E> current = std::move(work.back());
+				work.pop_back();
+				while(!current->ended()) {
+					forms.push_back(CanonicalLabeler::createCanonicalForm(*current->getGraph()));
+					++(*current);
+					if(split) {
+						unique_ptr<E> other = current->split();
+						if(other) work.push_back(std::move(other));
+					}
+				}
+			}
+
+			sort(forms.begin(), forms.end());
+			return forms;
+
+		}
+
 		void performMPOCTest(Rule_csp rule,
 				Hypergraph_csp target,
 				size_t count,
@@ -259,6 +291,86 @@ namespace uncover {
 
 		}
 
+		BOOST_AUTO_TEST_CASE(constrained_matches)
+		{
+
+			// the matcher has to find exactly the co-matches for which the rules are backward applicable
+			vector<pair<size_t, size_t>> pairs = {{0,0}, {1,0}, {2,1}, {3,2}, {4,3}, {1,3}, {5,4}, {6,4}, {7,4}, {8,5}, {9,6}, {10,6}};
+			for(auto const& p : pairs) {
+				Rule_csp rule = getRule(p.first);
+				MatchConstraints_sp constraints = make_shared<MatchConstraints>();
+				rule->fillMatchConstraints(*constraints);
+				Hypergraph_csp target = getGraph(p.second);
+				for(bool injective : {false, true}) {
+					StdMatchFinder matcher(injective);
+					vector<Mapping> applicable;
+					shared_ptr<vector<Mapping>> all = matcher.findMatches(*rule->getRight(), *target);
+					for(Mapping const& match : *all) {
+						if(rule->isBackApplicable(*target, match)) {
+							applicable.push_back(match);
+						}
+					}
+					matcher.setConstraints(constraints);
+					shared_ptr<vector<Mapping>> constrained = matcher.findMatches(*rule->getRight(), *target);
+					BOOST_REQUIRE_EQUAL(constrained->size(), applicable.size());
+					for(Mapping const& match : *constrained) {
+						BOOST_CHECK(find(applicable.cbegin(), applicable.cend(), match) != applicable.cend());
+					}
+				}
+			}
+
+		}
+
+		BOOST_AUTO_TEST_CASE(parallel_matches)
+		{
+
+			// the parallel search has to find the same matches in the same order as the sequential search
+			vector<pair<size_t, size_t>> pairs = {{0,0}, {1,0}, {2,1}, {3,2}, {4,3}, {1,3}, {5,4}, {6,4}, {7,4}, {8,5}, {9,6}, {10,6}};
+			for(auto const& p : pairs) {
+				Rule_csp rule = getRule(p.first);
+				Hypergraph_csp target = getGraph(p.second);
+				for(bool injective : {false, true}) {
+					StdMatchFinder sequential(injective);
+					StdMatchFinder parallel(injective);
+					parallel.setThreadCount(4);
+					parallel.setParallelThreshold(1);
+					shared_ptr<vector<Mapping>> all = sequential.findMatches(*rule->getRight(), *target);
+					BOOST_CHECK(*all == *parallel.findMatches(*rule->getRight(), *target));
+
+					// if only one match is searched, any match may be returned
+					parallel.setStopOnFirstFind(true);
+					shared_ptr<vector<Mapping>> one = parallel.findMatches(*rule->getRight(), *target);
+					BOOST_REQUIRE_EQUAL(one->size(), all->empty() ? 0 : 1);
+					if(!one->empty()) {
+						BOOST_CHECK(find(all->cbegin(), all->cend(), one->front()) != all->cend());
+					}
+				}
+			}
+
+		}
+
+		BOOST_AUTO_TEST_CASE(reconfigured_matches)
+		{
+
+			// a matcher reconfigured via its setters has to behave like a matcher constructed with the new settings
+			vector<pair<size_t, size_t>> pairs = {{0,0}, {2,1}, {4,3}, {1,3}, {6,4}, {8,5}, {10,6}};
+			for(auto const& p : pairs) {
+				Rule_csp rule = getRule(p.first);
+				Hypergraph_csp target = getGraph(p.second);
+				StdMatchFinder reconfigured;
+				for(int mode = 0; mode < 4; ++mode) {
+					bool injective = mode & 1;
+					bool stopFast = mode & 2;
+					reconfigured.setInjectivity(injective);
+					reconfigured.setStopOnFirstFind(stopFast);
+					StdMatchFinder fresh(injective, stopFast);
+					BOOST_CHECK(*fresh.findMatches(*rule->getRight(), *target) ==
+							*reconfigured.findMatches(*rule->getRight(), *target));
+				}
+			}
+
+		}
+
 		BOOST_AUTO_TEST_SUITE_END()
 
 		//////////////////////////////////////////////////////////////////////////////////////
@@ -293,6 +405,103 @@ namespace uncover {
 
 		}
 
+		BOOST_AUTO_TEST_CASE(subgraph_poc_up_to_isomorphism)
+		{
+
+			// returns the sorted canonical forms of all pushout complements with and without skipping isomorphic ones
+			auto enumerateForms = [](AnonRule_csp rule, Hypergraph_csp target, bool injective, vector<string> (&forms)[2]) {
+				for(int upToIso = 0; upToIso < 2; ++upToIso) {
+					SubgraphPOCEnumerator enumerator(injective,-1);
+					enumerator.setUpToIsomorphism(upToIso);
+					enumerator.resetWith(rule,0,target);
+					for(; !enumerator.ended(); ++enumerator) {
+						forms[upToIso].push_back(CanonicalLabeler::createCanonicalForm(**enumerator));
+					}
+					sort(forms[upToIso].begin(), forms[upToIso].end());
+				}
+			};
+
+			// rule 1 has two interchangeable isolated nodes, hence some pushout complements can be skipped
+			Rule_csp rule = getRule(1);
+			vector<size_t> graphs = {0, 3};
+			for(size_t g : graphs) {
+				Hypergraph_csp target = getGraph(g);
+				for(bool injective : {true, false}) {
+					vector<string> forms[2];
+					enumerateForms(rule, target, injective, forms);
+					BOOST_CHECK(forms[1].size() <= forms[0].size());
+					BOOST_CHECK(set<string>(forms[0].begin(), forms[0].end()) == set<string>(forms[1].begin(), forms[1].end()));
+					if(g == 3 && !injective) {
+						BOOST_CHECK(forms[1].size() < forms[0].size());
+					}
+				}
+			}
+
+			// the isolated universally quantified vertex of an instance has to be matched with exact degree, hence it is
+			// not interchangeable with the preserved isolated vertex; both orders of their IDs are checked
+			for(bool uqFirst : {true, false}) {
+				Hypergraph_sp left = make_shared<Hypergraph>();
+				Hypergraph_sp right = make_shared<Hypergraph>();
+				IDType leftUQ = 0, leftStd = 0, rightUQ = 0, rightStd = 0;
+				for(int i = 0; i < 2; ++i) {
+					if((i == 0) == uqFirst) {
+						leftUQ = left->addVertex();
+						rightUQ = right->addVertex();
+					} else {
+						leftStd = left->addVertex();
+						rightStd = right->addVertex();
+					}
+				}
+				left->addEdge("A", {left->addVertex()});
+				Mapping mapp;
+				mapp[leftUQ] = rightUQ;
+				mapp[leftStd] = rightStd;
+				UQRuleInstance_sp instance = make_shared<UQRuleInstance>("uq instance", left, right, mapp,
+						unordered_set<IDType>({leftUQ}), unordered_set<IDType>({rightUQ}));
+				BOOST_REQUIRE(!SplitRule(*instance).getInterchangeableNodes());
+
+				// the non-isolated target vertex is created first, the isolated one second
+				Hypergraph_sp target = make_shared<Hypergraph>();
+				target->addEdge("B", {target->addVertex()});
+				target->addVertex();
+				for(bool injective : {true, false}) {
+					vector<string> forms[2];
+					enumerateForms(instance, target, injective, forms);
+					BOOST_CHECK(!forms[0].empty());
+					BOOST_CHECK(forms[0] == forms[1]);
+				}
+			}
+
+		}
+
+		BOOST_AUTO_TEST_CASE(subgraph_poc_cancellation)
+		{
+
+			Rule_csp rule = getRule(1);
+			Hypergraph_csp target = getGraph(0);
+			CancellationToken_sp token = make_shared<CancellationToken>();
+			SubgraphPOCEnumerator enumerator(false,-1);
+			enumerator.setCancellationToken(token);
+
+			// a cancelled token interrupts the search for co-matches
+			token->cancel();
+			BOOST_CHECK_THROW(enumerator.resetWith(rule,target), CancelledException);
+			BOOST_CHECK_THROW(enumerator.ended(), InvalidStateException);
+
+			// the same holds for a reached deadline, but the enumerator can be reset afterwards
+			token->reset();
+			token->setTimeout(chrono::seconds(0));
+			BOOST_CHECK_THROW(enumerator.resetWith(rule,target), CancelledException);
+			token->reset();
+			BOOST_REQUIRE(enumerator.resetWith(rule,target));
+			size_t count = 0;
+			for(; !enumerator.ended(); ++enumerator) {
+				++count;
+			}
+			BOOST_CHECK_EQUAL(count, 25);
+
+		}
+
 		BOOST_AUTO_TEST_CASE(subgraph_poc_enumerator3)
 		{
 
@@ -470,6 +679,71 @@ namespace uncover {
 
 		}
 
+		BOOST_AUTO_TEST_CASE(split_poc_enumerators)
+		{
+
+			// splitting must neither lose nor duplicate pushout complements
+			vector<pair<size_t, size_t>> pairs = {{0,0}, {1,0}, {2,1}, {3,2}, {1,3}, {5,4}, {6,4}, {7,4}};
+			for(auto const& p : pairs) {
+				Rule_csp rule = getRule(p.first);
+				Hypergraph_csp target = getGraph(p.second);
+				for(bool injective : {false, true}) {
+
+					// only the rules 0 to 5 are total
+					if(p.first <= 5) {
+						vector<string> unsplit = collectPOCs(TotalPOCEnumerator::create(rule, target, injective), false);
+						vector<string> split = collectPOCs(TotalPOCEnumerator::create(rule, target, injective), true);
+						BOOST_CHECK(unsplit == split);
+					}
+
+					vector<string> unsplit = collectPOCs(PartialPOCEnumerator_up(new PartialPOCEnumerator(rule, target, injective, nullptr)), false);
+					vector<string> split = collectPOCs(PartialPOCEnumerator_up(new PartialPOCEnumerator(rule, target, injective, nullptr)), true);
+					BOOST_CHECK(unsplit == split);
+
+				}
+			}
+
+		}
+
+		BOOST_AUTO_TEST_CASE(cached_split_rules)
+		{
+
+			GTS gts;
+			gts.addStdRule(getRule(13));
+			PreparedGTS_sp prepGTS = make_shared<PreparedGTS>(gts, make_shared<SubgraphRulePreparer>());
+
+			for(auto it = prepGTS->getStdRules().cbegin(); it != prepGTS->getStdRules().cend(); ++it) {
+
+				// the split is computed once and shared afterwards
+				SplitRule_csp split = prepGTS->getSplitRule(it->second);
+				BOOST_CHECK_EQUAL(split, prepGTS->getSplitRule(it->second));
+				for(IDType id : split->getDeletedVertices()) {
+					BOOST_CHECK(!split->getPartialRule()->getMapping().hasSrc(id));
+				}
+				for(IDType id : split->getDeletedEdges()) {
+					BOOST_CHECK(!split->getPartialRule()->getMapping().hasSrc(id));
+				}
+
+				// enumerating with the cached split yields the same pushout complements as splitting the rule again
+				Hypergraph_csp target = getGraph(27);
+				for(bool injective : {false, true}) {
+					size_t uncached = 0;
+					for(PartialPOCEnumerator enumerator(it->second, target, injective, nullptr); !enumerator.ended(); ++enumerator) {
+						++uncached;
+					}
+					size_t cached = 0;
+					for(int i = 0; i < 2; ++i) {
+						for(PartialPOCEnumerator enumerator(split, target, injective, nullptr); !enumerator.ended(); ++enumerator) {
+							++cached;
+						}
+					}
+					BOOST_CHECK_EQUAL(cached, 2 * uncached);
+				}
+
+			}
+
+		}
+
 		BOOST_AUTO_TEST_SUITE_END()
 
 		//////////////////////////////////////////////////////////////////////////////////////
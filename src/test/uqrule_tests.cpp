@@ -20,13 +20,24 @@
 #ifdef COMPILE_UNIT_TESTS
 
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <thread>
 #include "../graphs/UQRule.h"
 #include "../graphs/Hypergraph.h"
+#include "../graphs/GTS.h"
+#include "../analysis/PreparedGTS.h"
+#include "../analysis/NoRulePreparer.h"
+#include "../analysis/PreparedGTSCache.h"
+#include "graph_generator.h"
+#include <boost/filesystem.hpp>
+#include "../logging/MetricsRegistry.h"
 //#include "../basic_types/standard_operators.h"
 
 using namespace std;
 using namespace uncover::basic_types;
 using namespace uncover::graphs;
+using namespace uncover::analysis;
+using namespace uncover::logging;
 
 namespace uncover {
 	namespace test {
@@ -81,6 +92,159 @@ namespace uncover {
 			// there has to be an assertion for this to be a real test
 		}
 
+		/**
+		 * Creates a UQRule with two identical quantifications, each adding an A-edge to the single vertex.
+		 * @return the created rule
+		 */
+		UQRule_sp createDoubleQuantRule() {
+			UQRule_sp rule = make_shared<UQRule>("test rule", make_shared<Hypergraph>(), make_shared<Hypergraph>(), Mapping());
+			IDType vidl = rule->getMainRule().getLeft()->addVertex();
+			IDType vidr = rule->getMainRule().getRight()->addVertex();
+			rule->getMainRule().getMapping()[vidl] = vidr;
+			for(int i = 0; i < 2; ++i) {
+				Rule quantRule("test quantification", make_shared<Hypergraph>(), make_shared<Hypergraph>());
+				IDType vidlq = quantRule.getLeft()->addVertex();
+				IDType vidrq = quantRule.getRight()->addVertex();
+				quantRule.getRight()->addEdge("A",{vidrq});
+				quantRule.getMapping()[vidlq] = vidrq;
+				Mapping quantMap;
+				quantMap[vidlq] = vidl;
+				rule->addQuantification(pair<Rule, Mapping>(quantRule, quantMap));
+			}
+			return rule;
+		}
+
+		BOOST_AUTO_TEST_CASE(prepared_instances_test)
+		{
+			UQRule_sp rule = createDoubleQuantRule();
+			GTS::UQRuleMap uqRules;
+			uqRules[rule->getID()] = rule;
+			GTS gts("test gts", GTS::RuleMap(), uqRules);
+
+			// the bound of this graph is 2, i.e. 6 quantities are enumerated
+			Hypergraph graph;
+			graph.addVertex();
+			graph.addVertex();
+
+			PreparedGTS unoptimized(gts, make_shared<NoRulePreparer>(), false);
+			size_t count = 0;
+			for(auto it = unoptimized.beginUQInstances(rule->getID(), graph); !it.hasEnded(); ++it) {
+				BOOST_REQUIRE(*it);
+				++count;
+			}
+			BOOST_CHECK_EQUAL(count, 6);
+
+			// with optimization only one instance per number of instantiations remains
+			Counter& prepared = metrics.getCounter("uq.instances.prepared");
+			Counter& reused = metrics.getCounter("uq.instances.reused");
+			PreparedGTS optimized(gts, make_shared<NoRulePreparer>(), true);
+			uint64_t preparedBefore = prepared.getValue();
+			vector<size_t> edgeCounts;
+			for(auto it = optimized.beginUQInstances(rule->getID(), graph); !it.hasEnded(); ++it) {
+				edgeCounts.push_back((*it)->getRight()->getEdgeCount());
+			}
+			std::sort(edgeCounts.begin(), edgeCounts.end());
+			BOOST_CHECK(edgeCounts == vector<size_t>({0, 1, 2}));
+			BOOST_CHECK_EQUAL(prepared.getValue() - preparedBefore, 6);
+
+			// a second iteration reuses all prepared instances
+			uint64_t reusedBefore = reused.getValue();
+			count = 0;
+			for(auto it = optimized.beginUQInstances(rule->getID(), graph); !it.hasEnded(); ++it) {
+				++count;
+			}
+			BOOST_CHECK_EQUAL(count, 3);
+			BOOST_CHECK_EQUAL(prepared.getValue() - preparedBefore, 6);
+			BOOST_CHECK_EQUAL(reused.getValue() - reusedBefore, 3);
+		}
+
+		BOOST_AUTO_TEST_CASE(concurrent_instances_test)
+		{
+			UQRule_sp rule = createDoubleQuantRule();
+			GTS::UQRuleMap uqRules;
+			uqRules[rule->getID()] = rule;
+			GTS gts("test gts", GTS::RuleMap(), uqRules);
+
+			Hypergraph graph;
+			for(int i = 0; i < 4; ++i) {
+				graph.addVertex();
+			}
+
+			// all threads share the cache of the same PreparedGTS and have to see the same instances
+			PreparedGTS prepared(gts, make_shared<NoRulePreparer>(), false);
+			vector<size_t> counts(4, 0);
+			vector<std::thread> threads;
+			for(size_t t = 0; t < counts.size(); ++t) {
+				threads.push_back(std::thread([&prepared, &rule, &graph, &counts, t]() {
+					for(auto it = prepared.beginUQInstances(rule->getID(), graph); !it.hasEnded(); ++it) {
+						++counts[t];
+					}
+				}));
+			}
+			for(std::thread& thread : threads) {
+				thread.join();
+			}
+
+			// 15 quantity vectors with a sum of at most 4
+			for(size_t count : counts) {
+				BOOST_CHECK_EQUAL(count, 15);
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(prepared_gts_cache_test)
+		{
+			UQRule_sp rule = createDoubleQuantRule();
+			GTS::UQRuleMap uqRules;
+			uqRules[rule->getID()] = rule;
+			GTS::RuleMap stdRules;
+			for(size_t i = 0; i < 3; ++i) {
+				Rule_sp stdRule = getRule(i);
+				stdRules[stdRule->getID()] = stdRule;
+			}
+			GTS gts("test gts", stdRules, uqRules);
+
+			Hypergraph graph;
+			graph.addVertex();
+			graph.addVertex();
+
+			PreparedGTS prepared(gts, make_shared<NoRulePreparer>(), true);
+			for(auto it = prepared.beginUQInstances(rule->getID(), graph); !it.hasEnded(); ++it) {}
+
+			boost::filesystem::path file = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+			PreparedGTSCache cache(file.string(), 42);
+			BOOST_REQUIRE(cache.store(prepared));
+
+			// the restored rules have to be in the same order and prepared from the same rules
+			PreparedGTS_sp loaded = cache.load(gts, make_shared<NoRulePreparer>(), true);
+			BOOST_REQUIRE(loaded);
+			BOOST_REQUIRE_EQUAL(loaded->getStdRuleCount(), prepared.getStdRuleCount());
+			map<IDType, Rule_sp> expected(prepared.getStdRules().cbegin(), prepared.getStdRules().cend());
+			map<IDType, Rule_sp> actual(loaded->getStdRules().cbegin(), loaded->getStdRules().cend());
+			for(auto expIt = expected.cbegin(), actIt = actual.cbegin(); expIt != expected.cend(); ++expIt, ++actIt) {
+				BOOST_CHECK_EQUAL(actIt->second->getName(), expIt->second->getName());
+				BOOST_CHECK_EQUAL(actIt->second->getLeft()->getEdgeCount(), expIt->second->getLeft()->getEdgeCount());
+				BOOST_CHECK_EQUAL(actIt->second->getRight()->getVertexCount(), expIt->second->getRight()->getVertexCount());
+				BOOST_CHECK(*loaded->getOriginalRules(actIt->first) == *prepared.getOriginalRules(expIt->first));
+			}
+
+			// the restored instances are reused without preparing them again
+			BOOST_CHECK_EQUAL(loaded->getPreparedQuantityCount(), prepared.getPreparedQuantityCount());
+			Counter& preparedCounter = metrics.getCounter("uq.instances.prepared");
+			uint64_t preparedBefore = preparedCounter.getValue();
+			size_t count = 0;
+			for(auto it = loaded->beginUQInstances(rule->getID(), graph); !it.hasEnded(); ++it) {
+				++count;
+			}
+			BOOST_CHECK_EQUAL(count, 3);
+			BOOST_CHECK_EQUAL(preparedCounter.getValue(), preparedBefore);
+
+			// caches of other inputs and corrupted caches are ignored
+			BOOST_CHECK(!PreparedGTSCache(file.string(), 43).load(gts, make_shared<NoRulePreparer>(), true));
+			boost::filesystem::resize_file(file, boost::filesystem::file_size(file) / 2);
+			BOOST_CHECK(!cache.load(gts, make_shared<NoRulePreparer>(), true));
+			boost::filesystem::remove(file);
+		}
+
 		BOOST_AUTO_TEST_SUITE_END()
 
 	}
@@ -0,0 +1,243 @@
+#!/bin/sh
+# Runs every configuration of benchmark-configs.txt and stores wall time, peak memory usage, number of backward
+# steps and number of error graphs in a JSON summary. If a baseline summary is given, the results are compared to
+# it and the script fails if a configuration got slower or used more memory than allowed by the thresholds, or if
+# the number of steps or error graphs changed.
+#
+# usage: perform-benchmark.sh [options]
+#   -c <file>   configuration file (default: benchmark-configs.txt)
+#   -f <text>   only run configurations whose name contains the given text
+#   -r <n>      run every configuration n times and use the median wall time (default: 1)
+#   -t <sec>    timeout passed to every analysis (default: 3600)
+#   -b <file>   compare the results against the given baseline summary
+#   -T <pct>    allowed increase of wall time in percent (default: 10, differences below 0.5s are ignored)
+#   -M <pct>    allowed increase of peak memory usage in percent (default: 10)
+#   -s <file>   additionally store the summary as new baseline in the given file
+#   -e <list>   run every configuration once per exploration strategy of the given comma separated list (e.g.
+#               bfs,smallest,fanout), append '@<strategy>' to the names and print a comparison of the strategies
+
+MAINPATH=`dirname $(readlink -f $0)`
+
+# search for executable (build versions have priority)
+if [ -x $MAINPATH/../build/uncover ];
+then
+  EXECTHIS=$MAINPATH/../build/uncover
+else
+  EXECTHIS=$MAINPATH/uncover
+fi
+
+CONFIGS=$MAINPATH/benchmark-configs.txt
+FILTER=""
+RUNS=1
+TIMEOUT=3600
+BASELINE=""
+TIME_THRESHOLD=10
+MEM_THRESHOLD=10
+SAVE_BASELINE=""
+STRATEGIES=""
+
+while getopts "c:f:r:t:b:T:M:s:e:" OPT; do
+  case $OPT in
+    c) CONFIGS=$(readlink -f $OPTARG) ;;
+    f) FILTER=$OPTARG ;;
+    r) RUNS=$OPTARG ;;
+    t) TIMEOUT=$OPTARG ;;
+    b) BASELINE=$(readlink -f $OPTARG) ;;
+    T) TIME_THRESHOLD=$OPTARG ;;
+    M) MEM_THRESHOLD=$OPTARG ;;
+    s) SAVE_BASELINE=$OPTARG ;;
+    e) STRATEGIES=$(echo $OPTARG | tr ',' ' ') ;;
+    *) echo "unknown option, see the head of this script for a usage description"; exit 2 ;;
+  esac
+done
+
+if [ ! -x $EXECTHIS ]; then
+  echo "no uncover executable found"
+  exit 2
+fi
+
+# create a fresh result folder
+if [ ! -d "$MAINPATH/run-results" ]; then
+  mkdir "$MAINPATH/run-results"
+fi
+FNAPP=$(date '+%F')
+COUNTER=1
+while [ -x $MAINPATH/run-results/benchmark_$FNAPP"_"$COUNTER ]; do
+   COUNTER=`expr $COUNTER + 1`
+done
+RESULTDIR=$MAINPATH/run-results/benchmark_$FNAPP"_"$COUNTER
+mkdir $RESULTDIR
+SUMMARY=$RESULTDIR/summary.json
+
+# returns the current time in seconds (with fractions if supported)
+now() {
+  date '+%s.%N' | sed 's/\.N$//; s/\.%N$//'
+}
+
+# extracts the value of the given JSON field from a single summary line
+json_field() {
+  echo "$1" | sed -n 's/.*"'$2'": *"\{0,1\}\([^",}]*\)"\{0,1\}.*/\1/p'
+}
+
+echo "{" > $SUMMARY
+echo "  \"uncover\": \"$EXECTHIS\"," >> $SUMMARY
+echo "  \"date\": \"$(date '+%F %T')\"," >> $SUMMARY
+echo "  \"runs\": $RUNS," >> $SUMMARY
+echo "  \"results\": [" >> $SUMMARY
+
+# expand the configurations by the exploration strategies to be compared
+RUNCONFIGS=$RESULTDIR/configs.txt
+grep -v '^[[:space:]]*#' $CONFIGS | grep -v '^[[:space:]]*$' | while read NAME GTS ERRORS ORDER PARAMS; do
+  if [ -z "$STRATEGIES" ]; then
+    echo "$NAME $GTS $ERRORS $ORDER $PARAMS"
+  else
+    for STRATEGY in $STRATEGIES; do
+      echo "$NAME@$STRATEGY $GTS $ERRORS $ORDER $PARAMS exploration=$STRATEGY"
+    done
+  fi
+done > $RUNCONFIGS
+
+FIRST=1
+while read NAME GTS ERRORS ORDER PARAMS; do
+
+  case "$NAME" in
+    *"$FILTER"*) ;;
+    *) continue ;;
+  esac
+
+  CONFDIR=$RESULTDIR/$NAME
+  mkdir $CONFDIR
+
+  # generate the GTS if necessary
+  case "$GTS" in
+    lerc:*)
+      $EXECTHIS --scn=lerc ${GTS#lerc:} $CONFDIR/generated.xml > $CONFDIR/generate.log 2>&1
+      GTSFILE=$CONFDIR/generated.xml
+      ;;
+    *)
+      GTSFILE=$MAINPATH/$GTS
+      ;;
+  esac
+
+  TIMES=""
+  PEAK=-1
+  RUN=1
+  while [ $RUN -le $RUNS ]; do
+    echo "running $NAME ($RUN/$RUNS)"
+    START=$(now)
+    $EXECTHIS --scn=backw $GTSFILE $MAINPATH/$ERRORS "$ORDER" $CONFDIR to=$TIMEOUT $PARAMS > $CONFDIR/run$RUN.log 2>&1
+    EXITCODE=$?
+    END=$(now)
+    TIMES="$TIMES $(echo "$START $END" | awk '{ printf "%.3f", $2 - $1 }')"
+    RSS=$(sed -n 's/.*Peak memory usage: \([0-9-]*\) KB.*/\1/p' $CONFDIR/run$RUN.log | tail -n 1)
+    if [ -n "$RSS" ] && [ $RSS -gt $PEAK ]; then
+      PEAK=$RSS
+    fi
+    RUN=`expr $RUN + 1`
+  done
+
+  # the last run determines steps and result
+  LOG=$CONFDIR/run$RUNS.log
+  WALL=$(echo $TIMES | tr ' ' '\n' | sort -n | awk '{ v[NR] = $1 } END { print v[int((NR + 1) / 2)] }')
+  STEPS=$(grep -c "Starting with search depth" $LOG)
+  PROCESSED=$(grep -c "Processing graph" $LOG)
+  SKIPPED=$(grep -c "Skipping graph" $LOG)
+  GRAPHS=$(sed -n 's/.*Writing error graphs (\([0-9]*\) in total).*/\1/p' $LOG | tail -n 1)
+  if [ -z "$GRAPHS" ]; then
+    GRAPHS=-1
+  fi
+  # "timeout reached" is produced by BackwardAnalysis::getCancellationReason() and checked by timeout_message_test
+  if [ $EXITCODE -ne 0 ]; then
+    STATUS="failed"
+  elif grep -qi "timeout reached" $LOG; then
+    STATUS="timeout"
+  elif grep -q "initial graphs was covered" $LOG; then
+    STATUS="covered"
+  else
+    STATUS="ok"
+  fi
+
+  if [ $FIRST -eq 0 ]; then
+    echo "," >> $SUMMARY
+  fi
+  FIRST=0
+  printf '    {"name": "%s", "status": "%s", "wall_time": %s, "peak_rss_kb": %s, "steps": %s, "error_graphs": %s, "processed": %s, "skipped": %s}' \
+    "$NAME" "$STATUS" "$WALL" "$PEAK" "$STEPS" "$GRAPHS" "$PROCESSED" "$SKIPPED" >> $SUMMARY
+
+done < $RUNCONFIGS
+
+echo "" >> $SUMMARY
+echo "  ]" >> $SUMMARY
+echo "}" >> $SUMMARY
+
+echo "summary written to $SUMMARY"
+
+if [ -n "$SAVE_BASELINE" ]; then
+  cp $SUMMARY $SAVE_BASELINE
+  echo "baseline stored in $SAVE_BASELINE"
+fi
+
+# compare the exploration strategies (time relative to the first strategy of the list)
+if [ -n "$STRATEGIES" ]; then
+  printf '%-40s %-10s %8s %12s %8s %10s %10s %12s\n' "name" "strategy" "status" "time" "diff%" "processed" "skipped" "error_graphs"
+  grep '"name":' $SUMMARY | sed 's/@/ /' | awk '{ print $2 }' | tr -d '",' | uniq | while read BASENAME; do
+    REFTIME=""
+    for STRATEGY in $STRATEGIES; do
+      LINE=$(grep "\"name\": \"$BASENAME@$STRATEGY\"" $SUMMARY)
+      if [ -z "$LINE" ]; then
+        continue
+      fi
+      TIME=$(json_field "$LINE" wall_time)
+      if [ -z "$REFTIME" ]; then
+        REFTIME=$TIME
+      fi
+      printf '%-40s %-10s %8s %12.3f %8.1f %10s %10s %12s\n' "$BASENAME" "$STRATEGY" "$(json_field "$LINE" status)" "$TIME" \
+        "$(awk -v r="$REFTIME" -v t="$TIME" 'BEGIN { print (r > 0) ? (t - r) * 100 / r : 0 }')" \
+        "$(json_field "$LINE" processed)" "$(json_field "$LINE" skipped)" "$(json_field "$LINE" error_graphs)"
+    done
+  done
+fi
+
+# compare with baseline
+if [ -z "$BASELINE" ]; then
+  cat $SUMMARY
+  exit 0
+fi
+
+REGRESSIONS=0
+printf '%-40s %12s %12s %8s %12s %12s %8s %s\n' "name" "time(base)" "time(new)" "diff%" "rss(base)" "rss(new)" "diff%" "result"
+grep '"name":' $SUMMARY > $RESULTDIR/new.lines
+while read LINE; do
+  NAME=$(json_field "$LINE" name)
+  BASE=$(grep "\"name\": \"$NAME\"" $BASELINE)
+  if [ -z "$BASE" ]; then
+    printf '%-40s %s\n' "$NAME" "not in baseline"
+    continue
+  fi
+  RESULT=$(awk -v bt="$(json_field "$BASE" wall_time)" -v nt="$(json_field "$LINE" wall_time)" \
+      -v bm="$(json_field "$BASE" peak_rss_kb)" -v nm="$(json_field "$LINE" peak_rss_kb)" \
+      -v tt=$TIME_THRESHOLD -v mt=$MEM_THRESHOLD 'BEGIN {
+    td = (bt > 0) ? (nt - bt) * 100 / bt : 0;
+    md = (bm > 0) ? (nm - bm) * 100 / bm : 0;
+    flag = "";
+    if (td > tt && nt - bt > 0.5) flag = flag " SLOWER";
+    if (bm > 0 && nm > 0 && md > mt) flag = flag " MORE-MEMORY";
+    printf "%12.3f %12.3f %8.1f %12d %12d %8.1f%s", bt, nt, td, bm, nm, md, flag
+  }')
+  if [ "$(json_field "$BASE" steps)" != "$(json_field "$LINE" steps)" ] || \
+     [ "$(json_field "$BASE" error_graphs)" != "$(json_field "$LINE" error_graphs)" ] || \
+     [ "$(json_field "$BASE" status)" != "$(json_field "$LINE" status)" ]; then
+    RESULT="$RESULT RESULT-CHANGED"
+  fi
+  printf '%-40s %s\n' "$NAME" "$RESULT"
+  case "$RESULT" in
+    *SLOWER*|*MORE-MEMORY*|*RESULT-CHANGED*) echo "$NAME" >> $RESULTDIR/regressions.txt ;;
+  esac
+done < $RESULTDIR/new.lines
+
+if [ -f $RESULTDIR/regressions.txt ]; then
+  echo "regressions found in $(wc -l < $RESULTDIR/regressions.txt) configuration(s)"
+  exit 1
+fi
+echo "no regressions found"
+exit 0